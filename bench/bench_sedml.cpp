@@ -0,0 +1,726 @@
+/**
+ * @file    bench_sedml.cpp
+ * @brief   times libSEDML on synthetic documents of parametric size
+ * @author  Frank T. Bergmann
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SEDML, and the latest version of libSEDML.
+ *
+ * Copyright (c) 2013, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Usage: bench_sedml [options]
+ *
+ *   --models N           number of models (default 100)
+ *   --changes M          number of changes per model (default 20)
+ *   --depth D            depth of the nested repeated tasks (default 10)
+ *   --generators K       number of data generators with math (default 500)
+ *   --range-size V       number of values of each vector range (default 1000)
+ *   --annotation-size A  number of elements in each annotation (default 50)
+ *   --repeat R           number of times each operation is run (default 5)
+ *   --threads T          number of threads of the parallel analysis
+ *                        (default 0, one per core)
+ *   --points P           number of points each data generator is
+ *                        evaluated over (default 1000)
+ *
+ * The program builds a document of the requested size, then times writing,
+ * reading (also as trusted input, and failing fast), cloning, looking up every id, traversing it through its getters
+ * and with a SedVisitor, analyzing it on one thread and with a
+ * SedParallelTraversal, evaluating its data generators with SedMathProgram,
+ * and destroying it.  The results are printed on
+ * the standard output as JSON: for each operation, the best and the mean
+ * time over the runs, and its throughput; and the peak resident set size
+ * of the process.
+ *
+ * The parallel analysis is meant to be measured on a document of about
+ * 100,000 elements, built with
+ *
+ *   bench_sedml --models 1000 --changes 40 --generators 10000 --depth 10
+ */
+
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sedml/SedTypes.h>
+#include <sbml/math/FormulaParser.h>
+#include <sbml/math/L3FormulaFormatter.h>
+
+#if defined(WIN32) && !defined(CYGWIN)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+LIBSEDML_CPP_NAMESPACE_USE
+
+
+/**
+ * The size of the generated document.
+ */
+struct BenchParameters
+{
+  unsigned int numModels;
+  unsigned int numChanges;
+  unsigned int depth;
+  unsigned int numGenerators;
+  unsigned int rangeSize;
+  unsigned int annotationSize;
+  unsigned int repeat;
+  unsigned int numThreads;
+  unsigned int numPoints;
+};
+
+
+/**
+ * The times measured for one operation.
+ */
+struct BenchTiming
+{
+  BenchTiming() : best(0.0), total(0.0), runs(0) {}
+
+  void add(double time)
+  {
+    if (runs == 0 || time < best) best = time;
+    total += time;
+    ++runs;
+  }
+
+  double mean() const { return (runs > 0) ? total / runs : 0.0; }
+
+  double best;
+  double total;
+  unsigned int runs;
+};
+
+
+static string
+makeId(const char* prefix, unsigned int n)
+{
+  ostringstream id;
+  id << prefix << n;
+  return id.str();
+}
+
+
+static string
+makeAnnotation(unsigned int size)
+{
+  ostringstream annotation;
+  annotation << "<annotation><bench:data xmlns:bench='http://sed-ml.org/bench'>";
+
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      annotation << "<bench:entry index='" << i << "' value='" << i * 0.5
+                 << "'>annotation text of entry " << i << "</bench:entry>";
+    }
+
+  annotation << "</bench:data></annotation>";
+  return annotation.str();
+}
+
+
+/**
+ * Builds a document of the given size.
+ */
+static SedDocument*
+generateDocument(const BenchParameters& params)
+{
+  SedDocument* doc = new SedDocument();
+  const string annotation = makeAnnotation(params.annotationSize);
+
+  SedUniformTimeCourse* sim = doc->createUniformTimeCourse();
+  sim->setId("sim1");
+  sim->setInitialTime(0.0);
+  sim->setOutputStartTime(0.0);
+  sim->setOutputEndTime(100.0);
+  sim->setNumberOfPoints(1000);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  for (unsigned int m = 0; m < params.numModels; ++m)
+    {
+      SedModel* model = doc->createModel();
+      model->setId(makeId("model", m));
+      model->setLanguage("urn:sedml:language:sbml");
+      model->setSource(makeId("model", m) + ".xml");
+      model->setAnnotation(annotation);
+
+      for (unsigned int c = 0; c < params.numChanges; ++c)
+        {
+          SedChangeAttribute* change = model->createChangeAttribute();
+          change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='"
+                            + makeId("k", c) + "']/@value");
+          ostringstream value;
+          value << (c + 1) * 0.1;
+          change->setNewValue(value.str());
+        }
+
+      SedTask* task = doc->createTask();
+      task->setId(makeId("task", m));
+      task->setModelReference(model->getId());
+      task->setSimulationReference("sim1");
+    }
+
+  // repeated tasks nested to the requested depth, each over a vector range
+  vector<double> values(params.rangeSize);
+
+  for (unsigned int i = 0; i < params.rangeSize; ++i)
+    {
+      values[i] = i * 0.01;
+    }
+
+  string inner = (params.numModels > 0) ? "task0" : "";
+
+  for (unsigned int d = 0; d < params.depth; ++d)
+    {
+      SedRepeatedTask* repeated = doc->createRepeatedTask();
+      repeated->setId(makeId("repeat", d));
+      repeated->setRangeId(makeId("range", d));
+      repeated->setResetModel(d % 2 == 0);
+
+      SedVectorRange* range = repeated->createVectorRange();
+      range->setId(makeId("range", d));
+      range->setValues(values);
+
+      SedSetValue* setValue = repeated->createTaskChange();
+      setValue->setModelReference("model0");
+      setValue->setRange(makeId("range", d));
+      setValue->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k0']");
+      ASTNode* math = SBML_parseL3Formula(makeId("range", d).c_str());
+      setValue->setMath(math);
+      delete math;
+
+      SedSubTask* subTask = repeated->createSubTask();
+      subTask->setOrder(1);
+      subTask->setTask(inner);
+
+      inner = repeated->getId();
+    }
+
+  SedReport* report = doc->createReport();
+  report->setId("report1");
+
+  for (unsigned int g = 0; g < params.numGenerators; ++g)
+    {
+      SedDataGenerator* generator = doc->createDataGenerator();
+      generator->setId(makeId("dg", g));
+
+      SedVariable* variable = generator->createVariable();
+      variable->setId(makeId("v", g));
+      variable->setTaskReference(params.numModels > 0
+                                 ? makeId("task", g % params.numModels) : "");
+      variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='S1']");
+
+      SedParameter* parameter = generator->createParameter();
+      parameter->setId(makeId("p", g));
+      parameter->setValue(g * 0.5);
+
+      ASTNode* math = SBML_parseL3Formula((makeId("p", g) + " * " + makeId("v", g)
+                                           + " + sin(" + makeId("v", g) + ") / 2").c_str());
+      generator->setMath(math);
+      delete math;
+
+      SedDataSet* dataSet = report->createDataSet();
+      dataSet->setId(makeId("ds", g));
+      dataSet->setLabel(generator->getId());
+      dataSet->setDataReference(generator->getId());
+    }
+
+  return doc;
+}
+
+
+/**
+ * Looks up every element of the document by its id; returns the number of
+ * elements found.
+ */
+static unsigned int
+lookupIds(SedDocument* doc, const BenchParameters& params)
+{
+  unsigned int found = 0;
+
+  for (unsigned int m = 0; m < params.numModels; ++m)
+    {
+      if (doc->getModel(makeId("model", m)) != NULL) ++found;
+      if (doc->getTask(makeId("task", m)) != NULL) ++found;
+    }
+
+  for (unsigned int d = 0; d < params.depth; ++d)
+    {
+      if (doc->getTask(makeId("repeat", d)) != NULL) ++found;
+    }
+
+  for (unsigned int g = 0; g < params.numGenerators; ++g)
+    {
+      SedDataGenerator* generator = doc->getDataGenerator(makeId("dg", g));
+      if (generator == NULL) continue;
+      ++found;
+      if (generator->getVariable(makeId("v", g)) != NULL) ++found;
+    }
+
+  return found;
+}
+
+
+/**
+ * Visits every element of the document; returns the number of elements
+ * visited.
+ */
+static unsigned int
+traverse(const SedDocument* doc, size_t& checksum)
+{
+  unsigned int count = 1;
+
+  for (unsigned int n = 0; n < doc->getNumSimulations(); ++n, ++count)
+    {
+      checksum += doc->getSimulation(n)->getId().size();
+    }
+
+  for (unsigned int n = 0; n < doc->getNumModels(); ++n, ++count)
+    {
+      const SedModel* model = doc->getModel(n);
+      checksum += model->getId().size();
+
+      for (unsigned int c = 0; c < model->getNumChanges(); ++c, ++count)
+        {
+          checksum += model->getChange(c)->getTarget().size();
+        }
+    }
+
+  for (unsigned int n = 0; n < doc->getNumTasks(); ++n, ++count)
+    {
+      const SedTask* task = doc->getTask(n);
+      checksum += task->getId().size();
+
+      const SedRepeatedTask* repeated = dynamic_cast<const SedRepeatedTask*>(task);
+      if (repeated == NULL) continue;
+
+      count += repeated->getNumRanges() + repeated->getNumTaskChanges()
+               + repeated->getNumSubTasks();
+
+      for (unsigned int r = 0; r < repeated->getNumRanges(); ++r)
+        {
+          const SedVectorRange* range =
+            dynamic_cast<const SedVectorRange*>(repeated->getRange(r));
+          if (range != NULL) checksum += range->getValues().size();
+        }
+    }
+
+  for (unsigned int n = 0; n < doc->getNumDataGenerators(); ++n, ++count)
+    {
+      const SedDataGenerator* generator = doc->getDataGenerator(n);
+      checksum += generator->getId().size();
+      count += generator->getNumVariables() + generator->getNumParameters();
+
+      if (generator->getMath() != NULL)
+        checksum += generator->getMath()->getNumChildren();
+    }
+
+  for (unsigned int n = 0; n < doc->getNumOutputs(); ++n, ++count)
+    {
+      const SedReport* report = dynamic_cast<const SedReport*>(doc->getOutput(n));
+      if (report != NULL) count += report->getNumDataSets();
+    }
+
+  return count;
+}
+
+
+/**
+ * Counts the elements of a document, and touches their ids.
+ */
+class CountingVisitor : public SedVisitor
+{
+public:
+  CountingVisitor() : count(0), checksum(0) {}
+
+  virtual bool visit(const SedBase& x)
+  {
+    ++count;
+    checksum += x.getId().size();
+    return true;
+  }
+
+  unsigned int count;
+  size_t checksum;
+};
+
+
+/**
+ * Analyzes the elements of a document: renders the math of data generators
+ * and set values, and resolves the references of tasks and variables.
+ */
+class AnalysisVisitor : public SedMergeableVisitor
+{
+public:
+  using SedVisitor::visit;
+
+  AnalysisVisitor() : count(0), unresolved(0), checksum(0) {}
+
+  virtual bool visit(const SedBase& x)
+  {
+    ++count;
+    checksum += x.getId().size();
+    return true;
+  }
+
+  virtual bool visit(const SedDataGenerator& x)
+  {
+    addMath(x.getMath());
+    return visit(static_cast<const SedBase&>(x));
+  }
+
+  virtual bool visit(const SedSetValue& x)
+  {
+    addMath(x.getMath());
+    return visit(static_cast<const SedBase&>(x));
+  }
+
+  virtual bool visit(const SedTask& x)
+  {
+    const SedDocument* doc = x.getSedDocument();
+    if (x.isSetModelReference()
+        && doc->getModel(x.getModelReference()) == NULL)
+      ++unresolved;
+    if (x.isSetSimulationReference()
+        && doc->getSimulation(x.getSimulationReference()) == NULL)
+      ++unresolved;
+    return visit(static_cast<const SedBase&>(x));
+  }
+
+  virtual bool visit(const SedVariable& x)
+  {
+    if (x.isSetTaskReference()
+        && x.getSedDocument()->getTask(x.getTaskReference()) == NULL)
+      ++unresolved;
+    return visit(static_cast<const SedBase&>(x));
+  }
+
+  virtual SedMergeableVisitor* createWorker() const
+  {
+    return new AnalysisVisitor();
+  }
+
+  virtual void merge(const SedMergeableVisitor& worker)
+  {
+    const AnalysisVisitor& other = static_cast<const AnalysisVisitor&>(worker);
+    count += other.count;
+    unresolved += other.unresolved;
+    checksum += other.checksum;
+  }
+
+  unsigned int count;
+  unsigned int unresolved;
+  size_t checksum;
+
+private:
+  void addMath(const ASTNode* math)
+  {
+    if (math == NULL) return;
+
+    char* formula = SBML_formulaToL3String(math);
+    if (formula != NULL) checksum += strlen(formula);
+    free(formula);
+  }
+};
+
+
+/**
+ * Evaluates the compiled data generators over the given number of points,
+ * each variable being a column of synthetic values.
+ */
+static void
+evaluateGenerators(const vector<SedMathProgram>& programs,
+                   unsigned int numPoints, size_t& checksum)
+{
+  vector<double> column(numPoints);
+  vector<double> result(numPoints);
+
+  for (unsigned int n = 0; n < numPoints; ++n)
+    {
+      column[n] = n * 0.001;
+    }
+
+  for (size_t g = 0; g < programs.size(); ++g)
+    {
+      if (!programs[g].isCompiled() || numPoints == 0) continue;
+
+      vector<const double*> inputs(programs[g].getNumInputs() + 1, &column[0]);
+      programs[g].evaluate(&inputs[0], numPoints, &result[0]);
+      checksum += (result[numPoints - 1] == result[numPoints - 1]) ? 1 : 0;
+    }
+}
+
+
+/**
+ * @return the peak resident set size of the process, in bytes.
+ */
+static unsigned long
+getPeakRSS()
+{
+#if defined(WIN32) && !defined(CYGWIN)
+  PROCESS_MEMORY_COUNTERS counters;
+
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return (unsigned long)counters.PeakWorkingSetSize;
+
+  return 0;
+#else
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+
+#if defined(__APPLE__)
+  return (unsigned long)usage.ru_maxrss;
+#else
+  return (unsigned long)usage.ru_maxrss * 1024UL;
+#endif
+#endif
+}
+
+
+static void
+printTiming(const char* name, const BenchTiming& timing,
+            const char* unit, double amount, bool last = false)
+{
+  cout << "    \"" << name << "\": { "
+       << "\"seconds\": " << timing.best << ", "
+       << "\"mean_seconds\": " << timing.mean() << ", "
+       << "\"" << unit << "_per_second\": "
+       << ((timing.best > 0.0) ? amount / timing.best : 0.0)
+       << " }" << (last ? "" : ",") << endl;
+}
+
+
+static bool
+parseArguments(int argc, char* argv[], BenchParameters& params)
+{
+  for (int i = 1; i < argc; ++i)
+    {
+      if (i + 1 >= argc) return false;
+
+      const char* option = argv[i];
+      int value = atoi(argv[++i]);
+      if (value < 0) return false;
+
+      if      (strcmp(option, "--models") == 0)          params.numModels = value;
+      else if (strcmp(option, "--changes") == 0)         params.numChanges = value;
+      else if (strcmp(option, "--depth") == 0)           params.depth = value;
+      else if (strcmp(option, "--generators") == 0)      params.numGenerators = value;
+      else if (strcmp(option, "--range-size") == 0)      params.rangeSize = value;
+      else if (strcmp(option, "--annotation-size") == 0) params.annotationSize = value;
+      else if (strcmp(option, "--repeat") == 0)          params.repeat = value;
+      else if (strcmp(option, "--threads") == 0)         params.numThreads = value;
+      else if (strcmp(option, "--points") == 0)          params.numPoints = value;
+      else return false;
+    }
+
+  return params.repeat > 0;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  BenchParameters params;
+  params.numModels      = 100;
+  params.numChanges     = 20;
+  params.depth          = 10;
+  params.numGenerators  = 500;
+  params.rangeSize      = 1000;
+  params.annotationSize = 50;
+  params.repeat         = 5;
+  params.numThreads     = 0;
+  params.numPoints      = 1000;
+
+  if (!parseArguments(argc, argv, params))
+  {
+    cerr << endl << "Usage: bench_sedml [--models N] [--changes M] [--depth D]"
+         << " [--generators K] [--range-size V] [--annotation-size A]"
+         << " [--repeat R] [--threads T] [--points P]" << endl << endl;
+    return 2;
+  }
+
+  BenchTiming generateTime, writeTime, readTime, cloneTime;
+  BenchTiming trustedReadTime, failFastReadTime;
+  BenchTiming lookupTime, traverseTime, visitTime, destroyTime;
+  BenchTiming analyzeTime, parallelTime, compileTime, evaluateTime;
+  size_t numBytes = 0;
+  unsigned int numElements = 0;
+  unsigned int numFound = 0;
+  unsigned int numVisited = 0;
+  unsigned int numAnalyzed = 0;
+  unsigned int numUnresolved = 0;
+  unsigned int numPrograms = 0;
+  unsigned int numErrors = 0;
+  size_t checksum = 0;
+
+  SedWriter writer;
+  SedReader reader;
+  SedReader trustedReader;
+  SedReader failFastReader;
+  SedParallelTraversal traversal;
+
+  trustedReader.setTrustedInput(true);
+  failFastReader.setFailFast(true);
+
+  if (params.numThreads > 0)
+    traversal.setNumThreads(params.numThreads);
+
+  for (unsigned int r = 0; r < params.repeat; ++r)
+    {
+      double start = SedReaderStatistics::now();
+      SedDocument* doc = generateDocument(params);
+      generateTime.add(SedReaderStatistics::now() - start);
+
+      start = SedReaderStatistics::now();
+      char* xml = writer.writeSedMLToString(doc);
+      writeTime.add(SedReaderStatistics::now() - start);
+
+      numBytes = (xml != NULL) ? strlen(xml) : 0;
+
+      start = SedReaderStatistics::now();
+      SedDocument* copy = reader.readSedMLFromString(xml != NULL ? xml : "");
+      readTime.add(SedReaderStatistics::now() - start);
+
+      start = SedReaderStatistics::now();
+      SedDocument* trusted =
+        trustedReader.readSedMLFromString(xml != NULL ? xml : "");
+      trustedReadTime.add(SedReaderStatistics::now() - start);
+      delete trusted;
+
+      start = SedReaderStatistics::now();
+      SedDocument* failFast =
+        failFastReader.readSedMLFromString(xml != NULL ? xml : "");
+      failFastReadTime.add(SedReaderStatistics::now() - start);
+      delete failFast;
+
+      free(xml);
+      numErrors = copy->getNumErrors(LIBSEDML_SEV_ERROR)
+                  + copy->getNumErrors(LIBSEDML_SEV_FATAL);
+
+      start = SedReaderStatistics::now();
+      SedDocument* clone = copy->clone();
+      cloneTime.add(SedReaderStatistics::now() - start);
+
+      start = SedReaderStatistics::now();
+      numFound = lookupIds(copy, params);
+      lookupTime.add(SedReaderStatistics::now() - start);
+
+      start = SedReaderStatistics::now();
+      numElements = traverse(copy, checksum);
+      traverseTime.add(SedReaderStatistics::now() - start);
+
+      CountingVisitor visitor;
+      start = SedReaderStatistics::now();
+      copy->accept(visitor);
+      visitTime.add(SedReaderStatistics::now() - start);
+      numVisited = visitor.count;
+      checksum += visitor.checksum;
+
+      AnalysisVisitor analysis;
+      start = SedReaderStatistics::now();
+      copy->accept(analysis);
+      analyzeTime.add(SedReaderStatistics::now() - start);
+
+      AnalysisVisitor parallel;
+      start = SedReaderStatistics::now();
+      traversal.traverse(*copy, parallel);
+      parallelTime.add(SedReaderStatistics::now() - start);
+      numAnalyzed = parallel.count;
+      numUnresolved = parallel.unresolved;
+      checksum += (parallel.checksum == analysis.checksum) ? 0 : 1;
+
+      start = SedReaderStatistics::now();
+      vector<SedMathProgram> programs(copy->getNumDataGenerators());
+      numPrograms = 0;
+
+      for (unsigned int g = 0; g < programs.size(); ++g)
+        {
+          if (programs[g].compile(*copy->getDataGenerator(g))
+              == LIBSEDML_OPERATION_SUCCESS)
+            ++numPrograms;
+        }
+
+      compileTime.add(SedReaderStatistics::now() - start);
+
+      start = SedReaderStatistics::now();
+      evaluateGenerators(programs, params.numPoints, checksum);
+      evaluateTime.add(SedReaderStatistics::now() - start);
+
+      start = SedReaderStatistics::now();
+      delete copy;
+      destroyTime.add(SedReaderStatistics::now() - start);
+
+      delete clone;
+      delete doc;
+    }
+
+  cout << "{" << endl;
+  cout << "  \"parameters\": { "
+       << "\"models\": " << params.numModels << ", "
+       << "\"changes\": " << params.numChanges << ", "
+       << "\"depth\": " << params.depth << ", "
+       << "\"generators\": " << params.numGenerators << ", "
+       << "\"range_size\": " << params.rangeSize << ", "
+       << "\"annotation_size\": " << params.annotationSize << ", "
+       << "\"repeat\": " << params.repeat << ", "
+       << "\"threads\": " << traversal.getNumThreads() << ", "
+       << "\"points\": " << params.numPoints << " }," << endl;
+  cout << "  \"document\": { "
+       << "\"elements\": " << numElements << ", "
+       << "\"bytes\": " << numBytes << ", "
+       << "\"errors\": " << numErrors << ", "
+       << "\"unresolved\": " << numUnresolved << ", "
+       << "\"checksum\": " << checksum << " }," << endl;
+  cout << "  \"operations\": {" << endl;
+  printTiming("generate", generateTime, "elements", numElements);
+  printTiming("write",    writeTime,    "bytes",    (double)numBytes);
+  printTiming("read",     readTime,     "bytes",    (double)numBytes);
+  printTiming("read_trusted", trustedReadTime, "bytes", (double)numBytes);
+  printTiming("read_fail_fast", failFastReadTime, "bytes", (double)numBytes);
+  printTiming("clone",    cloneTime,    "elements", numElements);
+  printTiming("lookup",   lookupTime,   "lookups",  numFound);
+  printTiming("traverse", traverseTime, "elements", numElements);
+  printTiming("visit",    visitTime,    "objects",  numVisited);
+  printTiming("analyze",  analyzeTime,  "objects",  numAnalyzed);
+  printTiming("analyze_parallel", parallelTime, "objects", numAnalyzed);
+  printTiming("compile_math", compileTime, "generators", numPrograms);
+  printTiming("evaluate_math", evaluateTime, "points",
+              (double)numPrograms * params.numPoints);
+  printTiming("destroy",  destroyTime,  "elements", numElements, true);
+  cout << "  }," << endl;
+  cout << "  \"peak_rss_bytes\": " << getPeakRSS() << endl;
+  cout << "}" << endl;
+
+  return (numErrors == 0) ? 0 : 1;
+}
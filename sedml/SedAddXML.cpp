@@ -36,6 +36,7 @@
 
 #include <sedml/SedAddXML.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -141,6 +142,8 @@ SedAddXML::isSetNewXML() const
 int
 SedAddXML::setNewXML(XMLNode* newXML)
 {
+  markDirty();
+
   if (mNewXML == newXML)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -165,6 +168,8 @@ SedAddXML::setNewXML(XMLNode* newXML)
 int
 SedAddXML::unsetNewXML()
 {
+  markDirty();
+
   delete mNewXML;
   mNewXML = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -252,8 +257,27 @@ SedAddXML::writeElements(XMLOutputStream& stream) const
 bool
 SedAddXML::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedAddXML::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedChange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedAddXML));
+  usage.addXML(mNewXML);
 }
 
 
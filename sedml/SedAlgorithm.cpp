@@ -36,6 +36,7 @@
 
 #include <sedml/SedAlgorithm.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -157,6 +158,8 @@ SedAlgorithm::isSetKisaoID() const
 int
 SedAlgorithm::setKisaoID(const std::string& kisaoID)
 {
+  markDirty();
+
   {
     mKisaoID = kisaoID;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -170,6 +173,8 @@ SedAlgorithm::setKisaoID(const std::string& kisaoID)
 int
 SedAlgorithm::unsetKisaoID()
 {
+  markDirty();
+
   mKisaoID.erase();
 
   if (mKisaoID.empty() == true)
@@ -413,8 +418,62 @@ SedAlgorithm::writeElements(XMLOutputStream& stream) const
 bool
 SedAlgorithm::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mAlgorithmParameters.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedAlgorithm::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedAlgorithm));
+  usage.addString(mKisaoID);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedAlgorithm::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + 1;
+}
+
 
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedAlgorithm::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mAlgorithmParameters;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -533,6 +592,8 @@ SedAlgorithm::getKisaoIDasInt() const
 int
 SedAlgorithm::setKisaoID(int kisaoID)
 {
+  markDirty();
+
   std::stringstream str;
   str << "KISAO:"
       << std::setfill('0')
@@ -36,6 +36,7 @@
 
 #include <sedml/SedAlgorithmParameter.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -165,6 +166,8 @@ SedAlgorithmParameter::isSetValue() const
 int
 SedAlgorithmParameter::setKisaoID(const std::string& kisaoID)
 {
+  markDirty();
+
   {
     mKisaoID = kisaoID;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -178,6 +181,8 @@ SedAlgorithmParameter::setKisaoID(const std::string& kisaoID)
 int
 SedAlgorithmParameter::setValue(const std::string& value)
 {
+  markDirty();
+
   {
     mValue = value;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -191,6 +196,8 @@ SedAlgorithmParameter::setValue(const std::string& value)
 int
 SedAlgorithmParameter::unsetKisaoID()
 {
+  markDirty();
+
   mKisaoID.erase();
 
   if (mKisaoID.empty() == true)
@@ -210,6 +217,8 @@ SedAlgorithmParameter::unsetKisaoID()
 int
 SedAlgorithmParameter::unsetValue()
 {
+  markDirty();
+
   mValue.erase();
 
   if (mValue.empty() == true)
@@ -285,8 +294,28 @@ SedAlgorithmParameter::writeElements(XMLOutputStream& stream) const
 bool
 SedAlgorithmParameter::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedAlgorithmParameter::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedAlgorithmParameter));
+  usage.addString(mKisaoID);
+  usage.addString(mValue);
 }
 
 
@@ -423,6 +452,8 @@ SedAlgorithmParameter::getKisaoIDasInt() const
 int
 SedAlgorithmParameter::setKisaoID(int kisaoID)
 {
+  markDirty();
+
   std::stringstream str;
   str << "KISAO:"
       << std::setfill('0')
@@ -581,6 +612,7 @@ SedListOfAlgorithmParameters::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedAlgorithmParameter*>(item);
@@ -293,6 +293,17 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Adds the memory held by this object to the given SedMemoryUsage.
+   */
+  virtual void addMemoryUsage(SedMemoryUsage& usage) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
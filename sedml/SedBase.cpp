@@ -51,6 +51,10 @@
 #include <sedml/SedErrorLog.h>
 #include <sedml/SedDocument.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedReader.h>
+#include <sedml/SedOutputStream.h>
+#include <sedml/SedJSONWriter.h>
+#include <sedml/SedStatistics.h>
 #include <sedml/SedBase.h>
 
 
@@ -87,7 +91,18 @@ SedBase::getElementByMetaId(std::string metaid)
 List*
 SedBase::getAllElements()
 {
-  return NULL;
+  List* ret = new List();
+  SedElementRange<SedBase> elements = preOrder();
+  SedElementRange<SedBase>::iterator it = elements.begin();
+
+  // skip this object itself, the first of the range, and the lists
+  // holding the children
+  for (++it; it != elements.end(); ++it)
+    {
+      if ((*it)->getTypeCode() != SEDML_LIST_OF) ret->add(*it);
+    }
+
+  return ret;
 }
 
 /** @cond doxygen-libsbml-internal */
@@ -107,6 +122,8 @@ SedBase::SedBase(unsigned int level, unsigned int version) :
   , mHasBeenDeleted(false)
   , mEmptyString("")
   , mURI("")
+  , mRevision(1)
+  , mWriteCache(NULL)
 {
   mSedNamespaces = new SedNamespaces(level, version);
 
@@ -116,6 +133,8 @@ SedBase::SedBase(unsigned int level, unsigned int version) :
   //
   //
   setElementNamespace(mSedNamespaces->getURI());
+
+  SedMemoryUsage::objectCreated();
 }
 
 
@@ -136,6 +155,8 @@ SedBase::SedBase(SedNamespaces *sbmlns) :
   , mHasBeenDeleted(false)
   , mEmptyString("")
   , mURI("")
+  , mRevision(1)
+  , mWriteCache(NULL)
 {
   if (!sbmlns)
     {
@@ -159,6 +180,8 @@ SedBase::SedBase(SedNamespaces *sbmlns) :
 #endif
 
   setElementNamespace(static_cast<SedNamespaces>(*mSedNamespaces).getURI());
+
+  SedMemoryUsage::objectCreated();
 }
 /** @endcond */
 
@@ -204,6 +227,12 @@ SedBase::SedBase(const SedBase& orig)
   this->mHasBeenDeleted = false;
 
   this->mURI = orig.mURI;
+
+  /* the cached output is not copied; the copy is serialized afresh */
+  this->mRevision   = 1;
+  this->mWriteCache = NULL;
+
+  SedMemoryUsage::objectCreated();
 }
 
 
@@ -221,6 +250,9 @@ SedBase::~SedBase()
 
   if (mSedNamespaces != NULL)  delete mSedNamespaces;
 
+  delete mWriteCache;
+
+  SedMemoryUsage::objectDestroyed();
 }
 
 /*
@@ -263,6 +295,7 @@ SedBase& SedBase::operator=(const SedBase& rhs)
 
       this->mURI = rhs.mURI;
 
+      markDirty();
     }
 
   return *this;
@@ -645,6 +678,7 @@ SedBase::setMetaId(const std::string& metaid)
     }
   else if (metaid.empty())
     {
+      markDirty();
       mMetaId.erase();
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -654,6 +688,7 @@ SedBase::setMetaId(const std::string& metaid)
     }
   else
     {
+      markDirty();
       mMetaId = metaid;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -694,6 +729,8 @@ SedBase::setName(const std::string& name)
 int
 SedBase::setAnnotation(const XMLNode* annotation)
 {
+  markDirty();
+
   //
   // (*NOTICE*)
   //
@@ -907,7 +944,6 @@ SedBase::appendAnnotation(const XMLNode* annotation)
 int
 SedBase::appendAnnotation(const std::string& annotation)
 {
-
   int success = LIBSEDML_OPERATION_FAILED;
   XMLNode* annt_xmln;
 
@@ -935,7 +971,6 @@ int
 SedBase::removeTopLevelAnnotationElement(const std::string elementName,
     const std::string elementURI)
 {
-
   int success = LIBSEDML_OPERATION_FAILED;
 
   if (mAnnotation == NULL)
@@ -965,6 +1000,7 @@ SedBase::removeTopLevelAnnotationElement(const std::string elementName,
         }
 
       // remove the annotation at the index corresponding to the name
+      markDirty();
       mAnnotation->removeChild(index);
 
       if (mAnnotation->getNumChildren() == 0)
@@ -1052,6 +1088,8 @@ SedBase::replaceTopLevelAnnotationElement(const std::string& annotation)
 int
 SedBase::setNotes(const XMLNode* notes)
 {
+  markDirty();
+
   if (mNotes == notes)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -1414,6 +1452,8 @@ SedBase::appendNotes(const XMLNode* notes)
        * etc...
        */
 
+      markDirty();
+
       //------------------------------------------------------------
       //
       //  STEP3: appends the given notes to the current notes
@@ -1609,6 +1649,10 @@ void
 SedBase::connectToParent(SedBase* parent)
 {
   mParentSedObject = parent;
+  markDirty();
+
+  // the document is set later, by connectSubtree()
+  if (SedDeferredConnect::isActive()) return;
 
   if (mParentSedObject)
     {
@@ -1621,6 +1665,86 @@ SedBase::connectToParent(SedBase* parent)
 }
 
 
+/*
+ * Sets the parent and the document of every object nested in this object.
+ */
+void
+SedBase::connectSubtree()
+{
+  SedDocument* d = NULL;
+
+  if (getTypeCode() == SEDML_DOCUMENT)
+    d = static_cast<SedDocument*>(this);
+  else if (mParentSedObject != NULL)
+    d = mParentSedObject->mSed;
+
+  connectSubtree(d);
+}
+
+
+/*
+ * Sets the document of this object and its descendants to d.
+ */
+void
+SedBase::connectSubtree(SedDocument* d)
+{
+  mSed = d;
+
+  unsigned int numChildren = getNumChildObjects();
+
+  for (unsigned int n = 0; n < numChildren; ++n)
+    {
+      SedBase* child = const_cast<SedBase*>(getChildObject(n));
+      child->mParentSedObject = this;
+      child->connectSubtree(d);
+    }
+}
+
+
+/*
+ * Advances the revision of this Sed object and all its ancestors.
+ */
+void
+SedBase::markDirty()
+{
+  for (SedBase* sb = this; sb != NULL; sb = sb->mParentSedObject)
+    {
+      ++sb->mRevision;
+    }
+}
+
+
+/*
+ * @return true if the cached output of this object is out of date.
+ */
+bool
+SedBase::isDirty() const
+{
+  return mWriteCache == NULL || mWriteCache->revision != mRevision;
+}
+
+
+/*
+ * @return the revision of this Sed object.
+ */
+unsigned int
+SedBase::getRevision() const
+{
+  return mRevision;
+}
+
+
+/*
+ * Discards the cached output of this Sed object.
+ */
+void
+SedBase::clearWriteCache()
+{
+  delete mWriteCache;
+  mWriteCache = NULL;
+}
+
+
 /*
  * Sets this Sed object to child Sed objects (if any).
  * (Creates a child-parent relationship by the parent)
@@ -1637,6 +1761,89 @@ SedBase::connectToChild()
 
 /** @endcond */
 
+
+/** @cond doxygen-libsbml-internal */
+/*
+ * Adds the memory held by this Sed object, but not by its children, to
+ * the given SedMemoryUsage.
+ */
+void
+SedBase::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  usage.setObjectSize(sizeof(SedBase));
+  usage.addString(mMetaId);
+  usage.addString(mURI);
+  usage.addXML(mNotes);
+  usage.addXML(mAnnotation);
+  usage.addNamespaces(mSedNamespaces);
+
+  if (mWriteCache != NULL)
+    {
+      usage.addBytes(SEDML_MEMORY_OBJECTS, sizeof(SedWriteCache));
+      usage.addString(mWriteCache->output);
+    }
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedBase::getNumChildObjects() const
+{
+  return 0;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedBase::getChildObject(unsigned int n) const
+{
+  return NULL;
+}
+
+
+/*
+ * Adds the memory held by this Sed object and all its descendants to the
+ * given SedMemoryUsage.
+ */
+void
+SedBase::collectMemoryUsage(SedMemoryUsage& usage) const
+{
+  usage.beginObject(getTypeCode());
+  addMemoryUsage(usage);
+  usage.endObject();
+
+  unsigned int numChildren = getNumChildObjects();
+
+  for (unsigned int n = 0; n < numChildren; ++n)
+    {
+      getChildObject(n)->collectMemoryUsage(usage);
+    }
+}
+
+
+/*
+ * Brings the state that const methods of this Sed object and its
+ * descendants update lazily up to date.
+ */
+void
+SedBase::prepareForFreeze()
+{
+  syncAnnotation();
+
+  unsigned int numChildren = getNumChildObjects();
+
+  for (unsigned int n = 0; n < numChildren; ++n)
+    {
+      const_cast<SedBase*>(getChildObject(n))->prepareForFreeze();
+    }
+}
+
+/** @endcond */
+
 SedBase*
 SedBase::getAncestorOfType(int type, const std::string pkgName)
 {
@@ -1700,6 +1907,8 @@ SedBase::getAncestorOfType(int type, const std::string pkgName) const
 int
 SedBase::setNamespaces(XMLNamespaces* xmlns)
 {
+  markDirty();
+
   if (xmlns == NULL)
     {
       mSedNamespaces->setNamespaces(NULL);
@@ -1726,6 +1935,7 @@ SedBase::unsetMetaId()
       return LIBSEDML_UNEXPECTED_ATTRIBUTE;
     }
 
+  markDirty();
   mMetaId.erase();
 
   if (mMetaId.empty())
@@ -1765,6 +1975,8 @@ SedBase::unsetName()
 int
 SedBase::unsetNotes()
 {
+  markDirty();
+
   delete mNotes;
   mNotes = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -2093,9 +2305,38 @@ SedBase::read(XMLInputStream& stream)
 
   setSedBaseFields(element);
 
-  ExpectedAttributes expectedAttributes;
-  addExpectedAttributes(expectedAttributes);
-  readAttributes(element.getAttributes(), expectedAttributes);
+  SedReaderStatistics* stats = (mSed != NULL) ? mSed->getReadStatistics() : NULL;
+
+  if (stats != NULL)
+    stats->addElement(getTypeCode());
+
+  {
+    SedReadPhaseTimer timer(stats, SEDML_READ_PHASE_READ_ATTRIBUTES);
+
+    // the expected attributes only depend on the class of this object and
+    // the Level and Version of SED-ML, so the reader keeps them between
+    // elements (and documents)
+    SedReadCache* cache = (mSed != NULL) ? mSed->getReadCache() : NULL;
+
+    if (cache != NULL)
+      {
+        bool isNew = false;
+        ExpectedAttributes& expectedAttributes =
+          cache->getExpectedAttributes(typeid(*this), getLevel(), getVersion(),
+                                       isNew);
+
+        if (isNew)
+          addExpectedAttributes(expectedAttributes);
+
+        readAttributes(element.getAttributes(), expectedAttributes);
+      }
+    else
+      {
+        ExpectedAttributes expectedAttributes;
+        addExpectedAttributes(expectedAttributes);
+        readAttributes(element.getAttributes(), expectedAttributes);
+      }
+  }
 
   /* if we are reading a document pass the
    * Sed Namespace information to the input stream object
@@ -2104,17 +2345,15 @@ SedBase::read(XMLInputStream& stream)
    */
   if (element.getName() == "sedML")
     {
-      SedNamespaces *ns = new SedNamespaces(getLevel(), getVersion());
+      SedNamespaces ns(getLevel(), getVersion());
 
-      SBMLNamespaces *sbmlns = new SBMLNamespaces();
-      sbmlns->addNamespaces(this->getSedNamespaces()->getNamespaces());
       //stream.setNamespaces(this->getSedNamespaces());
       // need to check that any prefix on the sbmlns also occurs on element
       // remembering the horrible situation where the sbmlns might be declared
       // with more than one prefix
       XMLNamespaces * xmlns = this->getSedNamespaces()->getNamespaces();
 
-      if (xmlns != NULL)
+      if (xmlns != NULL && !isTrustedRead())
         {
           int i = xmlns->getIndexByPrefix(element.getPrefix());
 
@@ -2125,7 +2364,7 @@ SedBase::read(XMLInputStream& stream)
 
               if (i > -1)
                 {
-                  if (xmlns->getURI(i) != ns->getURI())
+                  if (xmlns->getURI(i) != ns.getURI())
                     {
                       error = true;
                     }
@@ -2138,18 +2377,14 @@ SedBase::read(XMLInputStream& stream)
               /* if there is a mismatch in level/version this will already
                * be logged; do not need another error
                */
-              for (unsigned int n = 0; n < this->getErrorLog()->getNumErrors(); n++)
-                {
-                  unsigned int errorId =
-                    this->getErrorLog()->getError(n)->getErrorId();
+              SedErrorLog* log = this->getErrorLog();
 
-                  if (errorId == SedMissingOrInconsistentLevel
-                      || errorId == SedMissingOrInconsistentVersion
-                      || errorId == SedInvalidSedLevelVersion
-                      || errorId == SedInvalidNamespaceOnSed)
-                    {
-                      errorLoggedAlready = true;
-                    }
+              if (log->contains(SedMissingOrInconsistentLevel)
+                  || log->contains(SedMissingOrInconsistentVersion)
+                  || log->contains(SedInvalidSedLevelVersion)
+                  || log->contains(SedInvalidNamespaceOnSed))
+                {
+                  errorLoggedAlready = true;
                 }
 
               if (error == true && errorLoggedAlready == false)
@@ -2180,18 +2415,17 @@ SedBase::read(XMLInputStream& stream)
       //
       checkDefaultNamespace(mSedNamespaces->getNamespaces(), element.getName());
 
-      if (!element.getPrefix().empty())
+      if (!element.getPrefix().empty() && !isTrustedRead())
         {
-          XMLNamespaces * prefixedNS = new XMLNamespaces();
-          prefixedNS->add(element.getURI(), element.getPrefix());
-          checkDefaultNamespace(prefixedNS, element.getName(), element.getPrefix());
-          delete prefixedNS;
+          XMLNamespaces prefixedNS;
+          prefixedNS.add(element.getURI(), element.getPrefix());
+          checkDefaultNamespace(&prefixedNS, element.getName(), element.getPrefix());
         }
     }
 
   if (element.isEnd()) return;
 
-  while (stream.isGood())
+  while (stream.isGood() && !isReadAborted())
     {
       // this used to skip the text
       //    stream.skipText();
@@ -2223,7 +2457,12 @@ SedBase::read(XMLInputStream& stream)
                << stream.peek().getURI() << endl;
 #endif
 
-          SedBase * object = createObject(stream);
+          SedBase * object = NULL;
+
+          {
+            SedReadPhaseTimer timer(stats, SEDML_READ_PHASE_CREATE_OBJECT);
+            object = createObject(stream);
+          }
 
           if (object != NULL)
             {
@@ -2234,16 +2473,30 @@ SedBase::read(XMLInputStream& stream)
 
               object->read(stream);
 
-              if (!stream.isGood()) break;
+              if (!stream.isGood() || isReadAborted()) break;
 
               checkListOfPopulated(object);
             }
-          else if (!(readOtherXML(stream)
-                     || readAnnotation(stream)
-                     || readNotes(stream)))
+          else
             {
-              logUnknownElement(nextName, getLevel(), getVersion());
-              stream.skipPastEnd(stream.next());
+              bool read = false;
+
+              {
+                SedReadPhaseTimer timer(stats, SEDML_READ_PHASE_MATH);
+                read = readOtherXML(stream);
+              }
+
+              if (!read)
+                {
+                  SedReadPhaseTimer timer(stats, SEDML_READ_PHASE_NOTES_ANNOTATION);
+                  read = readAnnotation(stream) || readNotes(stream);
+                }
+
+              if (!read)
+                {
+                  logUnknownElement(nextName, getLevel(), getVersion());
+                  stream.skipPastEnd(stream.next());
+                }
             }
         }
       else
@@ -2284,13 +2537,33 @@ SedBase::write(XMLOutputStream& stream) const
 
     }
 
-  stream.startElement(getElementName(), getPrefix());
+  // the statistics of the stream are looked up once, by the document
+  SedWriteStatisticsScope scope(*this, stream);
+  SedWriterStatistics* stats = SedWriteStatisticsScope::getCurrent();
+
+  if (stats != NULL)
+    stats->addElement(getTypeCode());
+
+  // SedJSONWriter takes the elements, rather than their XML
+  SedJSONOutputStream* json = dynamic_cast<SedJSONOutputStream*>(&stream);
+
+  if (json != NULL)
+    json->startItem(getElementName(), getPrefix());
+  else
+    stream.startElement(getElementName(), getPrefix());
 
   writeXMLNS(stream);
   writeAttributes(stream);
+
+  if (json != NULL)
+    json->endItemAttributes();
+
   writeElements(stream);
 
-  stream.endElement(getElementName(), getPrefix());
+  if (json != NULL)
+    json->endItem();
+  else
+    stream.endElement(getElementName(), getPrefix());
 
 }
 /** @endcond */
@@ -2305,15 +2578,31 @@ SedBase::write(XMLOutputStream& stream) const
 void
 SedBase::writeElements(XMLOutputStream& stream) const
 {
-  if (mNotes != NULL) stream << *mNotes;
-
   /*
    * NOTE: CVTerms on a model have already been dealt with
    */
 
   const_cast <SedBase *>(this)->syncAnnotation();
 
-  if (mAnnotation != NULL) stream << *mAnnotation;
+  if (mNotes == NULL && mAnnotation == NULL) return;
+
+  SedJSONOutputStream* json = dynamic_cast<SedJSONOutputStream*>(&stream);
+
+  if (mNotes != NULL)
+    {
+      if (json != NULL)
+        json->writeNode(*mNotes);
+      else
+        stream << *mNotes;
+    }
+
+  if (mAnnotation != NULL)
+    {
+      if (json != NULL)
+        json->writeNode(*mAnnotation);
+      else
+        stream << *mAnnotation;
+    }
 }
 
 /** @endcond */
@@ -2575,6 +2864,8 @@ SedBase::logEmptyString(const string& attribute,
                         const string& element)
 
 {
+  if (isTrustedRead()) return;
+
   ostringstream msg;
 
   msg << "Attribute '" << attribute << "' on an "
@@ -2857,16 +3148,14 @@ SedBase::writeXMLNS(XMLOutputStream& stream) const
 void
 SedBase::syncAnnotation()
 {
-
+  /* there is nothing to synchronize into a missing annotation; returning
+   * here also keeps const methods from writing to mAnnotation
+   */
   if (mAnnotation == NULL)
-    {
-      XMLToken ann_token = XMLToken(XMLTriple("annotation", "", ""),
-                                    XMLAttributes());
-      mAnnotation = new XMLNode(ann_token);
-    }
+    return;
 
   // if annotation still empty delete the annotation
-  if (mAnnotation != NULL && mAnnotation->getNumChildren() == 0)
+  if (mAnnotation->getNumChildren() == 0)
     {
       delete mAnnotation;
       mAnnotation = NULL;
@@ -2884,6 +3173,8 @@ SedBase::syncAnnotation()
 void
 SedBase::checkOrderAndLogError(SedBase* object, int expected)
 {
+  if (isTrustedRead()) return;
+
   int actual = object->getElementPosition();
 
   if (actual != -1 && actual < expected)
@@ -2915,6 +3206,8 @@ SedBase::checkOrderAndLogError(SedBase* object, int expected)
 void
 SedBase::checkListOfPopulated(SedBase* object)
 {
+  if (isTrustedRead()) return;
+
   //
   // (TODO) Currently, the following check code works only for
   //        elements in Sed core.
@@ -2941,6 +3234,24 @@ SedBase::checkListOfPopulated(SedBase* object)
 }
 /** @endcond */
 
+/** @cond doxygen-libsbml-internal */
+bool
+SedBase::isTrustedRead() const
+{
+  return mSed != NULL && mSed->isTrustedRead();
+}
+
+
+bool
+SedBase::isReadAborted()
+{
+  if (mSed == NULL || !mSed->isFailFastRead()) return false;
+
+  return getErrorLog()->getNumFailsWithSeverity(LIBSEDML_SEV_ERROR) > 0
+         || getErrorLog()->getNumFailsWithSeverity(LIBSEDML_SEV_FATAL) > 0;
+}
+/** @endcond */
+
 //This assumes that the parent of the object is of the type SedListOf.  If this is not the case, it will need to be overridden.
 int SedBase::removeFromParentAndDelete()
 {
@@ -3027,6 +3338,8 @@ SedBase::checkDefaultNamespace(const XMLNamespaces* xmlns,
   // checks if the given default namespace (if any) is a valid
   // Sed namespace
   //
+  if (isTrustedRead()) return;
+
   if (xmlns != NULL && xmlns->getLength() > 0)
     {
       const std::string defaultURI = xmlns->getURI(prefix);
@@ -3056,7 +3369,7 @@ SedBase::checkAnnotation()
   std::vector<std::string> uri_list;
   uri_list.clear();
 
-  if (mAnnotation == NULL) return;
+  if (mAnnotation == NULL || isTrustedRead()) return;
 
   //
   // checks if the given default namespace (if any) is a valid
@@ -3176,7 +3489,7 @@ SedBase::checkAnnotation()
 void
 SedBase::checkXHTML(const XMLNode * xhtml)
 {
-  if (xhtml == NULL) return;
+  if (xhtml == NULL || isTrustedRead()) return;
 
   const string&  name = xhtml->getName();
   unsigned int i, errorNS, errorXML, errorDOC, errorELEM;
@@ -3398,8 +3711,12 @@ SedBase::removeDuplicateAnnotations()
 void
 SedBase::setSedBaseFields(const XMLToken& element)
 {
-  mLine   = element.getLine();
-  mColumn = element.getColumn();
+  // line and column numbers are only needed to report errors
+  if (!isTrustedRead())
+    {
+      mLine   = element.getLine();
+      mColumn = element.getColumn();
+    }
 
   if (element.getNamespaces().getLength() > 0)
     {
@@ -4596,5 +4913,15 @@ SedBase_getAllElements(SedBase_t* sb)
   return sb->getAllElements();
 }
 
+LIBSEDML_EXTERN
+int
+SedBase_connectSubtree(SedBase_t* sb)
+{
+  if (sb == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  sb->connectSubtree();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
 
 LIBSEDML_CPP_NAMESPACE_END
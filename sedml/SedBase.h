@@ -150,8 +150,12 @@
 #include <string>
 #include <stdexcept>
 #include <algorithm>
+#include <vector>
 
 #include <sedml/SedErrorLog.h>
+#include <sedml/SedMemoryUsage.h>
+#include <sedml/SedIterator.h>
+#include <sedml/SedDeferredConnect.h>
 
 
 
@@ -174,6 +178,8 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
 //class SedErrorLog;
 class SedVisitor;
 class SedDocument;
+class SedOutputStream;
+class SedWriteCache;
 
 
 
@@ -245,13 +251,91 @@ public:
 
   /**
    * Returns a List of all child SedBase objects, including those nested to
-   * an arbitrary depth.
+   * an arbitrary depth, in pre-order.
    *
-   * @return a pointer to a List of pointers to all children objects.
+   * The List holds elements only: the SedListOf objects holding the
+   * children are left out, as in earlier versions of libSEDML.  The walk
+   * of preOrder() includes them, each before its items, and iterating
+   * over that range instead also avoids allocating the List.
+   *
+   * @return a pointer to a List of pointers to all children objects; the
+   * caller owns the List, but not the objects.
    */
   virtual List* getAllElements();
 
 
+  /**
+   * Sets the parent and the document of every object nested in this
+   * object, in a single pass over them.  The document is this object if
+   * it is a SedDocument, otherwise the document of its parent.
+   *
+   * Objects added to a parent while a SedDeferredConnect exists are not
+   * linked to their document until this method is called on one of
+   * their ancestors.
+   *
+   * @see SedDeferredConnect
+   */
+  void connectSubtree();
+
+
+#ifndef SWIG
+
+  /**
+   * Returns the range of this object and all the objects nested in it, each
+   * object before its children.
+   *
+   * The range walks the objects in place, without allocating memory.
+   */
+  SedElementRange<SedBase> preOrder()
+  { return SedElementRange<SedBase>(this); }
+
+
+  /**
+   * Returns the range of this object and all the objects nested in it, each
+   * object before its children.
+   */
+  SedElementRange<const SedBase> preOrder() const
+  { return SedElementRange<const SedBase>(this); }
+
+
+  /**
+   * Returns the range of this object and all the objects nested in it, each
+   * object after its children.
+   */
+  SedElementRange<SedBase, SedPostOrderIterator> postOrder()
+  { return SedElementRange<SedBase, SedPostOrderIterator>(this); }
+
+
+  /**
+   * Returns the range of this object and all the objects nested in it, each
+   * object after its children.
+   */
+  SedElementRange<const SedBase, SedPostOrderIterator> postOrder() const
+  { return SedElementRange<const SedBase, SedPostOrderIterator>(this); }
+
+
+  /**
+   * Returns the range of the objects of class @p T (or of one of its
+   * subclasses) among this object and the objects nested in it, in
+   * pre-order; for instance <code>doc->elements<SedVariable>()</code>.
+   */
+  template<class T>
+  SedElementRange<T> elements()
+  { return SedElementRange<T>(this); }
+
+
+  /**
+   * Returns the range of the objects of class @p T (or of one of its
+   * subclasses) among this object and the objects nested in it, in
+   * pre-order.
+   */
+  template<class T>
+  SedElementRange<const T> elements() const
+  { return SedElementRange<const T>(this); }
+
+#endif  /* !SWIG */
+
+
   /**
    * Returns the value of the "metaid" attribute of this object.
    *
@@ -1802,6 +1886,53 @@ public:
   /** @endcond */
 
 
+  /** @cond doxygen-libsbml-internal */
+  /**
+   * Adds the memory held by this Sed object, but not by its children, to
+   * the given SedMemoryUsage.
+   *
+   * Subclasses holding data of their own must override this function: call
+   * the implementation of the parent class, set the size of the subclass
+   * with SedMemoryUsage::setObjectSize() and add the data it holds.
+   */
+  virtual void addMemoryUsage(SedMemoryUsage& usage) const;
+
+
+  /**
+   * Returns the number of child Sed objects of this object.  Lists held
+   * by value are children of their parent, and their items are children
+   * of the lists.
+   *
+   * Subclasses must override this function and getChildObject() if they
+   * define one ore more child elements.
+   */
+  virtual unsigned int getNumChildObjects() const;
+
+
+  /**
+   * Returns the nth child Sed object of this object, in the order in which
+   * the children are written, or @c NULL if @p n is out of range.
+   */
+  virtual const SedBase* getChildObject(unsigned int n) const;
+
+
+  /**
+   * Adds the memory held by this Sed object and all its descendants to the
+   * given SedMemoryUsage.
+   */
+  void collectMemoryUsage(SedMemoryUsage& usage) const;
+
+
+  /**
+   * Brings the state that const methods of this Sed object and its
+   * descendants update lazily up to date, so that they no longer modify
+   * the objects; used by SedDocument::freeze().
+   */
+  virtual void prepareForFreeze();
+
+  /** @endcond */
+
+
   /**
    * Sets the namespaces relevant of this Sed object.
    *
@@ -2252,6 +2383,52 @@ public:
   virtual SedErrorLog* getErrorLog();
 
 
+  /**
+   * Records that this object has been modified since it was last
+   * serialized.
+   *
+   * The revision of this object and of all its ancestors is advanced, so
+   * that a SedWriter using the subtree cache (see
+   * SedWriter::setUseSubtreeCache()) re-serializes every element on the
+   * path to the modification and re-uses the cached output of all
+   * unmodified siblings.
+   *
+   * All setters and unsetters of libSEDML call this function when they
+   * succeed, as do the functions of the C API returning the math of an
+   * object, such as SedDataGenerator_getMath(), whose result may be
+   * modified.  Callers modifying an object through a pointer obtained from
+   * one of the other accessors (for example getNotes() or getAnnotation(),
+   * or the math of SedDataGenerator::getMath() once cast to non-const)
+   * need to call it themselves.
+   */
+  void markDirty();
+
+
+  /**
+   * Predicate returning @c true if this object has been modified since its
+   * serialized form was last cached.
+   *
+   * @return @c true if no cached output exists for the current revision of
+   * this object, @c false otherwise.
+   */
+  bool isDirty() const;
+
+
+  /**
+   * Returns the revision of this object.  The revision is advanced every
+   * time this object or one of its children is modified.
+   *
+   * @return the revision of this object.
+   */
+  unsigned int getRevision() const;
+
+
+  /**
+   * Discards any serialized output cached for this object.
+   */
+  void clearWriteCache();
+
+
 protected:
 
 
@@ -2266,6 +2443,12 @@ protected:
 
   /** @cond doxygen-libsbml-internal */
 
+  /**
+   * Sets the document of this object and of every object nested in it to
+   * @p d, and the parent of each nested object.
+   */
+  void connectSubtree(SedDocument* d);
+
   bool matchesCoreSedNamespace(const SedBase * sb);
 
   bool matchesCoreSedNamespace(const SedBase * sb) const;
@@ -2477,6 +2660,24 @@ protected:
   void checkXHTML(const XMLNode *);
 
 
+  /**
+   * @return true if this object is being read from trusted input, in which
+   * case the consistency checks made while reading are skipped.
+   *
+   * @see SedReader::setTrustedInput(bool trusted)
+   */
+  bool isTrustedRead() const;
+
+
+  /**
+   * @return true if this object is being read in fail-fast mode and an
+   * error has been logged already, in which case reading stops.
+   *
+   * @see SedReader::setFailFast(bool failFast)
+   */
+  bool isReadAborted();
+
+
   /**
    * Sets the XML namespace to which this element belongs to.
    * For example, all elements that belong to Sed Level 1 Version 1 Core
@@ -2582,6 +2783,15 @@ protected:
   //
   std::string mURI;
 
+  /* revision of this object, advanced by markDirty() */
+  unsigned int mRevision;
+
+  /* serialized form of this object as cached by SedOutputStream; only
+   * allocated for the top-level items it caches */
+  mutable SedWriteCache* mWriteCache;
+
+  friend class SedOutputStream;
+
   bool getHasBeenDeleted() const;
 
   /** @endcond */
@@ -2842,6 +3052,10 @@ LIBSEDML_EXTERN
 List_t*
 SedBase_getAllElements(SedBase_t* sb);
 
+LIBSEDML_EXTERN
+int
+SedBase_connectSubtree(SedBase_t* sb);
+
 LIBSEDML_EXTERN
 void
 SedBase_renameSIdRefs(SedBase_t* sb, const char* oldid, const char* newid);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedChange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -141,6 +142,8 @@ SedChange::isSetTarget() const
 int
 SedChange::setTarget(const std::string& target)
 {
+  markDirty();
+
   {
     mTarget = target;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -154,6 +157,8 @@ SedChange::setTarget(const std::string& target)
 int
 SedChange::unsetTarget()
 {
+  markDirty();
+
   mTarget.erase();
 
   if (mTarget.empty() == true)
@@ -226,8 +231,27 @@ SedChange::writeElements(XMLOutputStream& stream) const
 bool
 SedChange::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedChange::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedChange));
+  usage.addString(mTarget);
 }
 
 
@@ -542,6 +566,7 @@ SedListOfChanges::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedChange*>(item);
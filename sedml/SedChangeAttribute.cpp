@@ -36,6 +36,7 @@
 
 #include <sedml/SedChangeAttribute.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -141,6 +142,8 @@ SedChangeAttribute::isSetNewValue() const
 int
 SedChangeAttribute::setNewValue(const std::string& newValue)
 {
+  markDirty();
+
   {
     mNewValue = newValue;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -154,6 +157,8 @@ SedChangeAttribute::setNewValue(const std::string& newValue)
 int
 SedChangeAttribute::unsetNewValue()
 {
+  markDirty();
+
   mNewValue.erase();
 
   if (mNewValue.empty() == true)
@@ -240,8 +245,27 @@ SedChangeAttribute::writeElements(XMLOutputStream& stream) const
 bool
 SedChangeAttribute::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedChangeAttribute::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedChange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedChangeAttribute));
+  usage.addString(mNewValue);
 }
 
 
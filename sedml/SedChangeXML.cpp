@@ -36,6 +36,7 @@
 
 #include <sedml/SedChangeXML.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -141,6 +142,8 @@ SedChangeXML::isSetNewXML() const
 int
 SedChangeXML::setNewXML(XMLNode* newXML)
 {
+  markDirty();
+
   if (mNewXML == newXML)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -165,6 +168,8 @@ SedChangeXML::setNewXML(XMLNode* newXML)
 int
 SedChangeXML::unsetNewXML()
 {
+  markDirty();
+
   delete mNewXML;
   mNewXML = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -252,8 +257,27 @@ SedChangeXML::writeElements(XMLOutputStream& stream) const
 bool
 SedChangeXML::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedChangeXML::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedChange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedChangeXML));
+  usage.addXML(mNewXML);
 }
 
 
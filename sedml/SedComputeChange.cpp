@@ -36,6 +36,7 @@
 
 #include <sedml/SedComputeChange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -165,10 +166,13 @@ SedComputeChange::setMath(ASTNode* math)
 {
   if (mMath == math)
     {
+      // the math may have been modified in place
+      markDirty();
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else if (math == NULL)
     {
+      markDirty();
       delete mMath;
       mMath = NULL;
       return LIBSEDML_OPERATION_SUCCESS;
@@ -179,6 +183,7 @@ SedComputeChange::setMath(ASTNode* math)
     }
   else
     {
+      markDirty();
       delete mMath;
       mMath = (math != NULL) ?
               math->deepCopy() : NULL;
@@ -198,6 +203,8 @@ SedComputeChange::setMath(ASTNode* math)
 int
 SedComputeChange::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -568,8 +575,65 @@ SedComputeChange::writeElements(XMLOutputStream& stream) const
 bool
 SedComputeChange::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mVariables.accept(v);
+      mParameters.accept(v);
+    }
 
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedComputeChange::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedChange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedComputeChange));
+  usage.addMath(mMath);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedComputeChange::getNumChildObjects() const
+{
+  return SedChange::getNumChildObjects() + 2;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedComputeChange::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedChange::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedChange::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mVariables;
+    case 1:
+      return &mParameters;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -725,6 +789,9 @@ SedComputeChange_getMath(SedComputeChange_t * scc)
   if (scc == NULL)
     return NULL;
 
+  /* the caller may modify the math in place */
+  scc->markDirty();
+
   return (ASTNode_t*)scc->getMath();
 }
 
@@ -129,6 +129,10 @@ public:
    * Returns the "math" element of this SedComputeChange.
    *
    * @return the "math" element of this SedComputeChange.
+   *
+   * @note Modifying the returned math in place does not invalidate the
+   * subtree cache of a SedWriter; call markDirty() afterwards, or use
+   * setMath().
    */
   virtual const ASTNode* getMath() const;
 
@@ -523,6 +527,30 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Adds the memory held by this object to the given SedMemoryUsage.
+   */
+  virtual void addMemoryUsage(SedMemoryUsage& usage) const;
+
+
+  /**
+   * Returns the number of child Sed objects of this object.
+   */
+  virtual unsigned int getNumChildObjects() const;
+
+
+  /**
+   * Returns the nth child Sed object of this object, or @c NULL if @p n
+   * is out of range.
+   */
+  virtual const SedBase* getChildObject(unsigned int n) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -36,6 +36,7 @@
 
 #include <sedml/SedCurve.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -393,7 +394,12 @@ SedCurve::isSetLineStyle() const
 int
 SedCurve::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -403,6 +409,8 @@ SedCurve::setId(const std::string& id)
 int
 SedCurve::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -416,6 +424,8 @@ SedCurve::setName(const std::string& name)
 int
 SedCurve::setLogX(bool logX)
 {
+  markDirty();
+
   mLogX = logX;
   mIsSetLogX = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -428,6 +438,8 @@ SedCurve::setLogX(bool logX)
 int
 SedCurve::setLogY(bool logY)
 {
+  markDirty();
+
   mLogY = logY;
   mIsSetLogY = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -446,6 +458,7 @@ SedCurve::setXDataReference(const std::string& xDataReference)
     }
   else
     {
+      markDirty();
       mXDataReference = xDataReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -464,6 +477,7 @@ SedCurve::setYDataReference(const std::string& yDataReference)
     }
   else
     {
+      markDirty();
       mYDataReference = yDataReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -476,6 +490,8 @@ SedCurve::setYDataReference(const std::string& yDataReference)
 int
 SedCurve::setLineColor(const std::string& lineColor)
 {
+  markDirty();
+
   {
     mLineColor = lineColor;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -489,6 +505,8 @@ SedCurve::setLineColor(const std::string& lineColor)
 int
 SedCurve::setFillColor(const std::string& fillColor)
 {
+  markDirty();
+
   {
     mFillColor = fillColor;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -502,6 +520,8 @@ SedCurve::setFillColor(const std::string& fillColor)
 int
 SedCurve::setSymbol(const std::string& symbol)
 {
+  markDirty();
+
   {
     mSymbol = symbol;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -515,6 +535,8 @@ SedCurve::setSymbol(const std::string& symbol)
 int
 SedCurve::setLineThickness(double lineThickness)
 {
+  markDirty();
+
   mLineThickness = lineThickness;
   mIsSetLineThickness = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -527,6 +549,8 @@ SedCurve::setLineThickness(double lineThickness)
 int
 SedCurve::setLineStyle(const std::string& lineStyle)
 {
+  markDirty();
+
   {
     mLineStyle = lineStyle;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -540,6 +564,8 @@ SedCurve::setLineStyle(const std::string& lineStyle)
 int
 SedCurve::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -559,6 +585,8 @@ SedCurve::unsetId()
 int
 SedCurve::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -578,6 +606,8 @@ SedCurve::unsetName()
 int
 SedCurve::unsetLogX()
 {
+  markDirty();
+
   mLogX = false;
   mIsSetLogX = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -590,6 +620,8 @@ SedCurve::unsetLogX()
 int
 SedCurve::unsetLogY()
 {
+  markDirty();
+
   mLogY = false;
   mIsSetLogY = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -602,6 +634,8 @@ SedCurve::unsetLogY()
 int
 SedCurve::unsetXDataReference()
 {
+  markDirty();
+
   mXDataReference.erase();
 
   if (mXDataReference.empty() == true)
@@ -621,6 +655,8 @@ SedCurve::unsetXDataReference()
 int
 SedCurve::unsetYDataReference()
 {
+  markDirty();
+
   mYDataReference.erase();
 
   if (mYDataReference.empty() == true)
@@ -640,6 +676,8 @@ SedCurve::unsetYDataReference()
 int
 SedCurve::unsetLineColor()
 {
+  markDirty();
+
   mLineColor.erase();
 
   if (mLineColor.empty() == true)
@@ -659,6 +697,8 @@ SedCurve::unsetLineColor()
 int
 SedCurve::unsetFillColor()
 {
+  markDirty();
+
   mFillColor.erase();
 
   if (mFillColor.empty() == true)
@@ -678,6 +718,8 @@ SedCurve::unsetFillColor()
 int
 SedCurve::unsetSymbol()
 {
+  markDirty();
+
   mSymbol.erase();
 
   if (mSymbol.empty() == true)
@@ -697,6 +739,8 @@ SedCurve::unsetSymbol()
 int
 SedCurve::unsetLineThickness()
 {
+  markDirty();
+
   mLineThickness = numeric_limits<double>::quiet_NaN();
   mIsSetLineThickness = false;
 
@@ -717,6 +761,8 @@ SedCurve::unsetLineThickness()
 int
 SedCurve::unsetLineStyle()
 {
+  markDirty();
+
   mLineStyle.erase();
 
   if (mLineStyle.empty() == true)
@@ -798,8 +844,34 @@ SedCurve::writeElements(XMLOutputStream& stream) const
 bool
 SedCurve::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
 
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedCurve::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedCurve));
+  usage.addString(mId);
+  usage.addString(mName);
+  usage.addString(mXDataReference);
+  usage.addString(mYDataReference);
+  usage.addString(mLineColor);
+  usage.addString(mFillColor);
+  usage.addString(mSymbol);
+  usage.addString(mLineStyle);
 }
 
 
@@ -1214,6 +1286,7 @@ SedListOfCurves::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedCurve*>(item);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedDataDescription.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 #include <numl/DimensionDescription.h>
@@ -244,7 +245,12 @@ SedDataDescription::isSetDimensionDescription() const
 int
 SedDataDescription::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -254,6 +260,8 @@ SedDataDescription::setId(const std::string& id)
 int
 SedDataDescription::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -267,6 +275,8 @@ SedDataDescription::setName(const std::string& name)
 int
 SedDataDescription::setSource(const std::string& source)
 {
+  markDirty();
+
   {
     mSource = source;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -280,6 +290,8 @@ SedDataDescription::setSource(const std::string& source)
 int
 SedDataDescription::setDimensionDescription(DimensionDescription* dimensionDescription)
 {
+  markDirty();
+
   if (mDimensionDescription == dimensionDescription)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -304,6 +316,8 @@ SedDataDescription::setDimensionDescription(DimensionDescription* dimensionDescr
 int
 SedDataDescription::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -323,6 +337,8 @@ SedDataDescription::unsetId()
 int
 SedDataDescription::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -342,6 +358,8 @@ SedDataDescription::unsetName()
 int
 SedDataDescription::unsetSource()
 {
+  markDirty();
+
   mSource.erase();
 
   if (mSource.empty() == true)
@@ -361,6 +379,8 @@ SedDataDescription::unsetSource()
 int
 SedDataDescription::unsetDimensionDescription()
 {
+  markDirty();
+
   delete mDimensionDescription;
   mDimensionDescription = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -605,8 +625,64 @@ SedDataDescription::writeElements(XMLOutputStream& stream) const
 bool
 SedDataDescription::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mDataSources.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedDataDescription::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedDataDescription));
+  usage.addString(mId);
+  usage.addString(mName);
+  usage.addString(mSource);
+}
+
 
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedDataDescription::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + 1;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedDataDescription::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mDataSources;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -923,6 +999,7 @@ SedListOfDataDescriptions::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedDataDescription*>(item);
@@ -541,6 +541,30 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Adds the memory held by this object to the given SedMemoryUsage.
+   */
+  virtual void addMemoryUsage(SedMemoryUsage& usage) const;
+
+
+  /**
+   * Returns the number of child Sed objects of this object.
+   */
+  virtual unsigned int getNumChildObjects() const;
+
+
+  /**
+   * Returns the nth child Sed object of this object, or @c NULL if @p n
+   * is out of range.
+   */
+  virtual const SedBase* getChildObject(unsigned int n) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
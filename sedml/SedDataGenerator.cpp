@@ -36,6 +36,7 @@
 
 #include <sedml/SedDataGenerator.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -211,7 +212,12 @@ SedDataGenerator::isSetMath() const
 int
 SedDataGenerator::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -221,6 +227,8 @@ SedDataGenerator::setId(const std::string& id)
 int
 SedDataGenerator::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -236,10 +244,13 @@ SedDataGenerator::setMath(ASTNode* math)
 {
   if (mMath == math)
     {
+      // the math may have been modified in place
+      markDirty();
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else if (math == NULL)
     {
+      markDirty();
       delete mMath;
       mMath = NULL;
       return LIBSEDML_OPERATION_SUCCESS;
@@ -250,6 +261,7 @@ SedDataGenerator::setMath(ASTNode* math)
     }
   else
     {
+      markDirty();
       delete mMath;
       mMath = (math != NULL) ?
               math->deepCopy() : NULL;
@@ -269,6 +281,8 @@ SedDataGenerator::setMath(ASTNode* math)
 int
 SedDataGenerator::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -288,6 +302,8 @@ SedDataGenerator::unsetId()
 int
 SedDataGenerator::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -307,6 +323,8 @@ SedDataGenerator::unsetName()
 int
 SedDataGenerator::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -680,8 +698,67 @@ SedDataGenerator::writeElements(XMLOutputStream& stream) const
 bool
 SedDataGenerator::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mVariables.accept(v);
+      mParameters.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedDataGenerator::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedDataGenerator));
+  usage.addString(mId);
+  usage.addString(mName);
+  usage.addMath(mMath);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedDataGenerator::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + 2;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedDataGenerator::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
 
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mVariables;
+    case 1:
+      return &mParameters;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -979,6 +1056,7 @@ SedListOfDataGenerators::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedDataGenerator*>(item);
@@ -1148,6 +1226,9 @@ SedDataGenerator_getMath(SedDataGenerator_t * sdg)
   if (sdg == NULL)
     return NULL;
 
+  /* the caller may modify the math in place */
+  sdg->markDirty();
+
   return (ASTNode_t*)sdg->getMath();
 }
 
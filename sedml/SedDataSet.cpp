@@ -36,6 +36,7 @@
 
 #include <sedml/SedDataSet.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -213,7 +214,12 @@ SedDataSet::isSetDataReference() const
 int
 SedDataSet::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -223,6 +229,8 @@ SedDataSet::setId(const std::string& id)
 int
 SedDataSet::setLabel(const std::string& label)
 {
+  markDirty();
+
   {
     mLabel = label;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -236,6 +244,8 @@ SedDataSet::setLabel(const std::string& label)
 int
 SedDataSet::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -255,6 +265,7 @@ SedDataSet::setDataReference(const std::string& dataReference)
     }
   else
     {
+      markDirty();
       mDataReference = dataReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -267,6 +278,8 @@ SedDataSet::setDataReference(const std::string& dataReference)
 int
 SedDataSet::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -286,6 +299,8 @@ SedDataSet::unsetId()
 int
 SedDataSet::unsetLabel()
 {
+  markDirty();
+
   mLabel.erase();
 
   if (mLabel.empty() == true)
@@ -305,6 +320,8 @@ SedDataSet::unsetLabel()
 int
 SedDataSet::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -324,6 +341,8 @@ SedDataSet::unsetName()
 int
 SedDataSet::unsetDataReference()
 {
+  markDirty();
+
   mDataReference.erase();
 
   if (mDataReference.empty() == true)
@@ -402,8 +421,30 @@ SedDataSet::writeElements(XMLOutputStream& stream) const
 bool
 SedDataSet::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
 
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedDataSet::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedDataSet));
+  usage.addString(mId);
+  usage.addString(mLabel);
+  usage.addString(mName);
+  usage.addString(mDataReference);
 }
 
 
@@ -711,6 +752,7 @@ SedListOfDataSets::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedDataSet*>(item);
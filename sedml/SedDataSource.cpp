@@ -36,6 +36,7 @@
 
 #include <sedml/SedDataSource.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -205,7 +206,12 @@ SedDataSource::isSetIndexSet() const
 int
 SedDataSource::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -215,6 +221,8 @@ SedDataSource::setId(const std::string& id)
 int
 SedDataSource::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -228,6 +236,8 @@ SedDataSource::setName(const std::string& name)
 int
 SedDataSource::setIndexSet(const std::string& indexSet)
 {
+  markDirty();
+
   {
     mIndexSet = indexSet;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -241,6 +251,8 @@ SedDataSource::setIndexSet(const std::string& indexSet)
 int
 SedDataSource::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -260,6 +272,8 @@ SedDataSource::unsetId()
 int
 SedDataSource::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -279,6 +293,8 @@ SedDataSource::unsetName()
 int
 SedDataSource::unsetIndexSet()
 {
+  markDirty();
+
   mIndexSet.erase();
 
   if (mIndexSet.empty() == true)
@@ -522,8 +538,64 @@ SedDataSource::writeElements(XMLOutputStream& stream) const
 bool
 SedDataSource::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mSlices.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedDataSource::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedDataSource));
+  usage.addString(mId);
+  usage.addString(mName);
+  usage.addString(mIndexSet);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedDataSource::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + 1;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedDataSource::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
 
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mSlices;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -809,6 +881,7 @@ SedListOfDataSources::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedDataSource*>(item);
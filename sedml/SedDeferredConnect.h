@@ -0,0 +1,131 @@
+/**
+ * @file    SedDeferredConnect.h
+ * @brief   Defers linking objects to their document while building
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedDeferredConnect
+ * @ingroup Core
+ * @brief Defers linking objects to their document while building.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * Adding an object to a parent (with the <code>create</code>,
+ * <code>add</code> and <code>appendAndOwn</code> methods) sets its parent,
+ * and sets the document of the object and of every object nested in it.
+ * A document built from the bottom up, by adding variables to data
+ * generators and data generators to the document for instance, therefore
+ * walks the same objects again at every level.
+ *
+ * While a SedDeferredConnect exists, adding an object to a parent on the
+ * same thread only sets its parent.  SedBase::connectSubtree() then sets
+ * the document of all the objects of a subtree in a single pass; it is
+ * called on the root given to the SedDeferredConnect when it is destroyed:
+ * @code{.cpp}
+ * SedDocument* doc = new SedDocument();
+ * {
+ *   SedDeferredConnect deferred(doc);
+ *   // ... build the document ...
+ * }   // every object of doc now knows its document
+ * @endcode
+ *
+ * Until then, SedBase::getSedDocument() returns @c NULL for the objects
+ * added; in particular their errors are not logged to the document.
+ * SedDeferredConnect objects may be nested: adding objects is deferred
+ * until the outermost one is destroyed, and each one connects its own root.
+ */
+
+#ifndef SedDeferredConnect_h
+#define SedDeferredConnect_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+
+
+class LIBSEDML_EXTERN SedDeferredConnect
+{
+public:
+
+  /**
+   * Starts deferring the linking of objects to their document on the
+   * calling thread.
+   *
+   * @param root the object whose subtree is connected when this
+   * SedDeferredConnect is destroyed, usually the document being built;
+   * may be @c NULL.
+   */
+  explicit SedDeferredConnect(SedBase* root = NULL);
+
+
+  /**
+   * Stops deferring, unless another SedDeferredConnect exists on the
+   * calling thread, and connects the subtree of the root given to the
+   * constructor (see SedBase::connectSubtree()).
+   */
+  ~SedDeferredConnect();
+
+
+  /**
+   * @return @c true if linking objects to their document is deferred on
+   * the calling thread.
+   */
+  static bool isActive();
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  SedDeferredConnect(const SedDeferredConnect&);
+  SedDeferredConnect& operator=(const SedDeferredConnect&);
+
+  SedBase* mRoot;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedDeferredConnect_h */
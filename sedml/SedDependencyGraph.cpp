@@ -0,0 +1,636 @@
+/**
+ * @file    SedDependencyGraph.cpp
+ * @brief   Implementation of SedDependencyGraph
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedFunctionalRange.h>
+#include <sedml/SedPlot2D.h>
+#include <sedml/SedPlot3D.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedReport.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <new>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/*
+ * Creates a new, empty, SedDependencyGraph.
+ */
+SedDependencyGraph::SedDependencyGraph()
+  : mDependencyStart(1, 0)
+  , mDependentStart(1, 0)
+{
+}
+
+
+/*
+ * Builds the graph of the given document.
+ */
+int
+SedDependencyGraph::build(const SedDocument& doc)
+{
+  mNodes.clear();
+  mIndex.clear();
+  mEdges.clear();
+  mUnresolved.clear();
+
+  // the nodes, in the order of the document, so that the links can be
+  // made in a single pass
+  for (unsigned int n = 0; n < doc.getNumModels(); ++n)
+    {
+      addNode(doc.getModel(n));
+    }
+
+  for (unsigned int n = 0; n < doc.getNumSimulations(); ++n)
+    {
+      addNode(doc.getSimulation(n));
+    }
+
+  for (unsigned int n = 0; n < doc.getNumTasks(); ++n)
+    {
+      addNode(doc.getTask(n));
+    }
+
+  for (unsigned int n = 0; n < doc.getNumDataGenerators(); ++n)
+    {
+      const SedDataGenerator* generator = doc.getDataGenerator(n);
+
+      for (unsigned int v = 0; v < generator->getNumVariables(); ++v)
+        {
+          addNode(generator->getVariable(v));
+        }
+
+      addNode(generator);
+    }
+
+  for (unsigned int n = 0; n < doc.getNumOutputs(); ++n)
+    {
+      addNode(doc.getOutput(n));
+    }
+
+  // models: the model they are derived from, and the models their
+  // computed changes read
+  for (unsigned int n = 0; n < doc.getNumModels(); ++n)
+    {
+      const SedModel* model = doc.getModel(n);
+      unsigned int node = mIndex[model];
+      const std::string& source = model->getSource();
+      const SedModel* parent =
+        doc.getModel(source.compare(0, 1, "#") == 0 ? source.substr(1) : source);
+
+      // a source naming no model is a file or a URN
+      if (parent != NULL)
+        link(parent, node, "model", source);
+
+      for (unsigned int c = 0; c < model->getNumChanges(); ++c)
+        {
+          const SedChange* change = model->getChange(c);
+
+          if (change->getTypeCode() != SEDML_CHANGE_COMPUTECHANGE) continue;
+
+          const SedComputeChange* compute =
+            static_cast<const SedComputeChange*>(change);
+
+          for (unsigned int v = 0; v < compute->getNumVariables(); ++v)
+            {
+              const std::string& id = compute->getVariable(v)->getModelReference();
+
+              if (id != model->getId())
+                linkModel(doc, id, node);
+            }
+        }
+    }
+
+  // tasks: their model and simulation; repeated tasks: their subtasks, and
+  // the models their changes and functional ranges read
+  for (unsigned int n = 0; n < doc.getNumTasks(); ++n)
+    {
+      const SedTask* task = doc.getTask(n);
+      unsigned int node = mIndex[task];
+
+      linkModel(doc, task->getModelReference(), node);
+
+      if (!task->getSimulationReference().empty())
+        link(doc.getSimulation(task->getSimulationReference()), node,
+             "simulation", task->getSimulationReference());
+
+      if (task->getTypeCode() != SEDML_TASK_REPEATEDTASK) continue;
+
+      const SedRepeatedTask* repeated =
+        static_cast<const SedRepeatedTask*>(task);
+
+      for (unsigned int s = 0; s < repeated->getNumSubTasks(); ++s)
+        {
+          const std::string& id = repeated->getSubTask(s)->getTask();
+          link(doc.getTask(id), node, "task", id);
+        }
+
+      for (unsigned int c = 0; c < repeated->getNumTaskChanges(); ++c)
+        {
+          const SedSetValue* change = repeated->getTaskChange(c);
+          linkModel(doc, change->getModelReference(), node);
+
+          for (unsigned int v = 0; v < change->getNumVariables(); ++v)
+            {
+              linkModel(doc, change->getVariable(v)->getModelReference(), node);
+            }
+        }
+
+      for (unsigned int r = 0; r < repeated->getNumRanges(); ++r)
+        {
+          const SedRange* range = repeated->getRange(r);
+
+          if (range->getTypeCode() != SEDML_RANGE_FUNCTIONALRANGE) continue;
+
+          const SedFunctionalRange* functional =
+            static_cast<const SedFunctionalRange*>(range);
+
+          for (unsigned int v = 0; v < functional->getNumVariables(); ++v)
+            {
+              linkModel(doc, functional->getVariable(v)->getModelReference(),
+                        node);
+            }
+        }
+    }
+
+  // data generators: their variables, which read tasks or models
+  for (unsigned int n = 0; n < doc.getNumDataGenerators(); ++n)
+    {
+      const SedDataGenerator* generator = doc.getDataGenerator(n);
+      unsigned int node = mIndex[generator];
+
+      for (unsigned int v = 0; v < generator->getNumVariables(); ++v)
+        {
+          const SedVariable* variable = generator->getVariable(v);
+          unsigned int variableNode = mIndex[variable];
+          const std::string& id = variable->getTaskReference();
+
+          if (!id.empty())
+            link(doc.getTask(id), variableNode, "task", id);
+
+          linkModel(doc, variable->getModelReference(), variableNode);
+          mEdges.push_back(Edge(variableNode, node));
+        }
+    }
+
+  // outputs: the data generators they show
+  for (unsigned int n = 0; n < doc.getNumOutputs(); ++n)
+    {
+      const SedOutput* output = doc.getOutput(n);
+      unsigned int node = mIndex[output];
+
+      switch (output->getTypeCode())
+        {
+        case SEDML_OUTPUT_PLOT2D:
+          {
+            const SedPlot2D* plot = static_cast<const SedPlot2D*>(output);
+
+            for (unsigned int c = 0; c < plot->getNumCurves(); ++c)
+              {
+                const SedCurve* curve = plot->getCurve(c);
+                linkDataGenerator(doc, curve->getXDataReference(), node);
+                linkDataGenerator(doc, curve->getYDataReference(), node);
+              }
+          }
+          break;
+
+        case SEDML_OUTPUT_PLOT3D:
+          {
+            const SedPlot3D* plot = static_cast<const SedPlot3D*>(output);
+
+            for (unsigned int s = 0; s < plot->getNumSurfaces(); ++s)
+              {
+                const SedSurface* surface = plot->getSurface(s);
+                linkDataGenerator(doc, surface->getXDataReference(), node);
+                linkDataGenerator(doc, surface->getYDataReference(), node);
+                linkDataGenerator(doc, surface->getZDataReference(), node);
+              }
+          }
+          break;
+
+        case SEDML_OUTPUT_REPORT:
+          {
+            const SedReport* report = static_cast<const SedReport*>(output);
+
+            for (unsigned int d = 0; d < report->getNumDataSets(); ++d)
+              {
+                linkDataGenerator(doc, report->getDataSet(d)->getDataReference(),
+                                  node);
+              }
+          }
+          break;
+
+        default:
+          break;
+        }
+    }
+
+  // both directions, in compressed rows: the dependencies of each node,
+  // and the nodes depending on each node
+  std::sort(mEdges.begin(), mEdges.end());
+  mEdges.erase(std::unique(mEdges.begin(), mEdges.end()), mEdges.end());
+
+  unsigned int numNodes = (unsigned int)mNodes.size();
+  mDependencyStart.assign(numNodes + 1, 0);
+  mDependentStart.assign(numNodes + 1, 0);
+  mDependencies.resize(mEdges.size());
+  mDependents.resize(mEdges.size());
+
+  for (size_t e = 0; e < mEdges.size(); ++e)
+    {
+      ++mDependentStart[mEdges[e].first + 1];
+      ++mDependencyStart[mEdges[e].second + 1];
+    }
+
+  for (unsigned int n = 0; n < numNodes; ++n)
+    {
+      mDependentStart[n + 1] += mDependentStart[n];
+      mDependencyStart[n + 1] += mDependencyStart[n];
+    }
+
+  std::vector<unsigned int> dependencyEnd(mDependencyStart.begin(),
+                                          mDependencyStart.end() - 1);
+
+  for (size_t e = 0; e < mEdges.size(); ++e)
+    {
+      // sorted by dependency, the edges list the dependents node by node
+      mDependents[e] = mEdges[e].second;
+      mDependencies[dependencyEnd[mEdges[e].second]++] = mEdges[e].first;
+    }
+
+  mEdges.clear();
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds a node for the given element.
+ */
+unsigned int
+SedDependencyGraph::addNode(const SedBase* element)
+{
+  unsigned int node = (unsigned int)mNodes.size();
+  mNodes.push_back(element);
+  mIndex[element] = node;
+  return node;
+}
+
+
+/*
+ * Makes the given node need the given element, or records a reference to
+ * an element that does not exist.
+ */
+void
+SedDependencyGraph::link(const SedBase* dependency, unsigned int node,
+                         const std::string& kind, const std::string& id)
+{
+  std::map<const SedBase*, unsigned int>::const_iterator it =
+    mIndex.find(dependency);
+
+  if (it != mIndex.end())
+    {
+      mEdges.push_back(Edge(it->second, node));
+      return;
+    }
+
+  const SedBase* element = mNodes[node];
+  mUnresolved.push_back(element->getElementName() + " '" + element->getId()
+                        + "' references unknown " + kind + " '" + id + "'");
+}
+
+
+/*
+ * Makes the given node need the model with the given id, if any.
+ */
+void
+SedDependencyGraph::linkModel(const SedDocument& doc, const std::string& id,
+                              unsigned int node)
+{
+  if (!id.empty())
+    link(doc.getModel(id), node, "model", id);
+}
+
+
+/*
+ * Makes the given node need the data generator with the given id, if any.
+ */
+void
+SedDependencyGraph::linkDataGenerator(const SedDocument& doc,
+                                      const std::string& id,
+                                      unsigned int node)
+{
+  if (!id.empty())
+    link(doc.getDataGenerator(id), node, "data generator", id);
+}
+
+
+/*
+ * Lists the nodes the given ones need, depth first, each after the nodes
+ * it needs.
+ */
+int
+SedDependencyGraph::visit(const std::vector<unsigned int>& targets,
+                          std::vector<const SedBase*>& order) const
+{
+  enum { UNVISITED, VISITING, VISITED };
+
+  std::vector<unsigned char> state(mNodes.size(), UNVISITED);
+  std::vector<std::pair<unsigned int, unsigned int> > stack;
+
+  order.clear();
+
+  for (size_t t = 0; t < targets.size(); ++t)
+    {
+      if (state[targets[t]] != UNVISITED) continue;
+
+      state[targets[t]] = VISITING;
+      stack.push_back(std::make_pair(targets[t],
+                                     mDependencyStart[targets[t]]));
+
+      while (!stack.empty())
+        {
+          unsigned int node = stack.back().first;
+          unsigned int next = stack.back().second;
+
+          if (next == mDependencyStart[node + 1])
+            {
+              state[node] = VISITED;
+              order.push_back(mNodes[node]);
+              stack.pop_back();
+              continue;
+            }
+
+          ++stack.back().second;
+
+          unsigned int dependency = mDependencies[next];
+
+          if (state[dependency] == VISITING)
+            {
+              order.clear();
+              return LIBSEDML_OPERATION_FAILED;
+            }
+
+          if (state[dependency] == UNVISITED)
+            {
+              state[dependency] = VISITING;
+              stack.push_back(std::make_pair(dependency,
+                                             mDependencyStart[dependency]));
+            }
+        }
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * @return the number of nodes of this graph.
+ */
+unsigned int
+SedDependencyGraph::getNumNodes() const
+{
+  return (unsigned int)mNodes.size();
+}
+
+
+/*
+ * @return the nth node of this graph.
+ */
+const SedBase*
+SedDependencyGraph::getNode(unsigned int n) const
+{
+  return (n < mNodes.size()) ? mNodes[n] : NULL;
+}
+
+
+/*
+ * @return the index of the node of the given element.
+ */
+int
+SedDependencyGraph::getIndex(const SedBase* element) const
+{
+  std::map<const SedBase*, unsigned int>::const_iterator it =
+    mIndex.find(element);
+
+  return (it != mIndex.end()) ? (int)it->second : -1;
+}
+
+
+/*
+ * @return the number of nodes the nth node needs.
+ */
+unsigned int
+SedDependencyGraph::getNumDependencies(unsigned int n) const
+{
+  if (n >= mNodes.size()) return 0;
+
+  return mDependencyStart[n + 1] - mDependencyStart[n];
+}
+
+
+/*
+ * @return the index of the ith node the nth node needs.
+ */
+unsigned int
+SedDependencyGraph::getDependency(unsigned int n, unsigned int i) const
+{
+  return mDependencies[mDependencyStart[n] + i];
+}
+
+
+/*
+ * @return the number of nodes that need the nth node.
+ */
+unsigned int
+SedDependencyGraph::getNumDependents(unsigned int n) const
+{
+  if (n >= mNodes.size()) return 0;
+
+  return mDependentStart[n + 1] - mDependentStart[n];
+}
+
+
+/*
+ * @return the index of the ith node that needs the nth node.
+ */
+unsigned int
+SedDependencyGraph::getDependent(unsigned int n, unsigned int i) const
+{
+  return mDependents[mDependentStart[n] + i];
+}
+
+
+/*
+ * @return the number of references to elements that do not exist.
+ */
+unsigned int
+SedDependencyGraph::getNumUnresolved() const
+{
+  return (unsigned int)mUnresolved.size();
+}
+
+
+/*
+ * @return a description of the nth reference to an element that does not
+ * exist.
+ */
+const std::string&
+SedDependencyGraph::getUnresolved(unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mUnresolved.size()) ? mUnresolved[n] : empty;
+}
+
+
+/*
+ * Lists the elements the given targets need.
+ */
+int
+SedDependencyGraph::schedule(const std::vector<const SedBase*>& targets,
+                             std::vector<const SedBase*>& order) const
+{
+  std::vector<unsigned int> nodes;
+
+  for (size_t t = 0; t < targets.size(); ++t)
+    {
+      int node = getIndex(targets[t]);
+
+      if (node < 0) return LIBSEDML_INVALID_OBJECT;
+
+      nodes.push_back((unsigned int)node);
+    }
+
+  return visit(nodes, order);
+}
+
+
+/*
+ * Lists all the nodes of this graph.
+ */
+int
+SedDependencyGraph::schedule(std::vector<const SedBase*>& order) const
+{
+  std::vector<unsigned int> nodes(mNodes.size());
+
+  for (unsigned int n = 0; n < nodes.size(); ++n)
+    {
+      nodes[n] = n;
+    }
+
+  return visit(nodes, order);
+}
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedDependencyGraph_t *
+SedDependencyGraph_create(void)
+{
+  return new(std::nothrow) SedDependencyGraph();
+}
+
+
+LIBSEDML_EXTERN
+void
+SedDependencyGraph_free(SedDependencyGraph_t *graph)
+{
+  delete graph;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedDependencyGraph_build(SedDependencyGraph_t *graph, const SedDocument_t *doc)
+{
+  if (graph == NULL || doc == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return graph->build(*doc);
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedDependencyGraph_getNumNodes(const SedDependencyGraph_t *graph)
+{
+  return (graph != NULL) ? graph->getNumNodes() : 0;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedDependencyGraph_schedule(const SedDependencyGraph_t *graph,
+                            const SedBase_t * const *targets,
+                            unsigned int numTargets,
+                            const SedBase_t **order,
+                            unsigned int *numScheduled)
+{
+  if (graph == NULL || order == NULL || numScheduled == NULL
+      || (targets == NULL && numTargets > 0))
+    return LIBSEDML_INVALID_OBJECT;
+
+  std::vector<const SedBase*> elements(targets, targets + numTargets);
+  std::vector<const SedBase*> scheduled;
+  int result = graph->schedule(elements, scheduled);
+
+  std::copy(scheduled.begin(), scheduled.end(), order);
+  *numScheduled = (unsigned int)scheduled.size();
+
+  return result;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
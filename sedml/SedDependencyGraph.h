@@ -0,0 +1,302 @@
+/**
+ * @file    SedDependencyGraph.h
+ * @brief   Definition of SedDependencyGraph
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedDependencyGraph
+ * @ingroup Core
+ * @brief The dependencies between the elements of a document.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedDependencyGraph links the elements of a SedDocument to the elements
+ * they need: a model needs the model it is derived from (its @c source)
+ * and the models its computed changes read; a task needs its model and
+ * simulation; a repeated task needs its subtasks and the models its
+ * changes and ranges read; a variable of a data generator needs its task
+ * or model; a data generator needs its variables; and an output needs the
+ * data generators of its curves, surfaces or data sets.
+ *
+ * schedule() then lists, dependencies first, only the elements a set of
+ * targets needs.  To draw a single plot of a document with hundreds of
+ * outputs, for instance, a simulation tool runs the tasks of the schedule
+ * of that plot only:
+ * @code{.cpp}
+ * SedDependencyGraph graph;
+ * graph.build(doc);
+ * std::vector<const SedBase*> targets(1, doc.getOutput("plot1"));
+ * std::vector<const SedBase*> order;
+ * if (graph.schedule(targets, order) == LIBSEDML_OPERATION_SUCCESS)
+ *   {
+ *     for (size_t n = 0; n < order.size(); ++n)
+ *       // ... run order[n] if it is a task, compute it if it is a data
+ *       //     generator, ...
+ *   }
+ * @endcode
+ *
+ * The nodes of the graph are the models, simulations, tasks, data
+ * generators, variables of data generators and outputs of the document,
+ * in the order of the document.  References to elements that do not exist
+ * are not links; they are listed by getUnresolved().  The document must
+ * outlive the graph, which must be built again after the document is
+ * modified.
+ */
+
+#ifndef SedDependencyGraph_h
+#define SedDependencyGraph_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedDependencyGraph
+{
+public:
+
+  /**
+   * Creates a new, empty, SedDependencyGraph.
+   */
+  SedDependencyGraph();
+
+
+  /**
+   * Builds the graph of the given document, replacing the current one.
+   *
+   * @param doc the document.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int build(const SedDocument& doc);
+
+
+  /**
+   * @return the number of nodes of this graph.
+   */
+  unsigned int getNumNodes() const;
+
+
+  /**
+   * @return the nth node of this graph, or @c NULL.
+   */
+  const SedBase* getNode(unsigned int n) const;
+
+
+  /**
+   * @return the index of the node of the given element, or @c -1 if it is
+   * not a node of this graph.
+   */
+  int getIndex(const SedBase* element) const;
+
+
+  /**
+   * @return the number of nodes the nth node needs.
+   */
+  unsigned int getNumDependencies(unsigned int n) const;
+
+
+  /**
+   * @return the index of the ith node the nth node needs.
+   */
+  unsigned int getDependency(unsigned int n, unsigned int i) const;
+
+
+  /**
+   * @return the number of nodes that need the nth node.
+   */
+  unsigned int getNumDependents(unsigned int n) const;
+
+
+  /**
+   * @return the index of the ith node that needs the nth node.
+   */
+  unsigned int getDependent(unsigned int n, unsigned int i) const;
+
+
+  /**
+   * @return the number of references to elements that do not exist.
+   */
+  unsigned int getNumUnresolved() const;
+
+
+  /**
+   * @return a description of the nth reference to an element that does not
+   * exist, or an empty string.
+   */
+  const std::string& getUnresolved(unsigned int n) const;
+
+
+  /**
+   * Lists the elements the given targets need, the targets included, so
+   * that each element comes after the elements it needs.
+   *
+   * @param targets the elements to compute, nodes of this graph.
+   * @param order the vector receiving the elements, in order.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a target is not a node of this graph.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the targets need elements that need each other in a cycle.
+   */
+  int schedule(const std::vector<const SedBase*>& targets,
+               std::vector<const SedBase*>& order) const;
+
+
+  /**
+   * Lists all the nodes of this graph, each after the nodes it needs.
+   *
+   * @param order the vector receiving the elements, in order.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if elements need each other in a cycle.
+   */
+  int schedule(std::vector<const SedBase*>& order) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  typedef std::pair<unsigned int, unsigned int> Edge;
+
+  unsigned int addNode(const SedBase* element);
+
+  void link(const SedBase* dependency, unsigned int node,
+            const std::string& kind, const std::string& id);
+
+  void linkModel(const SedDocument& doc, const std::string& id,
+                 unsigned int node);
+
+  void linkDataGenerator(const SedDocument& doc, const std::string& id,
+                         unsigned int node);
+
+  int visit(const std::vector<unsigned int>& targets,
+            std::vector<const SedBase*>& order) const;
+
+  std::vector<const SedBase*>             mNodes;
+  std::map<const SedBase*, unsigned int>  mIndex;
+  std::vector<Edge>                       mEdges;
+  std::vector<unsigned int>               mDependencyStart;
+  std::vector<unsigned int>               mDependencies;
+  std::vector<unsigned int>               mDependentStart;
+  std::vector<unsigned int>               mDependents;
+  std::vector<std::string>                mUnresolved;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new, empty, SedDependencyGraph.
+ */
+LIBSEDML_EXTERN
+SedDependencyGraph_t *
+SedDependencyGraph_create(void);
+
+/**
+ * Frees the given SedDependencyGraph.
+ */
+LIBSEDML_EXTERN
+void
+SedDependencyGraph_free(SedDependencyGraph_t *graph);
+
+/**
+ * Builds the graph of the given document into the given
+ * SedDependencyGraph.
+ */
+LIBSEDML_EXTERN
+int
+SedDependencyGraph_build(SedDependencyGraph_t *graph, const SedDocument_t *doc);
+
+/**
+ * Returns the number of nodes of the given SedDependencyGraph.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDependencyGraph_getNumNodes(const SedDependencyGraph_t *graph);
+
+/**
+ * Lists, in @p order, the elements the given targets need, each after the
+ * elements it needs; @p order must have room for getNumNodes() elements.
+ * The number of elements listed is stored in @p numScheduled.
+ */
+LIBSEDML_EXTERN
+int
+SedDependencyGraph_schedule(const SedDependencyGraph_t *graph,
+                            const SedBase_t * const *targets,
+                            unsigned int numTargets,
+                            const SedBase_t **order,
+                            unsigned int *numScheduled);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedDependencyGraph_h */
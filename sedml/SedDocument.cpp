@@ -34,8 +34,11 @@
  */
 
 
+#include <sstream>
+
 #include <sedml/SedDocument.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -60,7 +63,14 @@ SedDocument::SedDocument(unsigned int level, unsigned int version)
   , mTasks(level, version)
   , mDataGenerators(level, version)
   , mOutputs(level, version)
-
+  , mWriteCacheEpoch(0)
+  , mWriteCacheContext("")
+  , mTrustedRead(false)
+  , mFailFastRead(false)
+  , mReadCache(NULL)
+  , mReadStatistics(NULL)
+  , mFrozen(false)
+  , mSnapshotVersion(0)
 {
   mLevel = level;
   mIsSetLevel = true;
@@ -92,7 +102,14 @@ SedDocument::SedDocument(SedNamespaces* sedns)
   , mTasks(sedns)
   , mDataGenerators(sedns)
   , mOutputs(sedns)
-
+  , mWriteCacheEpoch(0)
+  , mWriteCacheContext("")
+  , mTrustedRead(false)
+  , mFailFastRead(false)
+  , mReadCache(NULL)
+  , mReadStatistics(NULL)
+  , mFrozen(false)
+  , mSnapshotVersion(0)
 {
   mLevel = sedns->getLevel();
   mIsSetLevel = true;
@@ -114,6 +131,14 @@ SedDocument::SedDocument(SedNamespaces* sedns)
  */
 SedDocument::SedDocument(const SedDocument& orig)
   : SedBase(orig)
+  , mWriteCacheEpoch(0)
+  , mWriteCacheContext("")
+  , mTrustedRead(false)
+  , mFailFastRead(false)
+  , mReadCache(NULL)
+  , mReadStatistics(NULL)
+  , mFrozen(false)
+  , mSnapshotVersion(orig.mSnapshotVersion)
 {
   setSedDocument(this);
 
@@ -155,6 +180,7 @@ SedDocument::operator=(const SedDocument& rhs)
       mTasks  = rhs.mTasks;
       mDataGenerators  = rhs.mDataGenerators;
       mOutputs  = rhs.mOutputs;
+      mSnapshotVersion  = rhs.mSnapshotVersion;
 
       // connect to child objects
       connectToChild();
@@ -228,6 +254,8 @@ SedDocument::isSetVersion() const
 int
 SedDocument::setLevel(int level)
 {
+  markDirty();
+
   mLevel = level;
   mIsSetLevel = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -240,6 +268,8 @@ SedDocument::setLevel(int level)
 int
 SedDocument::setVersion(int version)
 {
+  markDirty();
+
   mVersion = version;
   mIsSetVersion = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -252,6 +282,8 @@ SedDocument::setVersion(int version)
 int
 SedDocument::unsetLevel()
 {
+  markDirty();
+
   mLevel = SEDML_INT_MAX;
   mIsSetLevel = false;
 
@@ -272,6 +304,8 @@ SedDocument::unsetLevel()
 int
 SedDocument::unsetVersion()
 {
+  markDirty();
+
   mVersion = SEDML_INT_MAX;
   mIsSetVersion = false;
 
@@ -1269,8 +1303,82 @@ SedDocument::writeElements(XMLOutputStream& stream) const
 bool
 SedDocument::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.enter(*this))
+    {
+      mDataDescriptions.accept(v);
+      mSimulations.accept(v);
+      mModels.accept(v);
+      mTasks.accept(v);
+      mDataGenerators.accept(v);
+      mOutputs.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedDocument::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedDocument));
+  usage.addString(mWriteCacheContext);
 
+  // the errors logged are held by pointer
+  unsigned int numErrors = mErrorLog.getNumErrors();
+  usage.addBytes(SEDML_MEMORY_OBJECTS, numErrors * sizeof(SedError));
+  usage.addListOverhead(numErrors * sizeof(SedError*));
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedDocument::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + 6;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedDocument::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mDataDescriptions;
+    case 1:
+      return &mSimulations;
+    case 2:
+      return &mModels;
+    case 3:
+      return &mTasks;
+    case 4:
+      return &mDataGenerators;
+    case 5:
+      return &mOutputs;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -1396,6 +1504,47 @@ SedDocument::getNumErrors(unsigned int severity) const
 }
 
 
+/*
+ * Returns an estimate of the memory held by this SedDocument and all the
+ * objects it contains.
+ */
+SedMemoryUsage
+SedDocument::getMemoryUsage() const
+{
+  SedMemoryUsage usage;
+  collectMemoryUsage(usage);
+  return usage;
+}
+
+
+/*
+ * Returns an immutable snapshot of this SedDocument.
+ */
+SedDocumentSnapshot
+SedDocument::freeze() const
+{
+  SedDocument* frozen = clone();
+
+  /* bring the state that const methods would otherwise update lazily up to
+   * date, so that readers of the frozen document never write to it
+   */
+  frozen->prepareForFreeze();
+  frozen->mErrorLog.updateIndex();
+
+  frozen->mFrozen = true;
+  frozen->mSnapshotVersion = mSnapshotVersion + 1;
+
+  return SedDocumentSnapshot(frozen, frozen->mSnapshotVersion);
+}
+
+
+bool
+SedDocument::isFrozen() const
+{
+  return mFrozen;
+}
+
+
 /*
  * @return the SedErrorLog used to log errors during while reading and
  * validating Sed.
@@ -1427,66 +1576,86 @@ SedDocument::getErrorLog() const
 void
 SedDocument::writeXMLNS(XMLOutputStream& stream) const
 {
-  // need to check that we have indeed a namespace set!
-  XMLNamespaces * thisNs = this->getNamespaces();
+  // complete a copy of the namespaces, so that writing never changes the
+  // document; freeze() settles the namespaces of the snapshot beforehand
+  XMLNamespaces xmlns;
 
-  // the SED-ML namespace is missing - add it
-  if (thisNs == NULL)
+  if (getNamespaces() != NULL)
     {
-      XMLNamespaces xmlns;
+      xmlns = *getNamespaces();
+    }
 
-      if (getVersion() == 1)
-        xmlns.add(SEDML_XMLNS_L1V1);
-      else
-        xmlns.add(SEDML_XMLNS_L1V2);
+  addSedNamespace(xmlns, getLevel(), getVersion());
 
-      mSedNamespaces->setNamespaces(&xmlns);
-      thisNs = getNamespaces();
-    }
-  else if (thisNs->getLength() == 0)
+  stream << xmlns;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+/*
+ * Adds the SED-ML namespace of the given level and version to the given
+ * namespaces if it is missing.
+ */
+void
+SedDocument::addSedNamespace(XMLNamespaces& xmlns, unsigned int level,
+                             unsigned int version)
+{
+  if (xmlns.getLength() == 0)
     {
-      if (getVersion() == 1)
-        thisNs->add(SEDML_XMLNS_L1V1);
-      else if (getVersion() == 2)
-        thisNs->add(SEDML_XMLNS_L1V2);
+      if (version == 1)
+        xmlns.add(SEDML_XMLNS_L1V1);
+      else if (version == 2)
+        xmlns.add(SEDML_XMLNS_L1V2);
       else
-        thisNs->add(SEDML_XMLNS_L1V3);
+        xmlns.add(SEDML_XMLNS_L1V3);
+
+      return;
     }
-  else
+
+  // check that there is an SED-ML namespace
+  std::string sedmlURI = SedNamespaces::getSedNamespaceURI(level, version);
+  std::string sedmlPrefix = xmlns.getPrefix(sedmlURI);
+
+  if (xmlns.hasNS(sedmlURI, sedmlPrefix) == false)
     {
-      // check that there is an SED-ML namespace
-      std::string sedmlURI = SedNamespaces::getSedNamespaceURI(getLevel(), getVersion());
-      std::string sedmlPrefix = thisNs->getPrefix(sedmlURI);
+      // the SED-ML ns is not present
+      std::string other = xmlns.getURI(sedmlPrefix);
 
-      if (thisNs->hasNS(sedmlURI, sedmlPrefix) == false)
+      if (other.empty() == false)
+        {
+          // there is another ns with the prefix that the SED-ML ns expects to have
+          //remove the this ns, add the sbml ns and
+          //add the new ns with a new prefix
+          xmlns.remove(sedmlPrefix);
+          xmlns.add(sedmlURI, sedmlPrefix);
+          xmlns.add(other, "addedPrefix");
+        }
+      else
         {
-          // the SED-ML ns is not present
-          std::string other = thisNs->getURI(sedmlPrefix);
-
-          if (other.empty() == false)
-            {
-              // there is another ns with the prefix that the SED-ML ns expects to have
-              //remove the this ns, add the sbml ns and
-              //add the new ns with a new prefix
-              thisNs->remove(sedmlPrefix);
-              thisNs->add(sedmlURI, sedmlPrefix);
-              thisNs->add(other, "addedPrefix");
-            }
-          else
-            {
-              thisNs->add(sedmlURI, sedmlPrefix);
-            }
+          xmlns.add(sedmlURI, sedmlPrefix);
         }
     }
+}
 
-  XMLNamespaces * xmlns = thisNs->clone();
 
-  if (xmlns != NULL)
+/*
+ * Adds the SED-ML namespace to the namespaces of this document, then
+ * prepares its descendants.
+ */
+void
+SedDocument::prepareForFreeze()
+{
+  if (getNamespaces() == NULL)
     {
-      stream << *(xmlns);
-      delete xmlns;
+      XMLNamespaces xmlns;
+      mSedNamespaces->setNamespaces(&xmlns);
     }
+
+  addSedNamespace(*getNamespaces(), getLevel(), getVersion());
+
+  SedBase::prepareForFreeze();
 }
+/** @endcond doxygen-libsedml-internal */
 
 /*
   * @return the Namespaces associated with this SED-ML object
@@ -1496,6 +1665,105 @@ SedDocument::getNamespaces() const
 {
   return mSedNamespaces->getNamespaces();
 }
+
+
+/** @cond doxygen-libsedml-internal */
+/*
+ * Returns the epoch under which serialized output of the elements of this
+ * document is cached; it changes whenever the level, version or namespaces
+ * of the document change.
+ */
+unsigned int
+SedDocument::getWriteCacheEpoch() const
+{
+  ostringstream context;
+  context << getLevel() << ' ' << getVersion();
+
+  const XMLNamespaces* xmlns = getNamespaces();
+
+  if (xmlns != NULL)
+    {
+      for (int n = 0; n < xmlns->getNumNamespaces(); ++n)
+        {
+          context << ' ' << xmlns->getPrefix(n) << '=' << xmlns->getURI(n);
+        }
+    }
+
+  if (mWriteCacheEpoch == 0 || context.str() != mWriteCacheContext)
+    {
+      mWriteCacheContext = context.str();
+      ++mWriteCacheEpoch;
+    }
+
+  return mWriteCacheEpoch;
+}
+
+
+void
+SedDocument::setReadOptions(bool trusted, bool failFast)
+{
+  mTrustedRead = trusted;
+  mFailFastRead = failFast;
+}
+
+
+bool
+SedDocument::isTrustedRead() const
+{
+  return mTrustedRead;
+}
+
+
+bool
+SedDocument::isFailFastRead() const
+{
+  return mFailFastRead;
+}
+
+
+void
+SedDocument::setReadCache(SedReadCache* cache)
+{
+  mReadCache = cache;
+}
+
+
+SedReadCache*
+SedDocument::getReadCache() const
+{
+  return mReadCache;
+}
+
+
+void
+SedDocument::setReadStatistics(SedReaderStatistics* stats)
+{
+  mReadStatistics = stats;
+}
+
+
+SedReaderStatistics*
+SedDocument::getReadStatistics() const
+{
+  return mReadStatistics;
+}
+
+
+/*
+ * The writers of a frozen document, which may be written by several
+ * threads at once, log their errors to a log of their own.
+ */
+SedErrorLog*
+SedDocument::getWriteErrorLog(SedErrorLog& scratch) const
+{
+  if (!mFrozen)
+    {
+      return const_cast<SedErrorLog*>(&mErrorLog);
+    }
+
+  return &scratch;
+}
+/** @endcond doxygen-libsedml-internal */
 /**
  * write comments
  */
@@ -2018,6 +2286,44 @@ SedDocument_hasRequiredElements(SedDocument_t * sd)
 }
 
 
+/**
+ * Returns an estimate of the memory held by the given SedDocument; the
+ * caller owns the SedMemoryUsage returned, to be freed with
+ * SedMemoryUsage_free().
+ */
+LIBSEDML_EXTERN
+SedMemoryUsage_t *
+SedDocument_getMemoryUsage(const SedDocument_t * sd)
+{
+  return (sd != NULL) ? new SedMemoryUsage(sd->getMemoryUsage()) : NULL;
+}
+
+
+/**
+ * Returns an immutable snapshot of the given SedDocument; the caller owns
+ * the SedDocumentSnapshot returned, to be freed with
+ * SedDocumentSnapshot_free().
+ */
+LIBSEDML_EXTERN
+SedDocumentSnapshot_t *
+SedDocument_freeze(const SedDocument_t * sd)
+{
+  return (sd != NULL) ? new SedDocumentSnapshot(sd->freeze()) : NULL;
+}
+
+
+/**
+ * Returns non-zero if the given SedDocument is the frozen document of a
+ * SedDocumentSnapshot.
+ */
+LIBSEDML_EXTERN
+int
+SedDocument_isFrozen(const SedDocument_t * sd)
+{
+  return (sd != NULL) ? static_cast<int>(sd->isFrozen()) : 0;
+}
+
+
 
 
 LIBSEDML_CPP_NAMESPACE_END
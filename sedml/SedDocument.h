@@ -57,6 +57,7 @@
 #include <sedml/SedTask.h>
 #include <sedml/SedDataGenerator.h>
 #include <sedml/SedOutput.h>
+#include <sedml/SedDocumentSnapshot.h>
 
 
 
@@ -64,6 +65,9 @@
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 
+class SedReadCache;
+class SedReaderStatistics;
+
 class LIBSEDML_EXTERN SedDocument : public SedBase
 {
 
@@ -1160,6 +1164,30 @@ public:
   /** @endcond doxygen-libsedml-internal */
 
 
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Adds the memory held by this object to the given SedMemoryUsage.
+   */
+  virtual void addMemoryUsage(SedMemoryUsage& usage) const;
+
+
+  /**
+   * Returns the number of child Sed objects of this object.
+   */
+  virtual unsigned int getNumChildObjects() const;
+
+
+  /**
+   * Returns the nth child Sed object of this object, or @c NULL if @p n
+   * is out of range.
+   */
+  virtual const SedBase* getChildObject(unsigned int n) const;
+
+
+  /** @endcond doxygen-libsedml-internal */
+
+
   /** @cond doxygen-libsedml-internal */
 
   /**
@@ -1289,12 +1317,49 @@ public:
    *
    * @param severity the severity of the error sought.
    *
-   * @return the number of errors or warnings encountered
+   * @return the number of errors or warnings encountered, including those
+   * the error log did not store because it was full (see
+   * SedErrorLog::setMaxErrors()).
    *
    * @see SedDocument::getError(unsigned int n)
    */
   unsigned int getNumErrors(unsigned int severity) const;
 
+
+  /**
+   * Returns an estimate of the memory held by this SedDocument and all the
+   * objects it contains, broken down by type code (see #SedTypeCode_t) and
+   * by the kind of data held (see #SedMemoryCategory_t).
+   *
+   * @return the memory held by this document.
+   *
+   * @see SedMemoryUsage
+   */
+  SedMemoryUsage getMemoryUsage() const;
+
+
+  /**
+   * Returns an immutable snapshot of this SedDocument.
+   *
+   * The snapshot holds a frozen copy of this document, which any number of
+   * threads may read, traverse and write at the same time without locking;
+   * this document itself is not changed and remains modifiable.  The
+   * version of the snapshot is one more than that of the snapshot this
+   * document was copied from with SedDocumentSnapshot::edit(), or 1.
+   *
+   * @return the snapshot.
+   *
+   * @see SedDocumentSnapshot
+   */
+  SedDocumentSnapshot freeze() const;
+
+
+  /**
+   * @return @c true if this document is the frozen document of a
+   * SedDocumentSnapshot, and must not be modified.
+   */
+  bool isFrozen() const;
+
   /**
    * Returns a list of XML Namespaces associated with the XML content
    * of this SED-ML document.
@@ -1303,6 +1368,92 @@ public:
    */
   virtual XMLNamespaces* getNamespaces() const;
 
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Returns the epoch under which the serialized output of the elements of
+   * this document is cached by SedWriter.  The epoch changes whenever the
+   * level, version or XML namespaces of the document change, as these
+   * affect the prefixes written for all elements.
+   *
+   * @return the current write cache epoch of this document.
+   */
+  unsigned int getWriteCacheEpoch() const;
+
+
+  /**
+   * Sets the options under which this document is being read; set by
+   * SedReader for the duration of a read.
+   *
+   * @param trusted whether the consistency checks made while reading are
+   * skipped.
+   * @param failFast whether reading stops at the first error.
+   */
+  void setReadOptions(bool trusted, bool failFast);
+
+
+  /**
+   * @return @c true if this document is being read from trusted input, in
+   * which case the consistency checks made while reading are skipped.
+   */
+  bool isTrustedRead() const;
+
+
+  /**
+   * @return @c true if reading this document stops at the first error.
+   */
+  bool isFailFastRead() const;
+
+
+  /**
+   * Sets the state shared with the SedReader reading this document; set
+   * by SedReader for the duration of a read.
+   *
+   * @param cache the state of the reader, or @c NULL.
+   */
+  void setReadCache(SedReadCache* cache);
+
+
+  /**
+   * @return the state shared with the SedReader reading this document, or
+   * @c NULL if this document is not being read.
+   */
+  SedReadCache* getReadCache() const;
+
+
+  /**
+   * Sets the statistics collected while this document is read, or
+   * @c NULL; set by SedReader for the duration of a read.
+   */
+  void setReadStatistics(SedReaderStatistics* stats);
+
+
+  /**
+   * @return the statistics collected while this document is read, or
+   * @c NULL if none are collected.
+   */
+  SedReaderStatistics* getReadStatistics() const;
+
+
+  /**
+   * @param scratch a log owned by the writer.
+   *
+   * @return the error log to which writers log the errors they meet: the
+   * error log of this document, or if this document is frozen (and may not
+   * change) @p scratch.
+   */
+  SedErrorLog* getWriteErrorLog(SedErrorLog& scratch) const;
+
+
+  /**
+   * Adds the SED-ML namespace to the namespaces of this document, then
+   * brings the state of its descendants up to date; used by freeze().
+   */
+  virtual void prepareForFreeze();
+
+  /** @endcond doxygen-libsedml-internal */
+
 protected:
   /**
    *
@@ -1312,10 +1463,34 @@ protected:
    *
    */
   virtual void writeXMLNS(XMLOutputStream& stream) const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Adds the SED-ML namespace of the given level and version to
+   * @p xmlns if it is missing.
+   */
+  static void addSedNamespace(XMLNamespaces& xmlns, unsigned int level,
+                              unsigned int version);
+
+  /** @endcond doxygen-libsedml-internal */
+
 private:
 
   SedErrorLog mErrorLog;
 
+  mutable unsigned int mWriteCacheEpoch;
+  mutable std::string  mWriteCacheContext;
+
+  bool mTrustedRead;
+  bool mFailFastRead;
+  SedReadCache* mReadCache;
+  SedReaderStatistics* mReadStatistics;
+
+  bool mFrozen;
+  unsigned int mSnapshotVersion;
+
 };
 
 
@@ -1659,6 +1834,21 @@ int
 SedDocument_hasRequiredElements(SedDocument_t * sd);
 
 
+LIBSEDML_EXTERN
+SedMemoryUsage_t *
+SedDocument_getMemoryUsage(const SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+SedDocumentSnapshot_t *
+SedDocument_freeze(const SedDocument_t * sd);
+
+
+LIBSEDML_EXTERN
+int
+SedDocument_isFrozen(const SedDocument_t * sd);
+
+
 
 
 END_C_DECLS
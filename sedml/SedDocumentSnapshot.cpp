@@ -0,0 +1,244 @@
+/**
+ * @file    SedDocumentSnapshot.cpp
+ * @brief   Implementation of SedDocumentSnapshot
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedDocumentSnapshot.h>
+#include <sedml/SedDocument.h>
+
+#ifdef LIBSEDML_USE_THREADS
+#include <atomic>
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The frozen document shared by the copies of a snapshot.  The count of
+ * copies is atomic, with std::atomic when libSEDML is built with threads
+ * and the atomic builtins of the compiler otherwise, so that snapshots may
+ * be copied and destroyed from any thread in every build.
+ */
+struct SedSnapshotState
+{
+  SedSnapshotState(SedDocument* document, unsigned int version)
+    : mDocument(document)
+    , mVersion(version)
+    , mRefs(1)
+  {
+  }
+
+  ~SedSnapshotState()
+  {
+    delete mDocument;
+  }
+
+  SedDocument* mDocument;
+  unsigned int mVersion;
+
+#ifdef LIBSEDML_USE_THREADS
+  std::atomic<long> mRefs;
+#else
+  volatile long mRefs;
+#endif
+};
+
+
+/*
+ * Counts a new copy of the given state.
+ */
+static void
+acquireState(SedSnapshotState* state)
+{
+#if defined(LIBSEDML_USE_THREADS)
+  ++state->mRefs;
+#elif defined(_MSC_VER)
+  _InterlockedIncrement(&state->mRefs);
+#else
+  __sync_add_and_fetch(&state->mRefs, 1);
+#endif
+}
+
+
+/*
+ * Counts a copy of the given state gone.
+ *
+ * @return true if it was the last copy.
+ */
+static bool
+releaseState(SedSnapshotState* state)
+{
+#if defined(LIBSEDML_USE_THREADS)
+  return --state->mRefs == 0;
+#elif defined(_MSC_VER)
+  return _InterlockedDecrement(&state->mRefs) == 0;
+#else
+  return __sync_sub_and_fetch(&state->mRefs, 1) == 0;
+#endif
+}
+
+/** @endcond */
+
+
+SedDocumentSnapshot::SedDocumentSnapshot()
+  : mState(NULL)
+{
+}
+
+
+SedDocumentSnapshot::SedDocumentSnapshot(SedDocument* frozen,
+                                         unsigned int version)
+  : mState(frozen != NULL ? new SedSnapshotState(frozen, version) : NULL)
+{
+}
+
+
+SedDocumentSnapshot::SedDocumentSnapshot(const SedDocumentSnapshot& orig)
+  : mState(orig.mState)
+{
+  if (mState != NULL)
+    acquireState(mState);
+}
+
+
+SedDocumentSnapshot&
+SedDocumentSnapshot::operator=(const SedDocumentSnapshot& rhs)
+{
+  if (rhs.mState != mState)
+    {
+      if (rhs.mState != NULL)
+        acquireState(rhs.mState);
+
+      release();
+      mState = rhs.mState;
+    }
+
+  return *this;
+}
+
+
+SedDocumentSnapshot::~SedDocumentSnapshot()
+{
+  release();
+}
+
+
+const SedDocument*
+SedDocumentSnapshot::getDocument() const
+{
+  return (mState != NULL) ? mState->mDocument : NULL;
+}
+
+
+unsigned int
+SedDocumentSnapshot::getVersion() const
+{
+  return (mState != NULL) ? mState->mVersion : 0;
+}
+
+
+bool
+SedDocumentSnapshot::isEmpty() const
+{
+  return mState == NULL;
+}
+
+
+SedDocument*
+SedDocumentSnapshot::edit() const
+{
+  return (mState != NULL) ? mState->mDocument->clone() : NULL;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+void
+SedDocumentSnapshot::release()
+{
+  if (mState != NULL && releaseState(mState))
+    delete mState;
+
+  mState = NULL;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+void
+SedDocumentSnapshot_free(SedDocumentSnapshot_t *snapshot)
+{
+  delete snapshot;
+}
+
+
+LIBSEDML_EXTERN
+SedDocumentSnapshot_t *
+SedDocumentSnapshot_clone(const SedDocumentSnapshot_t *snapshot)
+{
+  return (snapshot != NULL) ? new SedDocumentSnapshot(*snapshot) : NULL;
+}
+
+
+LIBSEDML_EXTERN
+const SedDocument_t *
+SedDocumentSnapshot_getDocument(const SedDocumentSnapshot_t *snapshot)
+{
+  return (snapshot != NULL) ? snapshot->getDocument() : NULL;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedDocumentSnapshot_getVersion(const SedDocumentSnapshot_t *snapshot)
+{
+  return (snapshot != NULL) ? snapshot->getVersion() : 0;
+}
+
+
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDocumentSnapshot_edit(const SedDocumentSnapshot_t *snapshot)
+{
+  return (snapshot != NULL) ? snapshot->edit() : NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,218 @@
+/**
+ * @file    SedDocumentSnapshot.h
+ * @brief   Immutable version of a SedDocument shared between threads
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedDocumentSnapshot
+ * @ingroup Core
+ * @brief Immutable version of a SedDocument shared between threads.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * SedDocument::freeze() returns a SedDocumentSnapshot holding a frozen copy
+ * of the document.  The frozen document is never modified again, not even
+ * by the caches libSEDML keeps behind const methods, so any number of
+ * threads may read, traverse and write it (with SedWriter, each thread
+ * using its own writer) at the same time without locking.
+ *
+ * Copies of a SedDocumentSnapshot share the same frozen document, which is
+ * deleted with the last of them; they may be copied and destroyed from any
+ * thread.
+ *
+ * A snapshot is edited by copy-on-write: edit() returns a new, modifiable
+ * copy of the document, and calling SedDocument::freeze() on that copy
+ * publishes it as the next version.  Readers holding the previous snapshot
+ * keep seeing the previous version.
+ * @code{.cpp}
+ * SedDocumentSnapshot current = doc->freeze();
+ * // ... share current with the reader threads ...
+ *
+ * SedDocument* draft = current.edit();
+ * draft->getModel(0)->setSource("new_model.xml");
+ * SedDocumentSnapshot next = draft->freeze();   // next.getVersion() == 2
+ * delete draft;
+ * @endcode
+ */
+
+#ifndef SedDocumentSnapshot_h
+#define SedDocumentSnapshot_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+struct SedSnapshotState;
+
+
+class LIBSEDML_EXTERN SedDocumentSnapshot
+{
+public:
+
+  /**
+   * Creates a new, empty SedDocumentSnapshot holding no document.
+   */
+  SedDocumentSnapshot();
+
+
+  /**
+   * Copy constructor; the copy shares the frozen document of @p orig.
+   */
+  SedDocumentSnapshot(const SedDocumentSnapshot& orig);
+
+
+  /**
+   * Assignment operator; this snapshot then shares the frozen document of
+   * @p rhs.
+   */
+  SedDocumentSnapshot& operator=(const SedDocumentSnapshot& rhs);
+
+
+  /**
+   * Destructor; deletes the frozen document if this is its last snapshot.
+   */
+  ~SedDocumentSnapshot();
+
+
+  /**
+   * @return the frozen document, or @c NULL if this snapshot is empty.
+   */
+  const SedDocument* getDocument() const;
+
+
+  /**
+   * @return the version of the frozen document: 1 for a document frozen
+   * for the first time, and one more than the version it was copied from
+   * for a document obtained with edit().  Empty snapshots have version 0.
+   */
+  unsigned int getVersion() const;
+
+
+  /**
+   * @return @c true if this snapshot holds no document.
+   */
+  bool isEmpty() const;
+
+
+  /**
+   * Returns a new, modifiable copy of the frozen document, owned by the
+   * caller.  Freezing the copy publishes it as the next version.
+   *
+   * @return a copy of the frozen document, or @c NULL if this snapshot is
+   * empty.
+   */
+  SedDocument* edit() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Creates a snapshot owning the given frozen document.
+   */
+  SedDocumentSnapshot(SedDocument* frozen, unsigned int version);
+
+  /** @endcond */
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  void release();
+
+  SedSnapshotState* mState;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Frees the given SedDocumentSnapshot; the frozen document is deleted with
+ * the last snapshot holding it.
+ */
+LIBSEDML_EXTERN
+void
+SedDocumentSnapshot_free(SedDocumentSnapshot_t *snapshot);
+
+/**
+ * Returns a new SedDocumentSnapshot sharing the frozen document of the
+ * given one.
+ */
+LIBSEDML_EXTERN
+SedDocumentSnapshot_t *
+SedDocumentSnapshot_clone(const SedDocumentSnapshot_t *snapshot);
+
+/**
+ * Returns the frozen document of the given SedDocumentSnapshot.
+ */
+LIBSEDML_EXTERN
+const SedDocument_t *
+SedDocumentSnapshot_getDocument(const SedDocumentSnapshot_t *snapshot);
+
+/**
+ * Returns the version of the frozen document of the given
+ * SedDocumentSnapshot.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedDocumentSnapshot_getVersion(const SedDocumentSnapshot_t *snapshot);
+
+/**
+ * Returns a new, modifiable copy of the frozen document of the given
+ * SedDocumentSnapshot, owned by the caller.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedDocumentSnapshot_edit(const SedDocumentSnapshot_t *snapshot);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedDocumentSnapshot_h */
@@ -74,6 +74,35 @@ getSeverityForEntry(unsigned int index,
 }
 
 
+/**
+ * Helper function for SedError().  Returns the index of the errorTable
+ * entry for the given error code, or 0 (the entry for SedUnknownError) if
+ * there is none.  The table is sorted by code, so this is a binary search.
+ */
+static unsigned int
+getIndexForCode(unsigned int code)
+{
+  unsigned int low = 0;
+  unsigned int high = sizeof(errorTable) / sizeof(errorTable[0]);
+
+  while (low < high)
+    {
+      unsigned int mid = low + (high - low) / 2;
+
+      if (errorTable[mid].code < code)
+        low = mid + 1;
+      else
+        high = mid;
+    }
+
+  if (low < sizeof(errorTable) / sizeof(errorTable[0])
+      && errorTable[low].code == code)
+    return low;
+
+  return 0;
+}
+
+
 /*
  * @return the severity as a string for the given @n code.
  */
@@ -177,17 +206,7 @@ SedError::SedError(const unsigned int errorId
   else if (mErrorId > XMLErrorCodesUpperBound
            && mErrorId < SedCodesUpperBound)
     {
-      unsigned int tableSize = sizeof(errorTable) / sizeof(errorTable[0]);
-      unsigned int index = 0;
-
-      for (unsigned int i = 0; i < tableSize; i++)
-        {
-          if (mErrorId == errorTable[i].code)
-            {
-              index = i;
-              break;
-            }
-        }
+      unsigned int index = getIndexForCode(mErrorId);
 
       if (index == 0 && mErrorId != SedUnknownError)
         {
@@ -220,12 +239,13 @@ SedError::SedError(const unsigned int errorId
           mErrorId = SedInconsistentArgUnits;
         }
 
-      ostringstream newMsg;
       mSeverity = getSeverityForEntry(index, level, version);
 
       if (mValidError == false)
         mSeverity = LIBSEDML_SEV_WARNING;
 
+      std::string prefix;
+
       if (mSeverity == LIBSEDML_SEV_SCHEMA_ERROR)
         {
           // Prior to L2v3, many possible errors were not listed separately as
@@ -241,7 +261,8 @@ SedError::SedError(const unsigned int errorId
 
           mErrorId  = SedNotSchemaConformant;
           mSeverity = LIBSEDML_SEV_ERROR;
-          newMsg << errorTable[3].message << " "; // FIXME
+          prefix = errorTable[getIndexForCode(SedNotSchemaConformant)].message;
+          prefix += " ";
         }
       else if (mSeverity == LIBSEDML_SEV_GENERAL_WARNING)
         {
@@ -252,26 +273,28 @@ SedError::SedError(const unsigned int errorId
           // and then here we translate them into regular warnings.
 
           mSeverity = LIBSEDML_SEV_WARNING;
-          newMsg << "[Although Sed Level " << level
-                 << " Version " << version << " does not explicitly define the "
-                 << "following as an error, other Levels and/or Versions "
-                 << "of Sed do.] " << endl;
-        }
 
-      // Finish updating the (full) error message.
+          ostringstream warning;
+          warning << "[Although Sed Level " << level
+                  << " Version " << version << " does not explicitly define the "
+                  << "following as an error, other Levels and/or Versions "
+                  << "of Sed do.] " << endl;
+          prefix = warning.str();
+        }
 
-      newMsg << errorTable[index].message;
+      // The message is assembled here, once, so that XMLError::getMessage()
+      // returns it as well.
 
-      // look for individual references
-      // if the code for this error does not yet exist skip
+      mMessage = prefix;
+      mMessage += errorTable[index].message;
 
       if (!details.empty())
         {
-          newMsg << " " << details;
+          mMessage += " ";
+          mMessage += details;
         }
 
-      newMsg << endl;
-      mMessage  = newMsg.str();
+      mMessage += "\n";
 
       // We mucked around with the severity code and (maybe) category code
       // after creating the XMLError object, so we may have to update the
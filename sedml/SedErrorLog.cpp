@@ -63,6 +63,9 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new empty SedErrorLog.
  */
 SedErrorLog::SedErrorLog()
+  : mNumIndexed(0)
+  , mLastIndexed(NULL)
+  , mMaxErrors(0)
 {
 }
 
@@ -103,6 +106,19 @@ SedErrorLog::~SedErrorLog()
 }
 
 
+/*
+ * Decrements the count of the given key, erasing it once it reaches zero.
+ */
+static void
+decrementCount(map<unsigned int, unsigned int>& counts, unsigned int key)
+{
+  map<unsigned int, unsigned int>::iterator found = counts.find(key);
+
+  if (found != counts.end() && --found->second == 0)
+    counts.erase(found);
+}
+
+
 /*
  * See SedError for a list of Sed error codes and XMLError
  * for a list of system and XML-level error codes.
@@ -147,8 +163,19 @@ SedErrorLog::logPackageError(const std::string& package
 void
 SedErrorLog::add(const SedError& error)
 {
-  if (error.getSeverity() != LIBSEDML_SEV_NOT_APPLICABLE)
-    XMLErrorLog::add(error);
+  if (error.getSeverity() == LIBSEDML_SEV_NOT_APPLICABLE)
+    return;
+
+  updateIndex();
+
+  if (mMaxErrors != 0 && mErrors.size() >= mMaxErrors)
+  {
+    ++mDropped[error.getSeverity()];
+    return;
+  }
+
+  XMLErrorLog::add(error);
+  updateIndex();
 }
 
 
@@ -165,7 +192,7 @@ SedErrorLog::add(const std::list<SedError>& errors)
   list<SedError>::const_iterator iter;
 
   for (iter = errors.begin(); iter != end; ++iter)
-    XMLErrorLog::add(*iter);
+    add(*iter);
 }
 
 /*
@@ -181,27 +208,9 @@ SedErrorLog::add(const std::vector<SedError>& errors)
   vector<SedError>::const_iterator iter;
 
   for (iter = errors.begin(); iter != end; ++iter)
-    XMLErrorLog::add(*iter);
+    add(*iter);
 }
 
-/*
- * Helper class used by SedErrorLog::remove.
- */
-class MatchErrorId
-{
-public:
-  MatchErrorId(const unsigned int theId) : idToFind(theId) {};
-
-  bool operator()(XMLError* e) const
-  {
-    return e->getErrorId() == idToFind;
-  };
-
-private:
-  unsigned int idToFind;
-};
-
-
 /*
  * Removes an error having errorId from the SedError list.
  *
@@ -213,6 +222,53 @@ private:
 void
 SedErrorLog::remove(const unsigned int errorId)
 {
+  updateIndex();
+
+  map<unsigned int, vector<unsigned int> >::iterator found =
+    mIndex.find(errorId);
+
+  if (found == mIndex.end())
+    return;
+
+  // the index gives the position of the first item with the given errorId;
+  // the positions of the items after it move down by one, in place.
+  unsigned int position = found->second.front();
+
+  decrementCount(mSeverityCounts, mErrors[position]->getSeverity());
+  found->second.erase(found->second.begin());
+
+  if (found->second.empty())
+    mIndex.erase(found);
+
+  delete mErrors[position];
+  mErrors.erase(mErrors.begin() + position);
+
+  for (map<unsigned int, vector<unsigned int> >::iterator iter = mIndex.begin();
+       iter != mIndex.end(); ++iter)
+    {
+      vector<unsigned int>& positions = iter->second;
+      vector<unsigned int>::iterator after =
+        upper_bound(positions.begin(), positions.end(), position);
+
+      for (; after != positions.end(); ++after)
+        --*after;
+    }
+
+  markIndexed();
+}
+
+
+/*
+ * Removes all errors having errorId from the SedError list.
+ */
+void
+SedErrorLog::removeAll(const unsigned int errorId)
+{
+  updateIndex();
+
+  if (mIndex.find(errorId) == mIndex.end())
+    return;
+
   //
   // "mErrors.erase( remove_if( ...))" can't be used for removing
   // the matched items from the list, because the type of the vector container is pointer
@@ -222,61 +278,187 @@ SedErrorLog::remove(const unsigned int errorId)
   //  Scott Meyers
   //  Item 33: Be wary of remove-like algorithms on containers of pointers. 143)
   //
+  // The kept items are therefore compacted by hand, in one pass.
   //
-  vector<XMLError*>::iterator delIter;
+  vector<XMLError*>::iterator dest = mErrors.begin();
+
+  for (vector<XMLError*>::iterator iter = mErrors.begin();
+       iter != mErrors.end(); ++iter)
+    {
+      if ((*iter)->getErrorId() == errorId)
+        delete *iter;
+      else
+        *dest++ = *iter;
+    }
+
+  mErrors.erase(dest, mErrors.end());
+  rebuildIndex();
+}
+
+
+/*
+ * Removes all errors for whose error identifier predicate returns true.
+ */
+unsigned int
+SedErrorLog::removeIf(bool (*predicate)(unsigned int errorId))
+{
+  if (predicate == NULL)
+    return 0;
 
-  // finds an item with the given errorId (the first item will be found if
-  // there are two or more items with the same Id)
-  delIter = find_if(mErrors.begin(), mErrors.end(), MatchErrorId(errorId));
+  updateIndex();
 
-  if (delIter != mErrors.end())
+  unsigned int removed = 0;
+  vector<XMLError*>::iterator dest = mErrors.begin();
+
+  for (vector<XMLError*>::iterator iter = mErrors.begin();
+       iter != mErrors.end(); ++iter)
+    {
+      if (predicate((*iter)->getErrorId()))
+        {
+          delete *iter;
+          ++removed;
+        }
+      else
+        *dest++ = *iter;
+    }
+
+  if (removed > 0)
     {
-      // deletes (invoke delete operator for the matched item) and erases (removes
-      // the pointer from mErrors) the matched item (if any)
-      delete *delIter;
-      mErrors.erase(delIter);
+      mErrors.erase(dest, mErrors.end());
+      rebuildIndex();
     }
+
+  return removed;
 }
 
 
 bool
 SedErrorLog::contains(const unsigned int errorId)
 {
-  vector<XMLError*>::iterator iter;
+  updateIndex();
+
+  return mIndex.find(errorId) != mIndex.end();
+}
+
 
-  // finds an item with the given errorId (the first item will be found if
-  // there are two or more items with the same Id)
-  iter = find_if(mErrors.begin(), mErrors.end(), MatchErrorId(errorId));
+/*
+ * Returns the number of errors in this log having errorId.
+ */
+unsigned int
+SedErrorLog::getNumErrorsWithId(const unsigned int errorId) const
+{
+  unsigned int count = 0;
+  unsigned int first = 0;
 
-  if (iter != mErrors.end())
+  if (isIndexValid())
     {
-      return true;
+      map<unsigned int, vector<unsigned int> >::const_iterator found =
+        mIndex.find(errorId);
+
+      if (found != mIndex.end())
+        count = (unsigned int)found->second.size();
+
+      first = mNumIndexed;
     }
-  else
+
+  // errors XMLErrorLog appended since the last update are counted without
+  // indexing them, so that this function leaves the log unchanged
+  for (unsigned int i = first; i < mErrors.size(); ++i)
     {
-      return false;
+      if (mErrors[i]->getErrorId() == errorId)
+        ++count;
     }
+
+  return count;
 }
 
 
 /*
- * Helper class used by
- * SedErrorLog::getNumFailsWithSeverity(SedErrorSeverity_t).
+ * Removes all errors from this log.
  */
-class MatchSeverity
+void
+SedErrorLog::clearLog()
 {
-public:
-  MatchSeverity(const unsigned int s) : severity(s) {};
+  XMLErrorLog::clearLog();
+  mDropped.clear();
+  invalidateIndex();
+}
 
-  bool operator()(XMLError* e) const
-  {
-    return e->getSeverity() == severity;
-  };
 
-private:
-  unsigned int severity;
-};
+void
+SedErrorLog::updateIndex()
+{
+  // errors were removed or replaced behind our back (e.g. through
+  // XMLErrorLog::clearLog); index them again, applying the limit only to
+  // the errors appended since
+  if (!isIndexValid())
+    {
+      rebuildIndex();
+      return;
+    }
+
+  unsigned int dest = mNumIndexed;
+
+  for (unsigned int i = mNumIndexed; i < mErrors.size(); ++i)
+    {
+      XMLError* error = mErrors[i];
+
+      if (mMaxErrors != 0 && dest >= mMaxErrors)
+        {
+          ++mDropped[error->getSeverity()];
+          delete error;
+          continue;
+        }
+
+      ++mSeverityCounts[error->getSeverity()];
+      mIndex[error->getErrorId()].push_back(dest);
+      mErrors[dest++] = error;
+    }
+
+  mErrors.resize(dest);
+  markIndexed();
+}
+
+
+void
+SedErrorLog::rebuildIndex()
+{
+  invalidateIndex();
 
+  for (unsigned int i = 0; i < mErrors.size(); ++i)
+    {
+      ++mSeverityCounts[mErrors[i]->getSeverity()];
+      mIndex[mErrors[i]->getErrorId()].push_back(i);
+    }
+
+  markIndexed();
+}
+
+
+bool
+SedErrorLog::isIndexValid() const
+{
+  return mNumIndexed <= mErrors.size()
+         && (mNumIndexed == 0 || mErrors[mNumIndexed - 1] == mLastIndexed);
+}
+
+
+void
+SedErrorLog::invalidateIndex()
+{
+  mNumIndexed = 0;
+  mLastIndexed = NULL;
+  mSeverityCounts.clear();
+  mIndex.clear();
+}
+
+
+void
+SedErrorLog::markIndexed()
+{
+  mNumIndexed = (unsigned int)mErrors.size();
+  mLastIndexed = mErrors.empty() ? NULL : mErrors.back();
+}
 
 
 /** @endcond */
@@ -284,16 +466,27 @@ private:
 unsigned int
 SedErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 {
-  int n = 0;
+  unsigned int count = getNumDroppedErrors(severity);
+  unsigned int first = 0;
 
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
+  if (isIndexValid())
+    {
+      map<unsigned int, unsigned int>::const_iterator found =
+        mSeverityCounts.find(severity);
 
-  return n;
+      if (found != mSeverityCounts.end())
+        count += found->second;
+
+      first = mNumIndexed;
+    }
+
+  for (unsigned int i = first; i < mErrors.size(); ++i)
+    {
+      if (mErrors[i]->getSeverity() == severity)
+        ++count;
+    }
+
+  return count;
 }
 
 /*
@@ -302,19 +495,49 @@ SedErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 unsigned int
 SedErrorLog::getNumFailsWithSeverity(unsigned int severity)
 {
-  int n = 0;
+  updateIndex();
+
+  return static_cast<const SedErrorLog*>(this)->getNumFailsWithSeverity(severity);
+}
 
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
+
+void
+SedErrorLog::setMaxErrors(unsigned int maxErrors)
+{
+  mMaxErrors = maxErrors;
+}
+
+
+unsigned int
+SedErrorLog::getMaxErrors() const
+{
+  return mMaxErrors;
+}
+
+
+unsigned int
+SedErrorLog::getNumDroppedErrors() const
+{
+  unsigned int n = 0;
+
+  for (map<unsigned int, unsigned int>::const_iterator iter = mDropped.begin();
+       iter != mDropped.end(); ++iter)
+    n += iter->second;
 
   return n;
 }
 
 
+unsigned int
+SedErrorLog::getNumDroppedErrors(unsigned int severity) const
+{
+  map<unsigned int, unsigned int>::const_iterator found =
+    mDropped.find(severity);
+
+  return found == mDropped.end() ? 0 : found->second;
+}
+
+
 /*
  * Returns the nth SedError in this log.
  *
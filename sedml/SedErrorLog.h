@@ -68,6 +68,10 @@
  * If you wish to simply print the error strings for a human to read, an
  * easier and more direct way might be to use SedDocument::printErrors().
  *
+ * The const methods of SedErrorLog do not modify the log, so they may be
+ * called from several threads at once, provided no thread logs or removes
+ * errors at the same time.
+ *
  * @see SedError
  * @see XMLErrorLog
  * @see XMLError
@@ -85,6 +89,7 @@
 
 #ifdef __cplusplus
 
+#include <map>
 #include <vector>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
@@ -136,7 +141,9 @@ public:
    * value from the set of <code>LIBSEDML_SEV_</code> constants defined by
    * the interface class @link libsbml libsbml@endlink. @endif@~
    *
-   * @return a count of the number of errors with the given severity code.
+   * @return a count of the number of errors with the given severity code,
+   * including those not stored because the log was full (see
+   * setMaxErrors()).
    *
    * @see getNumErrors()
    */
@@ -164,7 +171,9 @@ public:
   * value from the set of <code>LIBSEDML_SEV_</code> constants defined by
   * the interface class @link libsbml libsbml@endlink. @endif@~
   *
-  * @return a count of the number of errors with the given severity code.
+  * @return a count of the number of errors with the given severity code,
+  * including those not stored because the log was full (see
+  * setMaxErrors()).
   *
   * @see getNumErrors()
   */
@@ -289,6 +298,137 @@ public:
   bool contains(const unsigned int errorId);
 
 
+  /**
+   * Removes all errors having errorId from the SedError list.
+   *
+   * @param errorId the error identifier of the errors to be removed.
+   */
+  void removeAll(const unsigned int errorId);
+
+
+  /**
+   * Removes all errors for whose error identifier @p predicate returns
+   * @c true, in a single pass over the log.
+   *
+   * @param predicate function called with the identifier of each error.
+   *
+   * @return the number of errors removed.
+   */
+  unsigned int removeIf(bool (*predicate)(unsigned int errorId));
+
+
+  /**
+   * Returns the number of errors in this log having errorId.
+   *
+   * @param errorId the error identifier of the errors to be counted.
+   */
+  unsigned int getNumErrorsWithId(const unsigned int errorId) const;
+
+
+  /**
+   * Removes all errors from this log, and resets the number of errors
+   * dropped because the log was full.
+   */
+  void clearLog();
+
+
+  /**
+   * Indexes the errors appended to this log by XMLErrorLog directly, such
+   * as those reported by the XML parser, and applies the limit set by
+   * setMaxErrors() to them.  SedReader calls this function once a
+   * document has been read; the other functions of this log modifying it
+   * call it as well.
+   */
+  void updateIndex();
+
+  /** @endcond */
+
+
+  /**
+   * Sets the maximum number of errors this log stores.
+   *
+   * Once the log is full, further errors of any severity are not stored
+   * but only counted (see getNumDroppedErrors()), so that reading
+   * pathological input cannot allocate an unbounded number of error
+   * objects; getNumFailsWithSeverity() still counts them.  The limit
+   * applies to the messages of the underlying XML parser once they are
+   * indexed (see updateIndex()).
+   *
+   * @param maxErrors the maximum number of errors to store, or @c 0
+   * (the default) for no limit.
+   */
+  void setMaxErrors(unsigned int maxErrors);
+
+
+  /**
+   * @return the maximum number of errors this log stores, or @c 0 if
+   * there is no limit.
+   *
+   * @see setMaxErrors(unsigned int maxErrors)
+   */
+  unsigned int getMaxErrors() const;
+
+
+  /**
+   * @return the number of errors that were not stored because the log was
+   * full.
+   *
+   * @see setMaxErrors(unsigned int maxErrors)
+   */
+  unsigned int getNumDroppedErrors() const;
+
+
+  /**
+   * @return the number of errors of the given severity that were not
+   * stored because the log was full.
+   *
+   * @param severity the severity of the errors sought.
+   *
+   * @see setMaxErrors(unsigned int maxErrors)
+   */
+  unsigned int getNumDroppedErrors(unsigned int severity) const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * @return true if the index covers a prefix of mErrors, that is if
+   * XMLErrorLog has at most appended errors since it was updated.
+   */
+  bool isIndexValid() const;
+
+
+  /**
+   * Discards the index; it is rebuilt by the next updateIndex().
+   */
+  void invalidateIndex();
+
+
+  /**
+   * Indexes all of mErrors again, without applying the limit.
+   */
+  void rebuildIndex();
+
+
+  /**
+   * Records that the index covers all of mErrors.
+   */
+  void markIndexed();
+
+
+  /* number of (leading) errors of mErrors that are indexed */
+  unsigned int mNumIndexed;
+  /* last error indexed, used to detect changes made by XMLErrorLog */
+  const XMLError* mLastIndexed;
+  /* number of errors per severity */
+  std::map<unsigned int, unsigned int> mSeverityCounts;
+  /* the positions in mErrors of the errors per error identifier */
+  std::map<unsigned int, std::vector<unsigned int> > mIndex;
+
+  unsigned int mMaxErrors;
+  std::map<unsigned int, unsigned int> mDropped;
+
   /** @endcond */
 };
 
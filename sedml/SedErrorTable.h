@@ -63,6 +63,10 @@ typedef struct
 } sbmlErrorTableEntry;
 
 
+/*
+ * Entries must be kept in ascending order of their code: SedError looks
+ * them up by binary search.
+ */
 static const sbmlErrorTableEntry errorTable[] =
 {
   // 10000
@@ -36,6 +36,7 @@
 
 #include <sedml/SedFunctionalRange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -193,6 +194,7 @@ SedFunctionalRange::setRange(const std::string& range)
     }
   else
     {
+      markDirty();
       mRange = range;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -207,10 +209,13 @@ SedFunctionalRange::setMath(ASTNode* math)
 {
   if (mMath == math)
     {
+      // the math may have been modified in place
+      markDirty();
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else if (math == NULL)
     {
+      markDirty();
       delete mMath;
       mMath = NULL;
       return LIBSEDML_OPERATION_SUCCESS;
@@ -221,6 +226,7 @@ SedFunctionalRange::setMath(ASTNode* math)
     }
   else
     {
+      markDirty();
       delete mMath;
       mMath = (math != NULL) ?
               math->deepCopy() : NULL;
@@ -240,6 +246,8 @@ SedFunctionalRange::setMath(ASTNode* math)
 int
 SedFunctionalRange::unsetRange()
 {
+  markDirty();
+
   mRange.erase();
 
   if (mRange.empty() == true)
@@ -259,6 +267,8 @@ SedFunctionalRange::unsetRange()
 int
 SedFunctionalRange::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -632,8 +642,66 @@ SedFunctionalRange::writeElements(XMLOutputStream& stream) const
 bool
 SedFunctionalRange::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mVariables.accept(v);
+      mParameters.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedFunctionalRange::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedRange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedFunctionalRange));
+  usage.addString(mRange);
+  usage.addMath(mMath);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedFunctionalRange::getNumChildObjects() const
+{
+  return SedRange::getNumChildObjects() + 2;
+}
+
 
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedFunctionalRange::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedRange::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedRange::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mVariables;
+    case 1:
+      return &mParameters;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -912,6 +980,7 @@ SedListOfFunctionalRanges::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedFunctionalRange*>(item);
@@ -1067,6 +1136,9 @@ SedFunctionalRange_getMath(SedFunctionalRange_t * sfr)
   if (sfr == NULL)
     return NULL;
 
+  /* the caller may modify the math in place */
+  sfr->markDirty();
+
   return (ASTNode_t*)sfr->getMath();
 }
 
@@ -0,0 +1,244 @@
+/**
+ * @file    SedIterator.cpp
+ * @brief   Implementation of the Sed tree iterators
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedIterator.h>
+#include <sedml/SedBase.h>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+SedTreeIterator::SedTreeIterator(const SedBase* current) :
+  mCurrent(current)
+  , mDepth(0)
+{
+}
+
+
+/*
+ * Moves the iterator to the first child of the current object.
+ */
+void
+SedTreeIterator::descend()
+{
+  Frame frame;
+  frame.node = mCurrent;
+  frame.index = 0;
+
+  if (mDepth < SEDML_TREE_ITERATOR_DEPTH)
+    mFrames[mDepth] = frame;
+  else
+    mDeepFrames.push_back(frame);
+
+  ++mDepth;
+  mCurrent = mCurrent->getChildObject(0);
+}
+
+
+/*
+ * Moves the iterator to the first object without children below the
+ * current object.
+ */
+void
+SedTreeIterator::descendToLeaf()
+{
+  while (mCurrent->getNumChildObjects() > 0)
+    {
+      descend();
+    }
+}
+
+
+/*
+ * Returns the last step of the path.
+ */
+SedTreeIterator::Frame&
+SedTreeIterator::top()
+{
+  if (mDepth > SEDML_TREE_ITERATOR_DEPTH)
+    return mDeepFrames.back();
+
+  return mFrames[mDepth - 1];
+}
+
+
+/*
+ * Removes the last step of the path.
+ */
+void
+SedTreeIterator::pop()
+{
+  if (mDepth > SEDML_TREE_ITERATOR_DEPTH)
+    mDeepFrames.pop_back();
+
+  --mDepth;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+SedPreOrderIterator::SedPreOrderIterator() :
+  SedTreeIterator()
+{
+}
+
+
+SedPreOrderIterator::SedPreOrderIterator(const SedBase* root) :
+  SedTreeIterator(root)
+{
+}
+
+
+/*
+ * Moves this iterator to the next object of the walk: the first child of
+ * the current object if it has one, otherwise the next sibling of the
+ * closest ancestor that has one.
+ */
+SedPreOrderIterator&
+SedPreOrderIterator::operator++()
+{
+  if (mCurrent == NULL) return *this;
+
+  if (mCurrent->getNumChildObjects() > 0)
+    descend();
+  else
+    skipChildren();
+
+  return *this;
+}
+
+
+SedPreOrderIterator
+SedPreOrderIterator::operator++(int)
+{
+  SedPreOrderIterator copy(*this);
+  ++(*this);
+  return copy;
+}
+
+
+/*
+ * Moves this iterator to the next object that is not a descendant of the
+ * current object.
+ */
+void
+SedPreOrderIterator::skipChildren()
+{
+  while (mDepth > 0)
+    {
+      Frame& frame = top();
+
+      if (frame.index + 1 < frame.node->getNumChildObjects())
+        {
+          ++frame.index;
+          mCurrent = frame.node->getChildObject(frame.index);
+          return;
+        }
+
+      pop();
+    }
+
+  mCurrent = NULL;
+}
+
+
+SedPostOrderIterator::SedPostOrderIterator() :
+  SedTreeIterator()
+{
+}
+
+
+SedPostOrderIterator::SedPostOrderIterator(const SedBase* root) :
+  SedTreeIterator(root)
+{
+  if (mCurrent != NULL)
+    descendToLeaf();
+}
+
+
+/*
+ * Moves this iterator to the next object of the walk: the first leaf below
+ * the next sibling of the current object if it has one, otherwise its
+ * parent.
+ */
+SedPostOrderIterator&
+SedPostOrderIterator::operator++()
+{
+  if (mCurrent == NULL) return *this;
+
+  if (mDepth == 0)
+    {
+      mCurrent = NULL;
+      return *this;
+    }
+
+  Frame& frame = top();
+
+  if (frame.index + 1 < frame.node->getNumChildObjects())
+    {
+      ++frame.index;
+      mCurrent = frame.node->getChildObject(frame.index);
+      descendToLeaf();
+    }
+  else
+    {
+      mCurrent = frame.node;
+      pop();
+    }
+
+  return *this;
+}
+
+
+SedPostOrderIterator
+SedPostOrderIterator::operator++(int)
+{
+  SedPostOrderIterator copy(*this);
+  ++(*this);
+  return copy;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,432 @@
+/**
+ * @file    SedIterator.h
+ * @brief   Iteration over the objects of a Sed subtree
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedPreOrderIterator
+ * @ingroup Core
+ * @brief Iterates over the objects of a Sed subtree.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * SedPreOrderIterator and SedPostOrderIterator walk a Sed object and all
+ * the objects nested in it, in the order in which they are written.  A
+ * pre-order walk returns each object before its children, a post-order
+ * walk after them.  The lists held by an object (SedListOf) are returned
+ * like any other object.
+ *
+ * The iterators walk the tree in place: they keep the path from the root
+ * to the current object, and do not allocate memory unless the tree is
+ * more than #SEDML_TREE_ITERATOR_DEPTH levels deep, which no SED-ML
+ * document is.  The tree must not be modified while it is walked.
+ *
+ * The ranges returned by SedBase::preOrder(), SedBase::postOrder() and
+ * SedBase::elements() are the easiest way to use the iterators:
+ * @code{.cpp}
+ * SedElementRange<SedVariable> variables = doc->elements<SedVariable>();
+ * for (SedElementRange<SedVariable>::iterator it = variables.begin();
+ *      it != variables.end(); ++it)
+ *   {
+ *     std::cout << (*it)->getId() << std::endl;
+ *   }
+ * @endcode
+ */
+
+#ifndef SedIterator_h
+#define SedIterator_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+/**
+ * The number of levels of a tree the iterators walk without allocating
+ * memory.
+ */
+#define SEDML_TREE_ITERATOR_DEPTH 16
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+
+
+/** @cond doxygen-libsedml-internal */
+
+/**
+ * The state shared by the pre-order and post-order iterators: the object
+ * the iterator is on, and the path leading to it from the root.
+ */
+class LIBSEDML_EXTERN SedTreeIterator
+{
+public:
+
+  /**
+   * Returns the object this iterator is on, or @c NULL at the end.
+   */
+  const SedBase* get() const { return mCurrent; }
+
+
+  /**
+   * Returns @c true if both iterators are on the same object.
+   */
+  bool operator==(const SedTreeIterator& rhs) const
+  { return mCurrent == rhs.mCurrent; }
+
+
+  /**
+   * Returns @c true if the iterators are on different objects.
+   */
+  bool operator!=(const SedTreeIterator& rhs) const
+  { return mCurrent != rhs.mCurrent; }
+
+
+protected:
+
+  /**
+   * A step of the path from the root: an ancestor of the current object,
+   * and the index of the child of that ancestor that leads to it.
+   */
+  struct Frame
+  {
+    const SedBase* node;
+    unsigned int   index;
+  };
+
+
+  SedTreeIterator(const SedBase* current = NULL);
+
+
+  /**
+   * Moves the iterator to the first child of the current object, which
+   * must have one.
+   */
+  void descend();
+
+
+  /**
+   * Moves the iterator to the first object without children below the
+   * current object.
+   */
+  void descendToLeaf();
+
+
+  /**
+   * Returns the last step of the path.
+   */
+  Frame& top();
+
+
+  /**
+   * Removes the last step of the path.
+   */
+  void pop();
+
+
+  const SedBase*     mCurrent;
+  unsigned int       mDepth;
+  Frame              mFrames[SEDML_TREE_ITERATOR_DEPTH];
+  std::vector<Frame> mDeepFrames;
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+class LIBSEDML_EXTERN SedPreOrderIterator : public SedTreeIterator
+{
+public:
+
+  /**
+   * Creates an iterator at the end of any walk.
+   */
+  SedPreOrderIterator();
+
+
+  /**
+   * Creates an iterator on @p root, the first object of a pre-order walk
+   * of the subtree of @p root.
+   *
+   * @param root the object whose subtree is walked; may be @c NULL.
+   */
+  explicit SedPreOrderIterator(const SedBase* root);
+
+
+  /**
+   * Moves this iterator to the next object of the walk.
+   */
+  SedPreOrderIterator& operator++();
+
+
+  /**
+   * Moves this iterator to the next object of the walk, and returns a copy
+   * of it made before the move.
+   */
+  SedPreOrderIterator operator++(int);
+
+
+  /**
+   * Moves this iterator past the objects below the current object, to the
+   * next object that is not one of its descendants.
+   */
+  void skipChildren();
+};
+
+
+/**
+ * @class SedPostOrderIterator
+ * @ingroup Core
+ * @brief Iterates over the objects of a Sed subtree, children first.
+ *
+ * See SedPreOrderIterator.
+ */
+class LIBSEDML_EXTERN SedPostOrderIterator : public SedTreeIterator
+{
+public:
+
+  /**
+   * Creates an iterator at the end of any walk.
+   */
+  SedPostOrderIterator();
+
+
+  /**
+   * Creates an iterator on the first object of a post-order walk of the
+   * subtree of @p root.
+   *
+   * @param root the object whose subtree is walked; may be @c NULL.
+   */
+  explicit SedPostOrderIterator(const SedBase* root);
+
+
+  /**
+   * Moves this iterator to the next object of the walk.
+   */
+  SedPostOrderIterator& operator++();
+
+
+  /**
+   * Moves this iterator to the next object of the walk, and returns a copy
+   * of it made before the move.
+   */
+  SedPostOrderIterator operator++(int);
+};
+
+
+#ifndef SWIG
+
+/** @cond doxygen-libsedml-internal */
+
+/**
+ * Converts the objects met by a walk to class T.  The walks hold const
+ * pointers; only a walk started from a non-const root hands out non-const
+ * objects, so a const root never yields a mutable pointer.
+ */
+template<class T>
+struct SedElementTraits
+{
+  typedef SedBase* root_type;
+
+  static T* cast(const SedBase* obj)
+  { return dynamic_cast<T*>(const_cast<SedBase*>(obj)); }
+};
+
+
+template<class T>
+struct SedElementTraits<const T>
+{
+  typedef const SedBase* root_type;
+
+  static const T* cast(const SedBase* obj)
+  { return dynamic_cast<const T*>(obj); }
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/**
+ * @class SedElementIterator
+ * @ingroup Core
+ * @brief Iterates over the objects of a Sed subtree that are of class T.
+ *
+ * Wraps a SedPreOrderIterator or a SedPostOrderIterator, skipping the
+ * objects that are not of class @p T or one of its subclasses.  @p T may
+ * be const-qualified.
+ */
+template<class T, class Iterator = SedPreOrderIterator>
+class SedElementIterator
+{
+public:
+
+  typedef std::forward_iterator_tag iterator_category;
+  typedef T*                        value_type;
+  typedef std::ptrdiff_t            difference_type;
+  typedef T**                       pointer;
+  typedef T*                        reference;
+
+
+  /**
+   * Creates an iterator at the end of any walk.
+   */
+  SedElementIterator() : mIt() { }
+
+
+  /**
+   * Creates an iterator on the first object of class @p T from @p it on.
+   */
+  explicit SedElementIterator(const Iterator& it) : mIt(it) { skip(); }
+
+
+  /**
+   * Returns the object this iterator is on.
+   */
+  T* operator*() const { return cast(mIt.get()); }
+
+
+  /**
+   * Moves this iterator to the next object of class @p T.
+   */
+  SedElementIterator& operator++() { ++mIt; skip(); return *this; }
+
+
+  /**
+   * Moves this iterator to the next object of class @p T, and returns a
+   * copy of it made before the move.
+   */
+  SedElementIterator operator++(int)
+  { SedElementIterator copy(*this); ++(*this); return copy; }
+
+
+  bool operator==(const SedElementIterator& rhs) const
+  { return mIt == rhs.mIt; }
+
+
+  bool operator!=(const SedElementIterator& rhs) const
+  { return mIt != rhs.mIt; }
+
+
+  /**
+   * Returns the underlying iterator.
+   */
+  Iterator& base() { return mIt; }
+
+
+private:
+
+  static T* cast(const SedBase* obj)
+  { return SedElementTraits<T>::cast(obj); }
+
+  void skip()
+  { while (mIt.get() != NULL && cast(mIt.get()) == NULL) ++mIt; }
+
+  Iterator mIt;
+};
+
+
+/**
+ * @class SedElementRange
+ * @ingroup Core
+ * @brief The objects of a Sed subtree that are of class T.
+ *
+ * A range over the subtree of an object, including the object itself;
+ * returned by SedBase::preOrder(), SedBase::postOrder() and
+ * SedBase::elements().
+ */
+template<class T, class Iterator = SedPreOrderIterator>
+class SedElementRange
+{
+public:
+
+  typedef SedElementIterator<T, Iterator> iterator;
+  typedef SedElementIterator<T, Iterator> const_iterator;
+
+
+  /**
+   * Creates the range of the objects of class @p T in the subtree of
+   * @p root, which must be const if @p T is.
+   */
+  explicit SedElementRange(typename SedElementTraits<T>::root_type root)
+    : mRoot(root) { }
+
+
+  /**
+   * Returns an iterator on the first object of the range.
+   */
+  iterator begin() const { return iterator(Iterator(mRoot)); }
+
+
+  /**
+   * Returns an iterator past the last object of the range.
+   */
+  iterator end() const { return iterator(); }
+
+
+  /**
+   * Returns @c true if the range has no object.
+   */
+  bool empty() const { return begin() == end(); }
+
+
+  /**
+   * Returns the number of objects in the range; this walks the subtree.
+   */
+  unsigned int size() const
+  {
+    unsigned int count = 0;
+    for (iterator it = begin(); it != end(); ++it) ++count;
+    return count;
+  }
+
+
+private:
+
+  const SedBase* mRoot;
+};
+
+#endif  /* !SWIG */
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedIterator_h */
@@ -0,0 +1,708 @@
+/**
+ * @file    SedJSONReader.cpp
+ * @brief   Implements the methods to read SED-ML documents from JSON
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <streambuf>
+#include <string>
+
+#include <sedml/common/common.h>
+#include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLError.h>
+#include <sbml/xml/XMLErrorLog.h>
+
+#include <sedml/SedErrorLog.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedJSONReader.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Stream buffer reading a string held elsewhere, so that a JSON string is
+ * read like a file without being copied.
+ */
+class JSONStringSource : public std::streambuf
+{
+public:
+
+  JSONStringSource(const std::string& json)
+  {
+    char* begin = const_cast<char*>(json.data());
+    setg(begin, begin, begin + json.size());
+  }
+};
+
+
+/*
+ * Single pass parser translating the JSON written by SedJSONWriter into
+ * the XML of the elements it describes, as the JSON is read.
+ *
+ * XMLInputStream only reads XML text, so this is what the objects of the
+ * document are read from; the JSON is neither loaded nor copied, and the
+ * XML is parsed into tokens on demand while the document reads them.
+ * Namespace prefixes are left for the XML parser to resolve.
+ */
+class JSONTranslator
+{
+public:
+
+  JSONTranslator(std::streambuf& json, std::string& xml)
+    : mJson(json)
+    , mXml(xml)
+    , mLine(1)
+    , mColumn(1)
+  {
+  }
+
+
+  /*
+   * Translates the root element.  @return true on success.
+   */
+  bool translate()
+  {
+    mXml = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+    skipWhitespace();
+
+    if (!parseNode(true)) return false;
+
+    skipWhitespace();
+
+    if (peek() != EOF)
+      return fail("unexpected content after the root element");
+
+    return true;
+  }
+
+
+  const std::string& getError() const
+  {
+    return mError;
+  }
+
+
+  unsigned int getLine() const
+  {
+    return mLine;
+  }
+
+
+  unsigned int getColumn() const
+  {
+    return mColumn;
+  }
+
+
+private:
+
+  int peek()
+  {
+    return mJson.sgetc();
+  }
+
+
+  int get()
+  {
+    int c = mJson.sbumpc();
+
+    if (c == '\n')
+      {
+        ++mLine;
+        mColumn = 1;
+      }
+    else if (c != EOF)
+      {
+        ++mColumn;
+      }
+
+    return c;
+  }
+
+
+  bool fail(const std::string& message)
+  {
+    if (mError.empty()) mError = message;
+
+    return false;
+  }
+
+
+  void skipWhitespace()
+  {
+    int c = peek();
+
+    while (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+      {
+        get();
+        c = peek();
+      }
+  }
+
+
+  bool expect(char c)
+  {
+    skipWhitespace();
+
+    if (peek() != static_cast<unsigned char>(c))
+      return fail(std::string("expected '") + c + "'");
+
+    get();
+    return true;
+  }
+
+
+  /*
+   * Consumes a ',' and returns true, or consumes the given closing
+   * character and returns false.  Sets mError on anything else.
+   */
+  bool nextMember(char close)
+  {
+    skipWhitespace();
+
+    int c = peek();
+
+    if (c == ',')
+      {
+        get();
+        return true;
+      }
+
+    if (c == static_cast<unsigned char>(close))
+      {
+        get();
+        return false;
+      }
+
+    fail(std::string("expected ',' or '") + close + "'");
+    return false;
+  }
+
+
+  /*
+   * Consumes the given closing character if it comes next.
+   */
+  bool isEmpty(char close)
+  {
+    skipWhitespace();
+
+    if (peek() != static_cast<unsigned char>(close)) return false;
+
+    get();
+    return true;
+  }
+
+
+  bool parseHex4(unsigned long& value)
+  {
+    value = 0;
+
+    for (int n = 0; n < 4; ++n)
+      {
+        int c = get();
+
+        if (c >= '0' && c <= '9')
+          value = value * 16 + (c - '0');
+        else if (c >= 'a' && c <= 'f')
+          value = value * 16 + (c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+          value = value * 16 + (c - 'A' + 10);
+        else
+          return fail(c == EOF ? "truncated unicode escape" :
+                      "invalid unicode escape");
+      }
+
+    return true;
+  }
+
+
+  static void appendUTF8(std::string& out, unsigned long cp)
+  {
+    if (cp < 0x80)
+      out += static_cast<char>(cp);
+    else if (cp < 0x800)
+      {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+      }
+    else if (cp < 0x10000)
+      {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+      }
+    else
+      {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+      }
+  }
+
+
+  bool parseString(std::string& value)
+  {
+    if (!expect('"')) return false;
+
+    value.clear();
+
+    for (int c = get(); c != EOF; c = get())
+      {
+        if (c == '"') return true;
+
+        if (c != '\\')
+          {
+            value += static_cast<char>(c);
+            continue;
+          }
+
+        c = get();
+
+        switch (c)
+          {
+            case '"':  value += '"';  break;
+            case '\\': value += '\\'; break;
+            case '/':  value += '/';  break;
+            case 'b':  value += '\b'; break;
+            case 'f':  value += '\f'; break;
+            case 'n':  value += '\n'; break;
+            case 'r':  value += '\r'; break;
+            case 't':  value += '\t'; break;
+
+            case 'u':
+              {
+                unsigned long cp;
+
+                if (!parseHex4(cp)) return false;
+
+                if (cp == 0) return fail("invalid character");
+
+                if (cp >= 0xDC00 && cp < 0xE000)
+                  return fail("unpaired low surrogate");
+
+                // combine surrogate pairs
+                if (cp >= 0xD800 && cp < 0xDC00)
+                  {
+                    unsigned long low;
+
+                    if (get() != '\\' || get() != 'u')
+                      return fail("unpaired high surrogate");
+
+                    if (!parseHex4(low)) return false;
+
+                    if (low < 0xDC00 || low >= 0xE000)
+                      return fail("invalid low surrogate");
+
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                  }
+
+                appendUTF8(value, cp);
+                break;
+              }
+
+            case EOF:
+              return fail("unterminated string");
+
+            default:
+              return fail("invalid escape sequence");
+          }
+      }
+
+    return fail("unterminated string");
+  }
+
+
+  /*
+   * Reads an element or attribute name, which is copied to the XML as it
+   * is and so must not contain markup.
+   */
+  bool parseName(std::string& name)
+  {
+    if (!parseString(name)) return false;
+
+    if (name.empty() ||
+        name.find_first_of(" \t\n\r<>&\"'/=!?") != std::string::npos)
+      return fail("invalid name \"" + name + "\"");
+
+    return true;
+  }
+
+
+  /*
+   * Appends value to the XML, escaped for use as character data or, if
+   * inAttribute, as the value of an attribute.
+   */
+  void appendEscaped(const std::string& value, bool inAttribute)
+  {
+    for (std::string::const_iterator it = value.begin(); it != value.end();
+         ++it)
+      {
+        switch (*it)
+          {
+            case '&':  mXml += "&amp;"; break;
+            case '<':  mXml += "&lt;";  break;
+            case '>':  mXml += "&gt;";  break;
+            case '\r': mXml += "&#13;"; break;
+
+            // XML parsers normalize whitespace in attribute values
+            case '"':  mXml += inAttribute ? "&quot;" : "\""; break;
+            case '\t': mXml += inAttribute ? "&#9;"   : "\t"; break;
+            case '\n': mXml += inAttribute ? "&#10;"  : "\n"; break;
+
+            default:
+              mXml += *it;
+          }
+      }
+  }
+
+
+  /*
+   * Translates an element object or a text object.
+   */
+  bool parseNode(bool isRoot)
+  {
+    if (!expect('{')) return false;
+
+    if (isEmpty('}')) return fail("empty object");
+
+    std::string qname;
+    bool named   = false;
+    bool started = false;
+    bool text    = false;
+
+    do
+      {
+        if (!parseString(mKey) || !expect(':')) return false;
+
+        if (mKey == "name")
+          {
+            if (named) return fail("duplicate name");
+
+            if (text) return fail("text object with a name");
+
+            if (!parseName(qname)) return false;
+
+            mXml += '<';
+            mXml += qname;
+            named = true;
+          }
+        else if (mKey == "text")
+          {
+            if (isRoot) return fail("the root has to be an element");
+
+            if (named || text) return fail("text object with a name");
+
+            if (!parseString(mValue)) return false;
+
+            appendEscaped(mValue, false);
+            text = true;
+          }
+        else if (mKey == "attributes")
+          {
+            if (!named) return fail("\"name\" has to precede \"attributes\"");
+
+            if (started)
+              return fail("\"attributes\" have to precede \"children\"");
+
+            if (!parseAttributes()) return false;
+          }
+        else if (mKey == "children")
+          {
+            if (!named) return fail("\"name\" has to precede \"children\"");
+
+            if (started) return fail("duplicate children");
+
+            mXml += '>';
+            started = true;
+
+            if (!parseChildren()) return false;
+          }
+        else
+          {
+            return fail("unknown member \"" + mKey + "\"");
+          }
+      }
+    while (nextMember('}'));
+
+    if (!mError.empty()) return false;
+
+    if (started)
+      {
+        mXml += "</";
+        mXml += qname;
+        mXml += '>';
+      }
+    else if (named)
+      {
+        mXml += "/>";
+      }
+
+    return true;
+  }
+
+
+  /*
+   * Translates the attributes of an element, including its namespace
+   * declarations.
+   */
+  bool parseAttributes()
+  {
+    if (!expect('{')) return false;
+
+    if (isEmpty('}')) return true;
+
+    do
+      {
+        if (!parseName(mKey) || !expect(':') || !parseString(mValue))
+          return false;
+
+        mXml += ' ';
+        mXml += mKey;
+        mXml += "=\"";
+        appendEscaped(mValue, true);
+        mXml += '"';
+      }
+    while (nextMember('}'));
+
+    return mError.empty();
+  }
+
+
+  bool parseChildren()
+  {
+    if (!expect('[')) return false;
+
+    if (isEmpty(']')) return true;
+
+    do
+      {
+        if (!parseNode(false)) return false;
+      }
+    while (nextMember(']'));
+
+    return mError.empty();
+  }
+
+
+  std::streambuf& mJson;
+  std::string&    mXml;
+  unsigned int    mLine;
+  unsigned int    mColumn;
+  std::string     mError;
+
+  /* the member name and string value read last */
+  std::string     mKey;
+  std::string     mValue;
+};
+
+
+/*
+ * Reads the document described by the JSON read from the given buffer.
+ */
+static SedDocument*
+readJSON(std::streambuf& json)
+{
+  SedDocument* d = new SedDocument();
+  std::string xml;
+  JSONTranslator translator(json, xml);
+
+  if (!translator.translate())
+    {
+      d->getErrorLog()->add(XMLError(BadlyFormedXML,
+                                     "Invalid JSON: " + translator.getError(),
+                                     translator.getLine(),
+                                     translator.getColumn()));
+      return d;
+    }
+
+  // the element and attribute values are interpreted by the regular
+  // readers of each class, exactly as when reading the XML with SedReader
+  XMLInputStream stream(xml.c_str(), false, "", d->getErrorLog());
+
+  d->read(stream);
+  d->getErrorLog()->updateIndex();
+
+  return d;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedJSONReader.
+ */
+SedJSONReader::SedJSONReader()
+{
+}
+
+
+/*
+ * Destroys this SedJSONReader.
+ */
+SedJSONReader::~SedJSONReader()
+{
+}
+
+
+/*
+ * Reads an Sed document from the given JSON file.
+ */
+SedDocument*
+SedJSONReader::readSedML(const std::string& filename)
+{
+  std::ifstream stream(filename.c_str(), std::ios::in | std::ios::binary);
+
+  if (!stream)
+    {
+      SedDocument* d = new SedDocument();
+      d->getErrorLog()->logError(XMLFileUnreadable);
+      return d;
+    }
+
+  return readJSON(*stream.rdbuf());
+}
+
+
+/*
+ * Reads an Sed document from the given JSON string.
+ */
+SedDocument*
+SedJSONReader::readSedMLFromString(const std::string& json)
+{
+  JSONStringSource source(json);
+
+  return readJSON(source);
+}
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedJSONReader and returns a pointer to it.
+ */
+LIBSEDML_EXTERN
+SedJSONReader_t *
+SedJSONReader_create()
+{
+  return new(nothrow) SedJSONReader;
+}
+
+
+/**
+ * Frees the given SedJSONReader.
+ */
+LIBSEDML_EXTERN
+void
+SedJSONReader_free(SedJSONReader_t *sr)
+{
+  delete sr;
+}
+
+
+/**
+ * Reads an Sed document from the given JSON file.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedJSONReader_readSedML(SedJSONReader_t *sr, const char *filename)
+{
+  if (sr != NULL)
+    return (filename != NULL) ? sr->readSedML(filename) : sr->readSedML("");
+  else
+    return NULL;
+}
+
+
+/**
+ * Reads an Sed document from the given JSON string.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedJSONReader_readSedMLFromString(SedJSONReader_t *sr, const char *json)
+{
+  if (sr != NULL)
+    return (json != NULL) ? sr->readSedMLFromString(json) :
+           sr->readSedMLFromString("");
+  else
+    return NULL;
+}
+
+
+/**
+ * Reads an Sed document from the given JSON file.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+readSedMLFromJSON(const char *filename)
+{
+  SedJSONReader sr;
+  return (filename != NULL) ? sr.readSedML(filename) : sr.readSedML("");
+}
+
+
+/**
+ * Reads an Sed document from the given JSON string.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+readSedMLFromJSONString(const char *json)
+{
+  SedJSONReader sr;
+  return (json != NULL) ? sr.readSedMLFromString(json) :
+         sr.readSedMLFromString("");
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
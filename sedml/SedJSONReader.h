@@ -0,0 +1,190 @@
+/**
+ * @file    SedJSONReader.h
+ * @brief   Reads an Sed Document from JSON
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedJSONReader
+ * @ingroup Core
+ * @brief Methods for reading Sed from JSON files and text strings.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * The SedJSONReader class reads the JSON representation written by
+ * SedJSONWriter and returns the SedDocument it describes.  Each element
+ * object must list its "name" before its "attributes" and "children", as
+ * SedJSONWriter does.  The JSON is read incrementally and translated into
+ * the XML it describes, which the objects of the document then read
+ * through an XMLInputStream as it is parsed; the element and attribute
+ * values are thus checked and interpreted exactly as by SedReader, and
+ * problems are logged in the error log of the document returned.  Malformed JSON is reported as a
+ * BadlyFormedXML error giving the line and column of the problem.
+ */
+
+#ifndef SedJSONReader_h
+#define SedJSONReader_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+class LIBSEDML_EXTERN SedJSONReader
+{
+public:
+
+  /**
+   * Creates a new SedJSONReader.
+   */
+  SedJSONReader();
+
+
+  /**
+   * Destroys this SedJSONReader.
+   */
+  virtual ~SedJSONReader();
+
+
+  /**
+   * Reads an Sed document from a JSON file.
+   *
+   * If the file named @p filename does not exist or its content is not
+   * valid, one or more errors will be logged with the SedDocument object
+   * returned by this method.
+   *
+   * @param filename the name or full pathname of the file to be read.
+   *
+   * @return a pointer to the SedDocument created from the JSON content.
+   */
+  SedDocument* readSedML(const std::string& filename);
+
+
+  /**
+   * Reads an Sed document from the given JSON string.
+   *
+   * @param json a string containing the JSON representation of a
+   * SedDocument.
+   *
+   * @return a pointer to the SedDocument created from the JSON content.
+   */
+  SedDocument* readSedMLFromString(const std::string& json);
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedJSONReader and returns a pointer to it.
+ */
+LIBSEDML_EXTERN
+SedJSONReader_t *
+SedJSONReader_create(void);
+
+/**
+ * Frees the given SedJSONReader.
+ */
+LIBSEDML_EXTERN
+void
+SedJSONReader_free(SedJSONReader_t *sr);
+
+/**
+ * Reads an Sed document from the given JSON file.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedJSONReader_readSedML(SedJSONReader_t *sr, const char *filename);
+
+/**
+ * Reads an Sed document from the given JSON string.
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+SedJSONReader_readSedMLFromString(SedJSONReader_t *sr, const char *json);
+
+/**
+ * Reads an Sed document from the given JSON file.  This convenience
+ * function is functionally equivalent to:
+ *
+ *   SedJSONReader_readSedML(SedJSONReader_create(), filename);
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+readSedMLFromJSON(const char *filename);
+
+/**
+ * Reads an Sed document from the given JSON string.  This convenience
+ * function is functionally equivalent to:
+ *
+ *   SedJSONReader_readSedMLFromString(SedJSONReader_create(), json);
+ *
+ * @return a pointer to the SedDocument read.
+ */
+LIBSEDML_EXTERN
+SedDocument_t *
+readSedMLFromJSONString(const char *json);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#endif  /* SedJSONReader_h */
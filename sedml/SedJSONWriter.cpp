@@ -0,0 +1,874 @@
+/**
+ * @file    SedJSONWriter.cpp
+ * @brief   Implements the methods to write SED-ML documents as JSON
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <cstdlib>
+#include <ios>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+#include <vector>
+
+#include <sedml/common/common.h>
+#include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLAttributes.h>
+#include <sbml/xml/XMLNamespaces.h>
+
+#include <sedml/SedErrorLog.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedJSONWriter.h>
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Appends value to out as a quoted JSON string.
+ */
+static void
+writeJSONString(std::ostream& out, const std::string& value)
+{
+  static const char* hex = "0123456789abcdef";
+
+  out << '"';
+
+  for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+    {
+      unsigned char c = static_cast<unsigned char>(*it);
+
+      switch (c)
+        {
+          case '"':  out << "\\\""; break;
+          case '\\': out << "\\\\"; break;
+          case '\n': out << "\\n";  break;
+          case '\r': out << "\\r";  break;
+          case '\t': out << "\\t";  break;
+
+          default:
+            if (c < 0x20)
+              out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+            else
+              out << *it;
+        }
+    }
+
+  out << '"';
+}
+
+
+/*
+ * Appends the UTF-8 encoding of the given code point to out.
+ */
+static void
+appendUTF8(std::string& out, unsigned long cp)
+{
+  if (cp < 0x80)
+    {
+      out += static_cast<char>(cp);
+    }
+  else if (cp < 0x800)
+    {
+      out += static_cast<char>(0xC0 | (cp >> 6));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  else if (cp < 0x10000)
+    {
+      out += static_cast<char>(0xE0 | (cp >> 12));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+  else
+    {
+      out += static_cast<char>(0xF0 | (cp >> 18));
+      out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+
+/*
+ * Replaces the XML character and entity references in value by the
+ * characters they stand for.
+ */
+static std::string
+decodeEntities(const std::string& value)
+{
+  if (value.find('&') == std::string::npos) return value;
+
+  std::string result;
+  result.reserve(value.size());
+
+  for (size_t n = 0; n < value.size(); ++n)
+    {
+      size_t end;
+
+      if (value[n] != '&' || (end = value.find(';', n)) == std::string::npos)
+        {
+          result += value[n];
+          continue;
+        }
+
+      std::string entity = value.substr(n + 1, end - n - 1);
+
+      if      (entity == "amp")  result += '&';
+      else if (entity == "lt")   result += '<';
+      else if (entity == "gt")   result += '>';
+      else if (entity == "quot") result += '"';
+      else if (entity == "apos") result += '\'';
+      else if (entity.size() > 1 && entity[0] == '#')
+        {
+          bool isHex = (entity[1] == 'x' || entity[1] == 'X');
+          appendUTF8(result, strtoul(entity.c_str() + (isHex ? 2 : 1), NULL,
+                                     isHex ? 16 : 10));
+        }
+      else
+        {
+          // not a reference we know about, keep it as it is
+          result += value.substr(n, end - n + 1);
+        }
+
+      n = end;
+    }
+
+  return result;
+}
+
+
+/*
+ * Writes the JSON representation of SedJSONWriter to a stream.
+ *
+ * The elements of the Sed objects, and their notes and annotations, are
+ * written directly through startItem(), endAttributes(), endItem() and
+ * writeNode().  As a stream buffer it receives whatever XMLOutputStream
+ * writes in between: the attributes of the element started last, and
+ * complete XML elements libSBML writes on behalf of an object, such as
+ * MathML.  That output is tokenized as it arrives, without ever holding
+ * more than the current tag, and is assumed to be well-formed.
+ *
+ * Character data consisting of whitespace only is the indentation
+ * XMLOutputStream adds and is dropped, and CDATA sections become
+ * character data; declarations, processing instructions, comments and
+ * document type declarations have no representation in a SedDocument and
+ * are skipped.
+ */
+class SedJSONTranscoder : public std::streambuf
+{
+public:
+
+  SedJSONTranscoder(std::ostream& out)
+    : mOut(out)
+    , mState(Text)
+    , mQuote('"')
+    , mAttributesOpen(false)
+    , mSkipDeclaration(false)
+    , mNumRoots(0)
+  {
+  }
+
+
+  /*
+   * @return true if the XML seen so far formed exactly one complete
+   * element.
+   */
+  bool finish()
+  {
+    return mState == Text && mOpen.empty() && mNumRoots == 1;
+  }
+
+
+  /*
+   * Starts the object of an element whose attributes are written to this
+   * buffer next.
+   */
+  void startItem(const std::string& name)
+  {
+    beginElement(name);
+    mState = InTag;
+  }
+
+
+  /*
+   * Ends the attributes of the element started last.
+   */
+  void endAttributes()
+  {
+    if (mState != InTag) return;
+
+    openContent();
+    mState = Text;
+  }
+
+
+  /*
+   * Ends the object of the element started last.
+   */
+  void endItem()
+  {
+    endAttributes();
+    endElement();
+  }
+
+
+  /*
+   * Writes the given node and its children, keeping all of its character
+   * data.  A node without a name only contributes its children.
+   */
+  void writeNode(const XMLNode& node)
+  {
+    if (node.isText())
+      {
+        flushText();
+        writeText(node.getCharacters());
+        return;
+      }
+
+    bool named = !node.getName().empty();
+
+    if (named)
+      {
+        const std::string& prefix = node.getPrefix();
+        beginElement(prefix.empty() ? node.getName() :
+                     prefix + ":" + node.getName());
+
+        const XMLNamespaces& namespaces = node.getNamespaces();
+
+        for (int n = 0; n < namespaces.getLength(); ++n)
+          {
+            const std::string& nsPrefix = namespaces.getPrefix(n);
+            writeAttribute(nsPrefix.empty() ? "xmlns" : "xmlns:" + nsPrefix,
+                           namespaces.getURI(n));
+          }
+
+        const XMLAttributes& attributes = node.getAttributes();
+
+        for (int n = 0; n < attributes.getLength(); ++n)
+          writeAttribute(attributes.getPrefixedName(n),
+                         attributes.getValue(n));
+
+        openContent();
+      }
+
+    for (unsigned int n = 0; n < node.getNumChildren(); ++n)
+      writeNode(node.getChild(n));
+
+    if (named) endElement();
+  }
+
+
+protected:
+
+  virtual int_type overflow(int_type c)
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      consume(traits_type::to_char_type(c));
+
+    return traits_type::not_eof(c);
+  }
+
+
+  virtual std::streamsize xsputn(const char* s, std::streamsize n)
+  {
+    for (std::streamsize i = 0; i < n; ++i) consume(s[i]);
+
+    return n;
+  }
+
+
+private:
+
+  enum State
+  {
+    Text, TagStart, StartName, EndName, InTag, AttrName, AttrEquals,
+    AttrValue, EmptyClose, Skip
+  };
+
+
+  static bool isSpace(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+
+  void consume(char c)
+  {
+    switch (mState)
+      {
+        case Text:
+          if (c == '<')
+            {
+              mChars += decodeEntities(mText);
+              mText.clear();
+              mState = TagStart;
+            }
+          else
+            mText += c;
+
+          break;
+
+        case TagStart:
+          mName.clear();
+
+          if (c == '/')
+            mState = EndName;
+          else if (c == '?' || c == '!')
+            {
+              mSkipDeclaration = (c == '?');
+              mSkipped.clear();
+              mState = Skip;
+            }
+          else
+            {
+              mName += c;
+              mState = StartName;
+            }
+
+          break;
+
+        case StartName:
+          if (isSpace(c) || c == '>' || c == '/')
+            {
+              beginElement(mName);
+              mState = InTag;
+              consume(c);
+            }
+          else
+            mName += c;
+
+          break;
+
+        case InTag:
+          if (c == '>')
+            {
+              openContent();
+              mState = Text;
+            }
+          else if (c == '/')
+            mState = EmptyClose;
+          else if (!isSpace(c))
+            {
+              mAttrName.assign(1, c);
+              mState = AttrName;
+            }
+
+          break;
+
+        case AttrName:
+          if (c == '=' || isSpace(c))
+            mState = AttrEquals;
+          else
+            mAttrName += c;
+
+          break;
+
+        case AttrEquals:
+          if (c == '"' || c == '\'')
+            {
+              mQuote = c;
+              mValue.clear();
+              mState = AttrValue;
+            }
+
+          break;
+
+        case AttrValue:
+          if (c == mQuote)
+            {
+              writeAttribute(mAttrName, decodeEntities(mValue));
+              mState = InTag;
+            }
+          else
+            mValue += c;
+
+          break;
+
+        case EmptyClose:
+          if (c == '>')
+            {
+              closeAttributes();
+              mOut << '}';
+              mState = Text;
+            }
+
+          break;
+
+        case EndName:
+          if (c == '>')
+            {
+              endElement();
+              mState = Text;
+            }
+
+          break;
+
+        case Skip:
+          mSkipped += c;
+
+          if (c == '>' && isSkipComplete())
+            {
+              // CDATA sections are character data taken literally
+              if (!mSkipDeclaration && mSkipped.compare(0, 7, "[CDATA[") == 0)
+                mChars.append(mSkipped, 7, mSkipped.size() - 10);
+
+              mState = Text;
+            }
+
+          break;
+      }
+  }
+
+
+  /*
+   * @return true if the '>' just added to mSkipped terminates the
+   * declaration, processing instruction or comment being skipped.
+   */
+  bool isSkipComplete() const
+  {
+    size_t len = mSkipped.size();
+
+    if (mSkipDeclaration)
+      return len >= 2 && mSkipped[len - 2] == '?';
+
+    // comments end with "-->" and CDATA sections with "]]>"
+    if (mSkipped.compare(0, 2, "--") == 0)
+      return len >= 5 && mSkipped.compare(len - 3, 3, "-->") == 0;
+
+    if (mSkipped.compare(0, 7, "[CDATA[") == 0)
+      return len >= 10 && mSkipped.compare(len - 3, 3, "]]>") == 0;
+
+    // other markup, such as a document type declaration, ends with the
+    // first '>' outside of its internal subset
+    size_t open = 0;
+
+    for (size_t n = 0; n < len; ++n)
+      {
+        if (mSkipped[n] == '[')
+          ++open;
+        else if (mSkipped[n] == ']' && open > 0)
+          --open;
+      }
+
+    return open == 0;
+  }
+
+
+  void writeSeparator()
+  {
+    if (mOpen.empty())
+      {
+        ++mNumRoots;
+        return;
+      }
+
+    if (!mOpen.back())
+      {
+        mOut << ",\"children\":[";
+        mOpen.back() = true;
+      }
+    else
+      {
+        mOut << ',';
+      }
+  }
+
+
+  /*
+   * Writes the character data received since the last tag as a text
+   * object, unless it is whitespace only.
+   */
+  void flushText()
+  {
+    if (!mText.empty())
+      {
+        mChars += decodeEntities(mText);
+        mText.clear();
+      }
+
+    if (mChars.find_first_not_of(" \t\n\r") != std::string::npos)
+      writeText(mChars);
+
+    mChars.clear();
+  }
+
+
+  /*
+   * Writes a text object; character data outside of the root element is
+   * dropped.
+   */
+  void writeText(const std::string& chars)
+  {
+    if (mOpen.empty() || chars.empty()) return;
+
+    writeSeparator();
+    mOut << "{\"text\":";
+    writeJSONString(mOut, chars);
+    mOut << '}';
+  }
+
+
+  void beginElement(const std::string& name)
+  {
+    flushText();
+    writeSeparator();
+    mOut << "{\"name\":";
+    writeJSONString(mOut, name);
+    mAttributesOpen = false;
+  }
+
+
+  void writeAttribute(const std::string& name, const std::string& value)
+  {
+    mOut << (mAttributesOpen ? "," : ",\"attributes\":{");
+    mAttributesOpen = true;
+
+    writeJSONString(mOut, name);
+    mOut << ':';
+    writeJSONString(mOut, value);
+  }
+
+
+  void closeAttributes()
+  {
+    if (mAttributesOpen) mOut << '}';
+
+    mAttributesOpen = false;
+  }
+
+
+  void openContent()
+  {
+    closeAttributes();
+    mOpen.push_back(false);
+  }
+
+
+  void endElement()
+  {
+    flushText();
+
+    if (mOpen.empty()) return;
+
+    if (mOpen.back()) mOut << ']';
+
+    mOut << '}';
+    mOpen.pop_back();
+  }
+
+
+  std::ostream&     mOut;
+  State             mState;
+  char              mQuote;
+  bool              mAttributesOpen;
+  bool              mSkipDeclaration;
+  unsigned int      mNumRoots;
+
+  std::string       mName;
+  std::string       mAttrName;
+  std::string       mValue;
+  /* the raw character data since the last tag, and the decoded character
+   * data not yet written */
+  std::string       mText;
+  std::string       mChars;
+  std::string       mSkipped;
+
+  /* one entry per open element: whether it has children written yet */
+  std::vector<bool> mOpen;
+};
+
+
+
+/*
+ * Creates a stream writing XML to xml, whose buffer is json.
+ */
+SedJSONOutputStream::SedJSONOutputStream(std::ostream& xml,
+                                         SedJSONTranscoder& json)
+  : XMLOutputStream(xml, "UTF-8", false)
+  , mJSON(json)
+{
+  setAutoIndent(false);
+}
+
+
+/*
+ * Starts the object of an element, whose attributes are written next.
+ */
+void
+SedJSONOutputStream::startItem(const std::string& name,
+                               const std::string& prefix)
+{
+  mJSON.startItem(prefix.empty() ? name : prefix + ":" + name);
+}
+
+
+/*
+ * Ends the attributes of the element started last.
+ */
+void
+SedJSONOutputStream::endItemAttributes()
+{
+  mJSON.endAttributes();
+}
+
+
+/*
+ * Ends the object of the element started last.
+ */
+void
+SedJSONOutputStream::endItem()
+{
+  mJSON.endItem();
+}
+
+
+/*
+ * Writes the given XML node and its children.
+ */
+void
+SedJSONOutputStream::writeNode(const XMLNode& node)
+{
+  mJSON.writeNode(node);
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedJSONWriter.
+ */
+SedJSONWriter::SedJSONWriter()
+{
+}
+
+
+/*
+ * Destroys this SedJSONWriter.
+ */
+SedJSONWriter::~SedJSONWriter()
+{
+}
+
+
+/*
+ * Writes the given Sed document as JSON to filename.
+ *
+ * @return true on success and false if the filename could not be opened
+ * for writing.
+ */
+bool
+SedJSONWriter::writeSedML(const SedDocument* d, const std::string& filename)
+{
+  std::ofstream stream(filename.c_str());
+
+  if (stream.fail() || stream.bad())
+    {
+      SedErrorLog scratch;
+      SedErrorLog *log = d->getWriteErrorLog(scratch);
+      log->logError(XMLFileUnwritable);
+      return false;
+    }
+
+  return writeSedML(d, stream);
+}
+
+
+/*
+ * Writes the given Sed document as JSON to the output stream.
+ *
+ * @return true on success and false if the stream could not be written.
+ */
+bool
+SedJSONWriter::writeSedML(const SedDocument* d, std::ostream& stream)
+{
+  bool result = false;
+
+  try
+    {
+      stream.exceptions(ios_base::badbit | ios_base::failbit | ios_base::eofbit);
+
+      SedJSONTranscoder transcoder(stream);
+      std::ostream xml(&transcoder);
+      xml.exceptions(ios_base::badbit);
+
+      {
+        SedJSONOutputStream xos(xml, transcoder);
+        d->write(xos);
+      }
+
+      xml.flush();
+      stream << endl;
+
+      result = transcoder.finish();
+    }
+  catch (ios_base::failure&)
+    {
+      SedErrorLog scratch;
+      SedErrorLog *log = d->getWriteErrorLog(scratch);
+      log->logError(XMLFileOperationError);
+    }
+
+  return result;
+}
+
+
+/*
+ * Writes the given Sed document as JSON to an in-memory string and
+ * returns a pointer to it.  The string is owned by the caller and should
+ * be freed (with free()) when no longer needed.
+ */
+char*
+SedJSONWriter::writeSedMLToString(const SedDocument* d)
+{
+  ostringstream stream;
+
+  if (!writeSedML(d, stream)) return NULL;
+
+  return safe_strdup(stream.str().c_str());
+}
+
+
+/** @cond doxygen-c-only */
+
+
+/**
+ * Creates a new SedJSONWriter and returns a pointer to it.
+ */
+LIBSEDML_EXTERN
+SedJSONWriter_t *
+SedJSONWriter_create()
+{
+  return new(nothrow) SedJSONWriter;
+}
+
+
+/**
+ * Frees the given SedJSONWriter.
+ */
+LIBSEDML_EXTERN
+void
+SedJSONWriter_free(SedJSONWriter_t *sw)
+{
+  delete sw;
+}
+
+
+/**
+ * Writes the given Sed document as JSON to filename.
+ *
+ * @return non-zero on success and zero if the filename could not be opened
+ * for writing.
+ */
+LIBSEDML_EXTERN
+int
+SedJSONWriter_writeSedML(SedJSONWriter_t     *sw,
+                         const SedDocument_t *d,
+                         const char          *filename)
+{
+  if (sw == NULL || d == NULL || filename == NULL)
+    return 0;
+  else
+    return static_cast<int>(sw->writeSedML(d, filename));
+}
+
+
+/**
+ * Writes the given Sed document as JSON to an in-memory string and returns
+ * a pointer to it.  The string is owned by the caller and should be freed
+ * (with free()) when no longer needed.
+ *
+ * @return the string on success and NULL if the document could not be
+ * written.
+ */
+LIBSEDML_EXTERN
+char *
+SedJSONWriter_writeSedMLToString(SedJSONWriter_t *sw, const SedDocument_t *d)
+{
+  return (sw != NULL && d != NULL) ? sw->writeSedMLToString(d) : NULL;
+}
+
+
+/**
+ * Writes the given Sed document as JSON to filename.  This convenience
+ * function is functionally equivalent to:
+ *
+ *   SedJSONWriter_writeSedML(SedJSONWriter_create(), d, filename);
+ *
+ * @return non-zero on success and zero if the filename could not be opened
+ * for writing.
+ */
+LIBSEDML_EXTERN
+int
+writeSedMLToJSON(const SedDocument_t *d, const char *filename)
+{
+  SedJSONWriter sw;
+
+  if (d == NULL || filename == NULL)
+    return 0;
+  else
+    return static_cast<int>(sw.writeSedML(d, filename));
+}
+
+
+/**
+ * Writes the given Sed document as JSON to an in-memory string and returns
+ * a pointer to it.  The string is owned by the caller and should be freed
+ * (with free()) when no longer needed.
+ *
+ * @return the string on success and NULL if the document could not be
+ * written.
+ */
+LIBSEDML_EXTERN
+char *
+writeSedMLToJSONString(const SedDocument_t *d)
+{
+  SedJSONWriter sw;
+
+  if (d == NULL)
+    return NULL;
+  else
+    return sw.writeSedMLToString(d);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,281 @@
+/**
+ * @file    SedJSONWriter.h
+ * @brief   Writes an Sed Document as JSON to file or in-memory string
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedJSONWriter
+ * @ingroup Core
+ * @brief Methods for writing Sed as JSON to files and text strings.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * The SedJSONWriter class serializes a SedDocument into JSON that maps
+ * the document hierarchy one-to-one.  Every element becomes an object
+ * @verbatim
+{ "name": "<element name>",
+  "attributes": { "<attribute>": "<value>", ... },
+  "children": [ <element or text>, ... ] }
+@endverbatim
+ * where "attributes" and "children" are omitted if empty, and character
+ * data (for example the content of MathML @c ci elements) becomes
+ * <code>{ "text": "..." }</code>.  Attributes, including namespace
+ * declarations, keep their XML names and string values, and children
+ * keep their document order; MathML is thus written as a JSON abstract
+ * syntax tree of its elements.  SedJSONReader reads this format back, so
+ * that JSON and XML can be converted into each other without loss.
+ *
+ * The JSON is produced directly from the serialization of each object
+ * (the same writeAttributes() and writeElements() methods used by
+ * SedWriter), streaming into the destination without building an XML
+ * document first.  Only the XML that libSBML writes on behalf of an
+ * object, such as its MathML, is transcoded to JSON as it is written;
+ * the whitespace libSBML indents it with is not kept.
+ */
+
+#ifndef SedJSONWriter_h
+#define SedJSONWriter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <iosfwd>
+#include <string>
+
+#include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLNode.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedJSONTranscoder;
+
+
+class LIBSEDML_EXTERN SedJSONWriter
+{
+public:
+
+  /**
+   * Creates a new SedJSONWriter.
+   */
+  SedJSONWriter();
+
+
+  /**
+   * Destroys this SedJSONWriter.
+   */
+  ~SedJSONWriter();
+
+
+  /**
+   * Writes the given Sed document as JSON to filename.
+   *
+   * @param d the Sed document to be written
+   *
+   * @param filename the name or full pathname of the file where the JSON
+   * is to be written.
+   *
+   * @return @c true on success and @c false if the filename could not be
+   * opened for writing.
+   */
+  bool writeSedML(const SedDocument* d, const std::string& filename);
+
+
+  /**
+   * Writes the given Sed document as JSON to the output stream.
+   *
+   * @param d the Sed document to be written
+   *
+   * @param stream the stream object where the JSON is to be written.
+   *
+   * @return @c true on success and @c false if the stream could not be
+   * written to.
+   */
+  bool writeSedML(const SedDocument* d, std::ostream& stream);
+
+
+  /**
+   * Writes the given Sed document as JSON to an in-memory string and
+   * returns a pointer to it.
+   *
+   * The string is owned by the caller and should be freed (with @c free())
+   * when no longer needed.
+   *
+   * @param d the Sed document to be written
+   *
+   * @return the string on success and @c 0 if the document could not be
+   * written.
+   */
+  char* writeSedMLToString(const SedDocument* d);
+};
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * XMLOutputStream that SedJSONWriter writes a document to.  SedBase
+ * announces every element it writes, and the notes and annotations it
+ * holds, through the methods below, which write the JSON directly.  The
+ * regular XMLOutputStream methods are left for the attributes of the
+ * current element and for content only libSBML knows how to write, such
+ * as MathML; that output is transcoded as it is produced.
+ */
+class SedJSONOutputStream : public XMLOutputStream
+{
+public:
+
+  /*
+   * Creates a stream writing XML to xml, whose buffer is json.
+   */
+  SedJSONOutputStream(std::ostream& xml, SedJSONTranscoder& json);
+
+  /*
+   * Starts the object of an element, whose attributes are written next.
+   */
+  void startItem(const std::string& name, const std::string& prefix);
+
+  /*
+   * Ends the attributes of the element started last.
+   */
+  void endItemAttributes();
+
+  /*
+   * Ends the object of the element started last.
+   */
+  void endItem();
+
+  /*
+   * Writes the given XML node and its children.
+   */
+  void writeNode(const XMLNode& node);
+
+private:
+
+  SedJSONTranscoder& mJSON;
+};
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+#ifndef SWIG
+
+
+/**
+ * Creates a new SedJSONWriter and returns a pointer to it.
+ */
+LIBSEDML_EXTERN
+SedJSONWriter_t *
+SedJSONWriter_create(void);
+
+/**
+ * Frees the given SedJSONWriter.
+ */
+LIBSEDML_EXTERN
+void
+SedJSONWriter_free(SedJSONWriter_t *sw);
+
+/**
+ * Writes the given Sed document as JSON to filename.
+ *
+ * @return non-zero on success and zero if the filename could not be opened
+ * for writing.
+ */
+LIBSEDML_EXTERN
+int
+SedJSONWriter_writeSedML(SedJSONWriter_t     *sw,
+                         const SedDocument_t *d,
+                         const char          *filename);
+
+/**
+ * Writes the given Sed document as JSON to an in-memory string and returns
+ * a pointer to it.  The string is owned by the caller and should be freed
+ * (with free()) when no longer needed.
+ *
+ * @return the string on success and @c NULL if the document could not be
+ * written.
+ */
+LIBSEDML_EXTERN
+char *
+SedJSONWriter_writeSedMLToString(SedJSONWriter_t *sw, const SedDocument_t *d);
+
+/**
+ * Writes the given Sed document as JSON to filename.  This convenience
+ * function is functionally equivalent to:
+ *
+ *   SedJSONWriter_writeSedML(SedJSONWriter_create(), d, filename);
+ *
+ * @return non-zero on success and zero if the filename could not be opened
+ * for writing.
+ */
+LIBSEDML_EXTERN
+int
+writeSedMLToJSON(const SedDocument_t *d, const char *filename);
+
+/**
+ * Writes the given Sed document as JSON to an in-memory string and returns
+ * a pointer to it.  The string is owned by the caller and should be freed
+ * (with free()) when no longer needed.  This convenience function is
+ * functionally equivalent to:
+ *
+ *   SedJSONWriter_writeSedMLToString(SedJSONWriter_create(), d);
+ *
+ * @return the string on success and @c NULL if the document could not be
+ * written.
+ */
+LIBSEDML_EXTERN
+char *
+writeSedMLToJSONString(const SedDocument_t *d);
+
+
+#endif  /* !SWIG */
+
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#endif  /* SedJSONWriter_h */
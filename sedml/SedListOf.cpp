@@ -40,6 +40,7 @@
 
 #include <sedml/SedVisitor.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedOutputStream.h>
 #include <sedml/common/common.h>
 
 /** @cond doxygen-ignored */
@@ -134,9 +135,10 @@ SedListOf& SedListOf::operator=(const SedListOf& rhs)
 bool
 SedListOf::accept(SedVisitor& v) const
 {
-  v.visit(*this, getItemTypeCode());
-
-  for (unsigned int n = 0 ; n < mItems.size() && mItems[n]->accept(v); ++n) ;
+  if (v.enter(*this, getItemTypeCode()))
+    {
+      for (unsigned int n = 0 ; n < mItems.size() && mItems[n]->accept(v); ++n) ;
+    }
 
   v.leave(*this, getItemTypeCode());
 
@@ -319,23 +321,6 @@ SedListOf::getElementByMetaId(std::string metaid)
 }
 
 
-List*
-SedListOf::getAllElements()
-{
-  List* ret = new List();
-  List* sublist = NULL;
-
-  for (unsigned int i = 0; i < size(); i++)
-    {
-      SedBase* obj = get(i);
-      ret->add(obj);
-      sublist = obj->getAllElements();
-      ret->transferFrom(sublist);
-      delete sublist;
-    }
-
-  return ret;
-}
 /**
  * Used by SedListOf::get() to lookup an SedBase based by its id.
  */
@@ -389,6 +374,7 @@ SedListOf::clear(bool doDelete)
     for_each(mItems.begin(), mItems.end(), Delete());
 
   mItems.clear();
+  markDirty();
 }
 
 int SedListOf::removeFromParentAndDelete()
@@ -412,7 +398,11 @@ SedListOf::remove(unsigned int n)
 {
   SedBase* item = get(n);
 
-  if (item != NULL) mItems.erase(mItems.begin() + n);
+  if (item != NULL)
+    {
+      mItems.erase(mItems.begin() + n);
+      markDirty();
+    }
 
   return item;
 }
@@ -498,6 +488,40 @@ SedListOf::connectToChild()
   for_each(mItems.begin(), mItems.end(), SetParentSedObject(this));
 }
 
+
+/*
+ * Adds the memory held by this SedListOf, but not by its items, to the
+ * given SedMemoryUsage.  A list held by value is part of its parent, which
+ * already accounts for the size of the list object itself.
+ */
+void
+SedListOf::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(mParentSedObject != NULL ? 0 : sizeof(SedListOf));
+  usage.addListOverhead(mItems.capacity() * sizeof(SedBase*));
+}
+
+
+/*
+ * Returns the number of items in this SedListOf.
+ */
+unsigned int
+SedListOf::getNumChildObjects() const
+{
+  return (unsigned int)mItems.size();
+}
+
+
+/*
+ * Returns the nth item of this SedListOf.
+ */
+const SedBase*
+SedListOf::getChildObject(unsigned int n) const
+{
+  return (n < mItems.size()) ? mItems[n] : NULL;
+}
+
 /** @endcond */
 
 
@@ -557,7 +581,22 @@ void
 SedListOf::writeElements(XMLOutputStream& stream) const
 {
   SedBase::writeElements(stream);
-  for_each(mItems.begin(), mItems.end(), Write(stream));
+
+  // the items of the top level lists of a document are the unit of
+  // caching and of concurrent serialization
+  SedOutputStream* sos = dynamic_cast<SedOutputStream*>(&stream);
+
+  if (sos != NULL &&
+      (sos->getUseSubtreeCache() || sos->getNumThreads() > 1) &&
+      mParentSedObject != NULL &&
+      mParentSedObject->getTypeCode() == SEDML_DOCUMENT)
+    {
+      sos->writeItems(mItems);
+    }
+  else
+    {
+      for_each(mItems.begin(), mItems.end(), Write(stream));
+    }
 
 }
 /** @endcond */
@@ -287,14 +287,6 @@ public:
    */
   virtual SedBase* getElementByMetaId(std::string metaid);
 
-  /**
-   * Returns a List of all child SedBase objects, including those nested to an arbitrary depth
-   *
-   * @return a List of pointers to all children objects.
-   */
-  virtual List* getAllElements();
-
-
 #if 0
   /**
    * Get an item from the list based on its identifier.
@@ -420,6 +412,26 @@ public:
   virtual void connectToChild();
 
 
+  /**
+   * Adds the memory held by this SedListOf, but not by its items, to the
+   * given SedMemoryUsage.
+   */
+  virtual void addMemoryUsage(SedMemoryUsage& usage) const;
+
+
+  /**
+   * Returns the number of items in this SedListOf.
+   */
+  virtual unsigned int getNumChildObjects() const;
+
+
+  /**
+   * Returns the nth item of this SedListOf, or @c NULL if @p n is out of
+   * range.
+   */
+  virtual const SedBase* getChildObject(unsigned int n) const;
+
+
   /** @endcond */
 
   /**
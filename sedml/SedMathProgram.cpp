@@ -0,0 +1,1024 @@
+/**
+ * @file    SedMathProgram.cpp
+ * @brief   Implementation of SedMathProgram
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/util/util.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The operations of the instructions.
+ */
+enum SedMathOp
+{
+    SEDML_MATH_COPY
+  , SEDML_MATH_ADD
+  , SEDML_MATH_SUB
+  , SEDML_MATH_MUL
+  , SEDML_MATH_DIV
+  , SEDML_MATH_NEG
+  , SEDML_MATH_POW
+  , SEDML_MATH_EXP
+  , SEDML_MATH_LN
+  , SEDML_MATH_LOG10
+  , SEDML_MATH_SQRT
+  , SEDML_MATH_ABS
+  , SEDML_MATH_FLOOR
+  , SEDML_MATH_CEIL
+  , SEDML_MATH_SIN
+  , SEDML_MATH_COS
+  , SEDML_MATH_TAN
+  , SEDML_MATH_LT
+  , SEDML_MATH_LEQ
+  , SEDML_MATH_GT
+  , SEDML_MATH_GEQ
+  , SEDML_MATH_EQ
+  , SEDML_MATH_NEQ
+  , SEDML_MATH_AND
+  , SEDML_MATH_OR
+  , SEDML_MATH_XOR
+  , SEDML_MATH_NOT
+  , SEDML_MATH_SELECT
+};
+
+
+/*
+ * Returns the number of operands of the given operation.
+ */
+static unsigned int
+getArity(int op)
+{
+  switch (op)
+    {
+    case SEDML_MATH_SELECT:
+      return 3;
+
+    case SEDML_MATH_ADD:
+    case SEDML_MATH_SUB:
+    case SEDML_MATH_MUL:
+    case SEDML_MATH_DIV:
+    case SEDML_MATH_POW:
+    case SEDML_MATH_LT:
+    case SEDML_MATH_LEQ:
+    case SEDML_MATH_GT:
+    case SEDML_MATH_GEQ:
+    case SEDML_MATH_EQ:
+    case SEDML_MATH_NEQ:
+    case SEDML_MATH_AND:
+    case SEDML_MATH_OR:
+    case SEDML_MATH_XOR:
+      return 2;
+
+    default:
+      return 1;
+    }
+}
+
+
+/*
+ * Runs an operation over n points.  Each case is a plain loop over
+ * contiguous arrays, which the compiler vectorizes; d may be one of the
+ * operands.
+ */
+static void
+runInstruction(int op, unsigned int n, double* d,
+               const double* a, const double* b, const double* c)
+{
+  unsigned int i;
+
+  switch (op)
+    {
+    case SEDML_MATH_COPY:
+      for (i = 0; i < n; ++i) d[i] = a[i];
+      break;
+
+    case SEDML_MATH_ADD:
+      for (i = 0; i < n; ++i) d[i] = a[i] + b[i];
+      break;
+
+    case SEDML_MATH_SUB:
+      for (i = 0; i < n; ++i) d[i] = a[i] - b[i];
+      break;
+
+    case SEDML_MATH_MUL:
+      for (i = 0; i < n; ++i) d[i] = a[i] * b[i];
+      break;
+
+    case SEDML_MATH_DIV:
+      for (i = 0; i < n; ++i) d[i] = a[i] / b[i];
+      break;
+
+    case SEDML_MATH_NEG:
+      for (i = 0; i < n; ++i) d[i] = -a[i];
+      break;
+
+    case SEDML_MATH_POW:
+      for (i = 0; i < n; ++i) d[i] = pow(a[i], b[i]);
+      break;
+
+    case SEDML_MATH_EXP:
+      for (i = 0; i < n; ++i) d[i] = exp(a[i]);
+      break;
+
+    case SEDML_MATH_LN:
+      for (i = 0; i < n; ++i) d[i] = log(a[i]);
+      break;
+
+    case SEDML_MATH_LOG10:
+      for (i = 0; i < n; ++i) d[i] = log10(a[i]);
+      break;
+
+    case SEDML_MATH_SQRT:
+      for (i = 0; i < n; ++i) d[i] = sqrt(a[i]);
+      break;
+
+    case SEDML_MATH_ABS:
+      for (i = 0; i < n; ++i) d[i] = fabs(a[i]);
+      break;
+
+    case SEDML_MATH_FLOOR:
+      for (i = 0; i < n; ++i) d[i] = floor(a[i]);
+      break;
+
+    case SEDML_MATH_CEIL:
+      for (i = 0; i < n; ++i) d[i] = ceil(a[i]);
+      break;
+
+    case SEDML_MATH_SIN:
+      for (i = 0; i < n; ++i) d[i] = sin(a[i]);
+      break;
+
+    case SEDML_MATH_COS:
+      for (i = 0; i < n; ++i) d[i] = cos(a[i]);
+      break;
+
+    case SEDML_MATH_TAN:
+      for (i = 0; i < n; ++i) d[i] = tan(a[i]);
+      break;
+
+    case SEDML_MATH_LT:
+      for (i = 0; i < n; ++i) d[i] = (a[i] < b[i]) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_LEQ:
+      for (i = 0; i < n; ++i) d[i] = (a[i] <= b[i]) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_GT:
+      for (i = 0; i < n; ++i) d[i] = (a[i] > b[i]) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_GEQ:
+      for (i = 0; i < n; ++i) d[i] = (a[i] >= b[i]) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_EQ:
+      for (i = 0; i < n; ++i) d[i] = (a[i] == b[i]) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_NEQ:
+      for (i = 0; i < n; ++i) d[i] = (a[i] != b[i]) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_AND:
+      for (i = 0; i < n; ++i) d[i] = (a[i] != 0.0 && b[i] != 0.0) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_OR:
+      for (i = 0; i < n; ++i) d[i] = (a[i] != 0.0 || b[i] != 0.0) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_XOR:
+      for (i = 0; i < n; ++i) d[i] = ((a[i] != 0.0) != (b[i] != 0.0)) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_NOT:
+      for (i = 0; i < n; ++i) d[i] = (a[i] == 0.0) ? 1.0 : 0.0;
+      break;
+
+    case SEDML_MATH_SELECT:
+      for (i = 0; i < n; ++i) d[i] = (a[i] != 0.0) ? b[i] : c[i];
+      break;
+    }
+}
+
+
+/*
+ * Translates an ASTNode into the instructions of a SedMathProgram.  While
+ * compiling, operands are tagged with their kind in their two upper bits;
+ * they are turned into slot numbers once the number of constants and
+ * registers is known.
+ */
+class SedMathCompiler
+{
+public:
+
+  SedMathCompiler(SedMathProgram& program,
+                  const std::map<std::string, double>& constants)
+    : mProgram(program)
+    , mConstants(constants)
+    , mNumRegisters(0)
+  {
+    for (unsigned int n = 0; n < program.mInputIds.size(); ++n)
+      {
+        mInputs[program.mInputIds[n]] = n;
+      }
+  }
+
+
+  bool compile(const ASTNode* math)
+  {
+    unsigned int root;
+
+    if (!compileNode(math, root)) return false;
+
+    // the last instruction usually computes the root
+    if (kind(root) == REGISTER && !mProgram.mCode.empty()
+        && mProgram.mCode.back().dst == root)
+      mProgram.mCode.back().dst = RESULT;
+    else
+      emitInstruction(SEDML_MATH_COPY, RESULT, root, RESULT, RESULT);
+
+    resolve();
+    return true;
+  }
+
+
+private:
+
+  enum { INPUT = 0, CONSTANT = 1, REGISTER = 2 };
+
+  // the result column, also used for the operands an operation ignores
+  static const unsigned int RESULT = 3u << 30;
+
+  static unsigned int kind(unsigned int operand) { return operand >> 30; }
+  static unsigned int index(unsigned int operand) { return operand & ~(3u << 30); }
+  static unsigned int tag(unsigned int k, unsigned int i) { return (k << 30) | i; }
+
+
+  bool fail(const std::string& message)
+  {
+    mProgram.mErrorMessage = message;
+    return false;
+  }
+
+
+  unsigned int constant(double value)
+  {
+    mProgram.mConstants.push_back(value);
+    return tag(CONSTANT, (unsigned int)mProgram.mConstants.size() - 1);
+  }
+
+
+  void release(unsigned int operand)
+  {
+    if (kind(operand) == REGISTER)
+      mFreeRegisters.push_back(index(operand));
+  }
+
+
+  void emitInstruction(int op, unsigned int dst, unsigned int a,
+                       unsigned int b, unsigned int c)
+  {
+    SedMathProgram::Instruction instruction;
+    instruction.op  = op;
+    instruction.dst = dst;
+    instruction.a   = a;
+    instruction.b   = b;
+    instruction.c   = c;
+    mProgram.mCode.push_back(instruction);
+  }
+
+
+  /*
+   * Emits an operation, or computes it now if its operands are constants;
+   * returns the operand holding its result.
+   */
+  unsigned int emit(int op, unsigned int a, unsigned int b = RESULT,
+                    unsigned int c = RESULT)
+  {
+    unsigned int arity = getArity(op);
+    unsigned int operands[3] = { a, b, c };
+    bool folded = true;
+
+    for (unsigned int n = 0; n < arity; ++n)
+      {
+        folded = folded && kind(operands[n]) == CONSTANT;
+      }
+
+    if (folded)
+      {
+        double values[3] = { 0.0, 0.0, 0.0 };
+        double value;
+
+        for (unsigned int n = 0; n < arity; ++n)
+          {
+            values[n] = mProgram.mConstants[index(operands[n])];
+          }
+
+        runInstruction(op, 1, &value, &values[0], &values[1], &values[2]);
+        return constant(value);
+      }
+
+    // the registers of the operands may receive the result
+    release(a);
+    if (arity > 1 && b != a) release(b);
+    if (arity > 2 && c != a && c != b) release(c);
+
+    unsigned int dst;
+
+    if (!mFreeRegisters.empty())
+      {
+        dst = mFreeRegisters.back();
+        mFreeRegisters.pop_back();
+      }
+    else
+      {
+        dst = mNumRegisters++;
+      }
+
+    emitInstruction(op, tag(REGISTER, dst), a, b, c);
+    return tag(REGISTER, dst);
+  }
+
+
+  /*
+   * Compiles the operation on every consecutive pair of the children of
+   * node, and combines the results with SEDML_MATH_AND.
+   */
+  bool compileRelational(const ASTNode* node, int op, unsigned int& result)
+  {
+    unsigned int numChildren = node->getNumChildren();
+    result = constant(1.0);
+
+    for (unsigned int n = 1; n < numChildren; ++n)
+      {
+        unsigned int left, right;
+
+        if (!compileNode(node->getChild(n - 1), left)) return false;
+        if (!compileNode(node->getChild(n), right)) return false;
+
+        unsigned int pair = emit(op, left, right);
+        result = (n == 1) ? pair : emit(SEDML_MATH_AND, result, pair);
+      }
+
+    return true;
+  }
+
+
+  /*
+   * Compiles the children of node, combined from left to right with op;
+   * a node without children is the given value.
+   */
+  bool compileChain(const ASTNode* node, int op, double empty,
+                    unsigned int& result)
+  {
+    unsigned int numChildren = node->getNumChildren();
+
+    if (numChildren == 0)
+      {
+        result = constant(empty);
+        return true;
+      }
+
+    if (!compileNode(node->getChild(0), result)) return false;
+
+    for (unsigned int n = 1; n < numChildren; ++n)
+      {
+        unsigned int operand;
+
+        if (!compileNode(node->getChild(n), operand)) return false;
+
+        result = emit(op, result, operand);
+      }
+
+    return true;
+  }
+
+
+  bool compileUnary(const ASTNode* node, int op, unsigned int& result)
+  {
+    if (node->getNumChildren() != 1)
+      return fail("wrong number of arguments");
+
+    unsigned int operand;
+
+    if (!compileNode(node->getChild(0), operand)) return false;
+
+    result = emit(op, operand);
+    return true;
+  }
+
+
+  /*
+   * Compiles x ^ exponent, with cheaper operations for common constant
+   * exponents.
+   */
+  unsigned int power(unsigned int x, unsigned int exponent)
+  {
+    if (kind(exponent) == CONSTANT)
+      {
+        double value = mProgram.mConstants[index(exponent)];
+
+        if (value == 1.0) return x;
+        if (value == 2.0) return emit(SEDML_MATH_MUL, x, x);
+        if (value == 0.5) return emit(SEDML_MATH_SQRT, x);
+      }
+
+    return emit(SEDML_MATH_POW, x, exponent);
+  }
+
+
+  bool compilePiecewise(const ASTNode* node, unsigned int& result)
+  {
+    unsigned int numChildren = node->getNumChildren();
+    unsigned int numPieces = numChildren / 2;
+
+    if (numChildren % 2 == 1)
+      {
+        if (!compileNode(node->getChild(numChildren - 1), result)) return false;
+      }
+    else
+      {
+        result = constant(numeric_limits<double>::quiet_NaN());
+      }
+
+    for (unsigned int n = numPieces; n > 0; --n)
+      {
+        unsigned int value, condition;
+
+        if (!compileNode(node->getChild(2 * n - 2), value)) return false;
+        if (!compileNode(node->getChild(2 * n - 1), condition)) return false;
+
+        if (kind(condition) == CONSTANT)
+          {
+            bool holds = mProgram.mConstants[index(condition)] != 0.0;
+            release(holds ? result : value);
+            result = holds ? value : result;
+          }
+        else
+          {
+            result = emit(SEDML_MATH_SELECT, condition, value, result);
+          }
+      }
+
+    return true;
+  }
+
+
+  bool compileNode(const ASTNode* node, unsigned int& result)
+  {
+    if (node == NULL) return fail("missing math");
+
+    if (node->isNumber())
+      {
+        result = constant(node->getValue());
+        return true;
+      }
+
+    unsigned int numChildren = node->getNumChildren();
+    unsigned int a, b;
+
+    switch (node->getType())
+      {
+      case AST_NAME:
+        {
+          const std::string name = (node->getName() != NULL) ? node->getName() : "";
+          std::map<std::string, unsigned int>::const_iterator input = mInputs.find(name);
+
+          if (input != mInputs.end())
+            {
+              result = tag(INPUT, input->second);
+              return true;
+            }
+
+          std::map<std::string, double>::const_iterator value = mConstants.find(name);
+
+          if (value != mConstants.end())
+            {
+              result = constant(value->second);
+              return true;
+            }
+
+          return fail("unknown name '" + name + "'");
+        }
+
+      case AST_CONSTANT_E:
+        result = constant(exp(1.0));
+        return true;
+
+      case AST_CONSTANT_PI:
+        result = constant(4.0 * atan(1.0));
+        return true;
+
+      case AST_CONSTANT_TRUE:
+        result = constant(1.0);
+        return true;
+
+      case AST_CONSTANT_FALSE:
+        result = constant(0.0);
+        return true;
+
+      case AST_PLUS:
+        return compileChain(node, SEDML_MATH_ADD, 0.0, result);
+
+      case AST_TIMES:
+        return compileChain(node, SEDML_MATH_MUL, 1.0, result);
+
+      case AST_MINUS:
+        if (numChildren == 1)
+          return compileUnary(node, SEDML_MATH_NEG, result);
+
+        if (numChildren != 2) return fail("wrong number of arguments");
+
+        if (!compileNode(node->getChild(0), a)) return false;
+        if (!compileNode(node->getChild(1), b)) return false;
+
+        result = emit(SEDML_MATH_SUB, a, b);
+        return true;
+
+      case AST_DIVIDE:
+        if (numChildren != 2) return fail("wrong number of arguments");
+
+        if (!compileNode(node->getChild(0), a)) return false;
+        if (!compileNode(node->getChild(1), b)) return false;
+
+        result = emit(SEDML_MATH_DIV, a, b);
+        return true;
+
+      case AST_POWER:
+      case AST_FUNCTION_POWER:
+        if (numChildren != 2) return fail("wrong number of arguments");
+
+        if (!compileNode(node->getChild(0), a)) return false;
+        if (!compileNode(node->getChild(1), b)) return false;
+
+        result = power(a, b);
+        return true;
+
+      case AST_FUNCTION_ROOT:
+        if (numChildren == 1)
+          return compileUnary(node, SEDML_MATH_SQRT, result);
+
+        if (numChildren != 2) return fail("wrong number of arguments");
+
+        // root(degree, x) = x ^ (1 / degree)
+        if (!compileNode(node->getChild(1), a)) return false;
+        if (!compileNode(node->getChild(0), b)) return false;
+
+        result = power(a, emit(SEDML_MATH_DIV, constant(1.0), b));
+        return true;
+
+      case AST_FUNCTION_LOG:
+        if (numChildren == 1)
+          return compileUnary(node, SEDML_MATH_LOG10, result);
+
+        if (numChildren != 2) return fail("wrong number of arguments");
+
+        // log(base, x) = ln(x) / ln(base)
+        if (!compileNode(node->getChild(0), b)) return false;
+
+        if (!compileNode(node->getChild(1), a)) return false;
+
+        if (kind(b) == CONSTANT && mProgram.mConstants[index(b)] == 10.0)
+          {
+            result = emit(SEDML_MATH_LOG10, a);
+            return true;
+          }
+
+        a = emit(SEDML_MATH_LN, a);
+        b = emit(SEDML_MATH_LN, b);
+        result = emit(SEDML_MATH_DIV, a, b);
+        return true;
+
+      case AST_FUNCTION_EXP:
+        return compileUnary(node, SEDML_MATH_EXP, result);
+
+      case AST_FUNCTION_LN:
+        return compileUnary(node, SEDML_MATH_LN, result);
+
+      case AST_FUNCTION_ABS:
+        return compileUnary(node, SEDML_MATH_ABS, result);
+
+      case AST_FUNCTION_FLOOR:
+        return compileUnary(node, SEDML_MATH_FLOOR, result);
+
+      case AST_FUNCTION_CEILING:
+        return compileUnary(node, SEDML_MATH_CEIL, result);
+
+      case AST_FUNCTION_SIN:
+        return compileUnary(node, SEDML_MATH_SIN, result);
+
+      case AST_FUNCTION_COS:
+        return compileUnary(node, SEDML_MATH_COS, result);
+
+      case AST_FUNCTION_TAN:
+        return compileUnary(node, SEDML_MATH_TAN, result);
+
+      case AST_FUNCTION_PIECEWISE:
+        return compilePiecewise(node, result);
+
+      case AST_RELATIONAL_LT:
+        return compileRelational(node, SEDML_MATH_LT, result);
+
+      case AST_RELATIONAL_LEQ:
+        return compileRelational(node, SEDML_MATH_LEQ, result);
+
+      case AST_RELATIONAL_GT:
+        return compileRelational(node, SEDML_MATH_GT, result);
+
+      case AST_RELATIONAL_GEQ:
+        return compileRelational(node, SEDML_MATH_GEQ, result);
+
+      case AST_RELATIONAL_EQ:
+        return compileRelational(node, SEDML_MATH_EQ, result);
+
+      case AST_RELATIONAL_NEQ:
+        return compileRelational(node, SEDML_MATH_NEQ, result);
+
+      case AST_LOGICAL_AND:
+        return compileChain(node, SEDML_MATH_AND, 1.0, result);
+
+      case AST_LOGICAL_OR:
+        return compileChain(node, SEDML_MATH_OR, 0.0, result);
+
+      case AST_LOGICAL_XOR:
+        return compileChain(node, SEDML_MATH_XOR, 0.0, result);
+
+      case AST_LOGICAL_NOT:
+        return compileUnary(node, SEDML_MATH_NOT, result);
+
+      default:
+        if (node->getName() != NULL)
+          return fail(std::string("unsupported function '") + node->getName() + "'");
+
+        return fail("unsupported math");
+      }
+  }
+
+
+  /*
+   * Replaces the tagged operands of the instructions by slot numbers.
+   */
+  void resolve()
+  {
+    unsigned int numInputs = (unsigned int)mProgram.mInputIds.size();
+    unsigned int numConstants = (unsigned int)mProgram.mConstants.size();
+    unsigned int result = numInputs + numConstants + mNumRegisters;
+
+    for (size_t n = 0; n < mProgram.mCode.size(); ++n)
+      {
+        unsigned int* operands[4] = { &mProgram.mCode[n].dst, &mProgram.mCode[n].a,
+                                      &mProgram.mCode[n].b, &mProgram.mCode[n].c };
+
+        for (unsigned int k = 0; k < 4; ++k)
+          {
+            unsigned int operand = *operands[k];
+
+            switch (kind(operand))
+              {
+              case INPUT:    *operands[k] = index(operand); break;
+              case CONSTANT: *operands[k] = numInputs + index(operand); break;
+              case REGISTER: *operands[k] = numInputs + numConstants + index(operand); break;
+              default:       *operands[k] = result; break;
+              }
+          }
+      }
+
+    mProgram.mNumRegisters = mNumRegisters;
+  }
+
+
+  SedMathProgram& mProgram;
+  const std::map<std::string, double>& mConstants;
+  std::map<std::string, unsigned int> mInputs;
+  std::vector<unsigned int> mFreeRegisters;
+  unsigned int mNumRegisters;
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty, SedMathProgram.
+ */
+SedMathProgram::SedMathProgram()
+  : mNumRegisters(0)
+  , mCompiled(false)
+{
+}
+
+
+/*
+ * Compiles the math of the given data generator.
+ */
+int
+SedMathProgram::compile(const SedDataGenerator& generator)
+{
+  std::vector<std::string> inputIds;
+  std::map<std::string, double> constants;
+
+  for (unsigned int n = 0; n < generator.getNumVariables(); ++n)
+    {
+      inputIds.push_back(generator.getVariable(n)->getId());
+    }
+
+  for (unsigned int n = 0; n < generator.getNumParameters(); ++n)
+    {
+      const SedParameter* parameter = generator.getParameter(n);
+
+      if (parameter->isSetValue())
+        constants[parameter->getId()] = parameter->getValue();
+    }
+
+  return compile(generator.getMath(), inputIds, constants);
+}
+
+
+/*
+ * Compiles the given math.
+ */
+int
+SedMathProgram::compile(const ASTNode* math,
+                        const std::vector<std::string>& inputIds,
+                        const std::map<std::string, double>& constants)
+{
+  mCode.clear();
+  mConstants.clear();
+  mInputIds = inputIds;
+  mNumRegisters = 0;
+  mCompiled = false;
+  mErrorMessage.clear();
+
+  if (math == NULL)
+    {
+      mErrorMessage = "missing math";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  SedMathCompiler compiler(*this, constants);
+
+  if (!compiler.compile(math))
+    {
+      mCode.clear();
+      mConstants.clear();
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  mCompiled = true;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if this program has been compiled successfully.
+ */
+bool
+SedMathProgram::isCompiled() const
+{
+  return mCompiled;
+}
+
+
+/*
+ * @return the reason the last compilation failed.
+ */
+const std::string&
+SedMathProgram::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/*
+ * @return the number of inputs of this program.
+ */
+unsigned int
+SedMathProgram::getNumInputs() const
+{
+  return (unsigned int)mInputIds.size();
+}
+
+
+/*
+ * @return the name of the nth input of this program.
+ */
+const std::string&
+SedMathProgram::getInputId(unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mInputIds.size()) ? mInputIds[n] : empty;
+}
+
+
+/*
+ * @return the number of instructions of this program.
+ */
+unsigned int
+SedMathProgram::getNumInstructions() const
+{
+  return (unsigned int)mCode.size();
+}
+
+
+/*
+ * @return the number of registers of this program.
+ */
+unsigned int
+SedMathProgram::getNumRegisters() const
+{
+  return mNumRegisters;
+}
+
+
+/*
+ * Evaluates this program over columns of points, one block of points at a
+ * time.
+ */
+int
+SedMathProgram::evaluate(const double* const* inputs, unsigned int numPoints,
+                         double* result) const
+{
+  if (!mCompiled || result == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  unsigned int numInputs = (unsigned int)mInputIds.size();
+
+  if (numInputs > 0 && inputs == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int n = 0; n < numInputs; ++n)
+    {
+      if (inputs[n] == NULL) return LIBSEDML_INVALID_OBJECT;
+    }
+
+  unsigned int numConstants = (unsigned int)mConstants.size();
+  unsigned int numBlocks = numConstants + mNumRegisters;
+  std::vector<double> storage(numBlocks * SEDML_MATH_BLOCK_SIZE + 1);
+  std::vector<double*> slots(numInputs + numBlocks + 1);
+
+  for (unsigned int n = 0; n < numBlocks; ++n)
+    {
+      slots[numInputs + n] = &storage[n * SEDML_MATH_BLOCK_SIZE];
+    }
+
+  for (unsigned int n = 0; n < numConstants; ++n)
+    {
+      std::fill(slots[numInputs + n], slots[numInputs + n] + SEDML_MATH_BLOCK_SIZE,
+                mConstants[n]);
+    }
+
+  for (unsigned int start = 0; start < numPoints; start += SEDML_MATH_BLOCK_SIZE)
+    {
+      unsigned int size = numPoints - start;
+      if (size > SEDML_MATH_BLOCK_SIZE) size = SEDML_MATH_BLOCK_SIZE;
+
+      for (unsigned int n = 0; n < numInputs; ++n)
+        {
+          slots[n] = const_cast<double*>(inputs[n]) + start;
+        }
+
+      slots[numInputs + numBlocks] = result + start;
+
+      for (size_t n = 0; n < mCode.size(); ++n)
+        {
+          const Instruction& instruction = mCode[n];
+          runInstruction(instruction.op, size, slots[instruction.dst],
+                         slots[instruction.a], slots[instruction.b],
+                         slots[instruction.c]);
+        }
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Evaluates this program at a single point.
+ */
+double
+SedMathProgram::evaluate(const double* values) const
+{
+  double result = numeric_limits<double>::quiet_NaN();
+  std::vector<const double*> inputs(mInputIds.size() + 1);
+
+  for (size_t n = 0; n < mInputIds.size(); ++n)
+    {
+      inputs[n] = (values != NULL) ? &values[n] : NULL;
+    }
+
+  evaluate(&inputs[0], 1, &result);
+  return result;
+}
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedMathProgram_t *
+SedMathProgram_create(void)
+{
+  return new(std::nothrow) SedMathProgram();
+}
+
+
+LIBSEDML_EXTERN
+void
+SedMathProgram_free(SedMathProgram_t *program)
+{
+  delete program;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedMathProgram_compile(SedMathProgram_t *program,
+                       const SedDataGenerator_t *generator)
+{
+  if (program == NULL || generator == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return program->compile(*generator);
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedMathProgram_getNumInputs(const SedMathProgram_t *program)
+{
+  return (program != NULL) ? program->getNumInputs() : 0;
+}
+
+
+LIBSEDML_EXTERN
+const char *
+SedMathProgram_getInputId(const SedMathProgram_t *program, unsigned int n)
+{
+  return (program != NULL) ? program->getInputId(n).c_str() : NULL;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedMathProgram_evaluate(const SedMathProgram_t *program,
+                        const double * const *inputs,
+                        unsigned int numPoints, double *result)
+{
+  if (program == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return program->evaluate(inputs, numPoints, result);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
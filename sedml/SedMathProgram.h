@@ -0,0 +1,330 @@
+/**
+ * @file    SedMathProgram.h
+ * @brief   Math of a data generator compiled for evaluation over columns
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedMathProgram
+ * @ingroup Core
+ * @brief Math of a data generator compiled for evaluation over columns.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedMathProgram compiles the math of a SedDataGenerator, together with
+ * its variables and parameters, into a flat list of register
+ * instructions, and evaluates it over whole columns of values at once:
+ * for a time course, each variable is a column with one value per time
+ * point, and the result is the column of values of the data generator.
+ *
+ * The variables of the data generator are the inputs of the program, in
+ * the order of the data generator; its parameters are constants.  The
+ * program evaluates the columns in blocks of #SEDML_MATH_BLOCK_SIZE
+ * points: each instruction runs a tight loop over a block of its operands,
+ * which the compiler vectorizes, and the intermediate blocks stay in the
+ * cache.  Subexpressions that only depend on constants are computed once
+ * when the program is compiled.
+ *
+ * The math may use the arithmetic operators, @c pow, @c exp, @c ln,
+ * @c log, @c root, @c abs, @c floor, @c ceiling, @c sin, @c cos, @c tan,
+ * the relational and logical operators, @c piecewise, numbers, and the
+ * constants @c true, @c false, @c pi and @c exponentiale.  Booleans are
+ * represented by 1 and 0.  All the pieces of a @c piecewise are evaluated
+ * for every point, and the result of the first piece whose condition holds
+ * is selected.
+ *
+ * A compiled program is not modified by evaluate(), which may be called
+ * from several threads at the same time.
+ * @code{.cpp}
+ * SedMathProgram program;
+ * if (program.compile(*generator) == LIBSEDML_OPERATION_SUCCESS)
+ *   {
+ *     // one column per variable of the generator
+ *     std::vector<const double*> inputs = ...;
+ *     std::vector<double> result(numPoints);
+ *     program.evaluate(&inputs[0], numPoints, &result[0]);
+ *   }
+ * @endcode
+ */
+
+#ifndef SedMathProgram_h
+#define SedMathProgram_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+/**
+ * The number of points of the blocks in which a SedMathProgram evaluates
+ * its columns.
+ */
+#define SEDML_MATH_BLOCK_SIZE 256
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class ASTNode;
+
+LIBSBML_CPP_NAMESPACE_END
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDataGenerator;
+
+
+class LIBSEDML_EXTERN SedMathProgram
+{
+public:
+
+  /**
+   * Creates a new, empty, SedMathProgram.
+   */
+  SedMathProgram();
+
+
+  /**
+   * Compiles the math of the given data generator.  The variables of the
+   * generator are the inputs of the program, in order; its parameters are
+   * constants.
+   *
+   * @param generator the data generator to compile.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if the generator has no math.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math uses an unknown name or an unsupported construct; see
+   * getErrorMessage().
+   */
+  int compile(const SedDataGenerator& generator);
+
+
+  /**
+   * Compiles the given math.
+   *
+   * @param math the math to compile.
+   * @param inputIds the names of the inputs of the program, in order.
+   * @param constants the values of the other names the math may use.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p math is @c NULL.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math uses an unknown name or an unsupported construct; see
+   * getErrorMessage().
+   */
+  int compile(const ASTNode* math,
+              const std::vector<std::string>& inputIds,
+              const std::map<std::string, double>& constants);
+
+
+  /**
+   * @return @c true if this program has been compiled successfully.
+   */
+  bool isCompiled() const;
+
+
+  /**
+   * @return the reason the last compilation failed, or an empty string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+  /**
+   * @return the number of inputs of this program.
+   */
+  unsigned int getNumInputs() const;
+
+
+  /**
+   * @return the name of the nth input of this program, or an empty string
+   * if @p n is out of range.
+   */
+  const std::string& getInputId(unsigned int n) const;
+
+
+  /**
+   * @return the number of instructions of this program.
+   */
+  unsigned int getNumInstructions() const;
+
+
+  /**
+   * @return the number of registers, each holding a block of points, this
+   * program uses for its intermediate results.
+   */
+  unsigned int getNumRegisters() const;
+
+
+  /**
+   * Evaluates this program over columns of points.
+   *
+   * @param inputs one column of @p numPoints values per input, in the order
+   * of the inputs.
+   * @param numPoints the number of points.
+   * @param result the column receiving the @p numPoints results.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if this program is not compiled, or a column is @c NULL.
+   */
+  int evaluate(const double* const* inputs, unsigned int numPoints,
+               double* result) const;
+
+
+  /**
+   * Evaluates this program at a single point.
+   *
+   * @param values the value of each input, in the order of the inputs.
+   *
+   * @return the result, or NaN if this program is not compiled.
+   */
+  double evaluate(const double* values) const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /*
+   * An instruction: an operation, the slot receiving its result and the
+   * slots of its operands.  The slots are the inputs, then the constants,
+   * then the registers, then the result.
+   */
+  struct Instruction
+  {
+    int          op;
+    unsigned int dst;
+    unsigned int a;
+    unsigned int b;
+    unsigned int c;
+  };
+
+  /** @endcond doxygen-libsedml-internal */
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  friend class SedMathCompiler;
+
+  std::vector<Instruction> mCode;
+  std::vector<double>      mConstants;
+  std::vector<std::string> mInputIds;
+  unsigned int             mNumRegisters;
+  bool                     mCompiled;
+  std::string              mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new, empty, SedMathProgram.
+ */
+LIBSEDML_EXTERN
+SedMathProgram_t *
+SedMathProgram_create(void);
+
+/**
+ * Frees the given SedMathProgram.
+ */
+LIBSEDML_EXTERN
+void
+SedMathProgram_free(SedMathProgram_t *program);
+
+/**
+ * Compiles the math of the given data generator into the given
+ * SedMathProgram.
+ */
+LIBSEDML_EXTERN
+int
+SedMathProgram_compile(SedMathProgram_t *program,
+                       const SedDataGenerator_t *generator);
+
+/**
+ * Returns the number of inputs of the given SedMathProgram.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMathProgram_getNumInputs(const SedMathProgram_t *program);
+
+/**
+ * Returns the name of the nth input of the given SedMathProgram.
+ */
+LIBSEDML_EXTERN
+const char *
+SedMathProgram_getInputId(const SedMathProgram_t *program, unsigned int n);
+
+/**
+ * Evaluates the given SedMathProgram over columns of points.
+ */
+LIBSEDML_EXTERN
+int
+SedMathProgram_evaluate(const SedMathProgram_t *program,
+                        const double * const *inputs,
+                        unsigned int numPoints, double *result);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedMathProgram_h */
@@ -0,0 +1,468 @@
+/**
+ * @file    SedMemoryUsage.cpp
+ * @brief   Implementation of SedMemoryUsage
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedMemoryUsage.h>
+#include <sedml/SedNamespaces.h>
+#include <sedml/SedTypeCodes.h>
+
+#include <sbml/math/ASTNode.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLAttributes.h>
+#include <sbml/xml/XMLNamespaces.h>
+
+#include <cstring>
+
+#ifdef LIBSEDML_USE_THREADS
+#include <atomic>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The counts of objects created and destroyed are shared by all threads;
+ * they are atomic when libSEDML is built with threads.
+ */
+#ifdef LIBSEDML_USE_THREADS
+static std::atomic<bool> sCountObjects(false);
+static std::atomic<unsigned long> sNumObjectsCreated(0);
+static std::atomic<unsigned long> sNumObjectsDestroyed(0);
+#else
+static bool sCountObjects = false;
+static unsigned long sNumObjectsCreated = 0;
+static unsigned long sNumObjectsDestroyed = 0;
+#endif
+
+
+/*
+ * Returns the number of bytes held by the given string outside of the
+ * string object itself; none if its characters are stored inline.
+ */
+static size_t
+getStringHeapSize(const std::string& str)
+{
+  const char* data  = str.data();
+  const char* inner = reinterpret_cast<const char*>(&str);
+
+  if (str.empty() || (data >= inner && data < inner + sizeof(std::string)))
+    return 0;
+
+  return str.capacity() + 1;
+}
+
+
+/*
+ * Returns the number of bytes held by the given namespaces, including the
+ * XMLNamespaces object itself.
+ */
+static size_t
+getNamespacesSize(const XMLNamespaces& xmlns)
+{
+  size_t size = sizeof(XMLNamespaces);
+
+  for (int i = 0; i < xmlns.getLength(); ++i)
+    {
+      // each namespace is a pair of strings held in a vector
+      size += 2 * sizeof(std::string);
+      size += getStringHeapSize(xmlns.getPrefix(i));
+      size += getStringHeapSize(xmlns.getURI(i));
+    }
+
+  return size;
+}
+
+
+/*
+ * Returns the number of bytes held by the given XMLNode outside of the
+ * XMLNode object itself, including its children.
+ */
+static size_t
+getXMLNodeHeapSize(const XMLNode& node)
+{
+  size_t size = getStringHeapSize(node.getName())
+                + getStringHeapSize(node.getPrefix())
+                + getStringHeapSize(node.getURI())
+                + getStringHeapSize(node.getCharacters());
+
+  const XMLAttributes& attributes = node.getAttributes();
+
+  for (int i = 0; i < attributes.getLength(); ++i)
+    {
+      // each attribute is a triple of strings held in a vector
+      size += 3 * sizeof(std::string);
+      size += getStringHeapSize(attributes.getName(i));
+      size += getStringHeapSize(attributes.getValue(i));
+    }
+
+  if (!node.getNamespaces().isEmpty())
+    size += getNamespacesSize(node.getNamespaces()) - sizeof(XMLNamespaces);
+
+  for (unsigned int n = 0; n < node.getNumChildren(); ++n)
+    {
+      // the children are held by value in a vector
+      size += sizeof(XMLNode) + getXMLNodeHeapSize(node.getChild(n));
+    }
+
+  return size;
+}
+
+
+/*
+ * Returns the number of bytes held by the given ASTNode, including its
+ * children.
+ */
+static size_t
+getMathSize(const ASTNode& math)
+{
+  size_t size = sizeof(ASTNode);
+
+  if (math.getName() != NULL)
+    size += strlen(math.getName()) + 1;
+
+  for (unsigned int n = 0; n < math.getNumChildren(); ++n)
+    {
+      // the children are held by pointer in a List
+      size += sizeof(ASTNode*) + getMathSize(*math.getChild(n));
+    }
+
+  return size;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedMemoryUsage.
+ */
+SedMemoryUsage::SedMemoryUsage()
+{
+  reset();
+}
+
+
+/*
+ * Resets all counters to zero.
+ */
+void
+SedMemoryUsage::reset()
+{
+  for (int i = 0; i < SEDML_MEMORY_UNKNOWN; ++i)
+    {
+      mBytes[i] = 0;
+    }
+
+  mNumObjects = 0;
+  mBytesPerType.clear();
+  mObjectsPerType.clear();
+  mCurrentType = SEDML_UNKNOWN;
+  mCurrentSize = 0;
+}
+
+
+unsigned long
+SedMemoryUsage::getTotalBytes() const
+{
+  unsigned long total = 0;
+
+  for (int i = 0; i < SEDML_MEMORY_UNKNOWN; ++i)
+    {
+      total += mBytes[i];
+    }
+
+  return total;
+}
+
+
+unsigned long
+SedMemoryUsage::getBytes(SedMemoryCategory_t category) const
+{
+  if (category < SEDML_MEMORY_OBJECTS || category >= SEDML_MEMORY_UNKNOWN)
+    return 0;
+
+  return mBytes[category];
+}
+
+
+unsigned long
+SedMemoryUsage::getBytesForType(int typeCode) const
+{
+  map<int, unsigned long>::const_iterator it = mBytesPerType.find(typeCode);
+
+  return (it != mBytesPerType.end()) ? it->second : 0;
+}
+
+
+unsigned int
+SedMemoryUsage::getNumObjects() const
+{
+  return mNumObjects;
+}
+
+
+unsigned int
+SedMemoryUsage::getNumObjects(int typeCode) const
+{
+  map<int, unsigned int>::const_iterator it = mObjectsPerType.find(typeCode);
+
+  return (it != mObjectsPerType.end()) ? it->second : 0;
+}
+
+
+void
+SedMemoryUsage::setCountObjects(bool count)
+{
+  sCountObjects = count;
+}
+
+
+bool
+SedMemoryUsage::getCountObjects()
+{
+  return sCountObjects;
+}
+
+
+unsigned long
+SedMemoryUsage::getNumObjectsCreated()
+{
+  return sNumObjectsCreated;
+}
+
+
+unsigned long
+SedMemoryUsage::getNumObjectsDestroyed()
+{
+  return sNumObjectsDestroyed;
+}
+
+
+void
+SedMemoryUsage::resetObjectCounts()
+{
+  sNumObjectsCreated = 0;
+  sNumObjectsDestroyed = 0;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+void
+SedMemoryUsage::beginObject(int typeCode)
+{
+  mCurrentType = typeCode;
+  mCurrentSize = 0;
+}
+
+
+void
+SedMemoryUsage::setObjectSize(size_t size)
+{
+  mCurrentSize = size;
+}
+
+
+void
+SedMemoryUsage::endObject()
+{
+  addBytes(SEDML_MEMORY_OBJECTS, mCurrentSize);
+  ++mNumObjects;
+  ++mObjectsPerType[mCurrentType];
+  mCurrentSize = 0;
+}
+
+
+void
+SedMemoryUsage::addBytes(SedMemoryCategory_t category, size_t bytes)
+{
+  if (category < SEDML_MEMORY_OBJECTS || category >= SEDML_MEMORY_UNKNOWN)
+    return;
+
+  mBytes[category] += bytes;
+  mBytesPerType[mCurrentType] += bytes;
+}
+
+
+void
+SedMemoryUsage::addString(const std::string& str)
+{
+  addBytes(SEDML_MEMORY_STRINGS, getStringHeapSize(str));
+}
+
+
+void
+SedMemoryUsage::addMath(const ASTNode* math)
+{
+  if (math != NULL)
+    addBytes(SEDML_MEMORY_MATH, getMathSize(*math));
+}
+
+
+void
+SedMemoryUsage::addXML(const XMLNode* node)
+{
+  if (node != NULL)
+    addBytes(SEDML_MEMORY_XML, sizeof(XMLNode) + getXMLNodeHeapSize(*node));
+}
+
+
+void
+SedMemoryUsage::addNamespaces(const XMLNamespaces* xmlns)
+{
+  if (xmlns != NULL)
+    addBytes(SEDML_MEMORY_NAMESPACES, getNamespacesSize(*xmlns));
+}
+
+
+void
+SedMemoryUsage::addNamespaces(const SedNamespaces* sedns)
+{
+  if (sedns == NULL)
+    return;
+
+  addBytes(SEDML_MEMORY_NAMESPACES, sizeof(SedNamespaces));
+  addNamespaces(sedns->getNamespaces());
+}
+
+
+void
+SedMemoryUsage::addListOverhead(size_t bytes)
+{
+  addBytes(SEDML_MEMORY_LIST_OVERHEAD, bytes);
+}
+
+
+void
+SedMemoryUsage::objectCreated()
+{
+  if (sCountObjects)
+    ++sNumObjectsCreated;
+}
+
+
+void
+SedMemoryUsage::objectDestroyed()
+{
+  if (sCountObjects)
+    ++sNumObjectsDestroyed;
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+void
+SedMemoryUsage_free(SedMemoryUsage_t *usage)
+{
+  delete usage;
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getTotalBytes(const SedMemoryUsage_t *usage)
+{
+  return (usage != NULL) ? usage->getTotalBytes() : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getBytes(const SedMemoryUsage_t *usage,
+                        SedMemoryCategory_t category)
+{
+  return (usage != NULL) ? usage->getBytes(category) : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getBytesForType(const SedMemoryUsage_t *usage, int typeCode)
+{
+  return (usage != NULL) ? usage->getBytesForType(typeCode) : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedMemoryUsage_getNumObjects(const SedMemoryUsage_t *usage)
+{
+  return (usage != NULL) ? usage->getNumObjects() : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedMemoryUsage_getNumObjectsOfType(const SedMemoryUsage_t *usage,
+                                   int typeCode)
+{
+  return (usage != NULL) ? usage->getNumObjects(typeCode) : 0;
+}
+
+
+LIBSEDML_EXTERN
+void
+SedMemoryUsage_setCountObjects(int count)
+{
+  SedMemoryUsage::setCountObjects(count != 0);
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getNumObjectsCreated(void)
+{
+  return SedMemoryUsage::getNumObjectsCreated();
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getNumObjectsDestroyed(void)
+{
+  return SedMemoryUsage::getNumObjectsDestroyed();
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
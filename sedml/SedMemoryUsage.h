@@ -0,0 +1,336 @@
+/**
+ * @file    SedMemoryUsage.h
+ * @brief   Memory footprint of a Sed document
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedMemoryUsage
+ * @ingroup Core
+ * @brief Estimate of the memory held by a Sed document.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * SedDocument::getMemoryUsage() walks the objects of a document and adds
+ * up the memory each of them holds.  The bytes are broken down by the type
+ * of the object that holds them (see #SedTypeCode_t), and by the kind of
+ * data they store (see #SedMemoryCategory_t):
+ *
+ * @li the objects themselves;
+ * @li the characters of their strings, when they are not stored inline;
+ * @li their mathematical expressions (ASTNode);
+ * @li their notes, annotations and other XML content (XMLNode);
+ * @li their namespaces;
+ * @li the storage of their lists and vectors.
+ *
+ * The figures are estimates: they are computed from the sizes of the
+ * objects and the capacities of their containers, and do not include the
+ * bookkeeping of the memory allocator.
+ *
+ * In addition, SedMemoryUsage can count the Sed objects created and
+ * destroyed by the whole program, once setCountObjects() has been called;
+ * this is useful to find objects that are never deleted.
+ */
+
+#ifndef SedMemoryUsage_h
+#define SedMemoryUsage_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * @enum SedMemoryCategory_t
+ * The kinds of data into which SedMemoryUsage breaks down the memory held
+ * by a document.
+ */
+typedef enum
+{
+    SEDML_MEMORY_OBJECTS         /*!< the Sed objects themselves */
+  , SEDML_MEMORY_STRINGS         /*!< characters of strings not stored inline */
+  , SEDML_MEMORY_MATH            /*!< mathematical expressions */
+  , SEDML_MEMORY_XML             /*!< notes, annotations and other XML content */
+  , SEDML_MEMORY_NAMESPACES      /*!< namespaces */
+  , SEDML_MEMORY_LIST_OVERHEAD   /*!< storage of lists and vectors */
+  , SEDML_MEMORY_UNKNOWN         /*!< not a category; the number of categories */
+} SedMemoryCategory_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class XMLNamespaces;
+
+LIBSBML_CPP_NAMESPACE_END
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedNamespaces;
+
+
+class LIBSEDML_EXTERN SedMemoryUsage
+{
+public:
+
+  /**
+   * Creates a new, empty SedMemoryUsage.
+   */
+  SedMemoryUsage();
+
+
+  /**
+   * Resets all counters to zero.
+   */
+  void reset();
+
+
+  /**
+   * @return the total number of bytes held by the objects accounted.
+   */
+  unsigned long getTotalBytes() const;
+
+
+  /**
+   * @param category the kind of data sought.
+   *
+   * @return the number of bytes of the given kind held by the objects
+   * accounted.
+   */
+  unsigned long getBytes(SedMemoryCategory_t category) const;
+
+
+  /**
+   * @param typeCode the type code (see #SedTypeCode_t) of the objects
+   * sought.
+   *
+   * @return the number of bytes held by the objects of the given type.
+   */
+  unsigned long getBytesForType(int typeCode) const;
+
+
+  /**
+   * @return the number of objects accounted.
+   */
+  unsigned int getNumObjects() const;
+
+
+  /**
+   * @param typeCode the type code (see #SedTypeCode_t) of the objects
+   * sought.
+   *
+   * @return the number of objects of the given type accounted.
+   */
+  unsigned int getNumObjects(int typeCode) const;
+
+
+  /**
+   * Sets whether the constructors and destructor of SedBase count the Sed
+   * objects created and destroyed.  Counting is off by default; turning it
+   * on or off does not reset the counters.
+   *
+   * @param count @c true to count objects, @c false otherwise.
+   */
+  static void setCountObjects(bool count);
+
+
+  /**
+   * @return @c true if Sed objects are counted, @c false otherwise.
+   */
+  static bool getCountObjects();
+
+
+  /**
+   * @return the number of Sed objects created while counting was on.
+   */
+  static unsigned long getNumObjectsCreated();
+
+
+  /**
+   * @return the number of Sed objects destroyed while counting was on.
+   */
+  static unsigned long getNumObjectsDestroyed();
+
+
+  /**
+   * Resets the counts of objects created and destroyed to zero.
+   */
+  static void resetObjectCounts();
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Starts accounting an object of the given type.  Its size is that of
+   * SedBase until setObjectSize() is called.
+   */
+  void beginObject(int typeCode);
+
+  /**
+   * Sets the size of the object being accounted.  Each class sets its own
+   * size after calling the implementation of its parent, so that the size
+   * of the most derived class is kept.
+   */
+  void setObjectSize(size_t size);
+
+  /**
+   * Adds the object being accounted to the counters.
+   */
+  void endObject();
+
+  void addBytes(SedMemoryCategory_t category, size_t bytes);
+
+  void addString(const std::string& str);
+
+  void addMath(const ASTNode* math);
+
+  void addXML(const XMLNode* node);
+
+  void addNamespaces(const XMLNamespaces* xmlns);
+
+  void addNamespaces(const SedNamespaces* sedns);
+
+  void addListOverhead(size_t bytes);
+
+  static void objectCreated();
+
+  static void objectDestroyed();
+
+  /** @endcond */
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  unsigned long mBytes[SEDML_MEMORY_UNKNOWN];
+  unsigned int mNumObjects;
+  std::map<int, unsigned long> mBytesPerType;
+  std::map<int, unsigned int> mObjectsPerType;
+
+  int mCurrentType;
+  size_t mCurrentSize;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Frees the given SedMemoryUsage.
+ */
+LIBSEDML_EXTERN
+void
+SedMemoryUsage_free(SedMemoryUsage_t *usage);
+
+/**
+ * Returns the total number of bytes held by the objects accounted.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getTotalBytes(const SedMemoryUsage_t *usage);
+
+/**
+ * Returns the number of bytes of the given kind held by the objects
+ * accounted.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getBytes(const SedMemoryUsage_t *usage,
+                        SedMemoryCategory_t category);
+
+/**
+ * Returns the number of bytes held by the objects of the given type.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getBytesForType(const SedMemoryUsage_t *usage, int typeCode);
+
+/**
+ * Returns the number of objects accounted.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMemoryUsage_getNumObjects(const SedMemoryUsage_t *usage);
+
+/**
+ * Returns the number of objects of the given type accounted.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedMemoryUsage_getNumObjectsOfType(const SedMemoryUsage_t *usage,
+                                   int typeCode);
+
+/**
+ * Sets whether the Sed objects created and destroyed are counted.
+ */
+LIBSEDML_EXTERN
+void
+SedMemoryUsage_setCountObjects(int count);
+
+/**
+ * Returns the number of Sed objects created while counting was on.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getNumObjectsCreated(void);
+
+/**
+ * Returns the number of Sed objects destroyed while counting was on.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedMemoryUsage_getNumObjectsDestroyed(void);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedMemoryUsage_h */
@@ -0,0 +1,236 @@
+/**
+ * @file    SedMockBackend.cpp
+ * @brief   Implementation of SedMockBackend
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedMockBackend.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <map>
+#include <new>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The state of a model in a SedMockBackend: the values set, and the number
+ * of simulations run, since the last reset.
+ */
+class SedMockSession : public SedSimulationSession
+{
+public:
+
+  SedMockSession()
+    : mNumSimulations(0)
+  {
+  }
+
+
+  virtual int reset()
+  {
+    mValues.clear();
+    mNumSimulations = 0;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  virtual int setValue(const SedSetValue& change, double value)
+  {
+    if (change.getTarget().empty())
+      {
+        mErrorMessage = "the change has no target";
+        return LIBSEDML_INVALID_OBJECT;
+      }
+
+    mValues[change.getTarget()] = value;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  virtual int simulate(const SedSimulationRun& run,
+                       SedSimulationResult& result)
+  {
+    const SedSimulation* simulation = run.getSimulation();
+
+    if (simulation == NULL)
+      {
+        mErrorMessage = "the run has no simulation";
+        return LIBSEDML_INVALID_OBJECT;
+      }
+
+    double start = 0;
+    double step = 0;
+    unsigned int numPoints = 1;
+
+    if (simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+      {
+        const SedUniformTimeCourse* timeCourse =
+          static_cast<const SedUniformTimeCourse*>(simulation);
+        int numberOfPoints = timeCourse->getNumberOfPoints();
+
+        start = timeCourse->getOutputStartTime();
+
+        if (numberOfPoints > 0 && numberOfPoints != SEDML_INT_MAX)
+          {
+            numPoints = (unsigned int)numberOfPoints + 1;
+            step = (timeCourse->getOutputEndTime() - start) / numberOfPoints;
+          }
+      }
+
+    result.setSize(run.getNumVariables(), numPoints);
+
+    for (unsigned int n = 0; n < run.getNumVariables(); ++n)
+      {
+        const SedVariable* variable = run.getVariable(n);
+        const std::string& target = variable->getTarget().empty()
+          ? variable->getSymbol() : variable->getTarget();
+        map<string, double>::const_iterator set = mValues.find(target);
+        bool isTime = (target == "urn:sedml:symbol:time");
+        double* values = result.getColumn(n);
+
+        for (unsigned int p = 0; p < numPoints; ++p)
+          {
+            double time = start + p * step;
+
+            if (isTime)
+              values[p] = time;
+            else if (set != mValues.end())
+              values[p] = set->second;
+            else
+              values[p] = SedMockBackend::getValue(target, time,
+                                                   mNumSimulations);
+          }
+      }
+
+    ++mNumSimulations;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+private:
+
+  map<string, double> mValues;
+  unsigned int        mNumSimulations;
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedMockBackend.
+ */
+SedMockBackend::SedMockBackend(const std::string& language,
+                               const std::string& kisaoID)
+  : mLanguage(language)
+  , mKisaoID(kisaoID)
+{
+}
+
+
+/*
+ * Destructor for SedMockBackend.
+ */
+SedMockBackend::~SedMockBackend()
+{
+}
+
+
+/*
+ * @return true if this backend simulates such models with such algorithms.
+ */
+bool
+SedMockBackend::supports(const std::string& language,
+                         const std::string& kisaoID) const
+{
+  return (mLanguage.empty() || language == mLanguage)
+         && (mKisaoID.empty() || kisaoID == mKisaoID);
+}
+
+
+/*
+ * Loads a model.
+ */
+SedSimulationSession*
+SedMockBackend::createSession(const SedModel&) const
+{
+  return new(std::nothrow) SedMockSession();
+}
+
+
+/*
+ * @return the value sessions give to a variable.
+ */
+double
+SedMockBackend::getValue(const std::string& target, double time,
+                         unsigned int numSimulations)
+{
+  // FNV-1a, so that the values do not depend on the platform
+  unsigned long hash = 2166136261UL;
+
+  for (size_t n = 0; n < target.size(); ++n)
+    {
+      hash ^= (unsigned char)target[n];
+      hash = (hash * 16777619UL) & 0xffffffffUL;
+    }
+
+  return (hash % 1000) / 1000.0 + time + numSimulations;
+}
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedSimulationBackend_t *
+SedMockBackend_create(void)
+{
+  return new(std::nothrow) SedMockBackend();
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
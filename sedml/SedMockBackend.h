@@ -0,0 +1,160 @@
+/**
+ * @file    SedMockBackend.h
+ * @brief   Definition of SedMockBackend
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedMockBackend
+ * @ingroup Core
+ * @brief A SedSimulationBackend giving made-up, deterministic, results.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedMockBackend does not read models: it lets SedTaskExecutor, and the
+ * code using its results, be tested without a simulation tool.  Its
+ * sessions give:
+ *
+ * @li one output point per value of a SedUniformTimeCourse, from its
+ * output start time to its output end time, and a single point at time
+ * zero for the other simulations;
+ * @li for a variable with the symbol @c urn:sedml:symbol:time, the time;
+ * @li for a variable whose target has been set with setValue() since the
+ * last reset, the value set;
+ * @li for another variable, getValue() of its target, or of its symbol if
+ * it has no target, at the time, knowing how many simulations the session
+ * has run since it was last reset.
+ *
+ * The backend supports any language and any algorithm, unless it is
+ * restricted to one of each.
+ */
+
+#ifndef SedMockBackend_h
+#define SedMockBackend_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedSimulationBackend.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedMockBackend : public SedSimulationBackend
+{
+public:
+
+  /**
+   * Creates a new SedMockBackend, supporting the given language and
+   * algorithm.
+   *
+   * @param language the language supported, or an empty string for any.
+   * @param kisaoID the algorithm supported, or an empty string for any.
+   */
+  SedMockBackend(const std::string& language = "",
+                 const std::string& kisaoID = "");
+
+
+  /**
+   * Destructor for SedMockBackend.
+   */
+  virtual ~SedMockBackend();
+
+
+  /**
+   * @copydoc SedSimulationBackend::supports
+   */
+  virtual bool supports(const std::string& language,
+                        const std::string& kisaoID) const;
+
+
+  /**
+   * @copydoc SedSimulationBackend::createSession
+   */
+  virtual SedSimulationSession* createSession(const SedModel& model) const;
+
+
+  /**
+   * @param target the target of a variable.
+   * @param time the time of the output point.
+   * @param numSimulations the number of simulations run before, since the
+   * last reset.
+   *
+   * @return the value sessions give to the variable: a fraction derived
+   * from @p target, plus @p time, plus @p numSimulations.
+   */
+  static double getValue(const std::string& target, double time,
+                         unsigned int numSimulations);
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  std::string mLanguage;
+  std::string mKisaoID;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new SedMockBackend supporting any language and algorithm; free
+ * it with SedSimulationBackend_free().
+ */
+LIBSEDML_EXTERN
+SedSimulationBackend_t *
+SedMockBackend_create(void);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedMockBackend_h */
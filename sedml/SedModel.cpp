@@ -36,6 +36,7 @@
 
 #include <sedml/SedModel.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -229,7 +230,12 @@ SedModel::isSetSource() const
 int
 SedModel::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -239,6 +245,8 @@ SedModel::setId(const std::string& id)
 int
 SedModel::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -252,6 +260,8 @@ SedModel::setName(const std::string& name)
 int
 SedModel::setLanguage(const std::string& language)
 {
+  markDirty();
+
   {
     mLanguage = language;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -265,6 +275,8 @@ SedModel::setLanguage(const std::string& language)
 int
 SedModel::setSource(const std::string& source)
 {
+  markDirty();
+
   {
     mSource = source;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -278,6 +290,8 @@ SedModel::setSource(const std::string& source)
 int
 SedModel::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -297,6 +311,8 @@ SedModel::unsetId()
 int
 SedModel::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -316,6 +332,8 @@ SedModel::unsetName()
 int
 SedModel::unsetLanguage()
 {
+  markDirty();
+
   mLanguage.erase();
 
   if (mLanguage.empty() == true)
@@ -335,6 +353,8 @@ SedModel::unsetLanguage()
 int
 SedModel::unsetSource()
 {
+  markDirty();
+
   mSource.erase();
 
   if (mSource.empty() == true)
@@ -653,8 +673,65 @@ SedModel::writeElements(XMLOutputStream& stream) const
 bool
 SedModel::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mChanges.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedModel::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedModel));
+  usage.addString(mId);
+  usage.addString(mName);
+  usage.addString(mLanguage);
+  usage.addString(mSource);
+}
+
 
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedModel::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + 1;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedModel::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mChanges;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -959,6 +1036,7 @@ SedListOfModels::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedModel*>(item);
@@ -0,0 +1,698 @@
+/**
+ * @file    SedOdeSolver.cpp
+ * @brief   Implementation of SedOdeSolver
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedOdeSolver.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The Butcher tableau of the Dormand-Prince method: the nodes, the
+ * coefficients of the stages (the last row being the weights of the
+ * solution), and the weights of the error estimate.
+ */
+static const double DORMAND_PRINCE_C[6] =
+  { 1.0 / 5, 3.0 / 10, 4.0 / 5, 8.0 / 9, 1.0, 1.0 };
+
+static const double DORMAND_PRINCE_A[6][6] =
+  {
+    { 1.0 / 5 },
+    { 3.0 / 40, 9.0 / 40 },
+    { 44.0 / 45, -56.0 / 15, 32.0 / 9 },
+    { 19372.0 / 6561, -25360.0 / 2187, 64448.0 / 6561, -212.0 / 729 },
+    { 9017.0 / 3168, -355.0 / 33, 46732.0 / 5247, 49.0 / 176,
+      -5103.0 / 18656 },
+    { 35.0 / 384, 0.0, 500.0 / 1113, 125.0 / 192, -2187.0 / 6784,
+      11.0 / 84 }
+  };
+
+static const double DORMAND_PRINCE_E[7] =
+  { 71.0 / 57600, 0.0, -71.0 / 16695, 71.0 / 1920, -17253.0 / 339200,
+    22.0 / 525, -1.0 / 40 };
+
+/*
+ * The diagonal coefficient of the ROS2 method of Verwer et al.
+ */
+static const double ROSENBROCK_GAMMA = 1.0 + 1.0 / 1.4142135623730951;
+
+/** @endcond doxygen-libsedml-internal */
+
+
+SedOdeSystem::~SedOdeSystem()
+{
+}
+
+
+/*
+ * Creates a new SedOdeSolver.
+ */
+SedOdeSolver::SedOdeSolver()
+  : mMethod(SEDML_ODE_DORMAND_PRINCE)
+  , mRelativeTolerance(1e-6)
+  , mAbsoluteTolerance(1e-9)
+  , mMaxSteps(100000)
+  , mStep(0)
+  , mNumSteps(0)
+  , mNumStates(0)
+  , mFirstSameAsLast(false)
+{
+}
+
+
+/*
+ * Sets the integration method.
+ */
+int
+SedOdeSolver::setMethod(SedOdeMethod_t method)
+{
+  if (method != SEDML_ODE_DORMAND_PRINCE && method != SEDML_ODE_ROSENBROCK)
+    {
+      return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+  mMethod = method;
+  restart();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the integration method.
+ */
+SedOdeMethod_t
+SedOdeSolver::getMethod() const
+{
+  return mMethod;
+}
+
+
+/*
+ * Sets the relative tolerance of the local error of each step.
+ */
+int
+SedOdeSolver::setRelativeTolerance(double tolerance)
+{
+  if (!(tolerance > 0)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mRelativeTolerance = tolerance;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the relative tolerance of the local error of each step.
+ */
+double
+SedOdeSolver::getRelativeTolerance() const
+{
+  return mRelativeTolerance;
+}
+
+
+/*
+ * Sets the absolute tolerance of the local error of each step.
+ */
+int
+SedOdeSolver::setAbsoluteTolerance(double tolerance)
+{
+  if (!(tolerance > 0)) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mAbsoluteTolerance = tolerance;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the absolute tolerance of the local error of each step.
+ */
+double
+SedOdeSolver::getAbsoluteTolerance() const
+{
+  return mAbsoluteTolerance;
+}
+
+
+/*
+ * Sets the maximum number of steps of a call to integrate().
+ */
+void
+SedOdeSolver::setMaxSteps(unsigned long maxSteps)
+{
+  mMaxSteps = maxSteps;
+}
+
+
+/*
+ * @return the maximum number of steps of a call to integrate().
+ */
+unsigned long
+SedOdeSolver::getMaxSteps() const
+{
+  return mMaxSteps;
+}
+
+
+/*
+ * Forgets the step size.
+ */
+void
+SedOdeSolver::restart()
+{
+  mStep = 0;
+  mNumSteps = 0;
+}
+
+
+/*
+ * Integrates the members of an ensemble from one time to another.
+ */
+int
+SedOdeSolver::integrate(SedOdeSystem& system, unsigned int numMembers,
+                        double* states, double from, double to)
+{
+  mErrorMessage.clear();
+
+  if (states == NULL || !(to >= from)) return LIBSEDML_INVALID_OBJECT;
+
+  mNumStates = system.getNumStates();
+  size_t size = (size_t)mNumStates * numMembers;
+
+  if (size == 0 || to == from) return LIBSEDML_OPERATION_SUCCESS;
+
+  if (mNext.size() != size)
+    {
+      mStages.resize(7 * size);
+      mNext.resize(size);
+      mWork.resize(size);
+      mStep = 0;
+    }
+
+  // the derivatives at the first point, kept while it does not move
+  double* derivatives0 = &mStages[0];
+  mFirstSameAsLast = false;
+
+  double time = from;
+  double step = mStep;
+
+  if (step <= 0)
+    {
+      if (!derivatives(system, time, states, numMembers, derivatives0))
+        return LIBSEDML_OPERATION_FAILED;
+
+      mFirstSameAsLast = true;
+
+      double scale = errorNorm(numMembers, states, states, states);
+      double slope = errorNorm(numMembers, states, states, derivatives0);
+
+      step = (scale < 1e-5 || slope < 1e-5) ? 1e-6 : 0.01 * scale / slope;
+      step = std::min(step, to - from);
+    }
+
+  double exponent = (mMethod == SEDML_ODE_DORMAND_PRINCE) ? 1.0 / 5 : 1.0 / 2;
+  unsigned long numSteps = 0;
+
+  while (time < to)
+    {
+      if (numSteps >= mMaxSteps)
+        {
+          ostringstream message;
+          message << "more than " << mMaxSteps << " steps are needed from time "
+                  << from << " to time " << to;
+          mErrorMessage = message.str();
+          return LIBSEDML_OPERATION_FAILED;
+        }
+
+      // the last step ends exactly at the final time
+      double proposed = step;
+      bool last = (time + 1.01 * step >= to);
+      if (last) step = to - time;
+
+      double error = (mMethod == SEDML_ODE_DORMAND_PRINCE)
+        ? stepDormandPrince(system, numMembers, states, time, step)
+        : stepRosenbrock(system, numMembers, states, time, step);
+
+      if (error < 0) return LIBSEDML_OPERATION_FAILED;
+
+      if (error <= 1)
+        {
+          memcpy(states, &mNext[0], size * sizeof(double));
+          time = last ? to : time + step;
+          ++numSteps;
+          ++mNumSteps;
+
+          // the derivatives at the end of a Dormand-Prince step are those
+          // at the start of the next one
+          if (mMethod == SEDML_ODE_DORMAND_PRINCE)
+            memcpy(derivatives0, &mStages[6 * size], size * sizeof(double));
+          else
+            mFirstSameAsLast = false;
+
+          double factor = (error == 0)
+            ? 5.0 : std::min(5.0, std::max(0.2, 0.9 * pow(error, -exponent)));
+          step = std::max(step, last ? proposed : step) * factor;
+        }
+      else
+        {
+          step *= std::max(0.2, 0.9 * pow(error, -exponent));
+
+          if (step < 1e-12 * std::max(fabs(time), 1.0))
+            {
+              ostringstream message;
+              message << "the step size became too small at time " << time;
+              mErrorMessage = message.str();
+              return LIBSEDML_OPERATION_FAILED;
+            }
+        }
+    }
+
+  mStep = step;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the number of steps taken since the last restart().
+ */
+unsigned long
+SedOdeSolver::getNumSteps() const
+{
+  return mNumSteps;
+}
+
+
+/*
+ * @return the reason the last call to integrate() failed.
+ */
+const std::string&
+SedOdeSolver::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Computes the derivatives of the system, or sets the error message.
+ */
+bool
+SedOdeSolver::derivatives(SedOdeSystem& system, double time,
+                          const double* states, unsigned int numMembers,
+                          double* result)
+{
+  if (system.computeDerivatives(time, states, numMembers, result)
+      == LIBSEDML_OPERATION_SUCCESS)
+    return true;
+
+  ostringstream message;
+  message << "the derivatives could not be computed at time " << time;
+  mErrorMessage = message.str();
+  return false;
+}
+
+
+/*
+ * @return the largest, over the members, root mean square of the error of
+ * each state relative to its tolerance; infinity if it is not finite.
+ */
+double
+SedOdeSolver::errorNorm(unsigned int numMembers, const double* states,
+                        const double* next, const double* error)
+{
+  mNorms.assign(numMembers, 0.0);
+
+  for (unsigned int i = 0; i < mNumStates; ++i)
+    {
+      size_t offset = (size_t)i * numMembers;
+
+      for (unsigned int m = 0; m < numMembers; ++m)
+        {
+          double scale = mAbsoluteTolerance + mRelativeTolerance
+            * std::max(fabs(states[offset + m]), fabs(next[offset + m]));
+          double ratio = error[offset + m] / scale;
+          mNorms[m] += ratio * ratio;
+        }
+    }
+
+  double norm = 0;
+
+  for (unsigned int m = 0; m < numMembers; ++m)
+    {
+      double member = sqrt(mNorms[m] / mNumStates);
+
+      if (!(member <= DBL_MAX)) return DBL_MAX;
+
+      norm = std::max(norm, member);
+    }
+
+  return norm;
+}
+
+
+/*
+ * Computes a step of the Dormand-Prince method into mNext; returns its
+ * error norm, or -1 on failure.
+ */
+double
+SedOdeSolver::stepDormandPrince(SedOdeSystem& system,
+                                unsigned int numMembers,
+                                const double* states, double time,
+                                double step)
+{
+  size_t size = (size_t)mNumStates * numMembers;
+  double* stages[7];
+
+  for (unsigned int s = 0; s < 7; ++s)
+    {
+      stages[s] = &mStages[s * size];
+    }
+
+  if (!mFirstSameAsLast)
+    {
+      if (!derivatives(system, time, states, numMembers, stages[0]))
+        return -1;
+
+      mFirstSameAsLast = true;
+    }
+
+  for (unsigned int s = 1; s < 7; ++s)
+    {
+      // the last stage is evaluated at the solution
+      double* point = (s == 6) ? &mNext[0] : &mWork[0];
+      memcpy(point, states, size * sizeof(double));
+
+      for (unsigned int r = 0; r < s; ++r)
+        {
+          double weight = step * DORMAND_PRINCE_A[s - 1][r];
+          if (weight == 0) continue;
+
+          const double* stage = stages[r];
+
+          for (size_t j = 0; j < size; ++j)
+            {
+              point[j] += weight * stage[j];
+            }
+        }
+
+      if (!derivatives(system, time + DORMAND_PRINCE_C[s - 1] * step, point,
+                       numMembers, stages[s]))
+        return -1;
+    }
+
+  double* error = &mWork[0];
+  memset(error, 0, size * sizeof(double));
+
+  for (unsigned int r = 0; r < 7; ++r)
+    {
+      double weight = step * DORMAND_PRINCE_E[r];
+      if (weight == 0) continue;
+
+      const double* stage = stages[r];
+
+      for (size_t j = 0; j < size; ++j)
+        {
+          error[j] += weight * stage[j];
+        }
+    }
+
+  return errorNorm(numMembers, states, &mNext[0], error);
+}
+
+
+/*
+ * Computes a step of the ROS2 Rosenbrock method into mNext; returns its
+ * error norm, or -1 on failure.
+ */
+double
+SedOdeSolver::stepRosenbrock(SedOdeSystem& system, unsigned int numMembers,
+                             const double* states, double time, double step)
+{
+  size_t size = (size_t)mNumStates * numMembers;
+  double* derivatives0 = &mStages[0];
+  double* k1 = &mStages[size];
+  double* rhs = &mStages[2 * size];
+  double* k2 = &mStages[3 * size];
+
+  if (!mFirstSameAsLast)
+    {
+      if (!derivatives(system, time, states, numMembers, derivatives0))
+        return -1;
+
+      mFirstSameAsLast = true;
+    }
+
+  if (!computeJacobian(system, numMembers, states, time)) return -1;
+
+  // a singular matrix is avoided with a shorter step
+  if (!factorize(numMembers, step)) return DBL_MAX;
+
+  // (I - gamma h J) k1 = f(t, y)
+  solve(numMembers, derivatives0, k1);
+
+  // (I - gamma h J) k2 = f(t + h, y + h k1) - 2 k1
+  for (size_t j = 0; j < size; ++j)
+    {
+      mWork[j] = states[j] + step * k1[j];
+    }
+
+  if (!derivatives(system, time + step, &mWork[0], numMembers, rhs))
+    return -1;
+
+  for (size_t j = 0; j < size; ++j)
+    {
+      rhs[j] -= 2 * k1[j];
+    }
+
+  solve(numMembers, rhs, k2);
+
+  // the error is the difference with the linearly implicit Euler method
+  for (size_t j = 0; j < size; ++j)
+    {
+      mNext[j] = states[j] + step * (1.5 * k1[j] + 0.5 * k2[j]);
+      mWork[j] = 0.5 * step * (k1[j] + k2[j]);
+    }
+
+  return errorNorm(numMembers, states, &mNext[0], &mWork[0]);
+}
+
+
+/*
+ * Approximates the Jacobian matrix of each member by finite differences,
+ * perturbing one state of all the members at once.
+ */
+bool
+SedOdeSolver::computeJacobian(SedOdeSystem& system, unsigned int numMembers,
+                              const double* states, double time)
+{
+  size_t size = (size_t)mNumStates * numMembers;
+  const double* derivatives0 = &mStages[0];
+  double* perturbed = &mStages[4 * size];
+  const double delta = sqrt(DBL_EPSILON);
+
+  mJacobian.resize((size_t)mNumStates * size);
+  mNorms.resize(numMembers);
+  memcpy(&mWork[0], states, size * sizeof(double));
+
+  for (unsigned int i = 0; i < mNumStates; ++i)
+    {
+      double* column = &mWork[(size_t)i * numMembers];
+
+      for (unsigned int m = 0; m < numMembers; ++m)
+        {
+          mNorms[m] = delta * std::max(fabs(column[m]), 1e-6);
+          column[m] += mNorms[m];
+        }
+
+      if (!derivatives(system, time, &mWork[0], numMembers, perturbed))
+        return false;
+
+      // the derivative of f_r with respect to y_i
+      for (unsigned int r = 0; r < mNumStates; ++r)
+        {
+          size_t row = (size_t)r * numMembers;
+          double* entry = &mJacobian[((size_t)r * mNumStates + i) * numMembers];
+
+          for (unsigned int m = 0; m < numMembers; ++m)
+            {
+              entry[m] = (perturbed[row + m] - derivatives0[row + m])
+                         / mNorms[m];
+            }
+        }
+
+      memcpy(column, states + (size_t)i * numMembers,
+             numMembers * sizeof(double));
+    }
+
+  return true;
+}
+
+
+/*
+ * Computes the LU decomposition, with partial pivoting, of the matrix
+ * I - gamma h J of each member; returns false if one is singular.
+ */
+bool
+SedOdeSolver::factorize(unsigned int numMembers, double step)
+{
+  size_t n = mNumStates;
+
+  mLU.resize(n * n * numMembers);
+  mPivots.resize(n * numMembers);
+
+  for (unsigned int m = 0; m < numMembers; ++m)
+    {
+      double* lu = &mLU[n * n * m];
+      size_t* pivots = &mPivots[n * m];
+
+      for (size_t r = 0; r < n; ++r)
+        {
+          for (size_t c = 0; c < n; ++c)
+            {
+              lu[r * n + c] = (r == c ? 1.0 : 0.0) - ROSENBROCK_GAMMA * step
+                              * mJacobian[(r * n + c) * numMembers + m];
+            }
+        }
+
+      for (size_t k = 0; k < n; ++k)
+        {
+          size_t pivot = k;
+
+          for (size_t r = k + 1; r < n; ++r)
+            {
+              if (fabs(lu[r * n + k]) > fabs(lu[pivot * n + k])) pivot = r;
+            }
+
+          if (lu[pivot * n + k] == 0) return false;
+
+          pivots[k] = pivot;
+
+          if (pivot != k)
+            {
+              for (size_t c = 0; c < n; ++c)
+                {
+                  std::swap(lu[k * n + c], lu[pivot * n + c]);
+                }
+            }
+
+          for (size_t r = k + 1; r < n; ++r)
+            {
+              double factor = (lu[r * n + k] /= lu[k * n + k]);
+
+              for (size_t c = k + 1; c < n; ++c)
+                {
+                  lu[r * n + c] -= factor * lu[k * n + c];
+                }
+            }
+        }
+    }
+
+  return true;
+}
+
+
+/*
+ * Solves the factorized system of each member.
+ */
+void
+SedOdeSolver::solve(unsigned int numMembers, const double* rhs,
+                    double* result)
+{
+  size_t n = mNumStates;
+
+  mColumn.resize(n);
+
+  for (unsigned int m = 0; m < numMembers; ++m)
+    {
+      const double* lu = &mLU[n * n * m];
+      const size_t* pivots = &mPivots[n * m];
+      double* x = &mColumn[0];
+
+      for (size_t r = 0; r < n; ++r)
+        {
+          x[r] = rhs[r * numMembers + m];
+        }
+
+      for (size_t k = 0; k < n; ++k)
+        {
+          std::swap(x[k], x[pivots[k]]);
+        }
+
+      for (size_t r = 1; r < n; ++r)
+        {
+          for (size_t c = 0; c < r; ++c)
+            {
+              x[r] -= lu[r * n + c] * x[c];
+            }
+        }
+
+      for (size_t r = n; r-- > 0; )
+        {
+          for (size_t c = r + 1; c < n; ++c)
+            {
+              x[r] -= lu[r * n + c] * x[c];
+            }
+
+          x[r] /= lu[r * n + r];
+        }
+
+      for (size_t r = 0; r < n; ++r)
+        {
+          result[r * numMembers + m] = x[r];
+        }
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,325 @@
+/**
+ * @file    SedOdeSolver.h
+ * @brief   Definition of SedOdeSolver
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedOdeSolver
+ * @ingroup Core
+ * @brief Integrates ensembles of ordinary differential equation systems.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedOdeSolver integrates a SedOdeSystem with an adaptive step size,
+ * using one of the methods of #SedOdeMethod_t.  It is the integrator of
+ * SedSbmlBackend.
+ *
+ * The solver integrates several members of an ensemble at once: copies of
+ * the same system, each with its own states and parameters, as given by
+ * the iterations of a SedRepeatedTask.  The states are stored structure of
+ * arrays: the values of a state for all the members are contiguous, so
+ * that the arithmetic of the method runs over long columns the compiler
+ * vectorizes, and so that SedMathProgram computes the derivatives of all
+ * the members in one pass.  The members advance in lockstep, with the step
+ * size the least accurate of them needs.
+ * @code{.cpp}
+ * // state i of member m is states[i * numMembers + m]
+ * SedOdeSolver solver;
+ * solver.setMethod(SEDML_ODE_ROSENBROCK);
+ * for (unsigned int p = 1; p < numPoints; ++p)
+ *   if (solver.integrate(system, numMembers, &states[0],
+ *                        times[p - 1], times[p]) != LIBSEDML_OPERATION_SUCCESS)
+ *     cerr << solver.getErrorMessage() << endl;
+ * @endcode
+ */
+
+#ifndef SedOdeSolver_h
+#define SedOdeSolver_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * @enum SedOdeMethod_t
+ * The integration methods of SedOdeSolver.
+ */
+typedef enum
+{
+    SEDML_ODE_DORMAND_PRINCE   /*!< explicit Runge-Kutta method of order 5(4), for non-stiff systems */
+  , SEDML_ODE_ROSENBROCK       /*!< linearly implicit Rosenbrock method of order 2(1), for stiff systems */
+} SedOdeMethod_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/**
+ * @class SedOdeSystem
+ * @ingroup Core
+ * @brief The right-hand side of a system of ordinary differential
+ * equations, integrated by SedOdeSolver.
+ */
+class LIBSEDML_EXTERN SedOdeSystem
+{
+public:
+
+  /**
+   * Destructor method.
+   */
+  virtual ~SedOdeSystem();
+
+
+  /**
+   * @return the number of states of the system.
+   */
+  virtual unsigned int getNumStates() const = 0;
+
+
+  /**
+   * Computes the derivatives of the states of the members of an ensemble.
+   *
+   * @param time the time.
+   * @param states the states, state @c i of member @c m being
+   * <code>states[i * numMembers + m]</code>.
+   * @param numMembers the number of members.
+   * @param derivatives the derivatives, in the same layout as @p states.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int computeDerivatives(double time, const double* states,
+                                 unsigned int numMembers,
+                                 double* derivatives) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedOdeSolver
+{
+public:
+
+  /**
+   * Creates a new SedOdeSolver, using the Dormand-Prince method with a
+   * relative tolerance of 1e-6 and an absolute tolerance of 1e-9.
+   */
+  SedOdeSolver();
+
+
+  /**
+   * Sets the integration method.
+   *
+   * @param method the method.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p method is not a #SedOdeMethod_t.
+   */
+  int setMethod(SedOdeMethod_t method);
+
+
+  /**
+   * @return the integration method.
+   */
+  SedOdeMethod_t getMethod() const;
+
+
+  /**
+   * Sets the relative tolerance of the local error of each step.
+   *
+   * @param tolerance the tolerance, positive.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p tolerance is not positive.
+   */
+  int setRelativeTolerance(double tolerance);
+
+
+  /**
+   * @return the relative tolerance of the local error of each step.
+   */
+  double getRelativeTolerance() const;
+
+
+  /**
+   * Sets the absolute tolerance of the local error of each step.
+   *
+   * @param tolerance the tolerance, positive.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p tolerance is not positive.
+   */
+  int setAbsoluteTolerance(double tolerance);
+
+
+  /**
+   * @return the absolute tolerance of the local error of each step.
+   */
+  double getAbsoluteTolerance() const;
+
+
+  /**
+   * Sets the maximum number of steps of a call to integrate().
+   *
+   * @param maxSteps the number of steps.
+   */
+  void setMaxSteps(unsigned long maxSteps);
+
+
+  /**
+   * @return the maximum number of steps of a call to integrate().
+   */
+  unsigned long getMaxSteps() const;
+
+
+  /**
+   * Forgets the step size, before integrating another system or from
+   * other states.
+   */
+  void restart();
+
+
+  /**
+   * Integrates the members of an ensemble from one time to another.  The
+   * step size is kept from one call to the next, until restart() is
+   * called.
+   *
+   * @param system the system.
+   * @param numMembers the number of members.
+   * @param states the states at @p from, replaced by the states at @p to;
+   * see SedOdeSystem::computeDerivatives() for the layout.
+   * @param from the initial time.
+   * @param to the final time, not before @p from.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p states is @c NULL or @p to is before @p from.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the derivatives cannot be computed, or the step size becomes too
+   * small or the steps too many; see getErrorMessage().
+   */
+  int integrate(SedOdeSystem& system, unsigned int numMembers,
+                double* states, double from, double to);
+
+
+  /**
+   * @return the number of steps taken since the last restart().
+   */
+  unsigned long getNumSteps() const;
+
+
+  /**
+   * @return the reason the last call to integrate() failed, or an empty
+   * string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  double stepDormandPrince(SedOdeSystem& system, unsigned int numMembers,
+                           const double* states, double time, double step);
+
+  double stepRosenbrock(SedOdeSystem& system, unsigned int numMembers,
+                        const double* states, double time, double step);
+
+  bool computeJacobian(SedOdeSystem& system, unsigned int numMembers,
+                       const double* states, double time);
+
+  double errorNorm(unsigned int numMembers, const double* states,
+                   const double* next, const double* error);
+
+  bool factorize(unsigned int numMembers, double step);
+
+  void solve(unsigned int numMembers, const double* rhs, double* result);
+
+  bool derivatives(SedOdeSystem& system, double time, const double* states,
+                   unsigned int numMembers, double* result);
+
+  SedOdeMethod_t        mMethod;
+  double                mRelativeTolerance;
+  double                mAbsoluteTolerance;
+  unsigned long         mMaxSteps;
+  double                mStep;
+  unsigned long         mNumSteps;
+  unsigned int          mNumStates;
+  bool                  mFirstSameAsLast;
+  std::vector<double>   mStages;
+  std::vector<double>   mNext;
+  std::vector<double>   mWork;
+  std::vector<double>   mJacobian;
+  std::vector<double>   mLU;
+  std::vector<size_t>   mPivots;
+  std::vector<double>   mColumn;
+  std::vector<double>   mNorms;
+  std::string           mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedOdeSolver_h */
@@ -36,6 +36,7 @@
 
 #include <sedml/SedOneStep.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -145,6 +146,8 @@ SedOneStep::isSetStep() const
 int
 SedOneStep::setStep(double step)
 {
+  markDirty();
+
   mStep = step;
   mIsSetStep = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -157,6 +160,8 @@ SedOneStep::setStep(double step)
 int
 SedOneStep::unsetStep()
 {
+  markDirty();
+
   mStep = numeric_limits<double>::quiet_NaN();
   mIsSetStep = false;
 
@@ -244,8 +249,31 @@ SedOneStep::writeElements(XMLOutputStream& stream) const
 bool
 SedOneStep::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (mAlgorithm != NULL)
+        mAlgorithm->accept(v);
+    }
+
+  v.leave(*this);
 
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedOneStep::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedSimulation::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedOneStep));
 }
 
 
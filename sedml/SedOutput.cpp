@@ -36,6 +36,7 @@
 
 #include <sedml/SedOutput.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -177,7 +178,12 @@ SedOutput::isSetName() const
 int
 SedOutput::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -187,6 +193,8 @@ SedOutput::setId(const std::string& id)
 int
 SedOutput::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -200,6 +208,8 @@ SedOutput::setName(const std::string& name)
 int
 SedOutput::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -219,6 +229,8 @@ SedOutput::unsetId()
 int
 SedOutput::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -330,8 +342,28 @@ SedOutput::writeElements(XMLOutputStream& stream) const
 bool
 SedOutput::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedOutput::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedOutput));
+  usage.addString(mId);
+  usage.addString(mName);
 }
 
 
@@ -633,6 +665,7 @@ SedListOfOutputs::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedOutput*>(item);
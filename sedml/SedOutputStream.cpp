@@ -0,0 +1,384 @@
+/**
+ * @file    SedOutputStream.cpp
+ * @brief   Implementation of SedOutputStream, re-using cached subtree output
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include <sedml/SedOutputStream.h>
+#include <sedml/SedBase.h>
+#include <sedml/SedStatistics.h>
+#include <sedml/common/common.h>
+
+#ifdef LIBSEDML_USE_THREADS
+#include <thread>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/* the statistics of the elements written on this thread */
+static LIBSEDML_THREAD_LOCAL SedWriterStatistics* sWriteStatistics = NULL;
+
+
+SedWriteStatisticsScope::SedWriteStatisticsScope(SedWriterStatistics* stats)
+  : mPrevious(sWriteStatistics)
+{
+  sWriteStatistics = stats;
+}
+
+
+SedWriteStatisticsScope::SedWriteStatisticsScope(const SedBase& item,
+                                                 XMLOutputStream& stream)
+  : mPrevious(sWriteStatistics)
+{
+  if (item.getTypeCode() == SEDML_DOCUMENT)
+    {
+      SedOutputStream* sos = dynamic_cast<SedOutputStream*>(&stream);
+      sWriteStatistics = (sos != NULL) ? sos->getStatistics() : NULL;
+    }
+}
+
+
+SedWriteStatisticsScope::~SedWriteStatisticsScope()
+{
+  sWriteStatistics = mPrevious;
+}
+
+
+SedWriterStatistics*
+SedWriteStatisticsScope::getCurrent()
+{
+  return sWriteStatistics;
+}
+
+/** @endcond */
+
+
+/*
+ * Creates a new SedOutputStream that wraps stream.
+ */
+SedOutputStream::SedOutputStream(std::ostream&       stream
+                                 , const std::string&  encoding
+                                 , bool                writeXMLDecl
+                                 , const std::string&  programName
+                                 , const std::string&  programVersion)
+  : XMLOutputStream(stream, encoding, writeXMLDecl, programName,
+                    programVersion)
+  , mUseSubtreeCache(false)
+  , mCacheEpoch(0)
+  , mNumThreads(1)
+  , mStatistics(NULL)
+{
+}
+
+
+/*
+ * Destroys this SedOutputStream.
+ */
+SedOutputStream::~SedOutputStream()
+{
+}
+
+
+/*
+ * Sets whether writeCached() uses the subtree cache.
+ */
+void
+SedOutputStream::setUseSubtreeCache(bool useCache)
+{
+  mUseSubtreeCache = useCache;
+}
+
+
+/*
+ * @return true if writeCached() uses the subtree cache.
+ */
+bool
+SedOutputStream::getUseSubtreeCache() const
+{
+  return mUseSubtreeCache;
+}
+
+
+/*
+ * Sets the cache epoch of this stream.
+ */
+void
+SedOutputStream::setCacheEpoch(unsigned int epoch)
+{
+  mCacheEpoch = epoch;
+}
+
+
+/*
+ * @return the cache epoch of this stream.
+ */
+unsigned int
+SedOutputStream::getCacheEpoch() const
+{
+  return mCacheEpoch;
+}
+
+
+/*
+ * Sets the number of threads used by writeItems().
+ */
+void
+SedOutputStream::setNumThreads(unsigned int numThreads)
+{
+  mNumThreads = (numThreads == 0) ? 1 : numThreads;
+}
+
+
+/*
+ * @return the number of threads used by writeItems().
+ */
+unsigned int
+SedOutputStream::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+/*
+ * Sets the statistics this stream adds the elements it writes to.
+ */
+void
+SedOutputStream::setStatistics(SedWriterStatistics* stats)
+{
+  mStatistics = stats;
+}
+
+
+/*
+ * @return the statistics this stream adds the elements it writes to.
+ */
+SedWriterStatistics*
+SedOutputStream::getStatistics() const
+{
+  return mStatistics;
+}
+
+
+/*
+ * Terminates the start tag of the enclosing element, if still open.
+ */
+void
+SedOutputStream::closeStartElement()
+{
+  if (mInStart)
+    {
+      mInStart = false;
+      mStream << '>';
+      upIndent();
+    }
+}
+
+
+/*
+ * @return true if the cached output of item can be re-used.
+ */
+bool
+SedOutputStream::isCachedOutputValid(const SedBase& item) const
+{
+  return mUseSubtreeCache &&
+         !item.isDirty() &&
+         item.mWriteCache->indent == mIndent &&
+         item.mWriteCache->epoch  == mCacheEpoch;
+}
+
+
+/*
+ * Appends the serialized form of the given items to out.
+ */
+void
+SedOutputStream::renderItems(const std::vector<SedBase*>* items,
+                             size_t begin, size_t end,
+                             std::string* out,
+                             SedWriterStatistics* stats) const
+{
+  for (size_t n = begin; n < end; ++n)
+    {
+      const SedBase& item = *(*items)[n];
+
+      if (isCachedOutputValid(item))
+        {
+          out->append(item.mWriteCache->output);
+
+          if (stats != NULL)
+            stats->addCachedElement();
+
+          continue;
+        }
+
+      // render the element into a stream positioned at the same
+      // indentation; the element leaves the indentation as it found it
+      ostringstream buffer;
+      SedOutputStream sub(buffer, mEncoding, false);
+      sub.mDoIndent   = mDoIndent;
+      sub.mIndent     = mIndent;
+      sub.mStatistics = stats;
+
+      {
+        // chunks are rendered on other threads, with their own statistics
+        SedWriteStatisticsScope scope(stats);
+        item.write(sub);
+      }
+
+      if (mUseSubtreeCache)
+        {
+          if (item.mWriteCache == NULL)
+            item.mWriteCache = new SedWriteCache();
+
+          item.mWriteCache->output   = buffer.str();
+          item.mWriteCache->indent   = mIndent;
+          item.mWriteCache->epoch    = mCacheEpoch;
+          item.mWriteCache->revision = item.mRevision;
+          out->append(item.mWriteCache->output);
+        }
+      else
+        {
+          out->append(buffer.str());
+        }
+    }
+}
+
+
+/*
+ * Writes the given Sed object, re-using its cached output if possible.
+ */
+void
+SedOutputStream::writeCached(const SedBase& item)
+{
+  // inside text content the indentation of the element depends on what
+  // was written before it, so it is not cached
+  if (!mUseSubtreeCache || mInText)
+    {
+      item.write(*this);
+      return;
+    }
+
+  closeStartElement();
+
+  if (isCachedOutputValid(item))
+    {
+      mStream << item.mWriteCache->output;
+
+      if (mStatistics != NULL)
+        mStatistics->addCachedElement();
+
+      return;
+    }
+
+  std::vector<SedBase*> items(1, const_cast<SedBase*>(&item));
+  std::string output;
+  renderItems(&items, 0, 1, &output, mStatistics);
+  mStream << output;
+}
+
+
+/*
+ * Writes the given Sed objects in order, serializing chunks of them
+ * concurrently if more than one thread is configured.
+ */
+void
+SedOutputStream::writeItems(const std::vector<SedBase*>& items)
+{
+  size_t numChunks = items.size() / MIN_ITEMS_PER_CHUNK;
+
+  if (numChunks > mNumThreads) numChunks = mNumThreads;
+
+#ifndef LIBSEDML_USE_THREADS
+  numChunks = 1;
+#endif
+
+  if (numChunks < 2 || mInText)
+    {
+      for (size_t n = 0; n < items.size(); ++n)
+        {
+          writeCached(*items[n]);
+        }
+
+      return;
+    }
+
+  closeStartElement();
+
+  std::vector<std::string> chunks(numChunks);
+  // each chunk counts its elements separately, to be added up in order
+  std::vector<SedWriterStatistics> chunkStats(numChunks);
+  size_t chunkSize = (items.size() + numChunks - 1) / numChunks;
+
+#ifdef LIBSEDML_USE_THREADS
+  std::vector<std::thread> workers;
+
+  for (size_t c = 1; c < numChunks; ++c)
+    {
+      size_t begin = c * chunkSize;
+      size_t end   = std::min(begin + chunkSize, items.size());
+      workers.push_back(std::thread(&SedOutputStream::renderItems, this,
+                                    &items, begin, end, &chunks[c],
+                                    mStatistics != NULL ? &chunkStats[c] : NULL));
+    }
+
+  renderItems(&items, 0, std::min(chunkSize, items.size()), &chunks[0],
+              mStatistics);
+
+  for (size_t c = 0; c < workers.size(); ++c)
+    {
+      workers[c].join();
+    }
+#endif
+
+  for (size_t c = 0; c < numChunks; ++c)
+    {
+      mStream << chunks[c];
+
+      if (mStatistics != NULL && c > 0)
+        mStatistics->merge(chunkStats[c]);
+    }
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,302 @@
+/**
+ * @file    SedOutputStream.h
+ * @brief   XMLOutputStream that re-uses the cached output of unmodified elements
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedOutputStream
+ * @ingroup Core
+ * @brief XMLOutputStream re-using cached output of unmodified Sed objects.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * SedOutputStream is used by SedWriter when the subtree cache is enabled
+ * (see SedWriter::setUseSubtreeCache()).  Every element written through
+ * writeCached() keeps a copy of its serialized form together with the
+ * revision it was produced from (see SedBase::getRevision()).  Writing the
+ * element again copies the cached bytes as long as neither the element nor
+ * one of its children has been modified since, and the element is written
+ * at the same indentation and with the same document namespaces.
+ *
+ * The items of the top level lists of a SedDocument (models, simulations,
+ * tasks, data generators, outputs and data descriptions) are written
+ * through the cache, so that re-serializing a large document after a
+ * small edit only re-renders the top level elements containing the edit.
+ *
+ * The same lists can also be serialized by several threads at once (see
+ * SedWriter::setNumThreads()).  The elements of such a list are written
+ * at the same indentation and independently of each other, so contiguous
+ * chunks of it are rendered into separate buffers which are concatenated
+ * in order.
+ */
+
+#ifndef SedOutputStream_h
+#define SedOutputStream_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <sbml/xml/XMLOutputStream.h>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedWriterStatistics;
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The serialized form of an item, as last written by a SedOutputStream
+ * using the subtree cache, and the state it was written in.
+ */
+class SedWriteCache
+{
+public:
+  SedWriteCache() : revision(0), indent(0), epoch(0) {}
+
+  unsigned int revision;
+  unsigned int indent;
+  unsigned int epoch;
+  std::string  output;
+};
+
+
+/*
+ * Makes statistics those of the elements written on the calling thread
+ * while it exists, restoring the previous ones when it is destroyed.  A
+ * document looks up the statistics of the SedOutputStream it is written
+ * to once, so that its elements need not inspect the stream.
+ */
+class SedWriteStatisticsScope
+{
+public:
+
+  /*
+   * Installs the given statistics.
+   */
+  SedWriteStatisticsScope(SedWriterStatistics* stats);
+
+  /*
+   * Installs the statistics of the stream if item is a SedDocument, and
+   * leaves the current ones in place otherwise.
+   */
+  SedWriteStatisticsScope(const SedBase& item, XMLOutputStream& stream);
+
+  ~SedWriteStatisticsScope();
+
+  /*
+   * @return the statistics of the elements written on the calling thread,
+   * or NULL.
+   */
+  static SedWriterStatistics* getCurrent();
+
+private:
+
+  SedWriterStatistics* mPrevious;
+};
+
+/** @endcond */
+
+
+class LIBSEDML_EXTERN SedOutputStream : public XMLOutputStream
+{
+public:
+
+  /**
+   * Creates a new SedOutputStream that wraps the given @p stream.
+   *
+   * @param stream the stream to write to
+   * @param encoding the XML encoding to declare in the output
+   * @param writeXMLDecl whether to write a standard XML declaration
+   * @param programName an optional program name to write as a comment
+   * @param programVersion an optional version to write as a comment
+   */
+  SedOutputStream(std::ostream&       stream
+                  , const std::string&  encoding       = "UTF-8"
+                  , bool                writeXMLDecl   = true
+                  , const std::string&  programName    = ""
+                  , const std::string&  programVersion = "");
+
+
+  /**
+   * Destroys this SedOutputStream.
+   */
+  virtual ~SedOutputStream();
+
+
+  /**
+   * Sets whether writeCached() re-uses and records the serialized output
+   * of the elements written.
+   *
+   * @param useCache @c true to enable the cache, @c false to write every
+   * element afresh.
+   */
+  void setUseSubtreeCache(bool useCache);
+
+
+  /**
+   * @return @c true if writeCached() re-uses cached output, @c false
+   * otherwise.
+   */
+  bool getUseSubtreeCache() const;
+
+
+  /**
+   * Sets the cache epoch of this stream.  Cached output recorded under a
+   * different epoch is not re-used; the writer derives the epoch from the
+   * namespaces of the document (see SedDocument::getWriteCacheEpoch()).
+   *
+   * @param epoch the epoch to use.
+   */
+  void setCacheEpoch(unsigned int epoch);
+
+
+  /**
+   * @return the cache epoch of this stream.
+   */
+  unsigned int getCacheEpoch() const;
+
+
+  /**
+   * Writes the given Sed object to this stream, copying its cached output
+   * if it has not been modified since it was last written, and caching the
+   * freshly serialized output otherwise.
+   *
+   * @param item the Sed object to write.
+   */
+  void writeCached(const SedBase& item);
+
+
+  /**
+   * Sets the number of threads used by writeItems() to serialize long
+   * lists of elements.
+   *
+   * @param numThreads the number of threads to use; @c 0 and @c 1 write
+   * all elements on the calling thread.
+   */
+  void setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads used by writeItems().
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Writes the given Sed objects to this stream, in order.
+   *
+   * If more than one thread is configured and the list is long enough,
+   * contiguous chunks of the list are serialized concurrently into
+   * separate buffers that are then written in order; the output is the
+   * same as writing the objects one after the other.  Cached output is
+   * used as in writeCached() if the subtree cache is enabled.
+   *
+   * @param items the Sed objects to write.
+   */
+  void writeItems(const std::vector<SedBase*>& items);
+
+
+  /**
+   * The minimum number of elements each thread serializes in
+   * writeItems(); shorter lists are written on the calling thread.
+   */
+  static const unsigned int MIN_ITEMS_PER_CHUNK = 64;
+
+
+  /**
+   * Sets the statistics this stream adds the elements it writes to.
+   *
+   * @param stats the statistics to collect, or @c NULL (the default) to
+   * collect none.
+   */
+  void setStatistics(SedWriterStatistics* stats);
+
+
+  /**
+   * @return the statistics this stream adds the elements it writes to, or
+   * @c NULL.
+   */
+  SedWriterStatistics* getStatistics() const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * Terminates the start tag of the enclosing element, if still open, the
+   * way startElement() would before writing a child element.
+   */
+  void closeStartElement();
+
+
+  /**
+   * @return true if the cached output of the given item can be copied to
+   * this stream.
+   */
+  bool isCachedOutputValid(const SedBase& item) const;
+
+
+  /**
+   * Appends the serialized form of the items in [begin, end) to @p out,
+   * at the current indentation of this stream.
+   */
+  void renderItems(const std::vector<SedBase*>* items, size_t begin,
+                   size_t end, std::string* out,
+                   SedWriterStatistics* stats) const;
+
+
+  bool         mUseSubtreeCache;
+  unsigned int mCacheEpoch;
+  unsigned int mNumThreads;
+  SedWriterStatistics* mStatistics;
+
+  /** @endcond */
+};
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedOutputStream_h */
@@ -0,0 +1,214 @@
+/**
+ * @file    SedParallelTraversal.cpp
+ * @brief   Implementation of SedParallelTraversal
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedParallelTraversal.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedListOf.h>
+#include <sedml/SedWorkQueue.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <vector>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The subtrees to visit, shared between the threads, and the visitor of
+ * each thread.
+ */
+struct SedTraversalWork
+{
+  SedTraversalWork(const std::vector<const SedBase*>& items,
+                   const std::vector<SedMergeableVisitor*>& workers)
+    : items(items)
+    , workers(workers)
+    , queue(items.size(), (unsigned int)workers.size())
+  {
+  }
+
+  const std::vector<const SedBase*>&        items;
+  const std::vector<SedMergeableVisitor*>&  workers;
+  SedWorkQueue                              queue;
+};
+
+
+static void
+visitSubtrees(void* context, unsigned int thread)
+{
+  SedTraversalWork* work = static_cast<SedTraversalWork*>(context);
+  size_t index;
+
+  while (work->queue.next(thread, index))
+    {
+      work->items[index]->accept(*work->workers[thread]);
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+SedMergeableVisitor::~SedMergeableVisitor()
+{
+}
+
+
+/*
+ * Creates a new SedParallelTraversal.
+ */
+SedParallelTraversal::SedParallelTraversal(unsigned int numThreads)
+  : mNumThreads(1)
+{
+  setNumThreads(numThreads);
+}
+
+
+/*
+ * Sets the number of threads used to visit the document.
+ */
+int
+SedParallelTraversal::setNumThreads(unsigned int numThreads)
+{
+  if (numThreads > 1 && !SedWorkQueue::hasThreads())
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  if (numThreads == 0)
+    {
+      numThreads = SedWorkQueue::getNumProcessors();
+    }
+
+  mNumThreads = (numThreads == 0) ? 1 : numThreads;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the number of threads used to visit the document.
+ */
+unsigned int
+SedParallelTraversal::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+/*
+ * Visits the document and its lists with the given visitor, and the
+ * subtrees of the items of the lists with worker visitors.
+ */
+bool
+SedParallelTraversal::traverse(const SedDocument& doc,
+                               SedMergeableVisitor& visitor) const
+{
+  std::vector<const SedBase*> items;
+
+  // as with accept(), the lists are not visited (nor left) if the document
+  // is pruned, and the items of a pruned list are not visited
+  unsigned int numLists = visitor.enter(doc) ? doc.getNumChildObjects() : 0;
+
+  for (unsigned int n = 0; n < numLists; ++n)
+    {
+      const SedListOf* list = static_cast<const SedListOf*>(doc.getChildObject(n));
+
+      if (!visitor.enter(*list, list->getItemTypeCode()))
+        {
+          continue;
+        }
+
+      for (unsigned int i = 0; i < list->getNumChildObjects(); ++i)
+        {
+          items.push_back(list->getChildObject(i));
+        }
+    }
+
+  size_t numWorkers = mNumThreads;
+
+  if (numWorkers > items.size()) numWorkers = items.size();
+  if (numWorkers == 0) numWorkers = 1;
+
+  std::vector<SedMergeableVisitor*> workers;
+  bool success = true;
+
+  for (size_t w = 0; w < numWorkers && success; ++w)
+    {
+      SedMergeableVisitor* worker = visitor.createWorker();
+
+      if (worker != NULL)
+        workers.push_back(worker);
+      else
+        success = false;
+    }
+
+  if (success)
+    {
+      SedTraversalWork work(items, workers);
+      SedWorkQueue::run((unsigned int)numWorkers, visitSubtrees, &work);
+
+      for (size_t w = 0; w < workers.size(); ++w)
+        {
+          visitor.merge(*workers[w]);
+        }
+    }
+
+  for (size_t w = 0; w < workers.size(); ++w)
+    {
+      delete workers[w];
+    }
+
+  for (unsigned int n = 0; n < numLists; ++n)
+    {
+      const SedListOf* list = static_cast<const SedListOf*>(doc.getChildObject(n));
+      visitor.leave(*list, list->getItemTypeCode());
+    }
+
+  visitor.leave(doc);
+
+  return success;
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
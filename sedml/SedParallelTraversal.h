@@ -0,0 +1,192 @@
+/**
+ * @file    SedParallelTraversal.h
+ * @brief   Visits the objects of a SedDocument on several threads
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedParallelTraversal
+ * @ingroup Core
+ * @brief Visits the objects of a SedDocument on several threads.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * SedParallelTraversal runs a visitor over a document like
+ * SedDocument::accept(), but spreads the subtrees of the items of the six
+ * top level lists (each model, task, data generator, and so on, with all
+ * the objects nested in it) over several threads.  It suits expensive
+ * analyses of every object, such as checking math or resolving references.
+ *
+ * The visitor is a SedMergeableVisitor.  Each thread visits its subtrees
+ * with its own worker visitor, created by
+ * SedMergeableVisitor::createWorker(), so that the visitors need no
+ * locking; once all subtrees have been visited, the workers are merged
+ * into the visitor with SedMergeableVisitor::merge(), in order, and
+ * deleted.  The document and its six lists are visited and left by the
+ * visitor itself, on the calling thread: the document and the lists
+ * first, in document order, then the subtrees, then the lists are left
+ * and finally the document.
+ *
+ * Each subtree is visited depth first, as with accept(), and returning
+ * @c false from a <code>visit</code> method still prunes the subtree below
+ * an item, as does returning @c false from <code>enter</code> for the
+ * document or a list.  The order in which different subtrees are visited, and the
+ * worker visiting each of them, are not specified.  The threads start
+ * with equal shares of the subtrees, and a thread that has finished its
+ * share takes half of the remaining share of another one, so that a few
+ * large subtrees do not hold up the traversal.
+ *
+ * The visitors must not modify the document, and must only call const
+ * methods of its objects.  Frozen documents (see SedDocument::freeze())
+ * are safe to traverse from any number of threads.
+ *
+ * When libSEDML is built without thread support (WITH_THREADS), the
+ * traversal uses a single worker on the calling thread.
+ */
+
+#ifndef SedParallelTraversal_h
+#define SedParallelTraversal_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedVisitor.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+
+
+/**
+ * @class SedMergeableVisitor
+ * @ingroup Core
+ * @brief A SedVisitor whose state can be split between threads.
+ *
+ * The visitor used by SedParallelTraversal: it creates the worker visitors
+ * of the threads, and adds up their results at the end.
+ */
+class LIBSEDML_EXTERN SedMergeableVisitor : public SedVisitor
+{
+public:
+
+  /**
+   * Destructor method.
+   */
+  virtual ~SedMergeableVisitor();
+
+
+  /**
+   * Creates a worker visitor with the same settings as this visitor but
+   * empty results, to be used by a single thread.
+   *
+   * @return a new visitor, owned by the caller; or @c NULL on failure.
+   */
+  virtual SedMergeableVisitor* createWorker() const = 0;
+
+
+  /**
+   * Adds the results of a worker visitor, created by createWorker() on this
+   * visitor, to the results of this visitor.
+   *
+   * @param worker the worker visitor to merge.
+   */
+  virtual void merge(const SedMergeableVisitor& worker) = 0;
+};
+
+
+class LIBSEDML_EXTERN SedParallelTraversal
+{
+public:
+
+  /**
+   * Creates a new SedParallelTraversal.
+   *
+   * @param numThreads the number of threads to use; @c 0 uses as many
+   * threads as the hardware runs concurrently.
+   */
+  SedParallelTraversal(unsigned int numThreads = 0);
+
+
+  /**
+   * Sets the number of threads used to visit the document.
+   *
+   * @param numThreads the number of threads; @c 0 uses as many threads as
+   * the hardware runs concurrently.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if more than one thread is requested and libSEDML was built without
+   * thread support.
+   */
+  int setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads used to visit the document.
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Visits @p doc with @p visitor, using the threads of this traversal.
+   *
+   * @param doc the document to visit.
+   * @param visitor the visitor, which receives the merged results.
+   *
+   * @return @c true on success, @c false if a worker visitor could not be
+   * created.
+   */
+  bool traverse(const SedDocument& doc, SedMergeableVisitor& visitor) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  unsigned int mNumThreads;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedParallelTraversal_h */
@@ -36,6 +36,7 @@
 
 #include <sedml/SedParameter.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -193,7 +194,12 @@ SedParameter::isSetValue() const
 int
 SedParameter::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -203,6 +209,8 @@ SedParameter::setId(const std::string& id)
 int
 SedParameter::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -216,6 +224,8 @@ SedParameter::setName(const std::string& name)
 int
 SedParameter::setValue(double value)
 {
+  markDirty();
+
   mValue = value;
   mIsSetValue = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -228,6 +238,8 @@ SedParameter::setValue(double value)
 int
 SedParameter::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -247,6 +259,8 @@ SedParameter::unsetId()
 int
 SedParameter::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -266,6 +280,8 @@ SedParameter::unsetName()
 int
 SedParameter::unsetValue()
 {
+  markDirty();
+
   mValue = numeric_limits<double>::quiet_NaN();
   mIsSetValue = false;
 
@@ -342,8 +358,28 @@ SedParameter::writeElements(XMLOutputStream& stream) const
 bool
 SedParameter::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
 
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedParameter::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedParameter));
+  usage.addString(mId);
+  usage.addString(mName);
 }
 
 
@@ -618,6 +654,7 @@ SedListOfParameters::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedParameter*>(item);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedPlot2D.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -189,6 +190,8 @@ SedPlot2D::isSetLogY() const
 int
 SedPlot2D::setLogX(bool logX)
 {
+  markDirty();
+
   mLogX = logX;
   mIsSetLogX = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -201,6 +204,8 @@ SedPlot2D::setLogX(bool logX)
 int
 SedPlot2D::setLogY(bool logY)
 {
+  markDirty();
+
   mLogY = logY;
   mIsSetLogY = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -213,6 +218,8 @@ SedPlot2D::setLogY(bool logY)
 int
 SedPlot2D::unsetLogX()
 {
+  markDirty();
+
   mLogX = false;
   mIsSetLogX = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -225,6 +232,8 @@ SedPlot2D::unsetLogX()
 int
 SedPlot2D::unsetLogY()
 {
+  markDirty();
+
   mLogY = false;
   mIsSetLogY = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -464,8 +473,61 @@ SedPlot2D::writeElements(XMLOutputStream& stream) const
 bool
 SedPlot2D::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mCurves.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
 
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedPlot2D::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedOutput::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedPlot2D));
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedPlot2D::getNumChildObjects() const
+{
+  return SedOutput::getNumChildObjects() + 1;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedPlot2D::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedOutput::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedOutput::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mCurves;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -36,6 +36,7 @@
 
 #include <sedml/SedPlot3D.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -354,8 +355,61 @@ SedPlot3D::writeElements(XMLOutputStream& stream) const
 bool
 SedPlot3D::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mSurfaces.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedPlot3D::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedOutput::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedPlot3D));
+}
 
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedPlot3D::getNumChildObjects() const
+{
+  return SedOutput::getNumChildObjects() + 1;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedPlot3D::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedOutput::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedOutput::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mSurfaces;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -0,0 +1,555 @@
+/**
+ * @file    SedRangeValues.cpp
+ * @brief   Implementation of SedRangeValues
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedRangeValues.h>
+#include <sedml/SedFunctionalRange.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedUniformRange.h>
+#include <sedml/SedVectorRange.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <new>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/*
+ * Creates a new SedRangeValues, without a range.
+ */
+SedRangeValues::SedRangeValues()
+  : mRange(NULL)
+  , mTypeCode(SEDML_UNKNOWN)
+  , mSize(0)
+  , mStart(0.0)
+  , mEnd(0.0)
+  , mOrigin(0.0)
+  , mStep(0.0)
+  , mSign(1.0)
+  , mLog(false)
+  , mVector(NULL)
+  , mReferenced(NULL)
+{
+}
+
+
+/*
+ * Destructor for SedRangeValues.
+ */
+SedRangeValues::~SedRangeValues()
+{
+  delete mReferenced;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Forgets the range.
+ */
+void
+SedRangeValues::clear()
+{
+  mRange = NULL;
+  mTypeCode = SEDML_UNKNOWN;
+  mSize = 0;
+  mLog = false;
+  mVector = NULL;
+  delete mReferenced;
+  mReferenced = NULL;
+  mProgram = SedMathProgram();
+  mVariableValues.clear();
+  mVariableColumns.clear();
+  mErrorMessage.clear();
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Prepares the expansion of the given range.
+ */
+int
+SedRangeValues::setRange(const SedRange& range)
+{
+  return setRange(range, 0);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Prepares the expansion of the given range, referenced through depth
+ * functional ranges.
+ */
+int
+SedRangeValues::setRange(const SedRange& range, unsigned int depth)
+{
+  clear();
+
+  int result = LIBSEDML_INVALID_OBJECT;
+
+  switch (range.getTypeCode())
+    {
+    case SEDML_RANGE_UNIFORMRANGE:
+      result = setUniformRange(range);
+      break;
+
+    case SEDML_RANGE_VECTORRANGE:
+      {
+        const std::vector<double>& values =
+          static_cast<const SedVectorRange&>(range).getValues();
+
+        mVector = values.empty() ? NULL : &values[0];
+        mSize = (unsigned int)values.size();
+        result = LIBSEDML_OPERATION_SUCCESS;
+      }
+      break;
+
+    case SEDML_RANGE_FUNCTIONALRANGE:
+      result = setFunctionalRange(range, depth);
+      break;
+
+    default:
+      mErrorMessage = "unknown kind of range";
+      break;
+    }
+
+  if (result != LIBSEDML_OPERATION_SUCCESS)
+    {
+      std::string message;
+      message.swap(mErrorMessage);
+      clear();
+      mErrorMessage.swap(message);
+      return result;
+    }
+
+  mRange = &range;
+  mTypeCode = range.getTypeCode();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Prepares the expansion of a uniform range.
+ */
+int
+SedRangeValues::setUniformRange(const SedRange& range)
+{
+  const SedUniformRange& uniform = static_cast<const SedUniformRange&>(range);
+
+  if (!uniform.isSetStart() || !uniform.isSetEnd()
+      || !uniform.isSetNumberOfPoints() || uniform.getNumberOfPoints() < 0)
+    {
+      mErrorMessage = "missing start, end or numberOfPoints";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  const std::string& type = uniform.getType();
+
+  if (type == "log")
+    {
+      mLog = true;
+    }
+  else if (!type.empty() && type != "linear")
+    {
+      mErrorMessage = "unknown type '" + type + "'";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  mStart = uniform.getStart();
+  mEnd = uniform.getEnd();
+
+  if (mLog && !(mStart * mEnd > 0))
+    {
+      mErrorMessage = "log range with bounds of different signs or zero";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  unsigned int numIntervals = (unsigned int)uniform.getNumberOfPoints();
+  mSize = numIntervals + 1;
+  mSign = (mStart < 0) ? -1.0 : 1.0;
+  mOrigin = mLog ? log(fabs(mStart)) : mStart;
+
+  double end = mLog ? log(fabs(mEnd)) : mEnd;
+  mStep = (numIntervals > 0) ? (end - mOrigin) / numIntervals : 0.0;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Prepares the expansion of a functional range: expands the range it
+ * references and compiles its math, whose inputs are the referenced range
+ * then the variables.
+ */
+int
+SedRangeValues::setFunctionalRange(const SedRange& range, unsigned int depth)
+{
+  const SedFunctionalRange& functional =
+    static_cast<const SedFunctionalRange&>(range);
+  const SedRepeatedTask* task = static_cast<const SedRepeatedTask*>(
+    range.getAncestorOfType(SEDML_TASK_REPEATEDTASK));
+
+  if (task == NULL)
+    {
+      mErrorMessage = "functional range outside a repeated task";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  const std::string& id = functional.isSetRange() ? functional.getRange()
+                                                  : task->getRangeId();
+  const SedRange* referenced = task->getRange(id);
+
+  if (referenced == NULL || referenced == &range)
+    {
+      mErrorMessage = "no range '" + id + "' to iterate over";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  if (depth >= task->getNumRanges())
+    {
+      mErrorMessage = "ranges referencing each other in a cycle";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  mReferenced = new SedRangeValues();
+
+  int result = mReferenced->setRange(*referenced, depth + 1);
+
+  if (result != LIBSEDML_OPERATION_SUCCESS)
+    {
+      mErrorMessage = mReferenced->getErrorMessage();
+      return result;
+    }
+
+  std::vector<std::string> inputIds(1, id);
+  std::map<std::string, double> constants;
+
+  for (unsigned int n = 0; n < functional.getNumVariables(); ++n)
+    {
+      inputIds.push_back(functional.getVariable(n)->getId());
+    }
+
+  for (unsigned int n = 0; n < functional.getNumParameters(); ++n)
+    {
+      const SedParameter* parameter = functional.getParameter(n);
+
+      if (parameter->isSetValue())
+        constants[parameter->getId()] = parameter->getValue();
+    }
+
+  result = mProgram.compile(functional.getMath(), inputIds, constants);
+
+  if (result != LIBSEDML_OPERATION_SUCCESS)
+    {
+      mErrorMessage = mProgram.getErrorMessage();
+      return result;
+    }
+
+  mSize = mReferenced->getSize();
+  mVariableValues.assign(functional.getNumVariables(),
+                         numeric_limits<double>::quiet_NaN());
+  mVariableColumns.assign(functional.getNumVariables(), NULL);
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the index of the variable with the given id, or -1.
+ */
+int
+SedRangeValues::findVariable(const std::string& id) const
+{
+  for (unsigned int n = 1; n < mProgram.getNumInputs(); ++n)
+    {
+      if (mProgram.getInputId(n) == id) return (int)n - 1;
+    }
+
+  return -1;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * @return the range being expanded.
+ */
+const SedRange*
+SedRangeValues::getRange() const
+{
+  return mRange;
+}
+
+
+/*
+ * @return the reason the last call to setRange() failed.
+ */
+const std::string&
+SedRangeValues::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/*
+ * @return the number of values of the range.
+ */
+unsigned int
+SedRangeValues::getSize() const
+{
+  return mSize;
+}
+
+
+/*
+ * Sets the same value of a variable for every iteration.
+ */
+int
+SedRangeValues::setVariableValue(const std::string& id, double value)
+{
+  int n = findVariable(id);
+
+  if (n < 0) return LIBSEDML_INVALID_OBJECT;
+
+  mVariableValues[n] = value;
+  mVariableColumns[n] = NULL;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets the values of a variable, one per iteration.
+ */
+int
+SedRangeValues::setVariableValues(const std::string& id, const double* values)
+{
+  int n = findVariable(id);
+
+  if (n < 0 || values == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  mVariableColumns[n] = values;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the expansion of the range a functional range references.
+ */
+SedRangeValues*
+SedRangeValues::getReferencedValues()
+{
+  return mReferenced;
+}
+
+
+/*
+ * Computes a chunk of the values of the range.
+ */
+const double*
+SedRangeValues::getValues(unsigned int first, unsigned int count,
+                          double* buffer) const
+{
+  if (mRange == NULL || first > mSize || count > mSize - first) return NULL;
+
+  if (mTypeCode == SEDML_RANGE_VECTORRANGE)
+    return (mVector != NULL) ? mVector + first : buffer;
+
+  if (buffer == NULL) return NULL;
+
+  if (count == 0) return buffer;
+
+  if (mTypeCode == SEDML_RANGE_UNIFORMRANGE)
+    {
+      if (mLog)
+        {
+          for (unsigned int n = 0; n < count; ++n)
+            {
+              buffer[n] = mSign * exp(mOrigin + (first + n) * mStep);
+            }
+        }
+      else
+        {
+          for (unsigned int n = 0; n < count; ++n)
+            {
+              buffer[n] = mOrigin + (first + n) * mStep;
+            }
+        }
+
+      // the bounds are exact, whatever the rounding of the steps
+      if (first == 0) buffer[0] = mStart;
+      if (first + count == mSize && mSize > 1) buffer[count - 1] = mEnd;
+
+      return buffer;
+    }
+
+  // a functional range: the chunk of the referenced range, and one column
+  // per variable, filled for the variables with a single value
+  unsigned int numVariables = (unsigned int)mVariableValues.size();
+  std::vector<double> storage((size_t)count * (numVariables + 1));
+  std::vector<const double*> inputs(numVariables + 1);
+
+  inputs[0] = mReferenced->getValues(first, count, &storage[0]);
+
+  for (unsigned int n = 0; n < numVariables; ++n)
+    {
+      if (mVariableColumns[n] != NULL)
+        {
+          inputs[n + 1] = mVariableColumns[n] + first;
+        }
+      else
+        {
+          double* column = &storage[(size_t)count * (n + 1)];
+          std::fill(column, column + count, mVariableValues[n]);
+          inputs[n + 1] = column;
+        }
+    }
+
+  if (mProgram.evaluate(&inputs[0], count, buffer)
+      != LIBSEDML_OPERATION_SUCCESS)
+    return NULL;
+
+  return buffer;
+}
+
+
+/*
+ * Copies all the values of the range.
+ */
+int
+SedRangeValues::getValues(std::vector<double>& values) const
+{
+  if (mRange == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  values.resize(mSize);
+
+  if (mSize == 0) return LIBSEDML_OPERATION_SUCCESS;
+
+  const double* chunk = getValues(0, mSize, &values[0]);
+
+  if (chunk == NULL) return LIBSEDML_OPERATION_FAILED;
+
+  if (chunk != &values[0])
+    std::copy(chunk, chunk + mSize, values.begin());
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the nth value of the range.
+ */
+double
+SedRangeValues::getValue(unsigned int n) const
+{
+  double value = numeric_limits<double>::quiet_NaN();
+  const double* chunk = getValues(n, 1, &value);
+
+  return (chunk != NULL) ? *chunk : numeric_limits<double>::quiet_NaN();
+}
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedRangeValues_t *
+SedRangeValues_create(void)
+{
+  return new(std::nothrow) SedRangeValues();
+}
+
+
+LIBSEDML_EXTERN
+void
+SedRangeValues_free(SedRangeValues_t *values)
+{
+  delete values;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedRangeValues_setRange(SedRangeValues_t *values, const SedRange_t *range)
+{
+  if (values == NULL || range == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return values->setRange(*range);
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedRangeValues_getSize(const SedRangeValues_t *values)
+{
+  return (values != NULL) ? values->getSize() : 0;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedRangeValues_setVariableValue(SedRangeValues_t *values, const char *id,
+                                double value)
+{
+  if (values == NULL || id == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return values->setVariableValue(id, value);
+}
+
+
+LIBSEDML_EXTERN
+const double *
+SedRangeValues_getValues(const SedRangeValues_t *values, unsigned int first,
+                         unsigned int count, double *buffer)
+{
+  return (values != NULL) ? values->getValues(first, count, buffer) : NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,351 @@
+/**
+ * @file    SedRangeValues.h
+ * @brief   Definition of SedRangeValues
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedRangeValues
+ * @ingroup Core
+ * @brief The values a range of a repeated task iterates over.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedRangeValues expands a SedRange into the sequence of values a
+ * SedRepeatedTask iterates over, so that tools running a parameter sweep
+ * need not interpret each kind of range themselves:
+ *
+ * @li a SedUniformRange yields <code>numberOfPoints + 1</code> values from
+ * its start to its end, spaced evenly (type @c linear, the default) or
+ * evenly on a logarithmic scale (type @c log);
+ * @li a SedVectorRange yields its values;
+ * @li a SedFunctionalRange yields its math evaluated once per value of the
+ * range it references, which its math refers to by the id of that range.
+ * Its parameters are constants, and the values of its variables, which
+ * come from the model being simulated, are given with setVariableValue()
+ * or setVariableValues().  A functional range that references no range
+ * iterates over the range of its repeated task.
+ *
+ * The values are not stored: getValues() computes a chunk of them on
+ * request, into a buffer given by the caller, so huge ranges can be
+ * streamed in pieces of constant size.  The values of a vector range are
+ * not copied: getValues() returns a pointer into the vector of the range,
+ * which stays valid until the range is modified or destroyed.  The math of
+ * a functional range is compiled once into a SedMathProgram and evaluated
+ * over the whole chunk at once.
+ * @code{.cpp}
+ * SedRangeValues values;
+ * if (values.setRange(*range) == LIBSEDML_OPERATION_SUCCESS)
+ *   {
+ *     double buffer[SEDML_MATH_BLOCK_SIZE];
+ *     for (unsigned int first = 0; first < values.getSize();
+ *          first += SEDML_MATH_BLOCK_SIZE)
+ *       {
+ *         unsigned int count = std::min(values.getSize() - first,
+ *                                       (unsigned int)SEDML_MATH_BLOCK_SIZE);
+ *         const double* chunk = values.getValues(first, count, buffer);
+ *         // ... run the iterations first to first + count - 1 ...
+ *       }
+ *   }
+ * @endcode
+ *
+ * The range, and the range it references, must outlive the SedRangeValues
+ * and not be modified while it is used; setRange() must then be called
+ * again.  getValues() does not modify the SedRangeValues, and may be
+ * called from several threads at the same time.
+ */
+
+#ifndef SedRangeValues_h
+#define SedRangeValues_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+#include <sedml/SedMathProgram.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedRange;
+
+
+class LIBSEDML_EXTERN SedRangeValues
+{
+public:
+
+  /**
+   * Creates a new SedRangeValues, without a range.
+   */
+  SedRangeValues();
+
+
+  /**
+   * Destructor for SedRangeValues.
+   */
+  ~SedRangeValues();
+
+
+  /**
+   * Prepares the expansion of the given range.  The range a functional
+   * range references is looked up in the repeated task containing it, and
+   * expanded as well; the values of the variables of a functional range
+   * are reset to NaN.
+   *
+   * @param range the range to expand.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if an attribute needed is missing or invalid, or the range a
+   * functional range references cannot be found; see getErrorMessage().
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math of a functional range cannot be compiled, or the ranges
+   * reference each other in a cycle; see getErrorMessage().
+   */
+  int setRange(const SedRange& range);
+
+
+  /**
+   * @return the range being expanded, or @c NULL if none has been set
+   * successfully.
+   */
+  const SedRange* getRange() const;
+
+
+  /**
+   * @return the reason the last call to setRange() failed, or an empty
+   * string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+  /**
+   * @return the number of values of the range, or @c 0 if no range has
+   * been set successfully.
+   */
+  unsigned int getSize() const;
+
+
+  /**
+   * Sets the same value of a variable of a functional range for every
+   * iteration.
+   *
+   * @param id the id of the variable.
+   * @param value the value of the variable.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if the range is not a functional range with a variable @p id.
+   */
+  int setVariableValue(const std::string& id, double value);
+
+
+  /**
+   * Sets the values of a variable of a functional range, one per
+   * iteration.  The values are not copied, and must outlive their use.
+   *
+   * @param id the id of the variable.
+   * @param values getSize() values of the variable.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if the range is not a functional range with a variable @p id, or
+   * @p values is @c NULL.
+   */
+  int setVariableValues(const std::string& id, const double* values);
+
+
+  /**
+   * @return the expansion of the range a functional range references, so
+   * that the values of its own variables can be set, or @c NULL.
+   */
+  SedRangeValues* getReferencedValues();
+
+
+  /**
+   * Computes a chunk of the values of the range.
+   *
+   * @param first the index of the first value.
+   * @param count the number of values.
+   * @param buffer room for @p count values, which may be left unused.
+   *
+   * @return a pointer to the @p count values, either @p buffer or, for a
+   * vector range, the values of the range; @c NULL if no range has been set
+   * successfully, or the chunk does not lie within the range.
+   */
+  const double* getValues(unsigned int first, unsigned int count,
+                          double* buffer) const;
+
+
+  /**
+   * Copies all the values of the range.
+   *
+   * @param values the vector receiving the values.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if no range has been set successfully.
+   */
+  int getValues(std::vector<double>& values) const;
+
+
+  /**
+   * @return the nth value of the range, or NaN if @p n is out of range.
+   */
+  double getValue(unsigned int n) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  SedRangeValues(const SedRangeValues&);
+  SedRangeValues& operator=(const SedRangeValues&);
+
+  void clear();
+
+  int setRange(const SedRange& range, unsigned int depth);
+
+  int setUniformRange(const SedRange& range);
+
+  int setFunctionalRange(const SedRange& range, unsigned int depth);
+
+  int findVariable(const std::string& id) const;
+
+  const SedRange*            mRange;
+  int                        mTypeCode;
+  unsigned int               mSize;
+
+  // uniform ranges; on a logarithmic scale, mOrigin and mStep apply to the
+  // logarithm of the magnitude of the values, whose sign is mSign
+  double                     mStart;
+  double                     mEnd;
+  double                     mOrigin;
+  double                     mStep;
+  double                     mSign;
+  bool                       mLog;
+
+  // vector ranges
+  const double*              mVector;
+
+  // functional ranges
+  SedRangeValues*            mReferenced;
+  SedMathProgram             mProgram;
+  std::vector<double>        mVariableValues;
+  std::vector<const double*> mVariableColumns;
+
+  std::string                mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new SedRangeValues, without a range.
+ */
+LIBSEDML_EXTERN
+SedRangeValues_t *
+SedRangeValues_create(void);
+
+/**
+ * Frees the given SedRangeValues.
+ */
+LIBSEDML_EXTERN
+void
+SedRangeValues_free(SedRangeValues_t *values);
+
+/**
+ * Prepares the expansion of the given range.
+ */
+LIBSEDML_EXTERN
+int
+SedRangeValues_setRange(SedRangeValues_t *values, const SedRange_t *range);
+
+/**
+ * Returns the number of values of the range of the given SedRangeValues.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedRangeValues_getSize(const SedRangeValues_t *values);
+
+/**
+ * Sets the same value of a variable of a functional range for every
+ * iteration.
+ */
+LIBSEDML_EXTERN
+int
+SedRangeValues_setVariableValue(SedRangeValues_t *values, const char *id,
+                                double value);
+
+/**
+ * Computes a chunk of the values of the range of the given SedRangeValues.
+ */
+LIBSEDML_EXTERN
+const double *
+SedRangeValues_getValues(const SedRangeValues_t *values, unsigned int first,
+                         unsigned int count, double *buffer);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedRangeValues_h */
@@ -35,6 +35,10 @@
  * ---------------------------------------------------------------------- -->
  */
 
+#include <cstring>
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include <sbml/xml/XMLError.h>
 #include <sbml/xml/XMLErrorLog.h>
 #include <sbml/xml/XMLInputStream.h>
@@ -60,6 +64,9 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new SedReader and returns it.
  */
 SedReader::SedReader()
+  : mTrustedInput(false)
+  , mFailFast(false)
+  , mCollectStatistics(false)
 {
 }
 
@@ -148,8 +155,13 @@ SedReader::readSedMLFromString(const std::string& xml)
     }
   else
     {
-      const std::string temp = (dummy_xml + xml);
-      return readInternal(temp.c_str(), false);
+      std::string& temp = mCache.getXMLBuffer();
+      temp.assign(dummy_xml);
+      temp.append(xml);
+
+      SedDocument* d = readInternal(temp.c_str(), false);
+      temp.clear();
+      return d;
     }
 
 
@@ -182,6 +194,143 @@ SedReader::hasBzip2()
 }
 
 
+/*
+ * Releases the state this SedReader keeps between reads.
+ */
+void
+SedReader::clearCache()
+{
+  mCache.clear();
+}
+
+
+/*
+ * Sets whether this SedReader trusts its input to be consistent.
+ */
+int
+SedReader::setTrustedInput(bool trusted)
+{
+  mTrustedInput = trusted;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if this SedReader skips the consistency checks made while
+ * reading.
+ */
+bool
+SedReader::getTrustedInput() const
+{
+  return mTrustedInput;
+}
+
+
+/*
+ * Sets whether this SedReader stops reading at the first error.
+ */
+int
+SedReader::setFailFast(bool failFast)
+{
+  mFailFast = failFast;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if this SedReader stops reading at the first error.
+ */
+bool
+SedReader::getFailFast() const
+{
+  return mFailFast;
+}
+
+
+/*
+ * Sets whether this SedReader collects statistics.
+ */
+int
+SedReader::setCollectStatistics(bool collect)
+{
+  mCollectStatistics = collect;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if this SedReader collects statistics.
+ */
+bool
+SedReader::getCollectStatistics() const
+{
+  return mCollectStatistics;
+}
+
+
+/*
+ * Returns the statistics collected by this SedReader.
+ */
+SedReaderStatistics*
+SedReader::getStatistics()
+{
+  return &mStatistics;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+bool
+SedReadCache::Key::operator<(const Key& other) const
+{
+  if (type != other.type && *type != *other.type)
+    return type->before(*other.type) != 0;
+
+  if (level != other.level)
+    return level < other.level;
+
+  return version < other.version;
+}
+
+
+ExpectedAttributes&
+SedReadCache::getExpectedAttributes(const std::type_info& type,
+                                    unsigned int level,
+                                    unsigned int version,
+                                    bool& isNew)
+{
+  Key key;
+  key.type = &type;
+  key.level = level;
+  key.version = version;
+
+  std::map<Key, ExpectedAttributes>::iterator it =
+    mExpectedAttributes.lower_bound(key);
+
+  isNew = (it == mExpectedAttributes.end() || key < it->first);
+
+  if (isNew)
+    it = mExpectedAttributes.insert(it, std::make_pair(key, ExpectedAttributes()));
+
+  return it->second;
+}
+
+
+std::string&
+SedReadCache::getXMLBuffer()
+{
+  return mXMLBuffer;
+}
+
+
+void
+SedReadCache::clear()
+{
+  mExpectedAttributes.clear();
+  std::string().swap(mXMLBuffer);
+}
+/** @endcond */
+
+
 /** @cond doxygen-libsbml-internal */
 static bool
 isCriticalError(const unsigned int errorId)
@@ -212,6 +361,13 @@ isCriticalError(const unsigned int errorId)
         return false;
     }
 }
+
+
+static bool
+isNotCriticalError(unsigned int errorId)
+{
+  return !isCriticalError(errorId);
+}
 /** @endcond */
 
 
@@ -222,6 +378,10 @@ isCriticalError(const unsigned int errorId)
 SedDocument*
 SedReader::readInternal(const char* content, bool isFile)
 {
+  SedReaderStatistics* stats = mCollectStatistics ? &mStatistics : NULL;
+  double start = (stats != NULL) ? SedReaderStatistics::now() : 0.0;
+  double parseTime = 0.0;
+
   SedDocument* d = new SedDocument();
   //if (isFile) {
   //  d->setURI(content);
@@ -235,7 +395,19 @@ SedReader::readInternal(const char* content, bool isFile)
     {
       XMLInputStream stream(content, isFile, "", d->getErrorLog());
 
+      d->setReadOptions(mTrustedInput, mFailFast);
+      d->setReadCache(&mCache);
+      d->setReadStatistics(stats);
       d->read(stream);
+      d->getErrorLog()->updateIndex();
+      d->setReadStatistics(NULL);
+      d->setReadCache(NULL);
+      d->setReadOptions(false, false);
+
+      if (stats != NULL)
+        parseTime = SedReaderStatistics::now() - start;
+
+      SedReadPhaseTimer timer(stats, SEDML_READ_PHASE_CHECKS);
 
       if (stream.isError())
         {
@@ -251,19 +423,15 @@ SedReader::readInternal(const char* content, bool isFile)
               if (isCriticalError(d->getErrorLog()->getError(i)->getErrorId()))
                 {
                   // If we find even one critical error, all other errors are
-                  // suspect and may be bogus.  Remove them.
+                  // suspect and may be bogus.  Remove them, in one pass.
 
-                  for (int n = d->getErrorLog()->getNumErrors() - 1; n >= 0; n--)
-                    if (!isCriticalError(d->getErrorLog()->getError(n)->getErrorId()))
-                      {
-                        d->getErrorLog()->remove(d->getErrorLog()->getError(n)->getErrorId());
-                      }
+                  d->getErrorLog()->removeIf(isNotCriticalError);
 
                   break;
                 }
             }
         }
-      else
+      else if (!mTrustedInput)
         {
           // Low-level XML errors will have been caught in the first read,
           // before we even attempt to interpret the content as Sed.  Here
@@ -289,6 +457,29 @@ SedReader::readInternal(const char* content, bool isFile)
         }
     }
 
+  if (stats != NULL)
+    {
+      unsigned long numBytes = 0;
+
+      if (!isFile && content != NULL)
+        {
+          numBytes = (unsigned long)strlen(content);
+        }
+      else if (content != NULL)
+        {
+          // XMLInputStream does not report how much it consumed; the size
+          // is taken from the directory entry rather than by opening the
+          // file a second time
+          struct stat info;
+
+          if (stat(content, &info) == 0)
+            numBytes = (unsigned long)info.st_size;
+        }
+
+      stats->addDocument(SedReaderStatistics::now() - start, parseTime,
+                         numBytes);
+    }
+
   return d;
 }
 /** @endcond */
@@ -319,6 +510,106 @@ SedReader_free(SedReader_t *sr)
 }
 
 
+/**
+ * Sets whether the given SedReader trusts its input to be consistent, and
+ * skips the consistency checks made while reading.
+ *
+ * @return integer value indicating success/failure of the
+ * function.  @if clike The value is drawn from the
+ * enumeration #OperationReturnValues_t. @endif@~ The possible values
+ * returned by this function are:
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setTrustedInput(SedReader_t *sr, int trusted)
+{
+  if (sr != NULL)
+    return sr->setTrustedInput(trusted != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns non-zero if the given SedReader skips the consistency checks made
+ * while reading, zero otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_getTrustedInput(const SedReader_t *sr)
+{
+  return (sr != NULL) ? static_cast<int>(sr->getTrustedInput()) : 0;
+}
+
+
+/**
+ * Sets whether the given SedReader stops reading at the first error.
+ *
+ * @return integer value indicating success/failure of the
+ * function.  @if clike The value is drawn from the
+ * enumeration #OperationReturnValues_t. @endif@~ The possible values
+ * returned by this function are:
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setFailFast(SedReader_t *sr, int failFast)
+{
+  if (sr != NULL)
+    return sr->setFailFast(failFast != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns non-zero if the given SedReader stops reading at the first error,
+ * zero otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_getFailFast(const SedReader_t *sr)
+{
+  return (sr != NULL) ? static_cast<int>(sr->getFailFast()) : 0;
+}
+
+
+/**
+ * Sets whether the given SedReader collects timings and counters about the
+ * documents it reads.
+ *
+ * @return integer value indicating success/failure of the
+ * function.  @if clike The value is drawn from the
+ * enumeration #OperationReturnValues_t. @endif@~ The possible values
+ * returned by this function are:
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setCollectStatistics(SedReader_t *sr, int collect)
+{
+  if (sr != NULL)
+    return sr->setCollectStatistics(collect != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the statistics collected by the given SedReader.
+ */
+LIBSEDML_EXTERN
+SedReaderStatistics_t *
+SedReader_getStatistics(SedReader_t *sr)
+{
+  return (sr != NULL) ? sr->getStatistics() : NULL;
+}
+
+
 /**
  * Reads an Sed document from the given file.  If filename does not exist
  * or is not an Sed file, an error will be logged.  Errors can be
@@ -51,6 +51,10 @@
  * check for errors and warnings using the methods for this purpose
  * provided by SedDocument.
  *
+ * A SedReader keeps state from one read to the next (see clearCache()),
+ * so one SedReader must not be used by several threads at once; threads
+ * reading documents concurrently should each use their own SedReader.
+ *
  * For convenience as well as easy access from other languages besides C++,
  * this file also defines two global functions,
  * libsbml::readSedML(@if java String filename@endif)
@@ -97,18 +101,82 @@
 #include <sedml/common/extern.h>
 #include <sedml/common/sedmlfwd.h>
 #include <sbml/util/util.h>
+#include <sbml/ExpectedAttributes.h>
+#include <sedml/SedStatistics.h>
 
 
 #ifdef __cplusplus
 
 
+#include <map>
 #include <string>
+#include <typeinfo>
 
 LIBSEDML_CPP_NAMESPACE_BEGIN
 
 class SedDocument;
 
 
+/** @cond doxygen-libsedml-internal */
+
+/**
+ * State a SedReader keeps from one read to the next, so that reading many
+ * documents with the same SedReader does not rebuild it for each of them:
+ * the attributes expected on each kind of element, and the buffer used to
+ * prepend an XML declaration to documents read from strings.
+ *
+ * A SedReadCache is not synchronized; it belongs to a single SedReader
+ * and is only used by the read in progress.
+ */
+class LIBSEDML_EXTERN SedReadCache
+{
+public:
+
+  /**
+   * Returns the expected attributes stored for elements of the given class
+   * in the given Level and Version of SED-ML.
+   *
+   * @param type the dynamic type of the element.
+   * @param level the SED-ML Level of the element.
+   * @param version the SED-ML Version of the element.
+   * @param isNew set to @c true if no attributes were stored yet, in which
+   * case the caller fills the (empty) object returned.
+   */
+  ExpectedAttributes& getExpectedAttributes(const std::type_info& type,
+                                            unsigned int level,
+                                            unsigned int version,
+                                            bool& isNew);
+
+  /**
+   * @return the buffer used to build the XML text of a document before it
+   * is parsed; its capacity is kept between reads.
+   */
+  std::string& getXMLBuffer();
+
+  /**
+   * Releases all the state kept by this SedReadCache.
+   */
+  void clear();
+
+private:
+
+  struct Key
+  {
+    const std::type_info* type;
+    unsigned int level;
+    unsigned int version;
+
+    bool operator<(const Key& other) const;
+  };
+
+  std::map<Key, ExpectedAttributes> mExpectedAttributes;
+  std::string mXMLBuffer;
+};
+
+/** @endcond */
+
+
+
 class LIBSEDML_EXTERN SedReader
 {
 public:
@@ -450,6 +518,111 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Releases the state this SedReader keeps between reads.
+   *
+   * A SedReader remembers the attributes expected on each kind of element
+   * and keeps the buffers it uses to parse strings, so that reading many
+   * documents with the same SedReader avoids redoing that work for each
+   * of them.  This method releases that state, for instance after reading
+   * an unusually large document.  As this state is not synchronized, a
+   * SedReader must only be used by one thread at a time.
+   */
+  void clearCache();
+
+
+  /**
+   * Sets whether this SedReader trusts its input to be consistent.
+   *
+   * Documents written by libSEDML itself (or by a pipeline that validated
+   * them before) need not be checked again when they are read back.  With
+   * trusted input the reader skips the checks on element order, empty
+   * lists, empty attribute values, default namespaces, annotations and
+   * notes, does not record the line and column of each element, and does
+   * not check the XML declaration of the document.  Errors reported by the
+   * XML parser, and attributes that cannot be parsed, are still logged.
+   *
+   * @param trusted @c true to skip the consistency checks, @c false (the
+   * default) to perform them.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setTrustedInput(bool trusted);
+
+
+  /**
+   * @return @c true if this SedReader skips the consistency checks made
+   * while reading, @c false otherwise.
+   *
+   * @see setTrustedInput(bool trusted)
+   */
+  bool getTrustedInput() const;
+
+
+  /**
+   * Sets whether this SedReader stops reading at the first error.
+   *
+   * Once an error of severity LIBSEDML_SEV_ERROR or LIBSEDML_SEV_FATAL has
+   * been logged, no further elements are read and the (incomplete)
+   * SedDocument is returned; its error log holds the error that stopped
+   * the read.
+   *
+   * @param failFast @c true to stop at the first error, @c false (the
+   * default) to read the whole document.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setFailFast(bool failFast);
+
+
+  /**
+   * @return @c true if this SedReader stops reading at the first error,
+   * @c false otherwise.
+   *
+   * @see setFailFast(bool failFast)
+   */
+  bool getFailFast() const;
+
+
+  /**
+   * Sets whether this SedReader collects timings and counters about the
+   * documents it reads (see SedReaderStatistics).  Statistics are added up
+   * over all documents read until they are reset.
+   *
+   * @param collect @c true to collect statistics, @c false (the default)
+   * not to.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setCollectStatistics(bool collect);
+
+
+  /**
+   * @return @c true if this SedReader collects statistics, @c false
+   * otherwise.
+   *
+   * @see setCollectStatistics(bool collect)
+   */
+  bool getCollectStatistics() const;
+
+
+  /**
+   * @return the statistics collected by this SedReader.
+   *
+   * @see setCollectStatistics(bool collect)
+   */
+  SedReaderStatistics* getStatistics();
+
+
 protected:
   /** @cond doxygen-libsbml-internal */
 
@@ -460,6 +633,12 @@ protected:
    */
   SedDocument* readInternal(const char* content, bool isFile = true);
 
+  bool mTrustedInput;
+  bool mFailFast;
+  SedReadCache mCache;
+  bool mCollectStatistics;
+  SedReaderStatistics mStatistics;
+
   /** @endcond */
 };
 
@@ -590,6 +769,58 @@ LIBSEDML_EXTERN
 int
 SedReader_hasBzip2();
 
+
+/**
+ * Sets whether the given SedReader trusts its input to be consistent, and
+ * skips the consistency checks made while reading.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setTrustedInput(SedReader_t *sr, int trusted);
+
+
+/**
+ * Returns non-zero if the given SedReader skips the consistency checks made
+ * while reading, zero otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_getTrustedInput(const SedReader_t *sr);
+
+
+/**
+ * Sets whether the given SedReader stops reading at the first error.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setFailFast(SedReader_t *sr, int failFast);
+
+
+/**
+ * Returns non-zero if the given SedReader stops reading at the first error,
+ * zero otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_getFailFast(const SedReader_t *sr);
+
+
+/**
+ * Sets whether the given SedReader collects timings and counters about the
+ * documents it reads.
+ */
+LIBSEDML_EXTERN
+int
+SedReader_setCollectStatistics(SedReader_t *sr, int collect);
+
+
+/**
+ * Returns the statistics collected by the given SedReader.
+ */
+LIBSEDML_EXTERN
+SedReaderStatistics_t *
+SedReader_getStatistics(SedReader_t *sr);
+
 #endif  /* !SWIG */
 
 
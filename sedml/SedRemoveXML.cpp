@@ -36,6 +36,7 @@
 
 #include <sedml/SedRemoveXML.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -181,8 +182,26 @@ SedRemoveXML::writeElements(XMLOutputStream& stream) const
 bool
 SedRemoveXML::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedRemoveXML::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedChange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedRemoveXML));
 }
 
 
@@ -36,6 +36,7 @@
 
 #include <sedml/SedRepeatedTask.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -199,6 +200,7 @@ SedRepeatedTask::setRangeId(const std::string& rangeId)
     }
   else
     {
+      markDirty();
       mRangeId = rangeId;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -211,6 +213,8 @@ SedRepeatedTask::setRangeId(const std::string& rangeId)
 int
 SedRepeatedTask::setResetModel(bool resetModel)
 {
+  markDirty();
+
   mResetModel = resetModel;
   mIsSetResetModel = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -223,6 +227,8 @@ SedRepeatedTask::setResetModel(bool resetModel)
 int
 SedRepeatedTask::unsetRangeId()
 {
+  markDirty();
+
   mRangeId.erase();
 
   if (mRangeId.empty() == true)
@@ -242,6 +248,8 @@ SedRepeatedTask::unsetRangeId()
 int
 SedRepeatedTask::unsetResetModel()
 {
+  markDirty();
+
   mResetModel = false;
   mIsSetResetModel = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -775,8 +783,68 @@ SedRepeatedTask::writeElements(XMLOutputStream& stream) const
 bool
 SedRepeatedTask::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mRanges.accept(v);
+      mTaskChanges.accept(v);
+      mSubTasks.accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedRepeatedTask::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedTask::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedRepeatedTask));
+  usage.addString(mRangeId);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedRepeatedTask::getNumChildObjects() const
+{
+  return SedTask::getNumChildObjects() + 3;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedRepeatedTask::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedTask::getNumChildObjects();
 
+  if (n < numInherited)
+    return SedTask::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mRanges;
+    case 1:
+      return &mTaskChanges;
+    case 2:
+      return &mSubTasks;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -0,0 +1,1166 @@
+/**
+ * @file    SedReportWriter.cpp
+ * @brief   Implementation of SedReportWriter
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedDataSet.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedReport.h>
+#include <sedml/SedResultStore.h>
+#include <sedml/SedTask.h>
+#include <sedml/SedTaskPlan.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <sbml/compress/CompressCommon.h>
+#include <sbml/compress/OutputCompressor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <set>
+#include <sstream>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The size of the buffer of the text written, and the number of rows of
+ * the blocks of the binary format.
+ */
+static const size_t SEDML_REPORT_BUFFER_SIZE = 65536;
+static const unsigned int SEDML_REPORT_BLOCK_ROWS = 4096;
+
+/*
+ * The largest number of characters of a value, with its separator.
+ */
+static const size_t SEDML_REPORT_VALUE_SIZE = 32;
+
+/*
+ * The default number of bytes of values of the runs held in memory.
+ */
+static const size_t SEDML_REPORT_MEMORY_BUDGET = 64 * 1024 * 1024;
+
+
+/*
+ * @return the document containing the given object, even if the object
+ * has not been connected to it yet.
+ */
+static const SedDocument*
+findDocument(const SedBase* object)
+{
+  while (object != NULL && object->getTypeCode() != SEDML_DOCUMENT)
+    {
+      object = object->getParentSedObject();
+    }
+
+  return static_cast<const SedDocument*>(object);
+}
+
+
+/*
+ * Formats a value as "%.*g" does in the "C" locale, the integers of at
+ * most precision digits without sprintf.
+ *
+ * @return the number of characters written.
+ */
+static size_t
+formatValue(double value, unsigned int precision, char* text)
+{
+  if (value != value)
+    {
+      memcpy(text, "NaN", 3);
+      return 3;
+    }
+
+  if (fabs(value) == numeric_limits<double>::infinity())
+    {
+      memcpy(text, (value < 0) ? "-INF" : "INF", (value < 0) ? 4 : 3);
+      return (value < 0) ? 4 : 3;
+    }
+
+  if (value == floor(value) && fabs(value) < 4294967296.0)
+    {
+      char digits[16];
+      size_t numDigits = 0;
+      unsigned long integer = (unsigned long)fabs(value);
+
+      do
+        {
+          digits[numDigits++] = (char)('0' + integer % 10);
+          integer /= 10;
+        }
+      while (integer != 0);
+
+      if (numDigits <= precision)
+        {
+          size_t length = 0;
+          if (value < 0) text[length++] = '-';
+
+          while (numDigits > 0)
+            {
+              text[length++] = digits[--numDigits];
+            }
+
+          return length;
+        }
+    }
+
+  // the decimal point of the locale, of one or more bytes, becomes a '.'
+  char formatted[2 * SEDML_REPORT_VALUE_SIZE];
+  int count = sprintf(formatted, "%.*g", (int)precision, value);
+  size_t length = 0;
+
+  for (int c = 0; c < count; ++c)
+    {
+      char character = formatted[c];
+
+      if ((character >= '0' && character <= '9') || character == '-'
+          || character == '+' || character == 'e')
+        text[length++] = character;
+      else if (length == 0 || text[length - 1] != '.')
+        text[length++] = '.';
+    }
+
+  return length;
+}
+
+
+/*
+ * Appends a 32-bit integer, little-endian.
+ */
+static void
+appendInteger(unsigned int value, char* bytes)
+{
+  for (unsigned int n = 0; n < 4; ++n)
+    {
+      bytes[n] = (char)((value >> (8 * n)) & 0xff);
+    }
+}
+
+
+/*
+ * Appends a 64-bit double, little-endian.
+ */
+static void
+appendDouble(double value, bool bigEndian, char* bytes)
+{
+  memcpy(bytes, &value, sizeof(double));
+
+  if (bigEndian) std::reverse(bytes, bytes + sizeof(double));
+}
+
+
+/*
+ * @return true if the machine is big-endian.
+ */
+static bool
+isBigEndian()
+{
+  const unsigned int one = 1;
+  return *reinterpret_cast<const unsigned char*>(&one) == 0;
+}
+
+
+/*
+ * @return the number of output points of the simulation of a run.
+ */
+static unsigned int
+countPoints(const SedSimulationRun& run)
+{
+  const SedSimulation* simulation = run.getSimulation();
+
+  if (simulation != NULL
+      && simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+    {
+      int numberOfPoints = static_cast<const SedUniformTimeCourse*>(simulation)
+                             ->getNumberOfPoints();
+
+      if (numberOfPoints >= 0 && numberOfPoints != SEDML_INT_MAX)
+        return (unsigned int)numberOfPoints + 1;
+    }
+
+  return 1;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedReportWriter.
+ */
+SedReportWriter::SedReportWriter()
+  : mFormat(SEDML_REPORT_CSV)
+  , mPrecision(17)
+  , mStream(NULL)
+  , mOwnsStream(false)
+  , mStreaming(false)
+  , mNumRuns(0)
+  , mNextRun(0)
+  , mMemoryBudget(SEDML_REPORT_MEMORY_BUDGET)
+  , mPendingSize(0)
+  , mSpillFile(NULL)
+  , mBufferSize(0)
+  , mBlockRows(0)
+  , mNumRows(0)
+  , mFailed(false)
+{
+}
+
+
+/*
+ * Destroys this SedReportWriter.
+ */
+SedReportWriter::~SedReportWriter()
+{
+  close();
+}
+
+
+/*
+ * Sets the format of the files opened next.
+ */
+int
+SedReportWriter::setFormat(SedReportFormat_t format)
+{
+  if (format != SEDML_REPORT_CSV && format != SEDML_REPORT_TSV
+      && format != SEDML_REPORT_BINARY)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mFormat = format;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the format of the files.
+ */
+SedReportFormat_t
+SedReportWriter::getFormat() const
+{
+  return mFormat;
+}
+
+
+/*
+ * Sets the number of significant digits of the values.
+ */
+int
+SedReportWriter::setPrecision(unsigned int digits)
+{
+  if (digits < 1 || digits > 17) return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mPrecision = digits;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the number of significant digits of the values.
+ */
+unsigned int
+SedReportWriter::getPrecision() const
+{
+  return mPrecision;
+}
+
+
+/*
+ * Sets the number of bytes of values of the runs held in memory.
+ */
+int
+SedReportWriter::setMemoryBudget(size_t bytes)
+{
+  mMemoryBudget = bytes;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the number of bytes of values of the runs held in memory.
+ */
+size_t
+SedReportWriter::getMemoryBudget() const
+{
+  return mMemoryBudget;
+}
+
+
+/*
+ * Opens a file, and writes the header of a report.
+ */
+int
+SedReportWriter::open(const SedReport& report, const std::string& filename)
+{
+  if (isOpen())
+    {
+      mErrorMessage = "a file is open already";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  int result = prepare(report);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  std::ostream* stream = NULL;
+
+  try
+    {
+      if (string::npos != filename.find(".gz", filename.length() - 3))
+        {
+          stream = OutputCompressor::openGzipOStream(filename);
+        }
+      else if (string::npos != filename.find(".bz2", filename.length() - 4))
+        {
+          stream = OutputCompressor::openBzip2OStream(filename);
+        }
+      else if (string::npos != filename.find(".zip", filename.length() - 4))
+        {
+          std::string filenameinzip = filename.substr(0, filename.length() - 4);
+
+#if defined(WIN32) && !defined(CYGWIN)
+          char sepr = '\\';
+#else
+          char sepr = '/';
+#endif
+          size_t spos = filenameinzip.rfind(sepr, filenameinzip.length() - 1);
+
+          if (spos != string::npos)
+            {
+              filenameinzip = filenameinzip.substr(spos + 1);
+            }
+
+          stream = OutputCompressor::openZipOStream(filename, filenameinzip);
+        }
+      else
+        {
+          stream = new(std::nothrow) std::ofstream(filename.c_str(),
+                                                   ios::out | ios::binary);
+        }
+    }
+  catch (ZlibNotLinked&)
+    {
+      mErrorMessage = "cannot write '" + filename
+                      + "': libSEDML is not linked with zlib";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+  catch (Bzip2NotLinked&)
+    {
+      mErrorMessage = "cannot write '" + filename
+                      + "': libSEDML is not linked with bzip2";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  if (stream == NULL || stream->fail() || stream->bad())
+    {
+      delete stream;
+      mErrorMessage = "cannot write '" + filename + "'";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  mStream = stream;
+  mOwnsStream = true;
+  writeHeader();
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Writes a report to a stream.
+ */
+int
+SedReportWriter::open(const SedReport& report, std::ostream& stream)
+{
+  if (isOpen())
+    {
+      mErrorMessage = "a file is open already";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  int result = prepare(report);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  mStream = &stream;
+  mOwnsStream = false;
+  writeHeader();
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns true if a file is open.
+ */
+bool
+SedReportWriter::isOpen() const
+{
+  return mStream != NULL;
+}
+
+
+/*
+ * Writes the rows of a run of the task of the report.
+ */
+void
+SedReportWriter::runFinished(const SedSimulationRun& run,
+                             const SedSimulationResult& result)
+{
+  if (!isOpen() || !mStreaming || mGenerators.empty()
+      || run.getTask()->getId() != mTaskId)
+    return;
+
+  unsigned int numPoints = result.getNumPoints();
+  std::vector<double> values(mGenerators.size() * numPoints);
+  std::vector<double> missing;
+
+  for (size_t g = 0; g < mGenerators.size(); ++g)
+    {
+      const SedDataGenerator* generator = mGenerators[g];
+      std::vector<const double*> inputs(generator->getNumVariables() + 1);
+
+      // the columns of the variables, or NaN for those the run lacks
+      for (unsigned int v = 0; v < generator->getNumVariables(); ++v)
+        {
+          const SedVariable* variable = generator->getVariable(v);
+
+          for (unsigned int n = 0; n < run.getNumVariables(); ++n)
+            {
+              if (run.getVariable(n) == variable)
+                inputs[v] = result.getColumn(n);
+            }
+
+          if (inputs[v] == NULL)
+            {
+              missing.assign(numPoints, numeric_limits<double>::quiet_NaN());
+              inputs[v] = missing.empty() ? NULL : &missing[0];
+            }
+        }
+
+      if (numPoints > 0
+          && mPrograms[g].evaluate(&inputs[0], numPoints,
+                                   &values[g * numPoints])
+             != LIBSEDML_OPERATION_SUCCESS)
+        {
+          ostringstream message;
+          message << "data generator '" << generator->getId()
+                  << "' cannot be evaluated for run " << run.getIndex()
+                  << " of task '" << mTaskId << "'";
+          fail(message.str());
+          std::fill(&values[g * numPoints], &values[(g + 1) * numPoints],
+                    numeric_limits<double>::quiet_NaN());
+        }
+    }
+
+  addRun(run.getIndex(), values);
+}
+
+
+/*
+ * Writes rows of NaN for a run that failed.
+ */
+void
+SedReportWriter::runFailed(const SedSimulationRun& run, const std::string&)
+{
+  if (!isOpen() || !mStreaming || mGenerators.empty()
+      || run.getTask()->getId() != mTaskId)
+    return;
+
+  std::vector<double> values(mGenerators.size() * countPoints(run),
+                             numeric_limits<double>::quiet_NaN());
+  addRun(run.getIndex(), values);
+}
+
+
+/*
+ * Writes the rows of the report from the values of a store.
+ */
+int
+SedReportWriter::write(const SedResultStore& store)
+{
+  if (!isOpen()) return LIBSEDML_INVALID_OBJECT;
+
+  // the values of the variables, all of the same shape
+  std::vector<std::vector<const double*> > inputs(mGenerators.size());
+  std::vector<unsigned int> shape;
+  bool shaped = false;
+
+  for (size_t g = 0; g < mGenerators.size(); ++g)
+    {
+      const SedDataGenerator* generator = mGenerators[g];
+      inputs[g].resize(generator->getNumVariables() + 1);
+
+      for (unsigned int v = 0; v < generator->getNumVariables(); ++v)
+        {
+          SedResultSlice slice = store.getSlice(*generator->getVariable(v));
+
+          if (slice.getData() == NULL)
+            {
+              mErrorMessage = "variable '" + generator->getVariable(v)->getId()
+                              + "' of data generator '" + generator->getId()
+                              + "' has no values";
+              return LIBSEDML_INVALID_OBJECT;
+            }
+
+          std::vector<unsigned int> extents(slice.getNumDimensions());
+
+          for (unsigned int d = 0; d < extents.size(); ++d)
+            {
+              extents[d] = slice.getExtent(d);
+            }
+
+          if (!shaped)
+            {
+              shape.swap(extents);
+              shaped = true;
+            }
+          else if (extents != shape)
+            {
+              mErrorMessage = "the variables of the report have values of "
+                              "different shapes";
+              return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+            }
+
+          inputs[g][v] = slice.getData();
+        }
+    }
+
+  unsigned long numRows = 1;
+
+  for (size_t d = 0; d < shape.size(); ++d)
+    {
+      numRows *= shape[d];
+    }
+
+  // evaluated and written a block of rows at a time
+  std::vector<double> block(mGenerators.size() * SEDML_REPORT_BLOCK_ROWS);
+  std::vector<const double*> columns(mGenerators.size());
+
+  for (unsigned long start = 0; start < numRows && !mGenerators.empty();
+       start += SEDML_REPORT_BLOCK_ROWS)
+    {
+      unsigned int rows = (unsigned int)min((unsigned long)SEDML_REPORT_BLOCK_ROWS,
+                                            numRows - start);
+
+      for (size_t g = 0; g < mGenerators.size(); ++g)
+        {
+          std::vector<const double*> blockInputs(inputs[g]);
+
+          for (size_t v = 0; v + 1 < blockInputs.size(); ++v)
+            {
+              blockInputs[v] += start;
+            }
+
+          columns[g] = &block[g * SEDML_REPORT_BLOCK_ROWS];
+
+          if (mPrograms[g].evaluate(&blockInputs[0], rows,
+                                    &block[g * SEDML_REPORT_BLOCK_ROWS])
+              != LIBSEDML_OPERATION_SUCCESS)
+            {
+              fail("data generator '" + mGenerators[g]->getId()
+                   + "' cannot be evaluated");
+              return LIBSEDML_OPERATION_FAILED;
+            }
+        }
+
+      writeRows(&columns[0], rows);
+    }
+
+  return mFailed ? LIBSEDML_OPERATION_FAILED : LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Writes the rows still held, and closes the file.
+ */
+int
+SedReportWriter::close()
+{
+  if (!isOpen()) return LIBSEDML_OPERATION_SUCCESS;
+
+  // the runs after a run that was not reported
+  bool missing = !mPending.empty() || !mSpilled.empty()
+                 || (mStreaming && mNextRun > 0 && mNextRun < mNumRuns);
+  std::vector<double> values;
+
+  while (!mPending.empty() || !mSpilled.empty())
+    {
+      unsigned long index;
+
+      if (mSpilled.empty()
+          || (!mPending.empty()
+              && mPending.begin()->first < mSpilled.begin()->first))
+        index = mPending.begin()->first;
+      else
+        index = mSpilled.begin()->first;
+
+      takeRun(index, values);
+      writeRun(values);
+    }
+
+  if (mSpillFile != NULL) fclose(mSpillFile);
+
+  mSpillFile = NULL;
+
+  if (mFormat == SEDML_REPORT_BINARY)
+    {
+      if (mBlockRows > 0) writeBlock();
+
+      reserve(4);
+      appendInteger(0, &mBuffer[mBufferSize]);
+      mBufferSize += 4;
+    }
+
+  flush();
+  mStream->flush();
+
+  if (mStream->fail() || mStream->bad()) fail("the file cannot be written");
+
+  if (mOwnsStream) delete mStream;
+
+  mStream = NULL;
+  mOwnsStream = false;
+
+  if (mFailed) return LIBSEDML_OPERATION_FAILED;
+
+  if (missing)
+    {
+      mErrorMessage = "runs of task '" + mTaskId + "' were not reported";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the number of rows written since the file was opened.
+ */
+unsigned long
+SedReportWriter::getNumRows() const
+{
+  return mNumRows;
+}
+
+
+/*
+ * Returns the reason the last operation failed.
+ */
+const std::string&
+SedReportWriter::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Finds and compiles the data generators of the data sets of a report,
+ * and the task their variables use.
+ */
+int
+SedReportWriter::prepare(const SedReport& report)
+{
+  mLabels.clear();
+  mGenerators.clear();
+  mPrograms.clear();
+  mTaskId.clear();
+  mStreaming = false;
+  mNumRuns = 0;
+  mNextRun = 0;
+  mPendingSize = 0;
+  mPending.clear();
+  mSpilled.clear();
+  mBuffer.assign(SEDML_REPORT_BUFFER_SIZE, '\0');
+  mBufferSize = 0;
+  mBlockRows = 0;
+  mNumRows = 0;
+  mFailed = false;
+  mErrorMessage.clear();
+
+  const SedDocument* doc = findDocument(&report);
+
+  if (doc == NULL)
+    {
+      mErrorMessage = "report '" + report.getId() + "' is not in a document";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  std::set<std::string> taskIds;
+  mPrograms.resize(report.getNumDataSets());
+
+  for (unsigned int n = 0; n < report.getNumDataSets(); ++n)
+    {
+      const SedDataSet* dataSet = report.getDataSet(n);
+      const SedDataGenerator* generator =
+        doc->getDataGenerator(dataSet->getDataReference());
+
+      if (generator == NULL)
+        {
+          mErrorMessage = "data set '" + dataSet->getId()
+                          + "' references unknown data generator '"
+                          + dataSet->getDataReference() + "'";
+          return LIBSEDML_INVALID_OBJECT;
+        }
+
+      if (mPrograms[n].compile(*generator) != LIBSEDML_OPERATION_SUCCESS)
+        {
+          mErrorMessage = "data generator '" + generator->getId() + "': "
+                          + mPrograms[n].getErrorMessage();
+          return LIBSEDML_INVALID_OBJECT;
+        }
+
+      for (unsigned int v = 0; v < generator->getNumVariables(); ++v)
+        {
+          taskIds.insert(generator->getVariable(v)->getTaskReference());
+        }
+
+      mLabels.push_back(dataSet->isSetLabel() ? dataSet->getLabel()
+                                              : dataSet->getId());
+      mGenerators.push_back(generator);
+    }
+
+  // the rows of a single task are written as its runs are reported
+  if (taskIds.size() == 1)
+    {
+      mTaskId = *taskIds.begin();
+      mStreaming = true;
+
+      const SedTask* task = doc->getTask(mTaskId);
+      SedTaskPlan plan;
+
+      if (task != NULL && plan.compile(*task) == LIBSEDML_OPERATION_SUCCESS)
+        mNumRuns = plan.getNumRuns();
+    }
+
+  if (mFormat == SEDML_REPORT_BINARY)
+    mBlock.assign(mGenerators.size() * SEDML_REPORT_BLOCK_ROWS, 0.0);
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Writes the values of a run, or holds them until the runs before it have
+ * been written.
+ */
+void
+SedReportWriter::addRun(unsigned long index, std::vector<double>& values)
+{
+  if (index < mNextRun) return;
+
+  if (index > mNextRun)
+    {
+      holdRun(index, values);
+      return;
+    }
+
+  writeRun(values);
+  ++mNextRun;
+
+  while (takeRun(mNextRun, values))
+    {
+      writeRun(values);
+      ++mNextRun;
+    }
+}
+
+
+/*
+ * Holds the values of a run, in memory within the budget and in the
+ * temporary file beyond it.
+ */
+void
+SedReportWriter::holdRun(unsigned long index, std::vector<double>& values)
+{
+  size_t bytes = values.size() * sizeof(double);
+
+  if (mMemoryBudget == 0 || mPendingSize + bytes <= mMemoryBudget)
+    {
+      mPendingSize += bytes;
+      mPending[index].swap(values);
+      return;
+    }
+
+  if (mSpillFile == NULL) mSpillFile = tmpfile();
+
+  long offset = -1;
+
+  if (mSpillFile != NULL && fseek(mSpillFile, 0, SEEK_END) == 0)
+    offset = ftell(mSpillFile);
+
+  if (offset < 0
+      || (!values.empty()
+          && fwrite(&values[0], sizeof(double), values.size(), mSpillFile)
+             != values.size()))
+    {
+      ostringstream message;
+      message << "run " << index << " of task '" << mTaskId
+              << "' cannot be held in a temporary file";
+      fail(message.str());
+      return;
+    }
+
+  mSpilled[index] = make_pair(offset, values.size());
+}
+
+
+/*
+ * Takes the values of a run that is held.
+ *
+ * @return false if the run is not held.
+ */
+bool
+SedReportWriter::takeRun(unsigned long index, std::vector<double>& values)
+{
+  std::map<unsigned long, std::vector<double> >::iterator held =
+    mPending.find(index);
+
+  if (held != mPending.end())
+    {
+      values.swap(held->second);
+      mPendingSize -= values.size() * sizeof(double);
+      mPending.erase(held);
+      return true;
+    }
+
+  std::map<unsigned long, std::pair<long, size_t> >::iterator spilled =
+    mSpilled.find(index);
+
+  if (spilled == mSpilled.end()) return false;
+
+  values.resize(spilled->second.second);
+
+  if (!values.empty()
+      && (fseek(mSpillFile, spilled->second.first, SEEK_SET) != 0
+          || fread(&values[0], sizeof(double), values.size(), mSpillFile)
+             != values.size()))
+    {
+      ostringstream message;
+      message << "run " << index << " of task '" << mTaskId
+              << "' cannot be read from its temporary file";
+      fail(message.str());
+      values.assign(values.size(), numeric_limits<double>::quiet_NaN());
+    }
+
+  mSpilled.erase(spilled);
+  return true;
+}
+
+
+/*
+ * Writes the rows of a run, whose values are stored column by column.
+ */
+void
+SedReportWriter::writeRun(const std::vector<double>& values)
+{
+  unsigned int numPoints = (unsigned int)(values.size() / mGenerators.size());
+  std::vector<const double*> columns(mGenerators.size());
+
+  for (size_t g = 0; g < columns.size() && numPoints > 0; ++g)
+    {
+      columns[g] = &values[g * numPoints];
+    }
+
+  if (numPoints > 0) writeRows(&columns[0], numPoints);
+}
+
+
+/*
+ * Writes rows, the values of each column being contiguous.
+ */
+void
+SedReportWriter::writeRows(const double* const* columns, unsigned int numRows)
+{
+  size_t numColumns = mGenerators.size();
+  mNumRows += numRows;
+
+  if (mFormat == SEDML_REPORT_BINARY)
+    {
+      for (unsigned int row = 0; row < numRows; )
+        {
+          unsigned int rows = min(numRows - row,
+                                  SEDML_REPORT_BLOCK_ROWS - mBlockRows);
+
+          for (size_t c = 0; c < numColumns; ++c)
+            {
+              std::copy(columns[c] + row, columns[c] + row + rows,
+                        &mBlock[c * SEDML_REPORT_BLOCK_ROWS + mBlockRows]);
+            }
+
+          row += rows;
+          mBlockRows += rows;
+
+          if (mBlockRows == SEDML_REPORT_BLOCK_ROWS) writeBlock();
+        }
+
+      return;
+    }
+
+  char separator = (mFormat == SEDML_REPORT_TSV) ? '\t' : ',';
+  size_t rowSize = numColumns * SEDML_REPORT_VALUE_SIZE + 1;
+
+  for (unsigned int row = 0; row < numRows; ++row)
+    {
+      reserve(rowSize);
+      char* text = &mBuffer[mBufferSize];
+      char* start = text;
+
+      for (size_t c = 0; c < numColumns; ++c)
+        {
+          if (c > 0) *text++ = separator;
+          text += formatValue(columns[c][row], mPrecision, text);
+        }
+
+      *text++ = '\n';
+      mBufferSize += text - start;
+    }
+}
+
+
+/*
+ * Writes the labels of the columns.
+ */
+void
+SedReportWriter::writeHeader()
+{
+  if (mFormat == SEDML_REPORT_BINARY)
+    {
+      reserve(12);
+      memcpy(&mBuffer[mBufferSize], "SEDR", 4);
+      appendInteger(1, &mBuffer[mBufferSize + 4]);
+      appendInteger((unsigned int)mLabels.size(), &mBuffer[mBufferSize + 8]);
+      mBufferSize += 12;
+
+      for (size_t n = 0; n < mLabels.size(); ++n)
+        {
+          reserve(4 + mLabels[n].size());
+          appendInteger((unsigned int)mLabels[n].size(), &mBuffer[mBufferSize]);
+          std::copy(mLabels[n].begin(), mLabels[n].end(),
+                    &mBuffer[mBufferSize + 4]);
+          mBufferSize += 4 + mLabels[n].size();
+        }
+
+      return;
+    }
+
+  std::string header;
+
+  for (size_t n = 0; n < mLabels.size(); ++n)
+    {
+      std::string label = mLabels[n];
+
+      if (mFormat == SEDML_REPORT_TSV)
+        {
+          std::replace(label.begin(), label.end(), '\t', ' ');
+          std::replace(label.begin(), label.end(), '\n', ' ');
+          std::replace(label.begin(), label.end(), '\r', ' ');
+        }
+      else if (label.find_first_of(",\"\r\n") != string::npos)
+        {
+          std::string quoted = "\"";
+
+          for (size_t c = 0; c < label.size(); ++c)
+            {
+              if (label[c] == '"') quoted += '"';
+              quoted += label[c];
+            }
+
+          label = quoted + "\"";
+        }
+
+      if (n > 0) header += (mFormat == SEDML_REPORT_TSV) ? '\t' : ',';
+      header += label;
+    }
+
+  header += '\n';
+  reserve(header.size());
+  std::copy(header.begin(), header.end(), &mBuffer[mBufferSize]);
+  mBufferSize += header.size();
+}
+
+
+/*
+ * Writes the rows of the block of the binary format.
+ */
+void
+SedReportWriter::writeBlock()
+{
+  bool bigEndian = isBigEndian();
+
+  reserve(4);
+  appendInteger(mBlockRows, &mBuffer[mBufferSize]);
+  mBufferSize += 4;
+
+  for (size_t c = 0; c < mGenerators.size(); ++c)
+    {
+      const double* column = &mBlock[c * SEDML_REPORT_BLOCK_ROWS];
+      reserve(mBlockRows * sizeof(double));
+
+      for (unsigned int row = 0; row < mBlockRows; ++row)
+        {
+          appendDouble(column[row], bigEndian, &mBuffer[mBufferSize]);
+          mBufferSize += sizeof(double);
+        }
+    }
+
+  mBlockRows = 0;
+}
+
+
+/*
+ * Makes room for the given number of bytes in the buffer, writing it to
+ * the file if needed.
+ */
+void
+SedReportWriter::reserve(size_t bytes)
+{
+  if (mBufferSize + bytes <= mBuffer.size()) return;
+
+  flush();
+
+  if (bytes > mBuffer.size()) mBuffer.resize(bytes);
+}
+
+
+/*
+ * Writes the buffer to the file.
+ */
+void
+SedReportWriter::flush()
+{
+  if (mBufferSize > 0)
+    {
+      mStream->write(&mBuffer[0], (std::streamsize)mBufferSize);
+      if (mStream->fail() || mStream->bad()) fail("the file cannot be written");
+    }
+
+  mBufferSize = 0;
+}
+
+
+/*
+ * Records the first reason the file is incomplete.
+ */
+void
+SedReportWriter::fail(const std::string& message)
+{
+  if (!mFailed) mErrorMessage = message;
+
+  mFailed = true;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedReportWriter_t *
+SedReportWriter_create(void)
+{
+  return new(std::nothrow) SedReportWriter();
+}
+
+
+LIBSEDML_EXTERN
+void
+SedReportWriter_free(SedReportWriter_t *writer)
+{
+  delete writer;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedReportWriter_setFormat(SedReportWriter_t *writer, SedReportFormat_t format)
+{
+  if (writer == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return writer->setFormat(format);
+}
+
+
+LIBSEDML_EXTERN
+int
+SedReportWriter_open(SedReportWriter_t *writer, const SedReport_t *report,
+                     const char *filename)
+{
+  if (writer == NULL || report == NULL || filename == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  return writer->open(*report, filename);
+}
+
+
+LIBSEDML_EXTERN
+int
+SedReportWriter_write(SedReportWriter_t *writer,
+                      const SedResultStore_t *store)
+{
+  if (writer == NULL || store == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return writer->write(*store);
+}
+
+
+LIBSEDML_EXTERN
+int
+SedReportWriter_close(SedReportWriter_t *writer)
+{
+  if (writer == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return writer->close();
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
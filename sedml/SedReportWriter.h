@@ -0,0 +1,435 @@
+/**
+ * @file    SedReportWriter.h
+ * @brief   Definition of SedReportWriter
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedReportWriter
+ * @ingroup Core
+ * @brief Streams the rows of a SedReport to a file.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedReportWriter writes the values of the data sets of a SedReport as
+ * rows, one column per data set, in one of the formats of
+ * #SedReportFormat_t:
+ *
+ * @li comma-separated values, with a header line of the labels of the data
+ * sets (their ids when they have no label), quoted as needed;
+ * @li tab-separated values, with the same header line;
+ * @li a binary columnar file: the four bytes @c SEDR, the version @c 1 and
+ * the number of columns as 32-bit integers, the length and bytes of each
+ * label, then blocks of rows, each block being its number of rows as a
+ * 32-bit integer followed by the values of each column in turn as 64-bit
+ * doubles; a block of zero rows ends the file.  All the numbers are
+ * little-endian.
+ *
+ * The writer is a SedExecutionListener: when the data generators of the
+ * data sets only use variables of one task, the rows are written while the
+ * task is executed.  Each run gives one row per output point, in the order
+ * of SedSimulationRun::getIndex(); the runs reported ahead of their turn
+ * by other threads are held until the runs before them are written, in
+ * memory up to the budget set by setMemoryBudget() and in a temporary file
+ * beyond it, and the runs that failed give rows of NaN.  When the data generators use
+ * variables of several tasks, the rows are written by write() once the
+ * tasks have been executed into a SedResultStore.
+ *
+ * The report is never held in memory: the data generators are evaluated
+ * run by run, or in blocks of rows, and the rows are formatted into a
+ * buffer written to the file whenever it fills.  The values are formatted
+ * with the precision set by setPrecision(), with a '.' whatever the locale;
+ * the integers that fit in it are formatted directly.  A file whose name ends with @em .gz, @em .bz2 or
+ * @em .zip is compressed, as by SedWriter.
+ * @code{.cpp}
+ * SedReportWriter writer;
+ * writer.setFormat(SEDML_REPORT_CSV);
+ * if (writer.open(*report, "report.csv.gz") == LIBSEDML_OPERATION_SUCCESS)
+ *   {
+ *     executor.execute(tasks, writer);
+ *     if (writer.close() != LIBSEDML_OPERATION_SUCCESS)
+ *       cerr << writer.getErrorMessage() << endl;
+ *   }
+ * @endcode
+ *
+ * The report, and the objects it references, must not be modified while
+ * the writer is open.
+ */
+
+#ifndef SedReportWriter_h
+#define SedReportWriter_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedTaskExecutor.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * @enum SedReportFormat_t
+ * The formats of SedReportWriter.
+ */
+typedef enum
+{
+    SEDML_REPORT_CSV      /*!< comma-separated values */
+  , SEDML_REPORT_TSV      /*!< tab-separated values */
+  , SEDML_REPORT_BINARY   /*!< binary columnar blocks */
+} SedReportFormat_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <cstdio>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class SedDataGenerator;
+class SedReport;
+class SedResultStore;
+
+
+class LIBSEDML_EXTERN SedReportWriter : public SedExecutionListener
+{
+public:
+
+  /**
+   * Creates a new SedReportWriter, writing comma-separated values.
+   */
+  SedReportWriter();
+
+
+  /**
+   * Destructor method; closes the file.
+   */
+  virtual ~SedReportWriter();
+
+
+  /**
+   * Sets the format of the files opened next.
+   *
+   * @param format the format.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   */
+  int setFormat(SedReportFormat_t format);
+
+
+  /**
+   * @return the format of the files.
+   */
+  SedReportFormat_t getFormat() const;
+
+
+  /**
+   * Sets the number of significant digits of the values, in the text
+   * formats.
+   *
+   * @param digits the number of digits, from 1 to 17, the default, which
+   * writes every value exactly.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   */
+  int setPrecision(unsigned int digits);
+
+
+  /**
+   * @return the number of significant digits of the values.
+   */
+  unsigned int getPrecision() const;
+
+
+  /**
+   * Sets the number of bytes of values of the runs held in memory until
+   * the runs before them are written; the other runs are held in a
+   * temporary file.
+   *
+   * @param bytes the budget, or @c 0 to hold all the runs in memory; the
+   * default is 64 MiB.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setMemoryBudget(size_t bytes);
+
+
+  /**
+   * @return the number of bytes of values of the runs held in memory.
+   */
+  size_t getMemoryBudget() const;
+
+
+  /**
+   * Opens a file, and writes the header of a report.
+   *
+   * @param report the report, in a document.
+   * @param filename the name of the file.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a data set references an unknown data generator, or the math of a
+   * data generator cannot be compiled.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the file cannot be written, or a file is open already.
+   */
+  int open(const SedReport& report, const std::string& filename);
+
+
+  /**
+   * Writes a report to a stream.
+   *
+   * @param report the report, in a document.
+   * @param stream the stream, which must outlive the writer or be closed
+   * with close() first.
+   *
+   * @copydetails open(const SedReport& report, const std::string& filename)
+   */
+  int open(const SedReport& report, std::ostream& stream);
+
+
+  /**
+   * @return @c true if a file is open.
+   */
+  bool isOpen() const;
+
+
+  /**
+   * Writes the rows of a run of the task of the report.
+   *
+   * @param run the run.
+   * @param result the values of the variables of the run.
+   */
+  virtual void runFinished(const SedSimulationRun& run,
+                           const SedSimulationResult& result);
+
+
+  /**
+   * Writes rows of NaN for a run of the task of the report that failed.
+   *
+   * @param run the run.
+   * @param message the reason it failed.
+   */
+  virtual void runFailed(const SedSimulationRun& run,
+                         const std::string& message);
+
+
+  /**
+   * Writes the rows of the report from the values of a store.  The data
+   * generators must give values of the same shape, which are written in
+   * order, the output points varying the fastest.
+   *
+   * @param store the store, holding the values of the variables of the
+   * data generators.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if no file is open, or a variable has no values.
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the values of the variables have different shapes.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the file cannot be written.
+   */
+  int write(const SedResultStore& store);
+
+
+  /**
+   * Writes the rows still held, and closes the file.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if runs were not reported, a data generator could not be evaluated,
+   * or the file cannot be written; the rows written are kept.
+   */
+  int close();
+
+
+  /**
+   * @return the number of rows written since the file was opened.
+   */
+  unsigned long getNumRows() const;
+
+
+  /**
+   * @return the reason the last operation failed, or an empty string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  SedReportWriter(const SedReportWriter&);
+  SedReportWriter& operator=(const SedReportWriter&);
+
+  int prepare(const SedReport& report);
+
+  void addRun(unsigned long index, std::vector<double>& values);
+
+  void holdRun(unsigned long index, std::vector<double>& values);
+
+  bool takeRun(unsigned long index, std::vector<double>& values);
+
+  void writeRun(const std::vector<double>& values);
+
+  void writeRows(const double* const* columns, unsigned int numRows);
+
+  void writeHeader();
+
+  void writeBlock();
+
+  void reserve(size_t bytes);
+
+  void flush();
+
+  void fail(const std::string& message);
+
+  SedReportFormat_t                                mFormat;
+  unsigned int                                     mPrecision;
+  std::ostream*                                    mStream;
+  bool                                             mOwnsStream;
+  std::vector<std::string>                         mLabels;
+  std::vector<const SedDataGenerator*>             mGenerators;
+  std::vector<SedMathProgram>                      mPrograms;
+  std::string                                      mTaskId;
+  bool                                             mStreaming;
+  double                                           mNumRuns;
+  unsigned long                                    mNextRun;
+  size_t                                           mMemoryBudget;
+  size_t                                           mPendingSize;
+  std::map<unsigned long, std::vector<double> >    mPending;
+  std::map<unsigned long, std::pair<long, size_t> > mSpilled;
+  std::FILE*                                       mSpillFile;
+  std::vector<char>                                mBuffer;
+  size_t                                           mBufferSize;
+  std::vector<double>                              mBlock;
+  unsigned int                                     mBlockRows;
+  unsigned long                                    mNumRows;
+  bool                                             mFailed;
+  std::string                                      mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new SedReportWriter, writing comma-separated values.
+ */
+LIBSEDML_EXTERN
+SedReportWriter_t *
+SedReportWriter_create(void);
+
+/**
+ * Frees the given SedReportWriter, closing its file.
+ */
+LIBSEDML_EXTERN
+void
+SedReportWriter_free(SedReportWriter_t *writer);
+
+/**
+ * Sets the format of the files the given SedReportWriter opens next.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_setFormat(SedReportWriter_t *writer, SedReportFormat_t format);
+
+/**
+ * Opens a file with the given SedReportWriter, and writes the header of a
+ * report.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_open(SedReportWriter_t *writer, const SedReport_t *report,
+                     const char *filename);
+
+/**
+ * Writes the rows of the report of the given SedReportWriter from the
+ * values of a store.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_write(SedReportWriter_t *writer,
+                      const SedResultStore_t *store);
+
+/**
+ * Closes the file of the given SedReportWriter.
+ */
+LIBSEDML_EXTERN
+int
+SedReportWriter_close(SedReportWriter_t *writer);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedReportWriter_h */
@@ -0,0 +1,597 @@
+/**
+ * @file    SedResampler.cpp
+ * @brief   Implementation of SedResampler
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedResampler.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedSimulationBackend.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <new>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * @return the document containing the given object, even if the object
+ * has not been connected to it yet.
+ */
+static const SedDocument*
+findDocument(const SedBase* object)
+{
+  while (object != NULL && object->getTypeCode() != SEDML_DOCUMENT)
+    {
+      object = object->getParentSedObject();
+    }
+
+  return static_cast<const SedDocument*>(object);
+}
+
+
+/*
+ * The weights of the values y[j - 1], y[j] and y[j + 1] in the slope at
+ * t[j] of the parabola through the three points.
+ */
+static void
+centredSlope(const double* t, unsigned int j, double* weights)
+{
+  double h0 = t[j] - t[j - 1];
+  double h1 = t[j + 1] - t[j];
+
+  weights[0] = -h1 / (h0 * (h0 + h1));
+  weights[1] = (h1 - h0) / (h0 * h1);
+  weights[2] = h0 / (h1 * (h0 + h1));
+}
+
+
+/*
+ * The weights of the values y[j], y[j + 1] and y[j + 2] in the slope at
+ * t[j] of the parabola through the three points.
+ */
+static void
+forwardSlope(const double* t, unsigned int j, double* weights)
+{
+  double h0 = t[j + 1] - t[j];
+  double h1 = t[j + 2] - t[j + 1];
+
+  weights[0] = -(2 * h0 + h1) / (h0 * (h0 + h1));
+  weights[1] = (h0 + h1) / (h0 * h1);
+  weights[2] = -h0 / (h1 * (h0 + h1));
+}
+
+
+/*
+ * The weights of the values y[j - 2], y[j - 1] and y[j] in the slope at
+ * t[j] of the parabola through the three points.
+ */
+static void
+backwardSlope(const double* t, unsigned int j, double* weights)
+{
+  double h0 = t[j - 1] - t[j - 2];
+  double h1 = t[j] - t[j - 1];
+
+  weights[0] = h1 / (h0 * (h0 + h1));
+  weights[1] = -(h0 + h1) / (h0 * h1);
+  weights[2] = (2 * h1 + h0) / (h1 * (h0 + h1));
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedResampler.
+ */
+SedResampler::SedResampler()
+  : mMethod(SEDML_RESAMPLE_LINEAR)
+  , mNumTimes(0)
+{
+}
+
+
+/*
+ * Sets the grid to evenly spaced times.
+ */
+int
+SedResampler::setGrid(double start, double end, unsigned int numPoints)
+{
+  if (!(end >= start) || numPoints == 0)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  // the times the simulations compute, with the last one exact
+  double step = (numPoints > 1) ? (end - start) / (numPoints - 1) : 0;
+
+  mGrid.resize(numPoints);
+
+  for (unsigned int n = 0; n < numPoints; ++n)
+    {
+      mGrid[n] = start + n * step;
+    }
+
+  if (numPoints > 1) mGrid[numPoints - 1] = end;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Sets the grid to the output points of a time course.
+ */
+int
+SedResampler::setGrid(const SedUniformTimeCourse& timeCourse)
+{
+  int numberOfPoints = timeCourse.getNumberOfPoints();
+
+  if (numberOfPoints <= 0 || numberOfPoints == SEDML_INT_MAX)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  return setGrid(timeCourse.getOutputStartTime(),
+                 timeCourse.getOutputEndTime(),
+                 (unsigned int)numberOfPoints + 1);
+}
+
+
+/*
+ * Sets the grid to that of a data generator.
+ */
+int
+SedResampler::setGrid(const SedDataGenerator& generator)
+{
+  const SedDocument* doc = findDocument(&generator);
+
+  if (doc == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int n = 0; n < generator.getNumVariables(); ++n)
+    {
+      const SedTask* task =
+        doc->getTask(generator.getVariable(n)->getTaskReference());
+
+      // the first subtask of a repeated task gives its simulation; the
+      // depth is bounded in case the repeated tasks form a cycle
+      for (unsigned int depth = 0;
+           task != NULL && task->getTypeCode() == SEDML_TASK_REPEATEDTASK;
+           ++depth)
+        {
+          const SedRepeatedTask* repeated =
+            static_cast<const SedRepeatedTask*>(task);
+
+          if (repeated->getNumSubTasks() == 0 || depth > doc->getNumTasks())
+            task = NULL;
+          else
+            task = doc->getTask(repeated->getSubTask(0)->getTask());
+        }
+
+      if (task == NULL) continue;
+
+      const SedSimulation* simulation =
+        doc->getSimulation(task->getSimulationReference());
+
+      if (simulation != NULL
+          && simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+        return setGrid(*static_cast<const SedUniformTimeCourse*>(simulation));
+    }
+
+  return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/*
+ * Returns the number of times of the grid.
+ */
+unsigned int
+SedResampler::getNumPoints() const
+{
+  return (unsigned int)mGrid.size();
+}
+
+
+/*
+ * Returns the nth time of the grid.
+ */
+double
+SedResampler::getTime(unsigned int n) const
+{
+  if (n >= mGrid.size()) return numeric_limits<double>::quiet_NaN();
+
+  return mGrid[n];
+}
+
+
+/*
+ * Sets the interpolation method.
+ */
+int
+SedResampler::setMethod(SedResampleMethod_t method)
+{
+  if (method != SEDML_RESAMPLE_LINEAR && method != SEDML_RESAMPLE_HERMITE)
+    return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+  mMethod = method;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Returns the interpolation method.
+ */
+SedResampleMethod_t
+SedResampler::getMethod() const
+{
+  return mMethod;
+}
+
+
+/*
+ * Resamples columns sharing the same time points onto the grid.
+ */
+int
+SedResampler::resample(const double* times, unsigned int numTimes,
+                       const double* const* columns, unsigned int numColumns,
+                       double* const* results)
+{
+  if ((times == NULL && numTimes > 0)
+      || ((columns == NULL || results == NULL) && numColumns > 0))
+    return LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int c = 0; c < numColumns; ++c)
+    {
+      if ((columns[c] == NULL && numTimes > 0) || results[c] == NULL)
+        return LIBSEDML_INVALID_OBJECT;
+    }
+
+  int result = plan(times, numTimes);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  apply(columns, numColumns, results);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Resamples all the columns of a simulation result onto the grid.
+ */
+int
+SedResampler::resample(const double* times, const SedSimulationResult& input,
+                       SedSimulationResult& output)
+{
+  unsigned int numTimes = input.getNumPoints();
+  unsigned int numColumns = input.getNumColumns();
+
+  if ((times == NULL && numTimes > 0) || &input == &output)
+    return LIBSEDML_INVALID_OBJECT;
+
+  int result = plan(times, numTimes);
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  output.setSize(numColumns, getNumPoints());
+
+  std::vector<const double*> columns(numColumns);
+  std::vector<double*> results(numColumns);
+
+  for (unsigned int c = 0; c < numColumns; ++c)
+    {
+      columns[c] = input.getColumn(c);
+      results[c] = output.getColumn(c);
+    }
+
+  if (numColumns > 0) apply(&columns[0], numColumns, &results[0]);
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Resamples columns with different time points onto the grid.
+ */
+int
+SedResampler::align(unsigned int numColumns, const double* const* times,
+                    const unsigned int* numTimes, const double* const* columns,
+                    double* const* results)
+{
+  if (numColumns == 0) return LIBSEDML_OPERATION_SUCCESS;
+
+  if (times == NULL || numTimes == NULL || columns == NULL || results == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int c = 0; c < numColumns; ++c)
+    {
+      if ((numTimes[c] > 0 && (times[c] == NULL || columns[c] == NULL))
+          || results[c] == NULL)
+        return LIBSEDML_INVALID_OBJECT;
+    }
+
+  std::vector<bool> done(numColumns, false);
+
+  for (unsigned int c = 0; c < numColumns; ++c)
+    {
+      if (done[c]) continue;
+
+      int result = plan(times[c], numTimes[c]);
+      if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+      // the columns with the same time points share the plan
+      mColumns.clear();
+      mResults.clear();
+
+      for (unsigned int other = c; other < numColumns; ++other)
+        {
+          if (done[other] || times[other] != times[c]
+              || numTimes[other] != numTimes[c])
+            continue;
+
+          done[other] = true;
+          mColumns.push_back(columns[other]);
+          mResults.push_back(results[other]);
+        }
+
+      apply(&mColumns[0], (unsigned int)mColumns.size(), &mResults[0]);
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Computes the four positions and weights of each point of the grid.
+ */
+int
+SedResampler::plan(const double* times, unsigned int numTimes)
+{
+  for (unsigned int i = 0; i < numTimes; ++i)
+    {
+      // also rejects NaN
+      if (!(times[i] == times[i]) || (i > 0 && !(times[i] >= times[i - 1])))
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+    }
+
+  unsigned int numPoints = getNumPoints();
+  const double nan = numeric_limits<double>::quiet_NaN();
+
+  mNumTimes = numTimes;
+  mIndices.assign(4 * numPoints, 0);
+  mWeights.assign(4 * numPoints, 0);
+
+  if (numTimes == 0) return LIBSEDML_OPERATION_SUCCESS;
+
+  double first = times[0];
+  double last = times[numTimes - 1];
+
+  // the grid and the time points may differ by rounding
+  double tolerance = 64 * DBL_EPSILON
+                     * max(max(fabs(first), fabs(last)), last - first);
+
+  unsigned int i = 0;
+
+  for (unsigned int p = 0; p < numPoints; ++p)
+    {
+      unsigned int* index = &mIndices[4 * p];
+      double* weight = &mWeights[4 * p];
+      double t = mGrid[p];
+
+      if (!(t >= first - tolerance && t <= last + tolerance))
+        {
+          weight[0] = nan;
+          continue;
+        }
+
+      if (numTimes == 1)
+        {
+          weight[0] = 1;
+          continue;
+        }
+
+      t = min(max(t, first), last);
+
+      // the last interval starting at or before t, so that equal time
+      // points give the value after the discontinuity
+      while (i + 2 < numTimes && times[i + 1] <= t) ++i;
+      while (i > 0 && times[i] > t) --i;
+
+      double h = times[i + 1] - times[i];
+      double s = (h > 0) ? min(max((t - times[i]) / h, 0.0), 1.0) : 1.0;
+
+      index[0] = i;
+      index[1] = i + 1;
+      index[2] = i + 1;
+      index[3] = i + 1;
+
+      if (mMethod == SEDML_RESAMPLE_LINEAR || h <= 0)
+        {
+          weight[0] = 1 - s;
+          weight[1] = s;
+          continue;
+        }
+
+      // the slopes at t[i] and t[i + 1], as weights of y[i - 1] to y[i + 2],
+      // from the neighbours on the same side of any discontinuity
+      bool before = i > 0 && times[i] > times[i - 1];
+      bool after = i + 2 < numTimes && times[i + 2] > times[i + 1];
+      double left[4] = { 0, -1 / h, 1 / h, 0 };
+      double right[4] = { 0, -1 / h, 1 / h, 0 };
+
+      if (before)
+        centredSlope(times, i, left);
+      else if (after)
+        forwardSlope(times, i, left + 1);
+
+      if (after)
+        centredSlope(times, i + 1, right + 1);
+      else if (before)
+        backwardSlope(times, i + 1, right);
+
+      if (before) index[0] = i - 1;
+      index[1] = i;
+      index[2] = i + 1;
+      if (after) index[3] = i + 2;
+
+      double s2 = s * s;
+      double s3 = s2 * s;
+      double h00 = 2 * s3 - 3 * s2 + 1;
+      double h10 = (s3 - 2 * s2 + s) * h;
+      double h01 = -2 * s3 + 3 * s2;
+      double h11 = (s3 - s2) * h;
+
+      for (unsigned int k = 0; k < 4; ++k)
+        {
+          weight[k] = h10 * left[k] + h11 * right[k];
+        }
+
+      weight[1] += h00;
+      weight[2] += h01;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * Applies the plan to the columns, a block of points of the grid at a time.
+ */
+void
+SedResampler::apply(const double* const* columns, unsigned int numColumns,
+                    double* const* results) const
+{
+  unsigned int numPoints = getNumPoints();
+
+  if (mNumTimes == 0)
+    {
+      for (unsigned int c = 0; c < numColumns; ++c)
+        {
+          fill(results[c], results[c] + numPoints,
+               numeric_limits<double>::quiet_NaN());
+        }
+
+      return;
+    }
+
+  for (unsigned int start = 0; start < numPoints;
+       start += SEDML_MATH_BLOCK_SIZE)
+    {
+      unsigned int end = min(start + SEDML_MATH_BLOCK_SIZE, numPoints);
+      const unsigned int* index = &mIndices[4 * start];
+      const double* weight = &mWeights[4 * start];
+
+      for (unsigned int c = 0; c < numColumns; ++c)
+        {
+          const double* y = columns[c];
+          double* out = results[c] + start;
+
+          for (unsigned int p = 0; p < end - start; ++p)
+            {
+              const unsigned int* i = index + 4 * p;
+              const double* w = weight + 4 * p;
+
+              out[p] = w[0] * y[i[0]] + w[1] * y[i[1]]
+                       + w[2] * y[i[2]] + w[3] * y[i[3]];
+            }
+        }
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedResampler_t *
+SedResampler_create(void)
+{
+  return new(std::nothrow) SedResampler();
+}
+
+
+LIBSEDML_EXTERN
+void
+SedResampler_free(SedResampler_t *resampler)
+{
+  delete resampler;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedResampler_setGrid(SedResampler_t *resampler, double start, double end,
+                     unsigned int numPoints)
+{
+  if (resampler == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return resampler->setGrid(start, end, numPoints);
+}
+
+
+LIBSEDML_EXTERN
+int
+SedResampler_setMethod(SedResampler_t *resampler, SedResampleMethod_t method)
+{
+  if (resampler == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return resampler->setMethod(method);
+}
+
+
+LIBSEDML_EXTERN
+int
+SedResampler_resample(SedResampler_t *resampler, const double *times,
+                      unsigned int numTimes, const double *const *columns,
+                      unsigned int numColumns, double *const *results)
+{
+  if (resampler == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return resampler->resample(times, numTimes, columns, numColumns, results);
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,353 @@
+/**
+ * @file    SedResampler.h
+ * @brief   Definition of SedResampler
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedResampler
+ * @ingroup Core
+ * @brief Resamples simulation results onto the output grid of a task.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * Simulation tools report their results at the time points their
+ * integrator chose, while SED-ML expects the values of a
+ * SedUniformTimeCourse at the <code>numberOfPoints + 1</code> evenly
+ * spaced times from its output start time to its output end time.  A
+ * SedResampler interpolates the columns of values of a result from the
+ * time points of the tool to such a grid, with one of the methods of
+ * #SedResampleMethod_t:
+ *
+ * @li linear interpolation between the two surrounding time points;
+ * @li cubic Hermite interpolation, with the slope at each time point
+ * estimated from its two neighbours, which is exact for quadratics.
+ *
+ * The values of the grid outside the time points of the result are NaN.
+ * The time points must not decrease; equal time points, as reported at
+ * discontinuities, give the value after the discontinuity.
+ *
+ * Each value of the grid is a weighted sum of at most four values of the
+ * result.  The positions and weights are computed once per set of time
+ * points, and are then applied to all the columns, in blocks of
+ * #SEDML_MATH_BLOCK_SIZE points, so that the weights of a block stay in
+ * the cache while every column is resampled.
+ *
+ * The variables of a SedDataGenerator may come from tasks with different
+ * time points; align() resamples them all onto the same grid, typically
+ * the grid of the data generator given by setGrid(const SedDataGenerator&),
+ * so that a SedMathProgram can combine them point by point.
+ * @code{.cpp}
+ * SedResampler resampler;
+ * resampler.setGrid(*timeCourse);
+ * resampler.setMethod(SEDML_RESAMPLE_HERMITE);
+ * // one column of numTimes values per variable
+ * resampler.resample(&times[0], numTimes, &columns[0], numColumns,
+ *                    &results[0]);
+ * @endcode
+ *
+ * A SedResampler keeps the positions and weights it computed, and must
+ * not be used by several threads at the same time.
+ */
+
+#ifndef SedResampler_h
+#define SedResampler_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * @enum SedResampleMethod_t
+ * The interpolation methods of SedResampler.
+ */
+typedef enum
+{
+    SEDML_RESAMPLE_LINEAR    /*!< linear interpolation */
+  , SEDML_RESAMPLE_HERMITE   /*!< cubic Hermite interpolation with estimated slopes */
+} SedResampleMethod_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class SedDataGenerator;
+class SedSimulationResult;
+class SedUniformTimeCourse;
+
+
+class LIBSEDML_EXTERN SedResampler
+{
+public:
+
+  /**
+   * Creates a new SedResampler, interpolating linearly onto an empty grid.
+   */
+  SedResampler();
+
+
+  /**
+   * Sets the grid to evenly spaced times.
+   *
+   * @param start the first time.
+   * @param end the last time.
+   * @param numPoints the number of times; a single time is @p start.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if @p end is before @p start, or @p numPoints is zero.
+   */
+  int setGrid(double start, double end, unsigned int numPoints);
+
+
+  /**
+   * Sets the grid to the output points of a time course.
+   *
+   * @param timeCourse the time course.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the number of points is not set, or the output end time is before
+   * the output start time.
+   */
+  int setGrid(const SedUniformTimeCourse& timeCourse);
+
+
+  /**
+   * Sets the grid to that of a data generator: the output points of the
+   * first of its variables whose task is simulated with a
+   * SedUniformTimeCourse.  The task of a variable may be a repeated task,
+   * whose first subtask gives the simulation.
+   *
+   * @param generator the data generator, in a document.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if no variable is simulated with a SedUniformTimeCourse.
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   */
+  int setGrid(const SedDataGenerator& generator);
+
+
+  /**
+   * @return the number of times of the grid.
+   */
+  unsigned int getNumPoints() const;
+
+
+  /**
+   * @param n the index of the time.
+   *
+   * @return the nth time of the grid, or NaN if there is no such time.
+   */
+  double getTime(unsigned int n) const;
+
+
+  /**
+   * Sets the interpolation method.
+   *
+   * @param method the method.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   */
+  int setMethod(SedResampleMethod_t method);
+
+
+  /**
+   * @return the interpolation method.
+   */
+  SedResampleMethod_t getMethod() const;
+
+
+  /**
+   * Resamples columns sharing the same time points onto the grid.
+   *
+   * @param times the @p numTimes time points of the columns.
+   * @param numTimes the number of time points.
+   * @param columns the @p numColumns columns of @p numTimes values.
+   * @param numColumns the number of columns.
+   * @param results the @p numColumns columns receiving getNumPoints()
+   * values each.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a pointer is @c NULL.
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the time points decrease.
+   */
+  int resample(const double* times, unsigned int numTimes,
+               const double* const* columns, unsigned int numColumns,
+               double* const* results);
+
+
+  /**
+   * Resamples all the columns of a simulation result onto the grid.
+   *
+   * @param times the time points of the result, one per point.
+   * @param input the result.
+   * @param output the resampled result, which this function sizes.
+   *
+   * @copydetails resample(const double* times, unsigned int numTimes, const double* const* columns, unsigned int numColumns, double* const* results)
+   */
+  int resample(const double* times, const SedSimulationResult& input,
+               SedSimulationResult& output);
+
+
+  /**
+   * Resamples columns with different time points onto the grid.  The
+   * columns sharing the same time points, the same array, are resampled
+   * together.
+   *
+   * @param numColumns the number of columns.
+   * @param times the time points of each column.
+   * @param numTimes the number of time points of each column.
+   * @param columns the @p numColumns columns.
+   * @param results the @p numColumns columns receiving getNumPoints()
+   * values each.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a pointer is @c NULL.
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the time points of a column decrease.
+   */
+  int align(unsigned int numColumns, const double* const* times,
+            const unsigned int* numTimes, const double* const* columns,
+            double* const* results);
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  int plan(const double* times, unsigned int numTimes);
+
+  void apply(const double* const* columns, unsigned int numColumns,
+             double* const* results) const;
+
+  SedResampleMethod_t         mMethod;
+  std::vector<double>         mGrid;
+  unsigned int                mNumTimes;
+  std::vector<unsigned int>   mIndices;
+  std::vector<double>         mWeights;
+  std::vector<const double*>  mColumns;
+  std::vector<double*>        mResults;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new SedResampler, interpolating linearly onto an empty grid.
+ */
+LIBSEDML_EXTERN
+SedResampler_t *
+SedResampler_create(void);
+
+/**
+ * Frees the given SedResampler.
+ */
+LIBSEDML_EXTERN
+void
+SedResampler_free(SedResampler_t *resampler);
+
+/**
+ * Sets the grid of the given SedResampler to evenly spaced times.
+ */
+LIBSEDML_EXTERN
+int
+SedResampler_setGrid(SedResampler_t *resampler, double start, double end,
+                     unsigned int numPoints);
+
+/**
+ * Sets the interpolation method of the given SedResampler.
+ */
+LIBSEDML_EXTERN
+int
+SedResampler_setMethod(SedResampler_t *resampler, SedResampleMethod_t method);
+
+/**
+ * Resamples columns sharing the same time points onto the grid of the
+ * given SedResampler.
+ */
+LIBSEDML_EXTERN
+int
+SedResampler_resample(SedResampler_t *resampler, const double *times,
+                      unsigned int numTimes, const double *const *columns,
+                      unsigned int numColumns, double *const *results);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedResampler_h */
@@ -0,0 +1,1261 @@
+/**
+ * @file    SedResultStore.cpp
+ * @brief   Implementation of SedResultStore
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedResultStore.h>
+#include <sedml/SedDataGenerator.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedTaskPlan.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <sbml/math/ASTNode.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#if defined(WIN32) && !defined(CYGWIN)
+#include <windows.h>
+
+#ifndef MEM_REPLACE_PLACEHOLDER
+#define MEM_REPLACE_PLACEHOLDER  0x00004000
+#endif
+#ifndef MEM_RESERVE_PLACEHOLDER
+#define MEM_RESERVE_PLACEHOLDER  0x00040000
+#endif
+#ifndef MEM_PRESERVE_PLACEHOLDER
+#define MEM_PRESERVE_PLACEHOLDER 0x00000002
+#endif
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+#if defined(WIN32) && !defined(CYGWIN)
+typedef PVOID (WINAPI *VirtualAlloc2Function)(HANDLE, PVOID, SIZE_T, ULONG,
+                                              ULONG, void*, ULONG);
+typedef PVOID (WINAPI *MapViewOfFile3Function)(HANDLE, HANDLE, PVOID,
+                                               ULONG64, SIZE_T, ULONG, ULONG,
+                                               void*, ULONG);
+
+/*
+ * Looks up the functions handing the pages of an allocation to a view of
+ * a file without releasing their addresses, which Windows offers from
+ * Windows 10 version 1803.
+ *
+ * @return true if both are available.
+ */
+static bool
+getPlaceholderFunctions(VirtualAlloc2Function& virtualAlloc2,
+                        MapViewOfFile3Function& mapViewOfFile3)
+{
+  HMODULE kernel = GetModuleHandleA("kernelbase.dll");
+
+  virtualAlloc2 = NULL;
+  mapViewOfFile3 = NULL;
+
+  if (kernel != NULL)
+    {
+      virtualAlloc2 = reinterpret_cast<VirtualAlloc2Function>(
+                        GetProcAddress(kernel, "VirtualAlloc2"));
+      mapViewOfFile3 = reinterpret_cast<MapViewOfFile3Function>(
+                         GetProcAddress(kernel, "MapViewOfFile3"));
+    }
+
+  return virtualAlloc2 != NULL && mapViewOfFile3 != NULL;
+}
+#endif
+
+
+/*
+ * The values of a variable: pages of memory, or a temporary file mapped
+ * into memory once they have been spilled.  The values keep their address
+ * when they are spilled, so that the slices viewing them remain valid.
+ */
+class SedResultBuffer
+{
+public:
+  explicit SedResultBuffer(size_t numValues)
+    : data(NULL)
+    , size(numValues)
+    , mapped(false)
+    , lastUse(0)
+#if defined(WIN32) && !defined(CYGWIN)
+    , mapping(NULL)
+#endif
+  {
+  }
+
+  ~SedResultBuffer()
+  {
+    release();
+  }
+
+  size_t getNumBytes() const
+  {
+    return max(size, (size_t)1) * sizeof(double);
+  }
+
+#if defined(WIN32) && !defined(CYGWIN)
+  /*
+   * @return the number of bytes of the pages of the values, which views
+   * replacing them have to span.
+   */
+  size_t getNumReservedBytes() const
+  {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    size_t granularity = info.dwAllocationGranularity;
+    return (getNumBytes() + granularity - 1) / granularity * granularity;
+  }
+#endif
+
+  bool allocate();
+
+  bool spill(const std::string& directory, std::string& message);
+
+  void prefetch() const;
+
+  void release();
+
+  double*          data;
+  size_t           size;
+  bool             mapped;
+  unsigned long    lastUse;
+#if defined(WIN32) && !defined(CYGWIN)
+  HANDLE           mapping;
+#endif
+
+private:
+  SedResultBuffer(const SedResultBuffer&);
+  SedResultBuffer& operator=(const SedResultBuffer&);
+};
+
+
+/*
+ * Allocates the values in pages of their own, which spill() can replace
+ * with those of a file.  On Windows they replace a placeholder, which
+ * spill() turns them back into for a view of the file to replace, where
+ * placeholders are available.
+ */
+bool
+SedResultBuffer::allocate()
+{
+#if defined(WIN32) && !defined(CYGWIN)
+  VirtualAlloc2Function virtualAlloc2;
+  MapViewOfFile3Function mapViewOfFile3;
+  void* address = NULL;
+
+  if (getPlaceholderFunctions(virtualAlloc2, mapViewOfFile3))
+    {
+      size_t bytes = getNumReservedBytes();
+      void* placeholder = virtualAlloc2(NULL, NULL, bytes,
+                                        MEM_RESERVE | MEM_RESERVE_PLACEHOLDER,
+                                        PAGE_NOACCESS, NULL, 0);
+
+      if (placeholder != NULL)
+        {
+          address = virtualAlloc2(NULL, placeholder, bytes,
+                                  MEM_RESERVE | MEM_COMMIT
+                                  | MEM_REPLACE_PLACEHOLDER,
+                                  PAGE_READWRITE, NULL, 0);
+
+          if (address == NULL) VirtualFree(placeholder, 0, MEM_RELEASE);
+        }
+    }
+  else
+    {
+      address = VirtualAlloc(NULL, getNumBytes(), MEM_COMMIT | MEM_RESERVE,
+                             PAGE_READWRITE);
+    }
+#else
+  void* address = mmap(NULL, getNumBytes(), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (address == MAP_FAILED) address = NULL;
+#endif
+
+  data = static_cast<double*>(address);
+  return data != NULL;
+}
+
+
+#if !defined(WIN32) || defined(CYGWIN)
+/*
+ * Writes the given values to a file.
+ */
+static bool
+writeValues(int file, const double* values, size_t numValues)
+{
+  const char* bytes = reinterpret_cast<const char*>(values);
+  size_t remaining = numValues * sizeof(double);
+
+  while (remaining > 0)
+    {
+      ssize_t written = write(file, bytes, remaining);
+
+      if (written < 0 && errno == EINTR) continue;
+      if (written <= 0) return false;
+
+      bytes += written;
+      remaining -= (size_t)written;
+    }
+
+  return true;
+}
+#endif
+
+
+/*
+ * Moves the values to a temporary file of the given directory, or of the
+ * directory of temporary files, mapped into memory in place of the values.
+ * The file is removed as soon as it is mapped, or when the mapping is
+ * released on Windows.  Values that cannot be mapped at their address
+ * stay in memory.
+ */
+bool
+SedResultBuffer::spill(const std::string& directory, std::string& message)
+{
+  size_t bytes = getNumBytes();
+  std::string folder = directory;
+  void* address = NULL;
+
+#if defined(WIN32) && !defined(CYGWIN)
+  VirtualAlloc2Function virtualAlloc2 = NULL;
+  MapViewOfFile3Function mapViewOfFile3 = NULL;
+
+  if (data != NULL && !getPlaceholderFunctions(virtualAlloc2, mapViewOfFile3))
+    {
+      message = "values in memory can only be spilled from Windows 10 "
+                "version 1803";
+      return false;
+    }
+
+  bytes = getNumReservedBytes();
+
+  if (folder.empty())
+    {
+      char temp[MAX_PATH + 1];
+      DWORD length = GetTempPathA(MAX_PATH + 1, temp);
+      folder = (length > 0 && length <= MAX_PATH) ? temp : ".";
+    }
+
+  char path[MAX_PATH];
+
+  if (GetTempFileNameA(folder.c_str(), "sed", 0, path) == 0)
+    {
+      message = "cannot create a file in '" + folder + "'";
+      return false;
+    }
+
+  HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                            CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_TEMPORARY
+                            | FILE_FLAG_DELETE_ON_CLOSE, NULL);
+
+  if (file == INVALID_HANDLE_VALUE)
+    {
+      DeleteFileA(path);
+      message = "cannot open the file '" + std::string(path) + "'";
+      return false;
+    }
+
+  ULARGE_INTEGER length;
+  length.QuadPart = bytes;
+  HANDLE handle = CreateFileMappingA(file, NULL, PAGE_READWRITE,
+                                     length.HighPart, length.LowPart, NULL);
+  CloseHandle(file);
+
+  if (handle != NULL)
+    {
+      address = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+
+      // the values are copied to the file, then their pages are turned
+      // back into the placeholder they were allocated in, which a view of
+      // the file replaces; their address is never released in between
+      if (address != NULL && data != NULL)
+        {
+          double* copy = static_cast<double*>(address);
+          std::copy(data, data + size, copy);
+          address = NULL;
+
+          if (VirtualFree(data, bytes, MEM_RELEASE | MEM_PRESERVE_PLACEHOLDER))
+            {
+              address = mapViewOfFile3(handle, NULL, data, 0, bytes,
+                                       MEM_REPLACE_PLACEHOLDER,
+                                       PAGE_READWRITE, NULL, 0);
+
+              // otherwise the values move back into pages of their own
+              if (address == NULL &&
+                  virtualAlloc2(NULL, data, bytes,
+                                MEM_RESERVE | MEM_COMMIT
+                                | MEM_REPLACE_PLACEHOLDER,
+                                PAGE_READWRITE, NULL, 0) != NULL)
+                std::copy(copy, copy + size, data);
+            }
+
+          UnmapViewOfFile(copy);
+        }
+
+      if (address == NULL) CloseHandle(handle);
+    }
+
+  if (address == NULL)
+    {
+      message = "cannot map the file '" + std::string(path) + "' into memory";
+      return false;
+    }
+#else
+  if (folder.empty())
+    {
+      const char* temp = getenv("TMPDIR");
+      folder = (temp != NULL && *temp != '\0') ? temp : "/tmp";
+    }
+
+  std::string pattern = folder + "/libsedml-XXXXXX";
+  std::vector<char> path(pattern.begin(), pattern.end());
+  path.push_back('\0');
+
+  int file = mkstemp(&path[0]);
+
+  if (file < 0)
+    {
+      message = "cannot create a file in '" + folder + "'";
+      return false;
+    }
+
+  unlink(&path[0]);
+
+  // the values are written to the file, whose pages then replace theirs
+  if (ftruncate(file, (off_t)bytes) == 0
+      && (data == NULL || writeValues(file, data, size)))
+    {
+      address = mmap(data, bytes, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | ((data != NULL) ? MAP_FIXED : 0), file, 0);
+      if (address == MAP_FAILED) address = NULL;
+    }
+
+  close(file);
+
+  if (address == NULL)
+    {
+      message = "cannot map a file of '" + folder + "' into memory";
+      return false;
+    }
+#endif
+
+  data = static_cast<double*>(address);
+  mapped = true;
+#if defined(WIN32) && !defined(CYGWIN)
+  mapping = handle;
+#endif
+
+  return true;
+}
+
+
+/*
+ * Asks the system to read the values of a spilled buffer back into memory.
+ */
+void
+SedResultBuffer::prefetch() const
+{
+#if !defined(WIN32) || defined(CYGWIN)
+  if (mapped) madvise(data, getNumBytes(), MADV_WILLNEED);
+#endif
+}
+
+
+/*
+ * Frees the values.
+ */
+void
+SedResultBuffer::release()
+{
+  if (data == NULL) return;
+
+#if defined(WIN32) && !defined(CYGWIN)
+  if (!mapped)
+    {
+      VirtualFree(data, 0, MEM_RELEASE);
+    }
+  else
+    {
+      UnmapViewOfFile(data);
+      CloseHandle(mapping);
+      mapping = NULL;
+    }
+#else
+  munmap(data, getNumBytes());
+#endif
+
+  data = NULL;
+  mapped = false;
+}
+
+
+/*
+ * The values of the variables of a task: one tensor of the shape of the
+ * plan of the task per variable.
+ */
+class SedResultColumns
+{
+public:
+  ~SedResultColumns()
+  {
+    for (size_t n = 0; n < buffers.size(); ++n)
+      {
+        delete buffers[n];
+      }
+  }
+
+  std::vector<unsigned int>             shape;
+  std::vector<unsigned long>            strides;
+  unsigned long                         numValues;
+  std::map<std::string, unsigned int>   columns;
+  std::vector<const SedVariable*>       variables;
+  std::vector<unsigned int>             indices;
+  std::vector<SedResultBuffer*>         buffers;
+};
+
+
+/*
+ * @return the key of the values of the given variable.
+ */
+static const std::string&
+getKey(const SedVariable& variable)
+{
+  return variable.isSetTarget() ? variable.getTarget() : variable.getSymbol();
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty, SedResultSlice.
+ */
+SedResultSlice::SedResultSlice()
+  : mData(NULL)
+{
+}
+
+
+/*
+ * Creates a new SedResultSlice of contiguous values.
+ */
+SedResultSlice::SedResultSlice(const double* data,
+                               const std::vector<unsigned int>& shape)
+  : mData(data)
+  , mExtents(shape)
+  , mStrides(shape.size())
+{
+  unsigned long stride = 1;
+
+  for (size_t n = shape.size(); n > 0; --n)
+    {
+      mStrides[n - 1] = stride;
+      stride *= shape[n - 1];
+    }
+}
+
+
+/*
+ * @return the first value of this slice.
+ */
+const double*
+SedResultSlice::getData() const
+{
+  return mData;
+}
+
+
+/*
+ * @return the number of dimensions of this slice.
+ */
+unsigned int
+SedResultSlice::getNumDimensions() const
+{
+  return (unsigned int)mExtents.size();
+}
+
+
+/*
+ * @return the extent of the given dimension.
+ */
+unsigned int
+SedResultSlice::getExtent(unsigned int n) const
+{
+  return (n < mExtents.size()) ? mExtents[n] : 0;
+}
+
+
+/*
+ * @return the stride of the given dimension.
+ */
+unsigned long
+SedResultSlice::getStride(unsigned int n) const
+{
+  return (n < mStrides.size()) ? mStrides[n] : 0;
+}
+
+
+/*
+ * @return the number of values of this slice.
+ */
+unsigned long
+SedResultSlice::getNumValues() const
+{
+  if (mData == NULL) return 0;
+
+  unsigned long numValues = 1;
+
+  for (size_t n = 0; n < mExtents.size(); ++n)
+    {
+      numValues *= mExtents[n];
+    }
+
+  return numValues;
+}
+
+
+/*
+ * @return true if the values of this slice are contiguous.
+ */
+bool
+SedResultSlice::isContiguous() const
+{
+  unsigned long stride = 1;
+
+  for (size_t n = mExtents.size(); n > 0; --n)
+    {
+      if (mExtents[n - 1] > 1 && mStrides[n - 1] != stride) return false;
+
+      stride *= mExtents[n - 1];
+    }
+
+  return true;
+}
+
+
+/*
+ * @return the value at the given indices.
+ */
+double
+SedResultSlice::getValue(const std::vector<unsigned int>& indices) const
+{
+  if (mData == NULL || indices.size() != mExtents.size())
+    return numeric_limits<double>::quiet_NaN();
+
+  unsigned long offset = 0;
+
+  for (size_t n = 0; n < indices.size(); ++n)
+    {
+      if (indices[n] >= mExtents[n])
+        return numeric_limits<double>::quiet_NaN();
+
+      offset += indices[n] * mStrides[n];
+    }
+
+  return mData[offset];
+}
+
+
+/*
+ * Narrows this slice to one index of a dimension.
+ */
+SedResultSlice
+SedResultSlice::select(unsigned int n, unsigned int index) const
+{
+  SedResultSlice slice;
+
+  if (mData == NULL || n >= mExtents.size() || index >= mExtents[n])
+    return slice;
+
+  slice.mData = mData + index * mStrides[n];
+  slice.mExtents = mExtents;
+  slice.mStrides = mStrides;
+  slice.mExtents.erase(slice.mExtents.begin() + n);
+  slice.mStrides.erase(slice.mStrides.begin() + n);
+
+  return slice;
+}
+
+
+/*
+ * Creates a new, empty, SedResultStore.
+ */
+SedResultStore::SedResultStore()
+  : mMemoryBudget(0)
+  , mMemoryUsage(0)
+  , mSpilledSize(0)
+  , mClock(0)
+{
+}
+
+
+/*
+ * Destroys this SedResultStore.
+ */
+SedResultStore::~SedResultStore()
+{
+  clear();
+}
+
+
+/*
+ * Stores the result of a run.
+ */
+void
+SedResultStore::runFinished(const SedSimulationRun& run,
+                            const SedSimulationResult& result)
+{
+  SedResultColumns* columns = prepare(run);
+
+  if (columns == NULL) return;
+
+  // the position of the run in the tensors
+  unsigned int depth = (unsigned int)columns->shape.size() - 1;
+  unsigned long offset = 0;
+
+  for (unsigned int d = 0; d < run.getNumIterations() && d < depth; ++d)
+    {
+      if (run.getIteration(d) >= columns->shape[d])
+        {
+          mErrorMessage = "a run of task '" + run.getTask()->getId()
+                          + "' is outside the plan of the task";
+          return;
+        }
+
+      offset += run.getIteration(d) * columns->strides[d];
+    }
+
+  unsigned int numPoints = min(result.getNumPoints(), columns->shape[depth]);
+  ++mClock;
+
+  for (unsigned int n = 0; n < result.getNumColumns()
+                           && n < columns->indices.size(); ++n)
+    {
+      SedResultBuffer* buffer = columns->buffers[columns->indices[n]];
+      const double* values = result.getColumn(n);
+
+      if (buffer->data == NULL) continue;
+
+      double* column = buffer->data + offset;
+      buffer->lastUse = mClock;
+
+      std::copy(values, values + numPoints, column);
+      std::fill(column + numPoints, column + columns->shape[depth],
+                numeric_limits<double>::quiet_NaN());
+    }
+}
+
+
+/*
+ * Removes all the values of this store.
+ */
+void
+SedResultStore::clear()
+{
+  std::map<std::string, SedResultColumns*>::iterator it;
+
+  for (it = mTasks.begin(); it != mTasks.end(); ++it)
+    {
+      delete it->second;
+    }
+
+  std::map<std::string, SedResultBuffer*>::iterator generated;
+
+  for (generated = mGenerated.begin(); generated != mGenerated.end();
+       ++generated)
+    {
+      delete generated->second;
+    }
+
+  mTasks.clear();
+  mGenerated.clear();
+  mMemoryUsage = 0;
+  mSpilledSize = 0;
+  mErrorMessage.clear();
+}
+
+
+/*
+ * Sets the number of bytes of values this store keeps in memory.
+ */
+int
+SedResultStore::setMemoryBudget(size_t bytes)
+{
+  mMemoryBudget = bytes;
+
+  return spill(0) ? LIBSEDML_OPERATION_SUCCESS : LIBSEDML_OPERATION_FAILED;
+}
+
+
+/*
+ * @return the number of bytes of values this store keeps in memory.
+ */
+size_t
+SedResultStore::getMemoryBudget() const
+{
+  return mMemoryBudget;
+}
+
+
+/*
+ * Sets the directory of the files values are spilled to.
+ */
+int
+SedResultStore::setSpillDirectory(const std::string& directory)
+{
+  mSpillDirectory = directory;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the directory of the files values are spilled to.
+ */
+const std::string&
+SedResultStore::getSpillDirectory() const
+{
+  return mSpillDirectory;
+}
+
+
+/*
+ * @return the number of bytes of values in memory.
+ */
+size_t
+SedResultStore::getMemoryUsage() const
+{
+  return mMemoryUsage;
+}
+
+
+/*
+ * @return the number of bytes of values spilled to files.
+ */
+size_t
+SedResultStore::getSpilledSize() const
+{
+  return mSpilledSize;
+}
+
+
+/*
+ * @return the number of tasks with values in this store.
+ */
+unsigned int
+SedResultStore::getNumTasks() const
+{
+  return (unsigned int)mTasks.size();
+}
+
+
+/*
+ * @return the number of variables of the given task with values.
+ */
+unsigned int
+SedResultStore::getNumVariables(const std::string& taskId) const
+{
+  std::map<std::string, SedResultColumns*>::const_iterator it =
+    mTasks.find(taskId);
+
+  return (it != mTasks.end()) ? (unsigned int)it->second->columns.size() : 0;
+}
+
+
+/*
+ * @return the values of the given variable of the given task.
+ */
+SedResultSlice
+SedResultStore::getSlice(const std::string& taskId,
+                         const std::string& key) const
+{
+  std::map<std::string, SedResultColumns*>::const_iterator it =
+    mTasks.find(taskId);
+
+  if (it == mTasks.end()) return SedResultSlice();
+
+  const SedResultColumns* columns = it->second;
+  std::map<std::string, unsigned int>::const_iterator column =
+    columns->columns.find(key);
+
+  if (column == columns->columns.end() || columns->numValues == 0
+      || column->second >= columns->buffers.size())
+    return SedResultSlice();
+
+  // reading does not count as a use, so that readers never write
+  const SedResultBuffer* buffer = columns->buffers[column->second];
+  buffer->prefetch();
+
+  return SedResultSlice(buffer->data, columns->shape);
+}
+
+
+/*
+ * @return the values of the given variable.
+ */
+SedResultSlice
+SedResultStore::getSlice(const SedVariable& variable) const
+{
+  return getSlice(variable.getTaskReference(), getKey(variable));
+}
+
+
+/*
+ * Evaluates a data generator over the values of its variables.
+ */
+int
+SedResultStore::evaluate(const SedDataGenerator& generator,
+                         const SedMathProgram& program,
+                         SedResultSlice& slice)
+{
+  unsigned int numVariables = generator.getNumVariables();
+
+  if (!program.isCompiled() || program.getNumInputs() != numVariables)
+    return LIBSEDML_INVALID_OBJECT;
+
+  std::vector<SedResultSlice> slices(numVariables);
+  std::vector<const double*> inputs(numVariables + 1);
+  std::vector<unsigned int> shape(1, 1);
+
+  for (unsigned int n = 0; n < numVariables; ++n)
+    {
+      const SedVariable* variable = generator.getVariable(n);
+
+      if (program.getInputId(n) != variable->getId())
+        return LIBSEDML_INVALID_OBJECT;
+
+      slices[n] = getSlice(*variable);
+
+      if (slices[n].getData() == NULL) return LIBSEDML_INVALID_OBJECT;
+
+      std::vector<unsigned int> extents(slices[n].getNumDimensions());
+
+      for (unsigned int d = 0; d < extents.size(); ++d)
+        {
+          extents[d] = slices[n].getExtent(d);
+        }
+
+      if (n == 0)
+        shape.swap(extents);
+      else if (extents != shape)
+        return LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+      inputs[n] = slices[n].getData();
+    }
+
+  // a generator that is one of its variables is a view of its values
+  const ASTNode* math = generator.getMath();
+
+  if (math != NULL && math->getType() == AST_NAME && math->getName() != NULL)
+    {
+      for (unsigned int n = 0; n < numVariables; ++n)
+        {
+          if (generator.getVariable(n)->getId() == math->getName())
+            {
+              slice = slices[n];
+              return LIBSEDML_OPERATION_SUCCESS;
+            }
+        }
+    }
+
+  unsigned long numValues = 1;
+
+  for (size_t d = 0; d < shape.size(); ++d)
+    {
+      numValues *= shape[d];
+    }
+
+  // the values of the previous evaluation are reused, or replaced
+  std::map<std::string, SedResultBuffer*>::iterator it =
+    mGenerated.find(generator.getId());
+  SedResultBuffer* buffer = (it != mGenerated.end()) ? it->second : NULL;
+
+  if (buffer != NULL && buffer->size != numValues)
+    {
+      discard(buffer);
+      mGenerated.erase(it);
+      buffer = NULL;
+    }
+
+  if (buffer == NULL)
+    {
+      buffer = allocate(numValues);
+
+      if (buffer == NULL)
+        {
+          mErrorMessage = "the values of data generator '" + generator.getId()
+                          + "' cannot be stored: " + mErrorMessage;
+          return LIBSEDML_OPERATION_FAILED;
+        }
+
+      mGenerated[generator.getId()] = buffer;
+    }
+
+  buffer->lastUse = ++mClock;
+
+  // in chunks the program can count
+  const unsigned long chunk = 1UL << 30;
+
+  for (unsigned long start = 0; start < numValues; start += chunk)
+    {
+      std::vector<const double*> chunkInputs(inputs);
+
+      for (unsigned int n = 0; n < numVariables; ++n)
+        {
+          chunkInputs[n] += start;
+        }
+
+      int result = program.evaluate(&chunkInputs[0],
+                                    (unsigned int)min(chunk, numValues - start),
+                                    buffer->data + start);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        {
+          mErrorMessage = "data generator '" + generator.getId()
+                          + "': " + program.getErrorMessage();
+          return LIBSEDML_OPERATION_FAILED;
+        }
+    }
+
+  slice = SedResultSlice(buffer->data, shape);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the reason the last results could not be stored.
+ */
+const std::string&
+SedResultStore::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * @return the values of the task of the given run, allocated when its
+ * first run is reported, with a column for each of its variables.
+ */
+SedResultColumns*
+SedResultStore::prepare(const SedSimulationRun& run)
+{
+  const SedTask* task = run.getTask();
+  SedResultColumns*& columns = mTasks[task->getId()];
+
+  if (columns == NULL)
+    {
+      SedTaskPlan plan;
+      int result = plan.compile(*task);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        {
+          mErrorMessage = "task '" + task->getId() + "': "
+                          + plan.getErrorMessage();
+          mTasks.erase(task->getId());
+          return NULL;
+        }
+
+      columns = new SedResultColumns();
+      plan.getShape(columns->shape);
+      columns->strides.resize(columns->shape.size());
+
+      double numValues = 1;
+
+      for (size_t n = columns->shape.size(); n > 0; --n)
+        {
+          columns->strides[n - 1] = (unsigned long)numValues;
+          numValues *= columns->shape[n - 1];
+        }
+
+      if (numValues * sizeof(double)
+          > (double)numeric_limits<size_t>::max())
+        {
+          mErrorMessage = "the results of task '" + task->getId()
+                          + "' do not fit in memory";
+          delete columns;
+          mTasks.erase(task->getId());
+          return NULL;
+        }
+
+      columns->numValues = (unsigned long)numValues;
+    }
+
+  // the columns of the variables of the run, added as they appear
+  bool known = columns->variables.size() == run.getNumVariables();
+
+  for (unsigned int n = 0; known && n < run.getNumVariables(); ++n)
+    {
+      known = columns->variables[n] == run.getVariable(n);
+    }
+
+  if (!known)
+    {
+      columns->variables.resize(run.getNumVariables());
+      columns->indices.resize(run.getNumVariables());
+
+      for (unsigned int n = 0; n < run.getNumVariables(); ++n)
+        {
+          const SedVariable* variable = run.getVariable(n);
+          unsigned int numColumns = (unsigned int)columns->columns.size();
+          std::pair<std::map<std::string, unsigned int>::iterator, bool> added =
+            columns->columns.insert(make_pair(getKey(*variable), numColumns));
+
+          columns->variables[n] = variable;
+          columns->indices[n] = added.first->second;
+        }
+
+      while (columns->buffers.size() < columns->columns.size())
+        {
+          SedResultBuffer* buffer = allocate(columns->numValues);
+
+          if (buffer == NULL)
+            {
+              mErrorMessage = "the results of task '" + task->getId()
+                              + "' cannot be stored: " + mErrorMessage;
+              columns->variables.clear();
+              return NULL;
+            }
+
+          columns->buffers.push_back(buffer);
+        }
+    }
+
+  return columns;
+}
+
+
+/*
+ * @return a new buffer of the given number of values, set to NaN, in
+ * memory if the budget allows it after spilling the least recently used
+ * buffers, or in a file.  A buffer larger than the budget goes to a file
+ * at once, rather than after all the others.
+ */
+SedResultBuffer*
+SedResultStore::allocate(size_t numValues)
+{
+  SedResultBuffer* buffer = new SedResultBuffer(numValues);
+  size_t bytes = buffer->getNumBytes();
+  bool stored;
+
+  if (mMemoryBudget == 0 || (bytes <= mMemoryBudget && spill(bytes)
+                             && mMemoryUsage + bytes <= mMemoryBudget))
+    {
+      stored = buffer->allocate();
+      if (!stored) mErrorMessage = "out of memory";
+    }
+  else
+    {
+      stored = buffer->spill(mSpillDirectory, mErrorMessage);
+    }
+
+  if (!stored)
+    {
+      delete buffer;
+      return NULL;
+    }
+
+  if (buffer->mapped)
+    mSpilledSize += bytes;
+  else
+    mMemoryUsage += bytes;
+
+  buffer->lastUse = ++mClock;
+  std::fill(buffer->data, buffer->data + numValues,
+            numeric_limits<double>::quiet_NaN());
+
+  return buffer;
+}
+
+
+/*
+ * Frees a buffer that is not part of the values of a task.
+ */
+void
+SedResultStore::discard(SedResultBuffer* buffer)
+{
+  if (buffer->mapped)
+    mSpilledSize -= buffer->getNumBytes();
+  else
+    mMemoryUsage -= buffer->getNumBytes();
+
+  delete buffer;
+}
+
+
+/*
+ * Spills the least recently used buffers in memory until the given number
+ * of bytes fits in the budget, or no buffer is left in memory.
+ *
+ * @return false if a buffer could not be spilled.
+ */
+bool
+SedResultStore::spill(size_t bytes)
+{
+  while (mMemoryBudget != 0 && mMemoryUsage + bytes > mMemoryBudget)
+    {
+      SedResultBuffer* coldest = NULL;
+      std::map<std::string, SedResultColumns*>::iterator it;
+
+      for (it = mTasks.begin(); it != mTasks.end(); ++it)
+        {
+          std::vector<SedResultBuffer*>& buffers = it->second->buffers;
+
+          for (size_t n = 0; n < buffers.size(); ++n)
+            {
+              if (!buffers[n]->mapped
+                  && (coldest == NULL || buffers[n]->lastUse < coldest->lastUse))
+                coldest = buffers[n];
+            }
+        }
+
+      std::map<std::string, SedResultBuffer*>::iterator generated;
+
+      for (generated = mGenerated.begin(); generated != mGenerated.end();
+           ++generated)
+        {
+          SedResultBuffer* buffer = generated->second;
+
+          if (!buffer->mapped
+              && (coldest == NULL || buffer->lastUse < coldest->lastUse))
+            coldest = buffer;
+        }
+
+      if (coldest == NULL) return true;
+
+      if (!coldest->spill(mSpillDirectory, mErrorMessage)) return false;
+
+      mMemoryUsage -= coldest->getNumBytes();
+      mSpilledSize += coldest->getNumBytes();
+    }
+
+  return true;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedResultStore_t *
+SedResultStore_create(void)
+{
+  return new(std::nothrow) SedResultStore();
+}
+
+
+LIBSEDML_EXTERN
+void
+SedResultStore_free(SedResultStore_t *store)
+{
+  delete store;
+}
+
+
+LIBSEDML_EXTERN
+void
+SedResultStore_clear(SedResultStore_t *store)
+{
+  if (store != NULL) store->clear();
+}
+
+
+LIBSEDML_EXTERN
+int
+SedResultStore_setMemoryBudget(SedResultStore_t *store, size_t bytes)
+{
+  if (store == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return store->setMemoryBudget(bytes);
+}
+
+
+LIBSEDML_EXTERN
+int
+SedResultStore_setSpillDirectory(SedResultStore_t *store,
+                                 const char *directory)
+{
+  if (store == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return store->setSpillDirectory(directory != NULL ? directory : "");
+}
+
+
+LIBSEDML_EXTERN
+const double *
+SedResultStore_getValues(const SedResultStore_t *store, const char *taskId,
+                         const char *key, unsigned long *numValues)
+{
+  if (numValues != NULL) *numValues = 0;
+
+  if (store == NULL || taskId == NULL || key == NULL) return NULL;
+
+  SedResultSlice slice = store->getSlice(taskId, key);
+
+  if (numValues != NULL) *numValues = slice.getNumValues();
+
+  return slice.getData();
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
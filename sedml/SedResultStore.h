@@ -0,0 +1,502 @@
+/**
+ * @file    SedResultStore.h
+ * @brief   Definition of SedResultStore
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedResultStore
+ * @ingroup Core
+ * @brief Stores the results of the runs of tasks, in contiguous columns.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedResultStore is a SedExecutionListener keeping the values of the
+ * variables of the runs a SedTaskExecutor reports.  The values are keyed
+ * by the id of the task a variable references, and by the target of the
+ * variable, or its symbol when it has no target; the variables of several
+ * data generators with the same task and target share their values.
+ *
+ * The values of a variable form a tensor, with one dimension per depth of
+ * nested repeated tasks, indexed by the iteration of the repeated task at
+ * that depth, and a last dimension indexed by the output point; the
+ * extents are those of SedTaskPlan::getShape().  A task that is not a
+ * repeated task has a single dimension, its output points.  The tensor of
+ * a variable is allocated in a single block when the first run of its task
+ * is reported, so that a large sweep fills preallocated memory rather than
+ * growing one vector per run.  The values
+ * of the runs that were not reported, or that failed, are NaN; so are the
+ * points past the end of the runs with fewer points than the others.  When
+ * a repeated task has several subtasks providing a variable in the same
+ * iteration, the last one reported is kept.
+ *
+ * The values are read through SedResultSlice views of the tensors, which
+ * copy nothing: a slice can be narrowed to the runs of an iteration, or to
+ * a single time course, and evaluate() passes the tensors of the variables
+ * of a SedDataGenerator to a SedMathProgram as they are, storing the
+ * result in a tensor of the store.  The slices of the x, y and z data
+ * generators of a SedCurve or SedSurface are then combined point by point.
+ * @code{.cpp}
+ * SedResultStore store;
+ * executor.execute(tasks, store);
+ *
+ * SedMathProgram program;
+ * program.compile(*generator);
+ * SedResultSlice slice;
+ * if (store.evaluate(*generator, program, slice)
+ *       == LIBSEDML_OPERATION_SUCCESS)
+ *   {
+ *     // the time course of the generator in iteration 3 of the sweep
+ *     SedResultSlice course = slice.select(0, 3);
+ *     for (unsigned int p = 0; p < course.getExtent(0); ++p)
+ *       cout << course.getData()[p * course.getStride(0)] << endl;
+ *   }
+ * @endcode
+ *
+ * The results of large sweeps may not fit in memory.  When a memory
+ * budget is set with setMemoryBudget(), the tensors that do not fit in it
+ * are spilled to temporary files, mapped into memory: the tensors least
+ * recently written first, then the new tensors themselves; a new tensor
+ * larger than the whole budget is spilled at once.  A spilled tensor
+ * keeps its address, and its values are read and written like the
+ * others, the system paging them in and out of the file as they are used;
+ * getSlice() asks the system to read them back in advance.  The files are removed when the
+ * tensors are freed, or when the process ends.  On Windows, tensors
+ * already in memory can only be spilled from Windows 10 version 1803;
+ * on earlier versions setMemoryBudget() fails and they stay in memory.  Where the directory of
+ * temporary files is itself in memory, a directory on disk must be set
+ * with setSpillDirectory().
+ * @code{.cpp}
+ * SedResultStore store;
+ * store.setMemoryBudget(512 * 1024 * 1024);
+ * store.setSpillDirectory("/scratch");
+ * executor.execute(tasks, store);
+ * @endcode
+ *
+ * The functions of SedExecutionListener are called one at a time by the
+ * executor.  The slices of a task remain valid until the store is cleared
+ * or destroyed; those of a data generator until it is evaluated again.
+ * The const functions of the store do not modify it, and may be called
+ * from several threads once the runs have been reported.  The shape of the
+ * values of a task is fixed by its first run: the store must be cleared
+ * before the runs of a modified task are reported.
+ */
+
+#ifndef SedResultStore_h
+#define SedResultStore_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedTaskExecutor.h>
+
+#include <stddef.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class SedDataGenerator;
+class SedMathProgram;
+class SedResultBuffer;
+class SedResultColumns;
+class SedVariable;
+
+
+/**
+ * @class SedResultSlice
+ * @ingroup Core
+ * @brief A view of values stored by a SedResultStore.
+ *
+ * A slice is a strided tensor: the value at the indices
+ * <code>(i0, i1, ...)</code> is
+ * <code>getData()[i0 * getStride(0) + i1 * getStride(1) + ...]</code>.
+ * It does not own its values.
+ */
+class LIBSEDML_EXTERN SedResultSlice
+{
+public:
+
+  /**
+   * Creates a new, empty, SedResultSlice.
+   */
+  SedResultSlice();
+
+
+  /**
+   * Creates a new SedResultSlice of contiguous values.
+   *
+   * @param data the values, stored with the last dimension varying the
+   * fastest.
+   * @param shape the extents of the dimensions.
+   */
+  SedResultSlice(const double* data, const std::vector<unsigned int>& shape);
+
+
+  /**
+   * @return the first value of this slice, or @c NULL if it is empty.
+   */
+  const double* getData() const;
+
+
+  /**
+   * @return the number of dimensions of this slice.
+   */
+  unsigned int getNumDimensions() const;
+
+
+  /**
+   * @param n the index of the dimension.
+   *
+   * @return the extent of the given dimension, or @c 0 if there is no such
+   * dimension.
+   */
+  unsigned int getExtent(unsigned int n) const;
+
+
+  /**
+   * @param n the index of the dimension.
+   *
+   * @return the distance between consecutive values of the given
+   * dimension, or @c 0 if there is no such dimension.
+   */
+  unsigned long getStride(unsigned int n) const;
+
+
+  /**
+   * @return the number of values of this slice.
+   */
+  unsigned long getNumValues() const;
+
+
+  /**
+   * @return @c true if the values of this slice are contiguous, so that
+   * getData() is a column of getNumValues() values.
+   */
+  bool isContiguous() const;
+
+
+  /**
+   * @param indices the index in each dimension.
+   *
+   * @return the value at the given indices, or NaN if they are out of
+   * range.
+   */
+  double getValue(const std::vector<unsigned int>& indices) const;
+
+
+  /**
+   * Narrows this slice to one index of a dimension.
+   *
+   * @param n the index of the dimension, which the result does not have.
+   * @param index the index in that dimension.
+   *
+   * @return the slice of the values at the given index, or an empty slice
+   * if there is no such dimension or index.
+   */
+  SedResultSlice select(unsigned int n, unsigned int index) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  const double*                mData;
+  std::vector<unsigned int>    mExtents;
+  std::vector<unsigned long>   mStrides;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+class LIBSEDML_EXTERN SedResultStore : public SedExecutionListener
+{
+public:
+
+  /**
+   * Creates a new, empty, SedResultStore.
+   */
+  SedResultStore();
+
+
+  /**
+   * Destructor method.
+   */
+  virtual ~SedResultStore();
+
+
+  /**
+   * Stores the result of a run.
+   *
+   * @param run the run.
+   * @param result the values of the variables of the run.
+   */
+  virtual void runFinished(const SedSimulationRun& run,
+                           const SedSimulationResult& result);
+
+
+  /**
+   * Removes all the values of this store.
+   */
+  void clear();
+
+
+  /**
+   * Sets the number of bytes of values this store keeps in memory; the
+   * other values are spilled to files.  The tensors in memory that do not
+   * fit in a new budget are spilled at once.
+   *
+   * @param bytes the budget, or @c 0 to keep all the values in memory, the
+   * default.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if a tensor could not be spilled; getErrorMessage() tells why.
+   */
+  int setMemoryBudget(size_t bytes);
+
+
+  /**
+   * @return the number of bytes of values this store keeps in memory, or
+   * @c 0 if there is no budget.
+   */
+  size_t getMemoryBudget() const;
+
+
+  /**
+   * Sets the directory of the files values are spilled to.
+   *
+   * @param directory the directory, or an empty string for the directory
+   * of temporary files of the system, the default.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setSpillDirectory(const std::string& directory);
+
+
+  /**
+   * @return the directory of the files values are spilled to.
+   */
+  const std::string& getSpillDirectory() const;
+
+
+  /**
+   * @return the number of bytes of values in memory.
+   */
+  size_t getMemoryUsage() const;
+
+
+  /**
+   * @return the number of bytes of values spilled to files.
+   */
+  size_t getSpilledSize() const;
+
+
+  /**
+   * @return the number of tasks with values in this store.
+   */
+  unsigned int getNumTasks() const;
+
+
+  /**
+   * @param taskId the id of a task.
+   *
+   * @return the number of variables of the given task with values in this
+   * store.
+   */
+  unsigned int getNumVariables(const std::string& taskId) const;
+
+
+  /**
+   * @param taskId the id of the task.
+   * @param key the target of the variable, or its symbol.
+   *
+   * @return the values of the given variable of the given task, or an
+   * empty slice if there are none.
+   */
+  SedResultSlice getSlice(const std::string& taskId,
+                          const std::string& key) const;
+
+
+  /**
+   * @param variable the variable.
+   *
+   * @return the values of the given variable, or an empty slice if there
+   * are none.
+   */
+  SedResultSlice getSlice(const SedVariable& variable) const;
+
+
+  /**
+   * Evaluates a data generator over the values of its variables.  All the
+   * variables must have values of the same shape, which is the shape of the
+   * result.  When the math of the generator is one of its variables, the
+   * result is a view of the values of that variable, which are not copied;
+   * otherwise the values computed are stored in a tensor of this store,
+   * under the memory budget like the others, which replaces the values of
+   * the previous evaluation of the generator.
+   *
+   * @param generator the data generator.
+   * @param program the math of the generator, compiled with
+   * SedMathProgram::compile(const SedDataGenerator&).
+   * @param slice the slice receiving the result, a view of the values of
+   * this store.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if the program is not compiled for the generator, or a variable has no
+   * values.
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_ATTRIBUTE_VALUE LIBSEDML_INVALID_ATTRIBUTE_VALUE @endlink
+   * if the values of the variables have different shapes.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the values could not be stored or computed; getErrorMessage() tells
+   * why.
+   */
+  int evaluate(const SedDataGenerator& generator,
+               const SedMathProgram& program, SedResultSlice& slice);
+
+
+  /**
+   * @return the reason the last results could not be stored or evaluated,
+   * or an empty string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  SedResultStore(const SedResultStore&);
+  SedResultStore& operator=(const SedResultStore&);
+
+  SedResultColumns* prepare(const SedSimulationRun& run);
+
+  SedResultBuffer* allocate(size_t numValues);
+
+  void discard(SedResultBuffer* buffer);
+
+  bool spill(size_t bytes);
+
+  std::map<std::string, SedResultColumns*>  mTasks;
+  std::map<std::string, SedResultBuffer*>   mGenerated;
+  size_t                                    mMemoryBudget;
+  size_t                                    mMemoryUsage;
+  size_t                                    mSpilledSize;
+  std::string                               mSpillDirectory;
+  unsigned long                             mClock;
+  std::string                               mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new, empty, SedResultStore.
+ */
+LIBSEDML_EXTERN
+SedResultStore_t *
+SedResultStore_create(void);
+
+/**
+ * Frees the given SedResultStore.
+ */
+LIBSEDML_EXTERN
+void
+SedResultStore_free(SedResultStore_t *store);
+
+/**
+ * Removes all the values of the given SedResultStore.
+ */
+LIBSEDML_EXTERN
+void
+SedResultStore_clear(SedResultStore_t *store);
+
+/**
+ * Sets the number of bytes of values the given SedResultStore keeps in
+ * memory, or @c 0 to keep them all.
+ */
+LIBSEDML_EXTERN
+int
+SedResultStore_setMemoryBudget(SedResultStore_t *store, size_t bytes);
+
+/**
+ * Sets the directory of the files the given SedResultStore spills values
+ * to, or @c NULL for the directory of temporary files of the system.
+ */
+LIBSEDML_EXTERN
+int
+SedResultStore_setSpillDirectory(SedResultStore_t *store,
+                                 const char *directory);
+
+/**
+ * Returns the values of a variable of a task in the given SedResultStore,
+ * contiguous, with the output points varying the fastest, or @c NULL if
+ * there are none; numValues receives their number.
+ */
+LIBSEDML_EXTERN
+const double *
+SedResultStore_getValues(const SedResultStore_t *store, const char *taskId,
+                         const char *key, unsigned long *numValues);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedResultStore_h */
@@ -0,0 +1,1546 @@
+/**
+ * @file    SedSbmlBackend.cpp
+ * @brief   Implementation of SedSbmlBackend
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedSbmlBackend.h>
+#include <sedml/SedAlgorithm.h>
+#include <sedml/SedAlgorithmParameter.h>
+#include <sedml/SedChangeAttribute.h>
+#include <sedml/SedComputeChange.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedOdeSolver.h>
+#include <sedml/SedOneStep.h>
+#include <sedml/SedSetValue.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/SedVariable.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <sbml/SBMLTypes.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <set>
+#include <sstream>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The name the math of the models uses for the time.
+ */
+static const char* const SEDML_SBML_TIME = "urn:sedml:symbol:time";
+
+
+/*
+ * @return the number of a KiSAO term id, or -1 if it has none.
+ */
+static int
+getKisaoNumber(const std::string& kisaoID)
+{
+  std::string::size_type pos = kisaoID.find(':');
+
+  if (pos == std::string::npos)
+    pos = kisaoID.find('_');
+
+  if (pos == std::string::npos)
+    return -1;
+
+  std::stringstream str(kisaoID.substr(pos + 1));
+  int result = -1; str >> result;
+  return result;
+}
+
+
+/*
+ * Finds the integration method of an algorithm; returns false if it is not
+ * supported.
+ */
+static bool
+getOdeMethod(const std::string& kisaoID, SedOdeMethod_t& method)
+{
+  if (kisaoID.empty())
+    {
+      method = SEDML_ODE_DORMAND_PRINCE;
+      return true;
+    }
+
+  switch (getKisaoNumber(kisaoID))
+    {
+    case 32:  // Runge-Kutta
+    case 87:  // Dormand-Prince
+      method = SEDML_ODE_DORMAND_PRINCE;
+      return true;
+
+    case 19:  // CVODE
+    case 33:  // Rosenbrock
+    case 88:  // LSODA
+      method = SEDML_ODE_ROSENBROCK;
+      return true;
+
+    default:
+      return false;
+    }
+}
+
+
+/*
+ * Splits an XPath expression selecting an element by its id, and maybe one
+ * of its attributes; returns false if it does not select an element.
+ */
+static bool
+parseTarget(const std::string& target, std::string& id,
+            std::string& attribute)
+{
+  std::string::size_type start = target.rfind("[@id=");
+
+  if (start == std::string::npos || start + 6 >= target.size())
+    return false;
+
+  start += 5;
+  char quote = target[start];
+
+  if (quote != '\'' && quote != '"') return false;
+
+  std::string::size_type end = target.find(quote, start + 1);
+
+  if (end == std::string::npos) return false;
+
+  id = target.substr(start + 1, end - start - 1);
+  attribute.clear();
+
+  std::string::size_type at = target.find("/@", end);
+
+  if (at != std::string::npos)
+    attribute = target.substr(at + 2);
+
+  return !id.empty();
+}
+
+
+/*
+ * @return the document containing the given object.
+ */
+static const SedDocument*
+findDocument(const SedBase* object)
+{
+  while (object != NULL && object->getTypeCode() != SEDML_DOCUMENT)
+    {
+      object = object->getParentSedObject();
+    }
+
+  return static_cast<const SedDocument*>(object);
+}
+
+
+/*
+ * Finds the value of the attribute of an element of a model; returns
+ * false, with the reason in message, if it has none.
+ */
+static bool
+getAttribute(const Model& model, const std::string& target, double& value,
+             std::string& message)
+{
+  std::string id, attribute;
+  const SBase* element = parseTarget(target, id, attribute)
+    ? const_cast<Model&>(model).getElementBySId(id) : NULL;
+
+  if (element == NULL)
+    {
+      message = "the target '" + target + "' is not in the model";
+      return false;
+    }
+
+  switch (element->getTypeCode())
+    {
+    case SBML_PARAMETER:
+      value = static_cast<const Parameter*>(element)->getValue();
+      return true;
+
+    case SBML_COMPARTMENT:
+      value = static_cast<const Compartment*>(element)->getSize();
+      return true;
+
+    case SBML_SPECIES:
+      {
+        const Species* species = static_cast<const Species*>(element);
+        bool amount = (attribute == "initialAmount")
+          || (attribute.empty() && species->getHasOnlySubstanceUnits());
+
+        value = amount ? species->getInitialAmount()
+                       : species->getInitialConcentration();
+        return true;
+      }
+
+    default:
+      message = "the target '" + target + "' has no value";
+      return false;
+    }
+}
+
+
+/*
+ * Sets an attribute of an element of a model; returns false, with the
+ * reason in message, if it cannot be changed.
+ */
+static bool
+setAttribute(Model& model, const std::string& target, double value,
+             std::string& message)
+{
+  std::string id, attribute;
+  SBase* element = parseTarget(target, id, attribute)
+    ? model.getElementBySId(id) : NULL;
+
+  if (element == NULL)
+    {
+      message = "the target '" + target + "' is not in the model";
+      return false;
+    }
+
+  switch (element->getTypeCode())
+    {
+    case SBML_PARAMETER:
+      if (!attribute.empty() && attribute != "value") break;
+
+      static_cast<Parameter*>(element)->setValue(value);
+      return true;
+
+    case SBML_COMPARTMENT:
+      if (!attribute.empty() && attribute != "size") break;
+
+      static_cast<Compartment*>(element)->setSize(value);
+      return true;
+
+    case SBML_SPECIES:
+      {
+        Species* species = static_cast<Species*>(element);
+
+        if (attribute == "initialAmount"
+            || (attribute.empty() && species->getHasOnlySubstanceUnits()))
+          {
+            species->unsetInitialConcentration();
+            species->setInitialAmount(value);
+            return true;
+          }
+
+        if (!attribute.empty() && attribute != "initialConcentration") break;
+
+        species->unsetInitialAmount();
+        species->setInitialConcentration(value);
+        return true;
+      }
+
+    default:
+      break;
+    }
+
+  message = "the target '" + target + "' cannot be changed";
+  return false;
+}
+
+
+/*
+ * Applies the changes of a SedModel to its SBML document; returns false,
+ * with the reason in message, if one of them is not supported.
+ */
+static bool
+applyChanges(const SedModel& model, SBMLDocument& document,
+             std::string& message)
+{
+  Model& sbml = *document.getModel();
+
+  for (unsigned int n = 0; n < model.getNumChanges(); ++n)
+    {
+      const SedChange* change = model.getChange(n);
+      double value;
+
+      if (change->getTypeCode() == SEDML_CHANGE_ATTRIBUTE)
+        {
+          const std::string& newValue =
+            static_cast<const SedChangeAttribute*>(change)->getNewValue();
+          char* end = NULL;
+
+          value = strtod(newValue.c_str(), &end);
+
+          if (newValue.empty() || *end != '\0')
+            {
+              message = "the new value '" + newValue + "' of '"
+                        + change->getTarget() + "' is not a number";
+              return false;
+            }
+        }
+      else if (change->getTypeCode() == SEDML_CHANGE_COMPUTECHANGE)
+        {
+          const SedComputeChange* compute =
+            static_cast<const SedComputeChange*>(change);
+          std::vector<std::string> inputIds;
+          std::vector<double> inputs;
+          std::map<std::string, double> constants;
+          SedMathProgram program;
+
+          // the variables are the values of the model before the change
+          for (unsigned int v = 0; v < compute->getNumVariables(); ++v)
+            {
+              const SedVariable* variable = compute->getVariable(v);
+              double input;
+
+              if (!variable->getModelReference().empty()
+                  && variable->getModelReference() != model.getId())
+                {
+                  message = "the change of '" + change->getTarget()
+                            + "' uses the model '"
+                            + variable->getModelReference() + "'";
+                  return false;
+                }
+
+              if (!getAttribute(sbml, variable->getTarget(), input, message))
+                return false;
+
+              inputIds.push_back(variable->getId());
+              inputs.push_back(input);
+            }
+
+          for (unsigned int p = 0; p < compute->getNumParameters(); ++p)
+            {
+              const SedParameter* parameter = compute->getParameter(p);
+              constants[parameter->getId()] = parameter->getValue();
+            }
+
+          if (program.compile(compute->getMath(), inputIds, constants)
+              != LIBSEDML_OPERATION_SUCCESS)
+            {
+              message = "the change of '" + change->getTarget() + "': "
+                        + program.getErrorMessage();
+              return false;
+            }
+
+          value = program.evaluate(inputs.empty() ? NULL : &inputs[0]);
+        }
+      else
+        {
+          message = "changes of type '" + change->getElementName()
+                    + "' are not supported";
+          return false;
+        }
+
+      if (!setAttribute(sbml, change->getTarget(), value, message))
+        return false;
+    }
+
+  return true;
+}
+
+
+/*
+ * Gives the math of a model the names SedMathProgram knows: the time is
+ * named after its SED-ML symbol, and the Avogadro constant is a number.
+ */
+static void
+prepareMath(ASTNode* node)
+{
+  if (node->getType() == AST_NAME_TIME)
+    {
+      node->setType(AST_NAME);
+      node->setName(SEDML_SBML_TIME);
+    }
+  else if (node->getType() == AST_NAME_AVOGADRO)
+    {
+      node->setValue(6.02214179e23);
+    }
+
+  for (unsigned int n = 0; n < node->getNumChildren(); ++n)
+    {
+      prepareMath(node->getChild(n));
+    }
+}
+
+
+/*
+ * Collects the names the given math uses, once each.
+ */
+static void
+collectNames(const ASTNode* node, std::vector<std::string>& names)
+{
+  if (node->getType() == AST_NAME && node->getName() != NULL)
+    {
+      std::string name = node->getName();
+
+      if (std::find(names.begin(), names.end(), name) == names.end())
+        names.push_back(name);
+    }
+
+  for (unsigned int n = 0; n < node->getNumChildren(); ++n)
+    {
+      collectNames(node->getChild(n), names);
+    }
+}
+
+
+/*
+ * An equation of a model: the math giving the value, or the rate, of a
+ * symbol, and the symbols it uses, in the order of the inputs of its
+ * program.
+ */
+struct SedSbmlEquation
+{
+  unsigned int                symbol;
+  SedMathProgram              program;
+  std::vector<unsigned int>   inputs;
+};
+
+
+/*
+ * The contribution of a reaction to the rate of a species; the
+ * compartment of a species that is a concentration divides it, and the
+ * conversion factor of the species (or of the model) multiplies it.
+ */
+struct SedSbmlFlux
+{
+  unsigned int  reaction;
+  unsigned int  species;
+  double        stoichiometry;
+  int           compartment;
+  int           factor;
+};
+
+
+/*
+ * Orders the given equations so that each comes after those giving the
+ * symbols it uses; returns false if they depend on each other in a cycle.
+ */
+static bool
+visitEquation(const std::vector<SedSbmlEquation>& equations, unsigned int e,
+              const std::map<unsigned int, unsigned int>& targets,
+              std::map<unsigned int, int>& marks,
+              std::vector<unsigned int>& order)
+{
+  int& mark = marks[e];
+
+  if (mark == 2) return true;
+  if (mark == 1) return false;
+
+  mark = 1;
+
+  const std::vector<unsigned int>& inputs = equations[e].inputs;
+
+  for (size_t n = 0; n < inputs.size(); ++n)
+    {
+      std::map<unsigned int, unsigned int>::const_iterator it =
+        targets.find(inputs[n]);
+
+      if (it != targets.end()
+          && !visitEquation(equations, it->second, targets, marks, order))
+        return false;
+    }
+
+  mark = 2;
+  order.push_back(e);
+  return true;
+}
+
+
+static bool
+sortEquations(const std::vector<SedSbmlEquation>& equations,
+              const std::vector<unsigned int>& selected,
+              std::vector<unsigned int>& order)
+{
+  std::map<unsigned int, unsigned int> targets;
+  std::map<unsigned int, int> marks;
+
+  for (size_t n = 0; n < selected.size(); ++n)
+    {
+      targets[equations[selected[n]].symbol] = selected[n];
+    }
+
+  order.clear();
+
+  for (size_t n = 0; n < selected.size(); ++n)
+    {
+      if (!visitEquation(equations, selected[n], targets, marks, order))
+        return false;
+    }
+
+  return true;
+}
+
+
+/*
+ * A model loaded into a SedSbmlBackend.  Each symbol of the model (its
+ * compartments, species, parameters and reactions, and the time) has a
+ * column of values, one per member of the ensemble being simulated; the
+ * states integrated come first, so that their columns are the states of
+ * the SedOdeSolver.
+ */
+class SedSbmlSession : public SedSimulationSession, public SedOdeSystem
+{
+public:
+
+  SedSbmlSession()
+    : mNumStates(0)
+    , mTimeSymbol(0)
+    , mNumMembers(1)
+    , mTime(0)
+    , mStarted(false)
+  {
+  }
+
+
+  /*
+   * Compiles the model of the given document, or remembers why it could
+   * not be.
+   */
+  void load(SBMLDocument* document, const std::string& message)
+  {
+    mLoadError = message;
+
+    if (document == NULL) return;
+
+    if (!document->expandFunctionDefinitions())
+      mLoadError = "the function definitions could not be expanded";
+    else
+      compileModel(*document->getModel());
+
+    reset();
+  }
+
+
+  virtual int reset()
+  {
+    if (!mLoadError.empty())
+      {
+        mErrorMessage = mLoadError;
+        return LIBSEDML_OPERATION_FAILED;
+      }
+
+    mNumMembers = 1;
+    mColumns = mInitialValues;
+    mChanged.assign(mInitialValues.size(), false);
+    mTime = 0;
+    mStarted = false;
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  virtual int setValue(const SedSetValue& change, double value)
+  {
+    bool amount;
+    int symbol = findChangeSymbol(change, amount);
+
+    if (symbol < 0) return mLoadError.empty() ? LIBSEDML_INVALID_OBJECT
+                                              : LIBSEDML_OPERATION_FAILED;
+
+    for (unsigned int m = 0; m < mNumMembers; ++m)
+      {
+        setMember((unsigned int)symbol, amount, m, value);
+      }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  virtual int simulate(const SedSimulationRun& run,
+                       SedSimulationResult& result)
+  {
+    if (!mLoadError.empty())
+      {
+        mErrorMessage = mLoadError;
+        return LIBSEDML_OPERATION_FAILED;
+      }
+
+    return integrate(&run, 1, &result);
+  }
+
+
+  virtual int simulateEnsemble(const SedSimulationRun* runs,
+                               unsigned int numRuns,
+                               const std::vector<const SedSetValue*>& changes,
+                               const double* values,
+                               SedSimulationResult* results)
+  {
+    if (!mLoadError.empty())
+      {
+        mErrorMessage = mLoadError;
+        return LIBSEDML_OPERATION_FAILED;
+      }
+
+    if (numRuns == 0) return LIBSEDML_OPERATION_SUCCESS;
+
+    if (runs == NULL || results == NULL
+        || (values == NULL && !changes.empty()))
+      return LIBSEDML_INVALID_OBJECT;
+
+    // runs of different simulations cannot be integrated together
+    for (unsigned int r = 1; r < numRuns; ++r)
+      {
+        if (runs[r].getSimulation() != runs[0].getSimulation()
+            || runs[r].getNumVariables() != runs[0].getNumVariables())
+          return SedSimulationSession::simulateEnsemble(runs, numRuns,
+                                                        changes, values,
+                                                        results);
+      }
+
+    std::vector<int> symbols(changes.size());
+    std::vector<bool> amounts(changes.size());
+
+    for (size_t c = 0; c < changes.size(); ++c)
+      {
+        bool amount;
+        symbols[c] = findChangeSymbol(*changes[c], amount);
+        amounts[c] = amount;
+
+        if (symbols[c] < 0) return LIBSEDML_INVALID_OBJECT;
+      }
+
+    size_t numSymbols = mInitialValues.size();
+
+    mNumMembers = numRuns;
+    mColumns.resize(numSymbols * numRuns);
+
+    for (size_t s = 0; s < numSymbols; ++s)
+      {
+        std::fill(&mColumns[s * numRuns], &mColumns[s * numRuns] + numRuns,
+                  mInitialValues[s]);
+      }
+
+    mChanged.assign(numSymbols, false);
+    mStarted = false;
+
+    for (unsigned int r = 0; r < numRuns; ++r)
+      {
+        for (size_t c = 0; c < changes.size(); ++c)
+          {
+            setMember((unsigned int)symbols[c], amounts[c], r,
+                      values[r * changes.size() + c]);
+          }
+      }
+
+    mTime = 0;
+    return integrate(runs, numRuns, results);
+  }
+
+
+  virtual unsigned int getNumStates() const
+  {
+    return mNumStates;
+  }
+
+
+  /*
+   * Computes the assignment rules and the rates of the reactions into
+   * their columns, then the derivatives of the states.
+   */
+  virtual int computeDerivatives(double time, const double* states,
+                                 unsigned int numMembers,
+                                 double* derivatives)
+  {
+    if (numMembers != mNumMembers) return LIBSEDML_INVALID_OBJECT;
+
+    double* columns = &mColumns[0];
+    double* timeColumn = columns + mTimeSymbol * numMembers;
+
+    std::fill(timeColumn, timeColumn + numMembers, time);
+
+    for (size_t n = 0; n < mAssignmentOrder.size(); ++n)
+      {
+        const SedSbmlEquation& equation = mEquations[mAssignmentOrder[n]];
+        evaluate(equation, states, columns + equation.symbol * numMembers);
+      }
+
+    std::fill(derivatives, derivatives + mNumStates * numMembers, 0.0);
+
+    for (size_t n = 0; n < mRateOrder.size(); ++n)
+      {
+        const SedSbmlEquation& equation = mEquations[mRateOrder[n]];
+        evaluate(equation, states,
+                 derivatives + equation.symbol * numMembers);
+      }
+
+    for (size_t n = 0; n < mFluxes.size(); ++n)
+      {
+        const SedSbmlFlux& flux = mFluxes[n];
+        const double* rate = columns + flux.reaction * numMembers;
+        double* derivative = derivatives + flux.species * numMembers;
+
+        if (flux.factor >= 0)
+          {
+            unsigned int symbol = (unsigned int)flux.factor;
+            const double* factor = ((symbol < mNumStates) ? states : columns)
+                                   + symbol * numMembers;
+            const double* size = (flux.compartment < 0) ? NULL
+                                 : columns + flux.compartment * numMembers;
+
+            for (unsigned int m = 0; m < numMembers; ++m)
+              {
+                double term = flux.stoichiometry * rate[m] * factor[m];
+                derivative[m] += (size != NULL) ? term / size[m] : term;
+              }
+          }
+        else if (flux.compartment < 0)
+          {
+            for (unsigned int m = 0; m < numMembers; ++m)
+              {
+                derivative[m] += flux.stoichiometry * rate[m];
+              }
+          }
+        else
+          {
+            const double* size = columns + flux.compartment * numMembers;
+
+            for (unsigned int m = 0; m < numMembers; ++m)
+              {
+                derivative[m] += flux.stoichiometry * rate[m] / size[m];
+              }
+          }
+      }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+private:
+
+  bool fail(const std::string& message)
+  {
+    mLoadError = message;
+    return false;
+  }
+
+
+  /*
+   * Finds the symbols of the given model, its states first, and compiles
+   * its equations.
+   */
+  bool compileModel(const Model& model)
+  {
+    std::set<std::string> assigned;
+    std::set<std::string> changed;
+    std::set<std::string> integrated;
+
+    if (model.getNumEvents() > 0)
+      return fail("events are not supported");
+
+    for (unsigned int n = 0; n < model.getNumRules(); ++n)
+      {
+        const Rule* rule = model.getRule(n);
+
+        if (rule->isAlgebraic())
+          return fail("algebraic rules are not supported");
+
+        if (rule->isAssignment())
+          assigned.insert(rule->getVariable());
+        else
+          integrated.insert(rule->getVariable());
+      }
+
+    for (unsigned int n = 0; n < model.getNumReactions(); ++n)
+      {
+        const Reaction* reaction = model.getReaction(n);
+
+        if (!reaction->isSetKineticLaw())
+          return fail("reaction '" + reaction->getId()
+                      + "' has no kinetic law");
+
+        assigned.insert(reaction->getId());
+
+        for (unsigned int s = 0; s < reaction->getNumReactants()
+                                 + reaction->getNumProducts(); ++s)
+          {
+            const SpeciesReference* reference = (s < reaction->getNumReactants())
+              ? reaction->getReactant(s)
+              : reaction->getProduct(s - reaction->getNumReactants());
+            const Species* species = model.getSpecies(reference->getSpecies());
+
+            if (species == NULL)
+              return fail("reaction '" + reaction->getId()
+                          + "' uses the unknown species '"
+                          + reference->getSpecies() + "'");
+
+            if (!species->getBoundaryCondition() && !species->getConstant()
+                && assigned.find(species->getId()) == assigned.end())
+              changed.insert(species->getId());
+          }
+      }
+
+    // the symbols, with their initial values
+    std::vector<std::string> ids;
+    std::vector<double> values;
+    std::vector<std::string> compartments;
+
+    for (unsigned int n = 0; n < model.getNumCompartments(); ++n)
+      {
+        const Compartment* compartment = model.getCompartment(n);
+
+        ids.push_back(compartment->getId());
+        values.push_back(compartment->getSize());
+        compartments.push_back("");
+      }
+
+    for (unsigned int n = 0; n < model.getNumSpecies(); ++n)
+      {
+        const Species* species = model.getSpecies(n);
+        const Compartment* compartment =
+          model.getCompartment(species->getCompartment());
+        double size = (compartment != NULL) ? compartment->getSize() : 1.0;
+        bool concentration = !species->getHasOnlySubstanceUnits();
+        double value;
+
+        if (species->isSetInitialConcentration())
+          value = species->getInitialConcentration()
+                  * (concentration ? 1.0 : size);
+        else
+          value = species->getInitialAmount() / (concentration ? size : 1.0);
+
+        ids.push_back(species->getId());
+        values.push_back(value);
+        compartments.push_back(concentration ? species->getCompartment() : "");
+      }
+
+    for (unsigned int n = 0; n < model.getNumParameters(); ++n)
+      {
+        const Parameter* parameter = model.getParameter(n);
+
+        ids.push_back(parameter->getId());
+        values.push_back(parameter->getValue());
+        compartments.push_back("");
+      }
+
+    for (unsigned int n = 0; n < model.getNumReactions(); ++n)
+      {
+        ids.push_back(model.getReaction(n)->getId());
+        values.push_back(0.0);
+        compartments.push_back("");
+      }
+
+    ids.push_back(SEDML_SBML_TIME);
+    values.push_back(0.0);
+    compartments.push_back("");
+
+    std::vector<size_t> symbols;
+
+    for (int pass = 0; pass < 2; ++pass)
+      {
+        for (size_t n = 0; n < ids.size(); ++n)
+          {
+            bool state = changed.find(ids[n]) != changed.end()
+                         || integrated.find(ids[n]) != integrated.end();
+
+            if (state == (pass == 0)) symbols.push_back(n);
+          }
+
+        if (pass == 0) mNumStates = (unsigned int)symbols.size();
+      }
+
+    mIds.resize(ids.size());
+    mInitialValues.resize(ids.size());
+    mCompartments.assign(ids.size(), -1);
+    mAssigned.assign(ids.size(), false);
+
+    for (size_t s = 0; s < symbols.size(); ++s)
+      {
+        mIds[s] = ids[symbols[s]];
+        mInitialValues[s] = values[symbols[s]];
+        mIndices[mIds[s]] = (unsigned int)s;
+        mAssigned[s] = assigned.find(mIds[s]) != assigned.end();
+      }
+
+    for (size_t s = 0; s < symbols.size(); ++s)
+      {
+        const std::string& compartment = compartments[symbols[s]];
+
+        if (!compartment.empty() && mIndices.count(compartment) > 0)
+          mCompartments[s] = (int)mIndices[compartment];
+      }
+
+    mTimeSymbol = mIndices[SEDML_SBML_TIME];
+
+    // the equations
+    std::vector<unsigned int> initial;
+    std::vector<unsigned int> assignments;
+    std::map<std::string, double> none;
+
+    for (unsigned int n = 0; n < model.getNumInitialAssignments(); ++n)
+      {
+        const InitialAssignment* assignment = model.getInitialAssignment(n);
+
+        initial.push_back((unsigned int)mEquations.size());
+
+        if (!addEquation("the initial assignment of '" + assignment->getSymbol()
+                         + "'", assignment->getSymbol(), assignment->getMath(),
+                         none))
+          return false;
+      }
+
+    for (unsigned int n = 0; n < model.getNumRules(); ++n)
+      {
+        const Rule* rule = model.getRule(n);
+        std::vector<unsigned int>& order =
+          rule->isAssignment() ? assignments : mRateOrder;
+
+        order.push_back((unsigned int)mEquations.size());
+
+        if (!addEquation("the rule of '" + rule->getVariable() + "'",
+                         rule->getVariable(), rule->getMath(), none))
+          return false;
+      }
+
+    for (unsigned int n = 0; n < model.getNumReactions(); ++n)
+      {
+        const Reaction* reaction = model.getReaction(n);
+        const KineticLaw* law = reaction->getKineticLaw();
+        std::map<std::string, double> locals;
+
+        for (unsigned int p = 0; p < law->getNumParameters(); ++p)
+          {
+            locals[law->getParameter(p)->getId()] =
+              law->getParameter(p)->getValue();
+          }
+
+        assignments.push_back((unsigned int)mEquations.size());
+
+        if (!addEquation("reaction '" + reaction->getId() + "'",
+                         reaction->getId(), law->getMath(), locals))
+          return false;
+
+        for (unsigned int s = 0; s < reaction->getNumReactants()
+                                 + reaction->getNumProducts(); ++s)
+          {
+            bool reactant = (s < reaction->getNumReactants());
+            const SpeciesReference* reference = reactant
+              ? reaction->getReactant(s)
+              : reaction->getProduct(s - reaction->getNumReactants());
+
+            if (changed.find(reference->getSpecies()) == changed.end())
+              continue;
+
+            const Species* species = model.getSpecies(reference->getSpecies());
+            const std::string& factor = species->isSetConversionFactor()
+              ? species->getConversionFactor() : model.getConversionFactor();
+
+            SedSbmlFlux flux;
+            flux.reaction = mIndices[reaction->getId()];
+            flux.species = mIndices[reference->getSpecies()];
+            flux.stoichiometry = reference->getStoichiometry();
+            flux.compartment = mCompartments[flux.species];
+            flux.factor = -1;
+
+            if (!factor.empty())
+              {
+                if (mIndices.count(factor) == 0)
+                  return fail("the conversion factor '" + factor
+                              + "' of species '" + reference->getSpecies()
+                              + "' is not in the model");
+
+                flux.factor = (int)mIndices[factor];
+              }
+
+            if (reference->isSetStoichiometryMath()
+                || !(flux.stoichiometry == flux.stoichiometry))
+              return fail("the stoichiometry of '" + reference->getSpecies()
+                          + "' in reaction '" + reaction->getId()
+                          + "' is not a constant");
+
+            if (flux.compartment >= 0
+                && ((unsigned int)flux.compartment < mNumStates
+                    || mAssigned[flux.compartment]))
+              return fail("the compartment of species '"
+                          + reference->getSpecies() + "' is not constant");
+
+            if (reactant) flux.stoichiometry = -flux.stoichiometry;
+
+            mFluxes.push_back(flux);
+          }
+      }
+
+    // the initial values are computed with the assignment rules
+    initial.insert(initial.end(), assignments.begin(), assignments.end());
+
+    if (!sortEquations(mEquations, assignments, mAssignmentOrder)
+        || !sortEquations(mEquations, initial, mInitialOrder))
+      return fail("the assignments of the model depend on each other in a "
+                  "cycle");
+
+    return true;
+  }
+
+
+  /*
+   * Compiles the math giving the value, or the rate, of a symbol.
+   */
+  bool addEquation(const std::string& owner, const std::string& id,
+                   const ASTNode* math,
+                   const std::map<std::string, double>& constants)
+  {
+    std::map<std::string, unsigned int>::const_iterator symbol =
+      mIndices.find(id);
+
+    if (symbol == mIndices.end())
+      return fail(owner + " targets an unknown symbol");
+
+    if (math == NULL) return fail(owner + " has no math");
+
+    ASTNode* copy = math->deepCopy();
+    std::vector<std::string> names;
+    std::vector<std::string> inputIds;
+    SedSbmlEquation equation;
+
+    prepareMath(copy);
+    collectNames(copy, names);
+    equation.symbol = symbol->second;
+
+    // local parameters hide the symbols of the model
+    for (size_t n = 0; n < names.size(); ++n)
+      {
+        std::map<std::string, unsigned int>::const_iterator input =
+          mIndices.find(names[n]);
+
+        if (constants.find(names[n]) != constants.end()
+            || input == mIndices.end())
+          continue;
+
+        inputIds.push_back(names[n]);
+        equation.inputs.push_back(input->second);
+      }
+
+    int result = equation.program.compile(copy, inputIds, constants);
+    delete copy;
+
+    if (result != LIBSEDML_OPERATION_SUCCESS)
+      return fail("the math of " + owner + " is not supported: "
+                  + equation.program.getErrorMessage());
+
+    mEquations.push_back(equation);
+    return true;
+  }
+
+
+  /*
+   * Evaluates an equation for all the members, with the given states.
+   */
+  void evaluate(const SedSbmlEquation& equation, const double* states,
+                double* result)
+  {
+    mInputs.resize(equation.inputs.size() + 1);
+
+    for (size_t n = 0; n < equation.inputs.size(); ++n)
+      {
+        unsigned int symbol = equation.inputs[n];
+
+        mInputs[n] = ((symbol < mNumStates) ? states : &mColumns[0])
+                     + symbol * mNumMembers;
+      }
+
+    equation.program.evaluate(&mInputs[0], mNumMembers, result);
+  }
+
+
+  /*
+   * Sets the value of a symbol for one member; the amount of a species that
+   * is a concentration is divided by the size of its compartment.  A value
+   * set before the model starts replaces the initial assignment of the
+   * symbol.
+   */
+  void setMember(unsigned int symbol, bool amount, unsigned int member,
+                 double value)
+  {
+    if (amount && mCompartments[symbol] >= 0)
+      value /= mColumns[mCompartments[symbol] * mNumMembers + member];
+
+    mColumns[symbol * mNumMembers + member] = value;
+
+    if (!mStarted) mChanged[symbol] = true;
+  }
+
+
+  /*
+   * @return the symbol a change targets, or -1 with the reason in
+   * mErrorMessage.
+   */
+  int findChangeSymbol(const SedSetValue& change, bool& amount)
+  {
+    if (!mLoadError.empty())
+      {
+        mErrorMessage = mLoadError;
+        return -1;
+      }
+
+    std::string id, attribute;
+    std::map<std::string, unsigned int>::const_iterator symbol =
+      mIndices.end();
+
+    if (parseTarget(change.getTarget(), id, attribute))
+      symbol = mIndices.find(id);
+
+    if (symbol == mIndices.end() || symbol->second == mTimeSymbol)
+      {
+        mErrorMessage = "the target '" + change.getTarget()
+                        + "' is not in the model";
+        return -1;
+      }
+
+    if (mAssigned[symbol->second])
+      {
+        mErrorMessage = "'" + id + "' is assigned by the model";
+        return -1;
+      }
+
+    amount = (attribute == "initialAmount");
+    return (int)symbol->second;
+  }
+
+
+  /*
+   * Configures the solver for the algorithm of a simulation.
+   */
+  int configureSolver(const SedSimulation& simulation)
+  {
+    const SedAlgorithm* algorithm = simulation.getAlgorithm();
+    std::string kisaoID = (algorithm != NULL) ? algorithm->getKisaoID() : "";
+    SedOdeMethod_t method;
+
+    if (!getOdeMethod(kisaoID, method))
+      {
+        mErrorMessage = "the algorithm '" + kisaoID + "' is not supported";
+        return LIBSEDML_INVALID_OBJECT;
+      }
+
+    mSolver.setMethod(method);
+    mSolver.setRelativeTolerance(1e-6);
+    mSolver.setAbsoluteTolerance(1e-9);
+    mSolver.setMaxSteps(100000);
+
+    for (unsigned int n = 0; algorithm != NULL
+                             && n < algorithm->getNumAlgorithmParameters(); ++n)
+      {
+        const SedAlgorithmParameter* parameter =
+          algorithm->getAlgorithmParameter(n);
+        const std::string& text = parameter->getValue();
+        char* end = NULL;
+        double value = strtod(text.c_str(), &end);
+        int result = LIBSEDML_OPERATION_SUCCESS;
+
+        if (text.empty() || *end != '\0')
+          result = LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+        else if (parameter->getKisaoIDasInt() == 209)
+          result = mSolver.setRelativeTolerance(value);
+        else if (parameter->getKisaoIDasInt() == 211)
+          result = mSolver.setAbsoluteTolerance(value);
+        else if (parameter->getKisaoIDasInt() == 415 && value >= 1)
+          mSolver.setMaxSteps((unsigned long)value);
+        else if (parameter->getKisaoIDasInt() == 415)
+          result = LIBSEDML_INVALID_ATTRIBUTE_VALUE;
+
+        if (result != LIBSEDML_OPERATION_SUCCESS)
+          {
+            mErrorMessage = "the algorithm parameter '"
+                            + parameter->getKisaoID()
+                            + "' has an invalid value '" + text + "'";
+            return LIBSEDML_INVALID_OBJECT;
+          }
+      }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  /*
+   * Integrates all the members, recording the variables of each run at
+   * the output points of their simulation.
+   */
+  int integrate(const SedSimulationRun* runs, unsigned int numRuns,
+                SedSimulationResult* results)
+  {
+    const SedSimulation* simulation = runs[0].getSimulation();
+    double start = mStarted ? mTime : 0;
+    double step = 0;
+    unsigned int numPoints = 1;
+
+    if (simulation == NULL)
+      {
+        mErrorMessage = "the run has no simulation";
+        return LIBSEDML_INVALID_OBJECT;
+      }
+
+    if (simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+      {
+        const SedUniformTimeCourse* timeCourse =
+          static_cast<const SedUniformTimeCourse*>(simulation);
+        int numberOfPoints = timeCourse->getNumberOfPoints();
+
+        mTime = timeCourse->getInitialTime();
+        start = timeCourse->getOutputStartTime();
+
+        if (numberOfPoints > 0 && numberOfPoints != SEDML_INT_MAX)
+          {
+            numPoints = (unsigned int)numberOfPoints + 1;
+            step = (timeCourse->getOutputEndTime() - start) / numberOfPoints;
+          }
+      }
+    else if (simulation->getTypeCode() == SEDML_SIMULATION_ONESTEP)
+      {
+        mTime = start;
+        start += static_cast<const SedOneStep*>(simulation)->getStep();
+      }
+    else
+      {
+        mErrorMessage = "simulations of type '" + simulation->getElementName()
+                        + "' are not supported";
+        return LIBSEDML_INVALID_OBJECT;
+      }
+
+    int result = configureSolver(*simulation);
+    if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+    // the symbols of the variables
+    std::vector<unsigned int> variables(runs[0].getNumVariables());
+
+    for (size_t v = 0; v < variables.size(); ++v)
+      {
+        const SedVariable* variable = runs[0].getVariable((unsigned int)v);
+        std::string id, attribute;
+        std::map<std::string, unsigned int>::const_iterator symbol =
+          mIndices.end();
+
+        if (variable->getSymbol() == SEDML_SBML_TIME)
+          symbol = mIndices.find(SEDML_SBML_TIME);
+        else if (parseTarget(variable->getTarget(), id, attribute)
+                 && attribute.empty())
+          symbol = mIndices.find(id);
+
+        if (symbol == mIndices.end())
+          {
+            mErrorMessage = "the variable '" + variable->getId()
+                            + "' is not in the model";
+            return LIBSEDML_INVALID_OBJECT;
+          }
+
+        variables[v] = symbol->second;
+      }
+
+    for (unsigned int r = 0; r < numRuns; ++r)
+      {
+        results[r].setSize((unsigned int)variables.size(), numPoints);
+      }
+
+    double* columns = &mColumns[0];
+    mDerivatives.resize(mNumStates * numRuns + 1);
+
+    // the initial assignments apply when the model starts, except to the
+    // symbols changed since the model was reset
+    if (!mStarted)
+      {
+        std::fill(columns + mTimeSymbol * numRuns,
+                  columns + (mTimeSymbol + 1) * numRuns, mTime);
+
+        for (size_t n = 0; n < mInitialOrder.size(); ++n)
+          {
+            const SedSbmlEquation& equation = mEquations[mInitialOrder[n]];
+
+            if (mChanged[equation.symbol]) continue;
+
+            evaluate(equation, columns, columns + equation.symbol * numRuns);
+          }
+
+        mStarted = true;
+      }
+
+    mSolver.restart();
+
+    for (unsigned int p = 0; p < numPoints; ++p)
+      {
+        double time = start + p * step;
+
+        if (time > mTime)
+          {
+            if (mSolver.integrate(*this, numRuns, columns, mTime, time)
+                != LIBSEDML_OPERATION_SUCCESS)
+              {
+                mErrorMessage = mSolver.getErrorMessage();
+                return LIBSEDML_OPERATION_FAILED;
+              }
+
+            mTime = time;
+          }
+
+        // the rules and the rates of the reactions at the output point
+        computeDerivatives(mTime, columns, numRuns, &mDerivatives[0]);
+
+        for (size_t v = 0; v < variables.size(); ++v)
+          {
+            const double* column = columns + variables[v] * numRuns;
+
+            for (unsigned int r = 0; r < numRuns; ++r)
+              {
+                results[r].getColumn((unsigned int)v)[p] = column[r];
+              }
+          }
+      }
+
+    return LIBSEDML_OPERATION_SUCCESS;
+  }
+
+
+  std::string                           mLoadError;
+  std::vector<std::string>              mIds;
+  std::map<std::string, unsigned int>   mIndices;
+  std::vector<double>                   mInitialValues;
+  std::vector<int>                      mCompartments;
+  std::vector<bool>                     mAssigned;
+  std::vector<bool>                     mChanged;
+  std::vector<SedSbmlEquation>          mEquations;
+  std::vector<unsigned int>             mInitialOrder;
+  std::vector<unsigned int>             mAssignmentOrder;
+  std::vector<unsigned int>             mRateOrder;
+  std::vector<SedSbmlFlux>              mFluxes;
+  unsigned int                          mNumStates;
+  unsigned int                          mTimeSymbol;
+  unsigned int                          mNumMembers;
+  double                                mTime;
+  bool                                  mStarted;
+  std::vector<double>                   mColumns;
+  std::vector<double>                   mDerivatives;
+  std::vector<const double*>            mInputs;
+  SedOdeSolver                          mSolver;
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedSbmlBackend.
+ */
+SedSbmlBackend::SedSbmlBackend()
+{
+}
+
+
+/*
+ * Destructor for SedSbmlBackend.
+ */
+SedSbmlBackend::~SedSbmlBackend()
+{
+  std::map<std::string, SBMLDocument*>::iterator it;
+
+  for (it = mDocuments.begin(); it != mDocuments.end(); ++it)
+    {
+      delete it->second;
+    }
+}
+
+
+/*
+ * @return true if this backend simulates such models with such algorithms.
+ */
+bool
+SedSbmlBackend::supports(const std::string& language,
+                         const std::string& kisaoID) const
+{
+  SedOdeMethod_t method;
+
+  return language.compare(0, 23, "urn:sedml:language:sbml") == 0
+         && getOdeMethod(kisaoID, method);
+}
+
+
+/*
+ * Loads a model.
+ */
+SedSimulationSession*
+SedSbmlBackend::createSession(const SedModel& model) const
+{
+  SedSbmlSession* session = new(std::nothrow) SedSbmlSession();
+
+  if (session == NULL) return NULL;
+
+  std::string message;
+  SBMLDocument* document = loadDocument(model, 0, message);
+
+  session->load(document, message);
+  delete document;
+  return session;
+}
+
+
+/*
+ * Sets the directory the relative sources of models are read from.
+ */
+int
+SedSbmlBackend::setBaseDirectory(const std::string& directory)
+{
+  mBaseDirectory = directory;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the directory the relative sources of models are read from.
+ */
+const std::string&
+SedSbmlBackend::getBaseDirectory() const
+{
+  return mBaseDirectory;
+}
+
+
+/*
+ * Gives the document of the models with the given source.
+ */
+int
+SedSbmlBackend::addDocument(const std::string& source,
+                            const SBMLDocument* document)
+{
+  if (document == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  SBMLDocument*& copy = mDocuments[source];
+  delete copy;
+  copy = document->clone();
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Reads the document of a model, or of the model it derives from, and
+ * applies its changes; returns NULL, with the reason in message, on
+ * failure.
+ */
+SBMLDocument*
+SedSbmlBackend::loadDocument(const SedModel& model, unsigned int depth,
+                             std::string& message) const
+{
+  const std::string& source = model.getSource();
+  const SedDocument* doc = findDocument(&model);
+  const SedModel* base = NULL;
+  SBMLDocument* document = NULL;
+
+  if (doc != NULL)
+    base = doc->getModel((!source.empty() && source[0] == '#')
+                         ? source.substr(1) : source);
+
+  if (base != NULL)
+    {
+      if (base == &model || depth >= doc->getNumModels())
+        {
+          message = "model '" + model.getId() + "' derives from itself";
+          return NULL;
+        }
+
+      document = loadDocument(*base, depth + 1, message);
+
+      if (document == NULL) return NULL;
+    }
+  else
+    {
+      std::map<std::string, SBMLDocument*>::const_iterator it =
+        mDocuments.find(source);
+      std::string path = source;
+
+      if (it != mDocuments.end())
+        {
+          document = it->second->clone();
+        }
+      else
+        {
+          if (!mBaseDirectory.empty() && !source.empty() && source[0] != '/'
+              && source.find(':') == std::string::npos)
+            path = mBaseDirectory + "/" + source;
+
+          document = readSBMLFromFile(path.c_str());
+        }
+
+      for (unsigned int n = 0; document != NULL && n < document->getNumErrors();
+           ++n)
+        {
+          const SBMLError* error = document->getError(n);
+
+          if (error->isError() || error->isFatal())
+            {
+              message = "the model could not be read from '" + path + "': "
+                        + error->getMessage();
+              delete document;
+              return NULL;
+            }
+        }
+
+      if (document == NULL || document->getModel() == NULL)
+        {
+          message = "the source '" + source + "' has no SBML model";
+          delete document;
+          return NULL;
+        }
+    }
+
+  if (!applyChanges(model, *document, message))
+    {
+      delete document;
+      return NULL;
+    }
+
+  return document;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedSimulationBackend_t *
+SedSbmlBackend_create(const char *baseDirectory)
+{
+  SedSbmlBackend* backend = new(std::nothrow) SedSbmlBackend();
+
+  if (backend != NULL && baseDirectory != NULL)
+    backend->setBaseDirectory(baseDirectory);
+
+  return backend;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,230 @@
+/**
+ * @file    SedSbmlBackend.h
+ * @brief   Definition of SedSbmlBackend
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedSbmlBackend
+ * @ingroup Core
+ * @brief A SedSimulationBackend integrating SBML models itself.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedSbmlBackend is a reference simulator, for testing and for small
+ * models: it reads SBML models with libSBML, turns their reaction networks
+ * and rules into ordinary differential equations, and integrates them with
+ * a SedOdeSolver.  The algorithm of a simulation selects the method:
+ *
+ * @li the Dormand-Prince method, for KISAO:0000087 (Dormand-Prince),
+ * KISAO:0000032 (Runge-Kutta) and simulations without an algorithm;
+ * @li the Rosenbrock method, for KISAO:0000033 (Rosenbrock), and for
+ * KISAO:0000019 (CVODE) and KISAO:0000088 (LSODA), which it stands in for
+ * on stiff models.
+ *
+ * The algorithm parameters KISAO:0000209 (relative tolerance),
+ * KISAO:0000211 (absolute tolerance) and KISAO:0000415 (maximum number of
+ * steps) are used.  SedUniformTimeCourse and SedOneStep simulations are
+ * supported.
+ *
+ * The models may use compartments, species, parameters, reactions with
+ * local parameters, initial assignments, assignment rules, rate rules and
+ * function definitions.  Species are concentrations unless they have only
+ * substance units; the compartments of the species changed by reactions
+ * must be constant.  Events, algebraic rules and delays are not
+ * supported, nor are the changes of a SedModel other than
+ * SedChangeAttribute and SedComputeChange without variables.  The targets
+ * of changes and variables are XPath expressions selecting an element by
+ * its @c id, such as
+ * <code>/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']</code>;
+ * the variable of a reaction gives its rate.
+ *
+ * The sessions of the backend implement
+ * SedSimulationSession::simulateEnsemble(): the runs of an ensemble are
+ * integrated together, in lockstep, with the values of each state stored
+ * as a column of one value per run, so that the right-hand side of the
+ * equations is evaluated for all the runs at once by SedMathProgram.
+ * @code{.cpp}
+ * SedSbmlBackend backend;
+ * backend.setBaseDirectory("/path/to/the/sedml/file");
+ *
+ * SedTaskExecutor executor;
+ * executor.addBackend(&backend);
+ * @endcode
+ *
+ * The models of a SedModel are read from the file its source names,
+ * relative to the base directory, unless a document has been added for
+ * that source with addDocument(); a source naming another SedModel, with
+ * or without a leading @c #, applies the changes of the model to that
+ * other model.
+ */
+
+#ifndef SedSbmlBackend_h
+#define SedSbmlBackend_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedSimulationBackend.h>
+
+
+#ifdef __cplusplus
+
+
+#include <map>
+#include <string>
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class SBMLDocument;
+
+LIBSBML_CPP_NAMESPACE_END
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedSbmlBackend : public SedSimulationBackend
+{
+public:
+
+  /**
+   * Creates a new SedSbmlBackend.
+   */
+  SedSbmlBackend();
+
+
+  /**
+   * Destructor for SedSbmlBackend.
+   */
+  virtual ~SedSbmlBackend();
+
+
+  /**
+   * @copydoc SedSimulationBackend::supports
+   *
+   * The languages supported are those starting with
+   * @c urn:sedml:language:sbml.
+   */
+  virtual bool supports(const std::string& language,
+                        const std::string& kisaoID) const;
+
+
+  /**
+   * @copydoc SedSimulationBackend::createSession
+   *
+   * The session of a model that could not be loaded fails all its calls,
+   * telling why.
+   */
+  virtual SedSimulationSession* createSession(const SedModel& model) const;
+
+
+  /**
+   * Sets the directory the relative sources of models are read from.
+   *
+   * @param directory the directory, usually that of the SED-ML file.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setBaseDirectory(const std::string& directory);
+
+
+  /**
+   * @return the directory the relative sources of models are read from.
+   */
+  const std::string& getBaseDirectory() const;
+
+
+  /**
+   * Gives the document of the models with the given source, instead of
+   * reading it from a file.  This function must not be called while the
+   * backend is used.
+   *
+   * @param source the source of the models.
+   * @param document the document, which is copied.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p document is @c NULL.
+   */
+  int addDocument(const std::string& source, const SBMLDocument* document);
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  SedSbmlBackend(const SedSbmlBackend&);
+  SedSbmlBackend& operator=(const SedSbmlBackend&);
+
+  SBMLDocument* loadDocument(const SedModel& model, unsigned int depth,
+                             std::string& message) const;
+
+  std::string                           mBaseDirectory;
+  std::map<std::string, SBMLDocument*>  mDocuments;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new SedSbmlBackend reading the relative sources of models from
+ * the given directory, which may be @c NULL; free it with
+ * SedSimulationBackend_free().
+ */
+LIBSEDML_EXTERN
+SedSimulationBackend_t *
+SedSbmlBackend_create(const char *baseDirectory);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedSbmlBackend_h */
@@ -36,6 +36,7 @@
 
 #include <sedml/SedSetValue.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/ASTNode.h>
@@ -265,6 +266,7 @@ SedSetValue::setRange(const std::string& range)
     }
   else
     {
+      markDirty();
       mRange = range;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -283,6 +285,7 @@ SedSetValue::setModelReference(const std::string& modelReference)
     }
   else
     {
+      markDirty();
       mModelReference = modelReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -295,6 +298,8 @@ SedSetValue::setModelReference(const std::string& modelReference)
 int
 SedSetValue::setSymbol(const std::string& symbol)
 {
+  markDirty();
+
   {
     mSymbol = symbol;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -308,6 +313,8 @@ SedSetValue::setSymbol(const std::string& symbol)
 int
 SedSetValue::setTarget(const std::string& target)
 {
+  markDirty();
+
   {
     mTarget = target;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -323,10 +330,13 @@ SedSetValue::setMath(ASTNode* math)
 {
   if (mMath == math)
     {
+      // the math may have been modified in place
+      markDirty();
       return LIBSEDML_OPERATION_SUCCESS;
     }
   else if (math == NULL)
     {
+      markDirty();
       delete mMath;
       mMath = NULL;
       return LIBSEDML_OPERATION_SUCCESS;
@@ -337,6 +347,7 @@ SedSetValue::setMath(ASTNode* math)
     }
   else
     {
+      markDirty();
       delete mMath;
       mMath = (math != NULL) ?
               math->deepCopy() : NULL;
@@ -356,6 +367,8 @@ SedSetValue::setMath(ASTNode* math)
 int
 SedSetValue::unsetRange()
 {
+  markDirty();
+
   mRange.erase();
 
   if (mRange.empty() == true)
@@ -375,6 +388,8 @@ SedSetValue::unsetRange()
 int
 SedSetValue::unsetModelReference()
 {
+  markDirty();
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -394,6 +409,8 @@ SedSetValue::unsetModelReference()
 int
 SedSetValue::unsetSymbol()
 {
+  markDirty();
+
   mSymbol.erase();
 
   if (mSymbol.empty() == true)
@@ -413,6 +430,8 @@ SedSetValue::unsetSymbol()
 int
 SedSetValue::unsetTarget()
 {
+  markDirty();
+
   mTarget.erase();
 
   if (mTarget.empty() == true)
@@ -432,6 +451,8 @@ SedSetValue::unsetTarget()
 int
 SedSetValue::unsetMath()
 {
+  markDirty();
+
   delete mMath;
   mMath = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -805,8 +826,69 @@ SedSetValue::writeElements(XMLOutputStream& stream) const
 bool
 SedSetValue::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      mVariables.accept(v);
+      mParameters.accept(v);
+    }
 
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedSetValue::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedSetValue));
+  usage.addString(mRange);
+  usage.addString(mModelReference);
+  usage.addString(mSymbol);
+  usage.addString(mTarget);
+  usage.addMath(mMath);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedSetValue::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + 2;
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedSetValue::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
+
+  switch (n - numInherited)
+    {
+    case 0:
+      return &mVariables;
+    case 1:
+      return &mParameters;
+    default:
+      return NULL;
+    }
 }
 
 
@@ -1146,6 +1228,7 @@ SedListOfTaskChanges::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedSetValue*>(item);
@@ -1343,6 +1426,9 @@ SedSetValue_getMath(SedSetValue_t * ssv)
   if (ssv == NULL)
     return NULL;
 
+  /* the caller may modify the math in place */
+  ssv->markDirty();
+
   return (ASTNode_t*)ssv->getMath();
 }
 
@@ -36,6 +36,7 @@
 
 #include <sedml/SedSimulation.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -222,7 +223,12 @@ SedSimulation::isSetAlgorithm() const
 int
 SedSimulation::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -232,6 +238,8 @@ SedSimulation::setId(const std::string& id)
 int
 SedSimulation::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -245,6 +253,8 @@ SedSimulation::setName(const std::string& name)
 int
 SedSimulation::setAlgorithm(SedAlgorithm* algorithm)
 {
+  markDirty();
+
   if (mAlgorithm == algorithm)
     {
       return LIBSEDML_OPERATION_SUCCESS;
@@ -277,6 +287,8 @@ SedSimulation::setAlgorithm(SedAlgorithm* algorithm)
 int
 SedSimulation::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -296,6 +308,8 @@ SedSimulation::unsetId()
 int
 SedSimulation::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -315,6 +329,8 @@ SedSimulation::unsetName()
 int
 SedSimulation::unsetAlgorithm()
 {
+  markDirty();
+
   delete mAlgorithm;
   mAlgorithm = NULL;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -432,8 +448,58 @@ SedSimulation::writeElements(XMLOutputStream& stream) const
 bool
 SedSimulation::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (mAlgorithm != NULL)
+        mAlgorithm->accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedSimulation::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedSimulation));
+  usage.addString(mId);
+  usage.addString(mName);
+}
+
+
+/*
+ * Returns the number of child Sed objects of this object.
+ */
+unsigned int
+SedSimulation::getNumChildObjects() const
+{
+  return SedBase::getNumChildObjects() + (mAlgorithm != NULL ? 1 : 0);
+}
+
+
+/*
+ * Returns the nth child Sed object of this object.
+ */
+const SedBase*
+SedSimulation::getChildObject(unsigned int n) const
+{
+  unsigned int numInherited = SedBase::getNumChildObjects();
+
+  if (n < numInherited)
+    return SedBase::getChildObject(n);
 
+  return (n == numInherited) ? mAlgorithm : NULL;
 }
 
 
@@ -738,6 +804,7 @@ SedListOfSimulations::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedSimulation*>(item);
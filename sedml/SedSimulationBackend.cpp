@@ -0,0 +1,335 @@
+/**
+ * @file    SedSimulationBackend.cpp
+ * @brief   Implementation of SedSimulationBackend
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedSimulationBackend.h>
+#include <sedml/common/operationReturnValues.h>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+/*
+ * Creates a new, empty, SedSimulationResult.
+ */
+SedSimulationResult::SedSimulationResult()
+  : mNumColumns(0)
+  , mNumPoints(0)
+{
+}
+
+
+/*
+ * Sets the size of this result.
+ */
+void
+SedSimulationResult::setSize(unsigned int numColumns, unsigned int numPoints)
+{
+  mNumColumns = numColumns;
+  mNumPoints = numPoints;
+  mValues.assign((size_t)numColumns * numPoints, 0.0);
+}
+
+
+/*
+ * @return the number of variables of this result.
+ */
+unsigned int
+SedSimulationResult::getNumColumns() const
+{
+  return mNumColumns;
+}
+
+
+/*
+ * @return the number of output points of this result.
+ */
+unsigned int
+SedSimulationResult::getNumPoints() const
+{
+  return mNumPoints;
+}
+
+
+/*
+ * @return the values of the given variable.
+ */
+double*
+SedSimulationResult::getColumn(unsigned int n)
+{
+  if (n >= mNumColumns) return NULL;
+
+  return mValues.empty() ? NULL : &mValues[(size_t)n * mNumPoints];
+}
+
+
+/*
+ * @return the values of the given variable.
+ */
+const double*
+SedSimulationResult::getColumn(unsigned int n) const
+{
+  if (n >= mNumColumns) return NULL;
+
+  return mValues.empty() ? NULL : &mValues[(size_t)n * mNumPoints];
+}
+
+
+/*
+ * Creates a new, empty, SedSimulationRun.
+ */
+SedSimulationRun::SedSimulationRun()
+  : mTask(NULL)
+  , mSimulatedTask(NULL)
+  , mModel(NULL)
+  , mSimulation(NULL)
+  , mIndex(0)
+  , mVariables(NULL)
+{
+}
+
+
+/*
+ * @return the task being executed.
+ */
+const SedTask*
+SedSimulationRun::getTask() const
+{
+  return mTask;
+}
+
+
+/*
+ * @return the task simulated.
+ */
+const SedTask*
+SedSimulationRun::getSimulatedTask() const
+{
+  return mSimulatedTask;
+}
+
+
+/*
+ * @return the model of the task simulated.
+ */
+const SedModel*
+SedSimulationRun::getModel() const
+{
+  return mModel;
+}
+
+
+/*
+ * @return the simulation of the task simulated.
+ */
+const SedSimulation*
+SedSimulationRun::getSimulation() const
+{
+  return mSimulation;
+}
+
+
+/*
+ * @return the index of this run among the runs of the task.
+ */
+unsigned long
+SedSimulationRun::getIndex() const
+{
+  return mIndex;
+}
+
+
+/*
+ * @return the number of repeated tasks the task simulated is nested in.
+ */
+unsigned int
+SedSimulationRun::getNumIterations() const
+{
+  return (unsigned int)mIterations.size();
+}
+
+
+/*
+ * @return the iteration of the given repeated task.
+ */
+unsigned int
+SedSimulationRun::getIteration(unsigned int depth) const
+{
+  return (depth < mIterations.size()) ? mIterations[depth] : 0;
+}
+
+
+/*
+ * @return the number of variables of this run.
+ */
+unsigned int
+SedSimulationRun::getNumVariables() const
+{
+  return (mVariables == NULL) ? 0 : (unsigned int)mVariables->size();
+}
+
+
+/*
+ * @return the given variable.
+ */
+const SedVariable*
+SedSimulationRun::getVariable(unsigned int n) const
+{
+  return (n < getNumVariables()) ? (*mVariables)[n] : NULL;
+}
+
+
+/*
+ * Destructor for SedSimulationSession.
+ */
+SedSimulationSession::~SedSimulationSession()
+{
+}
+
+
+/*
+ * Simulates an ensemble of runs, one after the other.
+ */
+int
+SedSimulationSession::simulateEnsemble(const SedSimulationRun* runs,
+                                       unsigned int numRuns,
+                                       const std::vector<const SedSetValue*>& changes,
+                                       const double* values,
+                                       SedSimulationResult* results)
+{
+  if (numRuns > 0 && (runs == NULL || results == NULL
+                      || (values == NULL && !changes.empty())))
+    return LIBSEDML_INVALID_OBJECT;
+
+  for (unsigned int r = 0; r < numRuns; ++r)
+    {
+      int result = reset();
+
+      for (size_t c = 0; c < changes.size()
+                         && result == LIBSEDML_OPERATION_SUCCESS; ++c)
+        {
+          result = setValue(*changes[c], values[r * changes.size() + c]);
+        }
+
+      if (result == LIBSEDML_OPERATION_SUCCESS)
+        result = simulate(runs[r], results[r]);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the reason the last call failed.
+ */
+const std::string&
+SedSimulationSession::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/*
+ * Destructor for SedSimulationBackend.
+ */
+SedSimulationBackend::~SedSimulationBackend()
+{
+}
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+void
+SedSimulationBackend_free(SedSimulationBackend_t *backend)
+{
+  delete backend;
+}
+
+
+LIBSEDML_EXTERN
+const SedTask_t *
+SedSimulationRun_getTask(const SedSimulationRun_t *run)
+{
+  return (run != NULL) ? run->getTask() : NULL;
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedSimulationRun_getIndex(const SedSimulationRun_t *run)
+{
+  return (run != NULL) ? run->getIndex() : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedSimulationResult_getNumColumns(const SedSimulationResult_t *result)
+{
+  return (result != NULL) ? result->getNumColumns() : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedSimulationResult_getNumPoints(const SedSimulationResult_t *result)
+{
+  return (result != NULL) ? result->getNumPoints() : 0;
+}
+
+
+LIBSEDML_EXTERN
+const double *
+SedSimulationResult_getColumn(const SedSimulationResult_t *result,
+                              unsigned int n)
+{
+  return (result != NULL) ? result->getColumn(n) : NULL;
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
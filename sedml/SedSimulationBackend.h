@@ -0,0 +1,452 @@
+/**
+ * @file    SedSimulationBackend.h
+ * @brief   Definition of SedSimulationBackend
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedSimulationBackend
+ * @ingroup Core
+ * @brief A simulation tool, as used by SedTaskExecutor.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * libSEDML describes simulation experiments but does not simulate models
+ * itself.  A SedSimulationBackend is the interface to a simulation tool
+ * that does: it tells which model languages (SedModel::getLanguage()) and
+ * algorithms (SedAlgorithm::getKisaoID()) it supports, and loads models
+ * into SedSimulationSession objects.  A session holds the state of one
+ * model: it applies the changes of repeated tasks, is reset to the initial
+ * state of the model, and simulates it.
+ *
+ * A SedTaskExecutor creates its sessions from several threads at once, so
+ * createSession() must be thread-safe; each session is only used by one
+ * thread at a time.  SedMockBackend is a backend that does not simulate
+ * anything, for testing.
+ */
+
+#ifndef SedSimulationBackend_h
+#define SedSimulationBackend_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class SedExecutionWorker;
+class SedModel;
+class SedSetValue;
+class SedSimulation;
+class SedTask;
+class SedVariable;
+
+
+/**
+ * @class SedSimulationResult
+ * @ingroup Core
+ * @brief The values of the variables of a simulation run.
+ *
+ * The values are stored column by column, one column of getNumPoints()
+ * values per variable, contiguously.
+ */
+class LIBSEDML_EXTERN SedSimulationResult
+{
+public:
+
+  /**
+   * Creates a new, empty, SedSimulationResult.
+   */
+  SedSimulationResult();
+
+
+  /**
+   * Sets the size of this result; the values are set to zero.
+   *
+   * @param numColumns the number of variables.
+   * @param numPoints the number of output points.
+   */
+  void setSize(unsigned int numColumns, unsigned int numPoints);
+
+
+  /**
+   * @return the number of variables of this result.
+   */
+  unsigned int getNumColumns() const;
+
+
+  /**
+   * @return the number of output points of this result.
+   */
+  unsigned int getNumPoints() const;
+
+
+  /**
+   * @param n the index of the variable.
+   *
+   * @return the getNumPoints() values of the given variable, or @c NULL if
+   * there is no such variable.
+   */
+  double* getColumn(unsigned int n);
+
+
+  /**
+   * @copydoc getColumn(unsigned int n)
+   */
+  const double* getColumn(unsigned int n) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  unsigned int          mNumColumns;
+  unsigned int          mNumPoints;
+  std::vector<double>   mValues;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+/**
+ * @class SedSimulationRun
+ * @ingroup Core
+ * @brief A simulation run of a task, as executed by SedTaskExecutor.
+ *
+ * A run simulates the model of a task with its simulation.  When the task
+ * is a repeated task, the task simulated is one of its subtasks, and the
+ * run has the iteration of each of the repeated tasks it is nested in (see
+ * SedTaskPlanStep).  The variables are those of the data generators of
+ * the document that reference the task; the result of the run has one
+ * column per variable, in the same order.
+ */
+class LIBSEDML_EXTERN SedSimulationRun
+{
+public:
+
+  /**
+   * Creates a new, empty, SedSimulationRun.
+   */
+  SedSimulationRun();
+
+
+  /**
+   * @return the task being executed.
+   */
+  const SedTask* getTask() const;
+
+
+  /**
+   * @return the task simulated: the task being executed, or one of its
+   * subtasks.
+   */
+  const SedTask* getSimulatedTask() const;
+
+
+  /**
+   * @return the model of the task simulated.
+   */
+  const SedModel* getModel() const;
+
+
+  /**
+   * @return the simulation of the task simulated.
+   */
+  const SedSimulation* getSimulation() const;
+
+
+  /**
+   * @return the index of this run among the runs of the task being
+   * executed, in the order of SedTaskPlanStep.
+   */
+  unsigned long getIndex() const;
+
+
+  /**
+   * @return the number of repeated tasks the task simulated is nested in.
+   */
+  unsigned int getNumIterations() const;
+
+
+  /**
+   * @param depth the depth of the repeated task, 0 being the task being
+   * executed.
+   *
+   * @return the iteration of the given repeated task.
+   */
+  unsigned int getIteration(unsigned int depth) const;
+
+
+  /**
+   * @return the number of variables of this run.
+   */
+  unsigned int getNumVariables() const;
+
+
+  /**
+   * @param n the index of the variable.
+   *
+   * @return the given variable, or @c NULL if there is no such variable.
+   */
+  const SedVariable* getVariable(unsigned int n) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  friend class SedExecutionWorker;
+
+  const SedTask*                            mTask;
+  const SedTask*                            mSimulatedTask;
+  const SedModel*                           mModel;
+  const SedSimulation*                      mSimulation;
+  unsigned long                             mIndex;
+  std::vector<unsigned int>                 mIterations;
+  const std::vector<const SedVariable*>*    mVariables;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+/**
+ * @class SedSimulationSession
+ * @ingroup Core
+ * @brief A model loaded into a SedSimulationBackend.
+ */
+class LIBSEDML_EXTERN SedSimulationSession
+{
+public:
+
+  /**
+   * Destructor for SedSimulationSession.
+   */
+  virtual ~SedSimulationSession();
+
+
+  /**
+   * Resets the model to its initial state, with the changes of its
+   * SedModel applied.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int reset() = 0;
+
+
+  /**
+   * Sets the target of a change of a repeated task.
+   *
+   * @param change the change.
+   * @param value the value of its math.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if the target is not in the model.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int setValue(const SedSetValue& change, double value) = 0;
+
+
+  /**
+   * Simulates the model, continuing from its current state.
+   *
+   * @param run the run, giving the simulation and the variables.
+   * @param result the values of the variables, which this function sizes.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if the simulation or a variable is not supported.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   */
+  virtual int simulate(const SedSimulationRun& run,
+                       SedSimulationResult& result) = 0;
+
+
+  /**
+   * Simulates an ensemble of runs of the same task, each starting from the
+   * initial state of the model with its own values of the same changes.
+   * A SedTaskExecutor calls this function for the runs of a repeated task
+   * resetting its model, so that a backend may simulate them together; by
+   * default, the runs are simulated one after the other with reset(),
+   * setValue() and simulate().  The session must be reset afterwards.
+   *
+   * @param runs the @p numRuns runs.
+   * @param numRuns the number of runs.
+   * @param changes the changes of the runs.
+   * @param values the values of the changes: the value of change @c c of
+   * run @c r is <code>values[r * changes.size() + c]</code>.
+   * @param results the @p numRuns results, which this function sizes.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if any of the runs failed.
+   */
+  virtual int simulateEnsemble(const SedSimulationRun* runs,
+                               unsigned int numRuns,
+                               const std::vector<const SedSetValue*>& changes,
+                               const double* values,
+                               SedSimulationResult* results);
+
+
+  /**
+   * @return the reason the last call failed, or an empty string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  std::string mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+class LIBSEDML_EXTERN SedSimulationBackend
+{
+public:
+
+  /**
+   * Destructor for SedSimulationBackend.
+   */
+  virtual ~SedSimulationBackend();
+
+
+  /**
+   * @param language the language of a model, a URN.
+   * @param kisaoID the algorithm of a simulation, a KiSAO term id; empty
+   * when the simulation has no algorithm.
+   *
+   * @return @c true if this backend simulates such models with such
+   * algorithms.
+   */
+  virtual bool supports(const std::string& language,
+                        const std::string& kisaoID) const = 0;
+
+
+  /**
+   * Loads a model.  This function may be called from several threads at
+   * once.
+   *
+   * @param model the model, which must outlive the session.
+   *
+   * @return the new session, owned by the caller, or @c NULL if the model
+   * could not be loaded.
+   */
+  virtual SedSimulationSession* createSession(const SedModel& model) const = 0;
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Frees the given SedSimulationBackend.
+ */
+LIBSEDML_EXTERN
+void
+SedSimulationBackend_free(SedSimulationBackend_t *backend);
+
+/**
+ * Returns the task being executed by the given SedSimulationRun.
+ */
+LIBSEDML_EXTERN
+const SedTask_t *
+SedSimulationRun_getTask(const SedSimulationRun_t *run);
+
+/**
+ * Returns the index of the given SedSimulationRun among the runs of its
+ * task.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedSimulationRun_getIndex(const SedSimulationRun_t *run);
+
+/**
+ * Returns the number of variables of the given SedSimulationResult.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSimulationResult_getNumColumns(const SedSimulationResult_t *result);
+
+/**
+ * Returns the number of output points of the given SedSimulationResult.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedSimulationResult_getNumPoints(const SedSimulationResult_t *result);
+
+/**
+ * Returns the values of the given variable of the given
+ * SedSimulationResult, or @c NULL if there is no such variable.
+ */
+LIBSEDML_EXTERN
+const double *
+SedSimulationResult_getColumn(const SedSimulationResult_t *result,
+                              unsigned int n);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedSimulationBackend_h */
@@ -36,6 +36,7 @@
 
 #include <sedml/SedSlice.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -183,6 +184,7 @@ SedSlice::setReference(const std::string& reference)
     }
   else
     {
+      markDirty();
       mReference = reference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -195,6 +197,8 @@ SedSlice::setReference(const std::string& reference)
 int
 SedSlice::setValue(const std::string& value)
 {
+  markDirty();
+
   {
     mValue = value;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -208,6 +212,8 @@ SedSlice::setValue(const std::string& value)
 int
 SedSlice::unsetReference()
 {
+  markDirty();
+
   mReference.erase();
 
   if (mReference.empty() == true)
@@ -227,6 +233,8 @@ SedSlice::unsetReference()
 int
 SedSlice::unsetValue()
 {
+  markDirty();
+
   mValue.erase();
 
   if (mValue.empty() == true)
@@ -341,8 +349,28 @@ SedSlice::writeElements(XMLOutputStream& stream) const
 bool
 SedSlice::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedSlice::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedSlice));
+  usage.addString(mReference);
+  usage.addString(mValue);
 }
 
 
@@ -608,6 +636,7 @@ SedListOfSlices::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedSlice*>(item);
@@ -0,0 +1,406 @@
+/**
+ * @file    SedStatistics.cpp
+ * @brief   Implementation of SedReaderStatistics and SedWriterStatistics
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedStatistics.h>
+
+#if defined(WIN32) && !defined(CYGWIN)
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates a new, empty SedReaderStatistics.
+ */
+SedReaderStatistics::SedReaderStatistics()
+{
+  reset();
+}
+
+
+/*
+ * Resets all timings and counters to zero.
+ */
+void
+SedReaderStatistics::reset()
+{
+  mNumDocuments = 0;
+  mTotalTime = 0.0;
+  mParseTime = 0.0;
+
+  for (int i = 0; i < SEDML_READ_PHASE_UNKNOWN; ++i)
+    {
+      mPhaseTime[i] = 0.0;
+    }
+
+  mNumBytes = 0;
+  mNumElements = 0;
+  mElementsPerType.clear();
+}
+
+
+unsigned int
+SedReaderStatistics::getNumDocuments() const
+{
+  return mNumDocuments;
+}
+
+
+double
+SedReaderStatistics::getTotalTime() const
+{
+  return mTotalTime;
+}
+
+
+/*
+ * The tokenizing time is not measured directly: it is the time spent in
+ * SedDocument::read() outside of the other phases.
+ */
+double
+SedReaderStatistics::getTime(SedReadPhase_t phase) const
+{
+  if (phase < SEDML_READ_PHASE_TOKENIZE || phase >= SEDML_READ_PHASE_UNKNOWN)
+    return 0.0;
+
+  if (phase != SEDML_READ_PHASE_TOKENIZE)
+    return mPhaseTime[phase];
+
+  double time = mParseTime
+                - mPhaseTime[SEDML_READ_PHASE_CREATE_OBJECT]
+                - mPhaseTime[SEDML_READ_PHASE_READ_ATTRIBUTES]
+                - mPhaseTime[SEDML_READ_PHASE_MATH]
+                - mPhaseTime[SEDML_READ_PHASE_NOTES_ANNOTATION];
+
+  return (time > 0.0) ? time : 0.0;
+}
+
+
+unsigned long
+SedReaderStatistics::getNumBytes() const
+{
+  return mNumBytes;
+}
+
+
+unsigned int
+SedReaderStatistics::getNumElements() const
+{
+  return mNumElements;
+}
+
+
+unsigned int
+SedReaderStatistics::getNumElements(int typeCode) const
+{
+  map<int, unsigned int>::const_iterator it = mElementsPerType.find(typeCode);
+
+  return (it != mElementsPerType.end()) ? it->second : 0;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+/*
+ * @return the current wall clock time, in seconds.
+ */
+double
+SedReaderStatistics::now()
+{
+#if defined(WIN32) && !defined(CYGWIN)
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return (double)tv.tv_sec + (double)tv.tv_usec * 1e-6;
+#endif
+}
+
+
+void
+SedReaderStatistics::addDocument(double totalTime, double parseTime,
+                                 unsigned long numBytes)
+{
+  ++mNumDocuments;
+  mTotalTime += totalTime;
+  mParseTime += parseTime;
+  mNumBytes += numBytes;
+}
+
+
+void
+SedReaderStatistics::addTime(SedReadPhase_t phase, double time)
+{
+  if (phase >= SEDML_READ_PHASE_TOKENIZE && phase < SEDML_READ_PHASE_UNKNOWN)
+    mPhaseTime[phase] += time;
+}
+
+
+void
+SedReaderStatistics::addElement(int typeCode)
+{
+  ++mNumElements;
+  ++mElementsPerType[typeCode];
+}
+/** @endcond */
+
+
+/*
+ * Creates a new, empty SedWriterStatistics.
+ */
+SedWriterStatistics::SedWriterStatistics()
+{
+  reset();
+}
+
+
+/*
+ * Resets all timings and counters to zero.
+ */
+void
+SedWriterStatistics::reset()
+{
+  mNumDocuments = 0;
+  mTotalTime = 0.0;
+  mNumBytes = 0;
+  mNumElements = 0;
+  mNumCachedElements = 0;
+  mElementsPerType.clear();
+}
+
+
+unsigned int
+SedWriterStatistics::getNumDocuments() const
+{
+  return mNumDocuments;
+}
+
+
+double
+SedWriterStatistics::getTotalTime() const
+{
+  return mTotalTime;
+}
+
+
+unsigned long
+SedWriterStatistics::getNumBytes() const
+{
+  return mNumBytes;
+}
+
+
+unsigned int
+SedWriterStatistics::getNumElements() const
+{
+  return mNumElements;
+}
+
+
+unsigned int
+SedWriterStatistics::getNumElements(int typeCode) const
+{
+  map<int, unsigned int>::const_iterator it = mElementsPerType.find(typeCode);
+
+  return (it != mElementsPerType.end()) ? it->second : 0;
+}
+
+
+unsigned int
+SedWriterStatistics::getNumCachedElements() const
+{
+  return mNumCachedElements;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+void
+SedWriterStatistics::addDocument(double totalTime, unsigned long numBytes)
+{
+  ++mNumDocuments;
+  mTotalTime += totalTime;
+  mNumBytes += numBytes;
+}
+
+
+void
+SedWriterStatistics::addElement(int typeCode)
+{
+  ++mNumElements;
+  ++mElementsPerType[typeCode];
+}
+
+
+void
+SedWriterStatistics::addCachedElement()
+{
+  ++mNumCachedElements;
+}
+
+
+void
+SedWriterStatistics::merge(const SedWriterStatistics& other)
+{
+  mNumElements += other.mNumElements;
+  mNumCachedElements += other.mNumCachedElements;
+
+  map<int, unsigned int>::const_iterator it;
+
+  for (it = other.mElementsPerType.begin(); it != other.mElementsPerType.end(); ++it)
+    {
+      mElementsPerType[it->first] += it->second;
+    }
+}
+/** @endcond */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+void
+SedReaderStatistics_reset(SedReaderStatistics_t *stats)
+{
+  if (stats != NULL)
+    stats->reset();
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedReaderStatistics_getNumDocuments(const SedReaderStatistics_t *stats)
+{
+  return (stats != NULL) ? stats->getNumDocuments() : 0;
+}
+
+
+LIBSEDML_EXTERN
+double
+SedReaderStatistics_getTotalTime(const SedReaderStatistics_t *stats)
+{
+  return (stats != NULL) ? stats->getTotalTime() : 0.0;
+}
+
+
+LIBSEDML_EXTERN
+double
+SedReaderStatistics_getTime(const SedReaderStatistics_t *stats,
+                            SedReadPhase_t phase)
+{
+  return (stats != NULL) ? stats->getTime(phase) : 0.0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedReaderStatistics_getNumBytes(const SedReaderStatistics_t *stats)
+{
+  return (stats != NULL) ? stats->getNumBytes() : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedReaderStatistics_getNumElements(const SedReaderStatistics_t *stats,
+                                   int typeCode)
+{
+  return (stats != NULL) ? stats->getNumElements(typeCode) : 0;
+}
+
+
+LIBSEDML_EXTERN
+void
+SedWriterStatistics_reset(SedWriterStatistics_t *stats)
+{
+  if (stats != NULL)
+    stats->reset();
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedWriterStatistics_getNumDocuments(const SedWriterStatistics_t *stats)
+{
+  return (stats != NULL) ? stats->getNumDocuments() : 0;
+}
+
+
+LIBSEDML_EXTERN
+double
+SedWriterStatistics_getTotalTime(const SedWriterStatistics_t *stats)
+{
+  return (stats != NULL) ? stats->getTotalTime() : 0.0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned long
+SedWriterStatistics_getNumBytes(const SedWriterStatistics_t *stats)
+{
+  return (stats != NULL) ? stats->getNumBytes() : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedWriterStatistics_getNumElements(const SedWriterStatistics_t *stats,
+                                   int typeCode)
+{
+  return (stats != NULL) ? stats->getNumElements(typeCode) : 0;
+}
+
+
+LIBSEDML_EXTERN
+unsigned int
+SedWriterStatistics_getNumCachedElements(const SedWriterStatistics_t *stats)
+{
+  return (stats != NULL) ? stats->getNumCachedElements() : 0;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
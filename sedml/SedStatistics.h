@@ -0,0 +1,420 @@
+/**
+ * @file    SedStatistics.h
+ * @brief   Timings and counters collected while reading and writing Sed
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedReaderStatistics
+ * @ingroup Core
+ * @brief Timings and counters collected by SedReader.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedReader collects statistics once SedReader::setCollectStatistics()
+ * has been called, and adds the figures of every document it reads to its
+ * SedReaderStatistics until reset() is called.  The time spent reading is
+ * split into the phases listed in #SedReadPhase_t:
+ *
+ * @li tokenizing: the XML parser, and the traversal of the elements read;
+ * @li creating the objects for the elements read (createObject());
+ * @li reading the attributes of the elements (readAttributes());
+ * @li reading MathML and other XML content held by elements;
+ * @li reading notes and annotations;
+ * @li the checks made on the whole document after it has been read.
+ *
+ * In addition the number of elements read of each type (see
+ * #SedTypeCode_t) and the number of bytes of input are counted.  When
+ * statistics are not collected, reading does not look at the clock at all.
+ *
+ * @class SedWriterStatistics
+ * @ingroup Core
+ * @brief Timings and counters collected by SedWriter.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedWriter collects statistics once SedWriter::setCollectStatistics()
+ * has been called: the time spent writing, the number of bytes written,
+ * the number of elements serialized of each type (see #SedTypeCode_t), and
+ * the number of top level elements whose output was copied from the
+ * subtree cache instead (see SedWriter::setUseSubtreeCache()).
+ */
+
+#ifndef SedStatistics_h
+#define SedStatistics_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/**
+ * @enum SedReadPhase_t
+ * The phases into which SedReaderStatistics splits the time spent reading.
+ */
+typedef enum
+{
+    SEDML_READ_PHASE_TOKENIZE         /*!< XML parsing and traversal of the elements */
+  , SEDML_READ_PHASE_CREATE_OBJECT    /*!< creating the objects for the elements */
+  , SEDML_READ_PHASE_READ_ATTRIBUTES  /*!< reading the attributes of the elements */
+  , SEDML_READ_PHASE_MATH             /*!< reading MathML and other XML content */
+  , SEDML_READ_PHASE_NOTES_ANNOTATION /*!< reading notes and annotations */
+  , SEDML_READ_PHASE_CHECKS           /*!< checks made once the document is read */
+  , SEDML_READ_PHASE_UNKNOWN          /*!< not a phase; the number of phases */
+} SedReadPhase_t;
+
+LIBSEDML_CPP_NAMESPACE_END
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+#include <map>
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedReaderStatistics
+{
+public:
+
+  /**
+   * Creates a new, empty SedReaderStatistics.
+   */
+  SedReaderStatistics();
+
+
+  /**
+   * Resets all timings and counters to zero.
+   */
+  void reset();
+
+
+  /**
+   * @return the number of documents read.
+   */
+  unsigned int getNumDocuments() const;
+
+
+  /**
+   * @return the total time, in seconds, spent reading documents.
+   */
+  double getTotalTime() const;
+
+
+  /**
+   * @param phase the phase of reading.
+   *
+   * @return the time, in seconds, spent in the given phase of reading.
+   */
+  double getTime(SedReadPhase_t phase) const;
+
+
+  /**
+   * @return the number of bytes of input read.  Compressed files count with
+   * their size on disk.
+   */
+  unsigned long getNumBytes() const;
+
+
+  /**
+   * @return the number of elements read.
+   */
+  unsigned int getNumElements() const;
+
+
+  /**
+   * @param typeCode the type code (see #SedTypeCode_t) of the elements
+   * sought.
+   *
+   * @return the number of elements of the given type read.
+   */
+  unsigned int getNumElements(int typeCode) const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  /**
+   * @return the current wall clock time, in seconds.
+   */
+  static double now();
+
+  void addDocument(double totalTime, double parseTime, unsigned long numBytes);
+
+  void addTime(SedReadPhase_t phase, double time);
+
+  void addElement(int typeCode);
+
+  /** @endcond */
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  unsigned int mNumDocuments;
+  double mTotalTime;
+  /* time spent in SedDocument::read(), including its inner phases */
+  double mParseTime;
+  double mPhaseTime[SEDML_READ_PHASE_UNKNOWN];
+  unsigned long mNumBytes;
+  unsigned int mNumElements;
+  std::map<int, unsigned int> mElementsPerType;
+
+  /** @endcond */
+};
+
+
+class LIBSEDML_EXTERN SedWriterStatistics
+{
+public:
+
+  /**
+   * Creates a new, empty SedWriterStatistics.
+   */
+  SedWriterStatistics();
+
+
+  /**
+   * Resets all timings and counters to zero.
+   */
+  void reset();
+
+
+  /**
+   * @return the number of documents written.
+   */
+  unsigned int getNumDocuments() const;
+
+
+  /**
+   * @return the total time, in seconds, spent writing documents.
+   */
+  double getTotalTime() const;
+
+
+  /**
+   * @return the number of bytes written, if the destination stream reports
+   * its position, before compression.
+   */
+  unsigned long getNumBytes() const;
+
+
+  /**
+   * @return the number of elements serialized.  Elements whose output was
+   * copied from the subtree cache are not counted.
+   */
+  unsigned int getNumElements() const;
+
+
+  /**
+   * @param typeCode the type code (see #SedTypeCode_t) of the elements
+   * sought.
+   *
+   * @return the number of elements of the given type serialized.
+   */
+  unsigned int getNumElements(int typeCode) const;
+
+
+  /**
+   * @return the number of top level elements whose output was copied from
+   * the subtree cache.
+   */
+  unsigned int getNumCachedElements() const;
+
+
+  /** @cond doxygen-libsedml-internal */
+
+  void addDocument(double totalTime, unsigned long numBytes);
+
+  void addElement(int typeCode);
+
+  void addCachedElement();
+
+  /**
+   * Adds the counters of @p other (collected by another thread) to these.
+   */
+  void merge(const SedWriterStatistics& other);
+
+  /** @endcond */
+
+protected:
+  /** @cond doxygen-libsedml-internal */
+
+  unsigned int mNumDocuments;
+  double mTotalTime;
+  unsigned long mNumBytes;
+  unsigned int mNumElements;
+  unsigned int mNumCachedElements;
+  std::map<int, unsigned int> mElementsPerType;
+
+  /** @endcond */
+};
+
+
+/** @cond doxygen-libsedml-internal */
+
+/**
+ * Adds the time spent in its scope to a phase of a SedReaderStatistics, if
+ * there is one.
+ */
+class SedReadPhaseTimer
+{
+public:
+  SedReadPhaseTimer(SedReaderStatistics* stats, SedReadPhase_t phase)
+    : mStats(stats)
+    , mPhase(phase)
+    , mStart(stats != NULL ? SedReaderStatistics::now() : 0.0)
+  {
+  }
+
+  ~SedReadPhaseTimer()
+  {
+    if (mStats != NULL)
+      mStats->addTime(mPhase, SedReaderStatistics::now() - mStart);
+  }
+
+private:
+  SedReaderStatistics* mStats;
+  SedReadPhase_t mPhase;
+  double mStart;
+};
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Resets the timings and counters of the given SedReaderStatistics.
+ */
+LIBSEDML_EXTERN
+void
+SedReaderStatistics_reset(SedReaderStatistics_t *stats);
+
+/**
+ * Returns the number of documents read.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedReaderStatistics_getNumDocuments(const SedReaderStatistics_t *stats);
+
+/**
+ * Returns the total time, in seconds, spent reading documents.
+ */
+LIBSEDML_EXTERN
+double
+SedReaderStatistics_getTotalTime(const SedReaderStatistics_t *stats);
+
+/**
+ * Returns the time, in seconds, spent in the given phase of reading.
+ */
+LIBSEDML_EXTERN
+double
+SedReaderStatistics_getTime(const SedReaderStatistics_t *stats,
+                            SedReadPhase_t phase);
+
+/**
+ * Returns the number of bytes of input read.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedReaderStatistics_getNumBytes(const SedReaderStatistics_t *stats);
+
+/**
+ * Returns the number of elements of the given type read.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedReaderStatistics_getNumElements(const SedReaderStatistics_t *stats,
+                                   int typeCode);
+
+/**
+ * Resets the timings and counters of the given SedWriterStatistics.
+ */
+LIBSEDML_EXTERN
+void
+SedWriterStatistics_reset(SedWriterStatistics_t *stats);
+
+/**
+ * Returns the number of documents written.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedWriterStatistics_getNumDocuments(const SedWriterStatistics_t *stats);
+
+/**
+ * Returns the total time, in seconds, spent writing documents.
+ */
+LIBSEDML_EXTERN
+double
+SedWriterStatistics_getTotalTime(const SedWriterStatistics_t *stats);
+
+/**
+ * Returns the number of bytes written.
+ */
+LIBSEDML_EXTERN
+unsigned long
+SedWriterStatistics_getNumBytes(const SedWriterStatistics_t *stats);
+
+/**
+ * Returns the number of elements of the given type serialized.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedWriterStatistics_getNumElements(const SedWriterStatistics_t *stats,
+                                   int typeCode);
+
+/**
+ * Returns the number of top level elements whose output was copied from
+ * the subtree cache.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedWriterStatistics_getNumCachedElements(const SedWriterStatistics_t *stats);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedStatistics_h */
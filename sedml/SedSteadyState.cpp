@@ -36,6 +36,7 @@
 
 #include <sedml/SedSteadyState.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -181,8 +182,31 @@ SedSteadyState::writeElements(XMLOutputStream& stream) const
 bool
 SedSteadyState::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (mAlgorithm != NULL)
+        mAlgorithm->accept(v);
+    }
+
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedSteadyState::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedSimulation::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedSteadyState));
 }
 
 
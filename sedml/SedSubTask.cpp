@@ -36,6 +36,7 @@
 
 #include <sedml/SedSubTask.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -169,6 +170,8 @@ SedSubTask::isSetTask() const
 int
 SedSubTask::setOrder(int order)
 {
+  markDirty();
+
   mOrder = order;
   mIsSetOrder = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -187,6 +190,7 @@ SedSubTask::setTask(const std::string& task)
     }
   else
     {
+      markDirty();
       mTask = task;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -199,6 +203,8 @@ SedSubTask::setTask(const std::string& task)
 int
 SedSubTask::unsetOrder()
 {
+  markDirty();
+
   mOrder = SEDML_INT_MAX;
   mIsSetOrder = false;
 
@@ -219,6 +225,8 @@ SedSubTask::unsetOrder()
 int
 SedSubTask::unsetTask()
 {
+  markDirty();
+
   mTask.erase();
 
   if (mTask.empty() == true)
@@ -294,8 +302,27 @@ SedSubTask::writeElements(XMLOutputStream& stream) const
 bool
 SedSubTask::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedSubTask::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedSubTask));
+  usage.addString(mTask);
 }
 
 
@@ -551,6 +578,7 @@ SedListOfSubTasks::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedSubTask*>(item);
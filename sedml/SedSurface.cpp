@@ -36,6 +36,7 @@
 
 #include <sedml/SedSurface.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -169,6 +170,8 @@ SedSurface::isSetZDataReference() const
 int
 SedSurface::setLogZ(bool logZ)
 {
+  markDirty();
+
   mLogZ = logZ;
   mIsSetLogZ = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -187,6 +190,7 @@ SedSurface::setZDataReference(const std::string& zDataReference)
     }
   else
     {
+      markDirty();
       mZDataReference = zDataReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -199,6 +203,8 @@ SedSurface::setZDataReference(const std::string& zDataReference)
 int
 SedSurface::unsetLogZ()
 {
+  markDirty();
+
   mLogZ = false;
   mIsSetLogZ = false;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -211,6 +217,8 @@ SedSurface::unsetLogZ()
 int
 SedSurface::unsetZDataReference()
 {
+  markDirty();
+
   mZDataReference.erase();
 
   if (mZDataReference.empty() == true)
@@ -300,8 +308,27 @@ SedSurface::writeElements(XMLOutputStream& stream) const
 bool
 SedSurface::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedSurface::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedCurve::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedSurface));
+  usage.addString(mZDataReference);
 }
 
 
@@ -557,6 +584,7 @@ SedListOfSurfaces::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedSurface*>(item);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedTask.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -225,7 +226,12 @@ SedTask::isSetSimulationReference() const
 int
 SedTask::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -235,6 +241,8 @@ SedTask::setId(const std::string& id)
 int
 SedTask::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -254,6 +262,7 @@ SedTask::setModelReference(const std::string& modelReference)
     }
   else
     {
+      markDirty();
       mModelReference = modelReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -272,6 +281,7 @@ SedTask::setSimulationReference(const std::string& simulationReference)
     }
   else
     {
+      markDirty();
       mSimulationReference = simulationReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -284,6 +294,8 @@ SedTask::setSimulationReference(const std::string& simulationReference)
 int
 SedTask::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -303,6 +315,8 @@ SedTask::unsetId()
 int
 SedTask::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -322,6 +336,8 @@ SedTask::unsetName()
 int
 SedTask::unsetModelReference()
 {
+  markDirty();
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -341,6 +357,8 @@ SedTask::unsetModelReference()
 int
 SedTask::unsetSimulationReference()
 {
+  markDirty();
+
   mSimulationReference.erase();
 
   if (mSimulationReference.empty() == true)
@@ -452,8 +470,30 @@ SedTask::writeElements(XMLOutputStream& stream) const
 bool
 SedTask::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
 
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedTask::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedTask));
+  usage.addString(mId);
+  usage.addString(mName);
+  usage.addString(mModelReference);
+  usage.addString(mSimulationReference);
 }
 
 
@@ -783,6 +823,7 @@ SedListOfTasks::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedTask*>(item);
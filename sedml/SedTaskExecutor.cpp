@@ -0,0 +1,973 @@
+/**
+ * @file    SedTaskExecutor.cpp
+ * @brief   Implementation of SedTaskExecutor
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedTaskExecutor.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedTaskPlan.h>
+#include <sedml/SedWorkQueue.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <sbml/util/util.h>
+
+#include <algorithm>
+#include <map>
+#include <new>
+#include <set>
+#include <sstream>
+
+#ifdef LIBSEDML_USE_THREADS
+#include <mutex>
+#endif
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * @return the document containing the given object, even if the object
+ * has not been connected to it yet.
+ */
+static const SedDocument*
+findDocument(const SedBase* object)
+{
+  while (object != NULL && object->getTypeCode() != SEDML_DOCUMENT)
+    {
+      object = object->getParentSedObject();
+    }
+
+  return static_cast<const SedDocument*>(object);
+}
+
+
+/*
+ * A task being executed: its plan, and the variables of its runs; the runs
+ * of an ensemble are simulated together by simulateEnsemble().
+ */
+struct SedExecutedTask
+{
+  const SedTask*                    task;
+  SedTaskPlan                       plan;
+  std::vector<const SedVariable*>   variables;
+  unsigned long                     runsPerIteration;
+  bool                              ensemble;
+};
+
+
+/*
+ * The model and the simulation of a task that is simulated.
+ */
+struct SedSimulatedTask
+{
+  const SedModel*       model;
+  const SedSimulation*  simulation;
+};
+
+
+/*
+ * Some iterations of a task being executed, run by one thread.
+ */
+struct SedExecutionUnit
+{
+  size_t        task;
+  unsigned int  firstIteration;
+  unsigned int  numIterations;
+};
+
+
+/*
+ * What the threads of SedTaskExecutor::execute() share.
+ */
+struct SedExecution
+{
+  SedExecution(SedExecutionListener& listener)
+    : queue(NULL)
+    , listener(&listener)
+    , numFailed(0)
+  {
+  }
+
+  ~SedExecution()
+  {
+    for (size_t n = 0; n < tasks.size(); ++n)
+      {
+        delete tasks[n];
+      }
+  }
+
+  std::vector<SedExecutedTask*>                           tasks;
+  std::vector<SedExecutionUnit>                           units;
+  std::set<const SedTask*>                                prepared;
+  std::map<const SedTask*, SedSimulatedTask>              simulated;
+  std::map<const SedModel*, const SedSimulationBackend*>  backends;
+  std::map<const SedSetValue*, const SedModel*>           changeModels;
+  SedWorkQueue*                                           queue;
+  SedExecutionListener*                                   listener;
+#ifdef LIBSEDML_USE_THREADS
+  std::mutex                                              mutex;
+#endif
+  unsigned long                                           numFailed;
+  std::string                                             firstFailure;
+};
+
+
+/*
+ * The sessions of a thread, one per model, and the runs it executes.
+ */
+class SedExecutionWorker
+{
+public:
+
+  SedExecutionWorker(SedExecution& execution)
+    : mExecution(execution)
+  {
+  }
+
+
+  ~SedExecutionWorker()
+  {
+    std::map<const SedModel*, SedSimulationSession*>::iterator it;
+
+    for (it = mSessions.begin(); it != mSessions.end(); ++it)
+      {
+        delete it->second;
+      }
+  }
+
+
+  /*
+   * Executes the runs of the given unit.
+   */
+  void execute(const SedExecutionUnit& unit)
+  {
+    if (mExecution.tasks[unit.task]->ensemble)
+      executeEnsemble(unit);
+    else
+      executeRuns(unit);
+  }
+
+
+private:
+
+  /*
+   * Executes the runs of the given unit one after the other.
+   */
+  void executeRuns(const SedExecutionUnit& unit)
+  {
+    const SedExecutedTask& executed = *mExecution.tasks[unit.task];
+    SedTaskPlanStep step(executed.plan, unit.firstIteration,
+                         unit.numIterations);
+    SedSimulationRun run;
+
+    run.mTask = executed.task;
+    run.mVariables = &executed.variables;
+    run.mIndex = unit.firstIteration * executed.runsPerIteration;
+
+    // the iterations of the unit do not depend on what the thread ran
+    std::string reset = resetSessions();
+    std::string failure;
+    unsigned int failureDepth = 0;
+
+    while (step.next())
+      {
+        unsigned int depth = step.getDepth();
+
+        // a failed iteration fails all its runs
+        if (!failure.empty() && step.getFirstNewIteration() <= failureDepth)
+          failure.clear();
+
+        for (unsigned int d = step.getFirstNewIteration();
+             d < depth && failure.empty() && reset.empty(); ++d)
+          {
+            failure = startIteration(step, d);
+            failureDepth = d;
+          }
+
+        const SedSimulatedTask& simulated =
+          mExecution.simulated.find(step.getTask())->second;
+
+        run.mSimulatedTask = step.getTask();
+        run.mModel = simulated.model;
+        run.mSimulation = simulated.simulation;
+        run.mIterations.resize(depth);
+
+        for (unsigned int d = 0; d < depth; ++d)
+          {
+            run.mIterations[d] = step.getIteration(d);
+          }
+
+        if (!reset.empty())
+          report(run, mResult, reset);
+        else
+          report(run, mResult, failure.empty() ? simulate(run) : failure);
+        ++run.mIndex;
+      }
+  }
+
+
+  /*
+   * Executes the runs of the given unit, each an iteration of a repeated
+   * task resetting its model, in ensembles of #SEDML_MATH_BLOCK_SIZE runs.
+   * When an ensemble fails, its runs are executed again one after the
+   * other, to tell which of them failed and why.
+   */
+  void executeEnsemble(const SedExecutionUnit& unit)
+  {
+    const SedExecutedTask& executed = *mExecution.tasks[unit.task];
+    unsigned int end = unit.firstIteration + unit.numIterations;
+
+    for (unsigned int first = unit.firstIteration; first < end;
+         first += SEDML_MATH_BLOCK_SIZE)
+      {
+        SedExecutionUnit batch = unit;
+        batch.firstIteration = first;
+        batch.numIterations = std::min(end - first,
+                                       (unsigned int)SEDML_MATH_BLOCK_SIZE);
+
+        SedTaskPlanStep step(executed.plan, batch.firstIteration,
+                             batch.numIterations);
+        std::vector<const SedSetValue*> changes;
+
+        mRuns.clear();
+        mValues.clear();
+
+        while (step.next())
+          {
+            const SedRepeatedTask* repeated = step.getRepeatedTask(0);
+            const SedSimulatedTask& simulated =
+              mExecution.simulated.find(step.getTask())->second;
+            SedSimulationRun run;
+
+            if (changes.empty())
+              {
+                for (unsigned int n = 0; n < repeated->getNumTaskChanges(); ++n)
+                  {
+                    changes.push_back(repeated->getTaskChange(n));
+                  }
+              }
+
+            run.mTask = executed.task;
+            run.mSimulatedTask = step.getTask();
+            run.mModel = simulated.model;
+            run.mSimulation = simulated.simulation;
+            run.mIndex = first + mRuns.size();
+            run.mIterations.push_back(step.getIteration(0));
+            run.mVariables = &executed.variables;
+            mRuns.push_back(run);
+
+            for (size_t n = 0; n < changes.size(); ++n)
+              {
+                mValues.push_back(step.getChangeValue(0, (unsigned int)n));
+              }
+          }
+
+        if (!simulateEnsemble(changes))
+          executeRuns(batch);
+      }
+  }
+
+
+  /*
+   * Simulates the runs of mRuns together, and reports their results;
+   * returns false if they failed.
+   */
+  bool simulateEnsemble(const std::vector<const SedSetValue*>& changes)
+  {
+    if (mRuns.empty()) return true;
+
+    std::string message;
+    SedSimulationSession* session = getSession(mRuns[0].getModel(), message);
+    unsigned int numRuns = (unsigned int)mRuns.size();
+
+    if (session == NULL) return false;
+
+    mResults.resize(numRuns);
+
+    int result = session->simulateEnsemble(&mRuns[0], numRuns, changes,
+                                           mValues.empty() ? NULL : &mValues[0],
+                                           &mResults[0]);
+
+    if (result != LIBSEDML_OPERATION_SUCCESS) return false;
+
+    for (unsigned int r = 0; r < numRuns; ++r)
+      {
+        if (mResults[r].getNumColumns() != mRuns[r].getNumVariables())
+          return false;
+      }
+
+    for (unsigned int r = 0; r < numRuns; ++r)
+      {
+        report(mRuns[r], mResults[r], "");
+      }
+
+    return true;
+  }
+
+  /*
+   * Resets the models of the thread; returns the reason it failed, if it
+   * did.
+   */
+  std::string resetSessions()
+  {
+    std::map<const SedModel*, SedSimulationSession*>::iterator it;
+
+    for (it = mSessions.begin(); it != mSessions.end(); ++it)
+      {
+        if (it->second->reset() != LIBSEDML_OPERATION_SUCCESS)
+          return "model '" + it->first->getId() + "' could not be reset: "
+                 + it->second->getErrorMessage();
+      }
+
+    return "";
+  }
+
+
+  /*
+   * @return the session of the given model, creating it if needed, or NULL
+   * with the reason in message.
+   */
+  SedSimulationSession* getSession(const SedModel* model,
+                                   std::string& message)
+  {
+    std::map<const SedModel*, SedSimulationSession*>::iterator it =
+      mSessions.find(model);
+
+    if (it != mSessions.end()) return it->second;
+
+    SedSimulationSession* session =
+      mExecution.backends.find(model)->second->createSession(*model);
+
+    if (session == NULL)
+      {
+        message = "model '" + model->getId() + "' could not be loaded";
+        return NULL;
+      }
+
+    mSessions[model] = session;
+    return session;
+  }
+
+
+  /*
+   * Starts the current iteration of the repeated task at the given depth;
+   * returns the reason it failed, if it did.
+   */
+  std::string startIteration(const SedTaskPlanStep& step, unsigned int depth)
+  {
+    const SedRepeatedTask* repeated = step.getRepeatedTask(depth);
+
+    if (repeated->getResetModel())
+      {
+        std::string message = resetSessions();
+        if (!message.empty()) return message;
+      }
+
+    for (unsigned int n = 0; n < repeated->getNumTaskChanges(); ++n)
+      {
+        const SedSetValue* change = repeated->getTaskChange(n);
+        const SedModel* model = mExecution.changeModels.find(change)->second;
+        double value = step.getChangeValue(depth, n);
+
+        // the change of a model that is not simulated has no effect
+        if (mExecution.backends.find(model) == mExecution.backends.end())
+          continue;
+
+        if (util_isNaN(value) && change->getNumVariables() > 0)
+          return "change of '" + change->getTarget() + "' of repeated task '"
+                 + repeated->getId() + "' uses variables of the model";
+
+        std::string message;
+        SedSimulationSession* session = getSession(model, message);
+
+        if (session == NULL) return message;
+
+        if (session->setValue(*change, value) != LIBSEDML_OPERATION_SUCCESS)
+          return "change of '" + change->getTarget() + "' of repeated task '"
+                 + repeated->getId() + "': " + session->getErrorMessage();
+      }
+
+    return "";
+  }
+
+
+  /*
+   * Simulates the given run into mResult; returns the reason it failed, if
+   * it did.
+   */
+  std::string simulate(const SedSimulationRun& run)
+  {
+    std::string message;
+    SedSimulationSession* session = getSession(run.getModel(), message);
+
+    if (session == NULL) return message;
+
+    if (session->simulate(run, mResult) != LIBSEDML_OPERATION_SUCCESS)
+      return "simulation of task '" + run.getSimulatedTask()->getId()
+             + "': " + session->getErrorMessage();
+
+    if (mResult.getNumColumns() != run.getNumVariables())
+      return "simulation of task '" + run.getSimulatedTask()->getId()
+             + "' did not give the values of all the variables";
+
+    return "";
+  }
+
+
+  /*
+   * Passes the result of the given run, or the reason it failed, to the
+   * listener.
+   */
+  void report(const SedSimulationRun& run, const SedSimulationResult& result,
+              const std::string& failure)
+  {
+#ifdef LIBSEDML_USE_THREADS
+    std::lock_guard<std::mutex> lock(mExecution.mutex);
+#endif
+
+    if (failure.empty())
+      {
+        mExecution.listener->runFinished(run, result);
+        return;
+      }
+
+    if (mExecution.numFailed++ == 0) mExecution.firstFailure = failure;
+
+    mExecution.listener->runFailed(run, failure);
+  }
+
+
+  SedExecutionWorker(const SedExecutionWorker&);
+  SedExecutionWorker& operator=(const SedExecutionWorker&);
+
+  SedExecution&                                     mExecution;
+  std::map<const SedModel*, SedSimulationSession*>  mSessions;
+  SedSimulationResult                               mResult;
+  std::vector<SedSimulationRun>                     mRuns;
+  std::vector<double>                               mValues;
+  std::vector<SedSimulationResult>                  mResults;
+};
+
+
+static void
+executeUnits(void* context, unsigned int thread)
+{
+  SedExecution* execution = static_cast<SedExecution*>(context);
+  SedExecutionWorker worker(*execution);
+  size_t unit;
+
+  while (execution->queue->next(thread, unit))
+    {
+      worker.execute(execution->units[unit]);
+    }
+}
+
+
+/*
+ * Finds the models, simulations and backends of the given task and of its
+ * subtasks.
+ */
+static int
+prepareTask(const SedTaskExecutor& executor, const SedDocument& doc,
+            const SedTask& task, SedExecution& execution,
+            std::string& message)
+{
+  if (!execution.prepared.insert(&task).second)
+    return LIBSEDML_OPERATION_SUCCESS;
+
+  if (task.getTypeCode() == SEDML_TASK_REPEATEDTASK)
+    {
+      const SedRepeatedTask& repeated =
+        static_cast<const SedRepeatedTask&>(task);
+
+      for (unsigned int n = 0; n < repeated.getNumTaskChanges(); ++n)
+        {
+          const SedSetValue* change = repeated.getTaskChange(n);
+          const SedModel* model = doc.getModel(change->getModelReference());
+
+          if (model == NULL)
+            {
+              message = "repeated task '" + task.getId()
+                        + "' references unknown model '"
+                        + change->getModelReference() + "'";
+              return LIBSEDML_INVALID_OBJECT;
+            }
+
+          execution.changeModels[change] = model;
+        }
+
+      // the plan has checked the subtasks
+      for (unsigned int n = 0; n < repeated.getNumSubTasks(); ++n)
+        {
+          const SedTask* child = doc.getTask(repeated.getSubTask(n)->getTask());
+          int result = prepareTask(executor, doc, *child, execution, message);
+
+          if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+        }
+
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  SedSimulatedTask simulated;
+  simulated.model = doc.getModel(task.getModelReference());
+  simulated.simulation = doc.getSimulation(task.getSimulationReference());
+
+  if (simulated.model == NULL)
+    {
+      message = "task '" + task.getId() + "' references unknown model '"
+                + task.getModelReference() + "'";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  if (simulated.simulation == NULL)
+    {
+      message = "task '" + task.getId() + "' references unknown simulation '"
+                + task.getSimulationReference() + "'";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  const SedAlgorithm* algorithm = simulated.simulation->getAlgorithm();
+  std::string kisaoID = (algorithm != NULL) ? algorithm->getKisaoID() : "";
+  const SedSimulationBackend* backend =
+    executor.findBackend(simulated.model->getLanguage(), kisaoID);
+
+  if (backend == NULL)
+    {
+      message = "task '" + task.getId() + "' has no backend for language '"
+                + simulated.model->getLanguage() + "' and algorithm '"
+                + kisaoID + "'";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  std::map<const SedModel*, const SedSimulationBackend*>::iterator it =
+    execution.backends.find(simulated.model);
+
+  if (it != execution.backends.end() && it->second != backend)
+    {
+      message = "model '" + simulated.model->getId()
+                + "' is simulated by several backends";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  execution.backends[simulated.model] = backend;
+  execution.simulated[&task] = simulated;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/*
+ * @return true if the runs of the given task can be simulated as an
+ * ensemble: the task repeats a single task, resetting its model, and
+ * changes that model with values that do not depend on it.
+ */
+static bool
+isEnsemble(const SedDocument& doc, const SedTask& task,
+           const SedExecution& execution)
+{
+  if (task.getTypeCode() != SEDML_TASK_REPEATEDTASK) return false;
+
+  const SedRepeatedTask& repeated = static_cast<const SedRepeatedTask&>(task);
+
+  if (!repeated.getResetModel() || repeated.getNumSubTasks() != 1)
+    return false;
+
+  const SedTask* child = doc.getTask(repeated.getSubTask(0)->getTask());
+
+  if (child == NULL || child->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+    return false;
+
+  const SedModel* model = execution.simulated.find(child)->second.model;
+
+  for (unsigned int n = 0; n < repeated.getNumTaskChanges(); ++n)
+    {
+      const SedSetValue* change = repeated.getTaskChange(n);
+
+      if (change->getNumVariables() > 0
+          || execution.changeModels.find(change)->second != model)
+        return false;
+    }
+
+  return true;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+SedExecutionListener::~SedExecutionListener()
+{
+}
+
+
+/*
+ * Is told that a run failed.
+ */
+void
+SedExecutionListener::runFailed(const SedSimulationRun&, const std::string&)
+{
+}
+
+
+/*
+ * Creates a new SedTaskExecutor.
+ */
+SedTaskExecutor::SedTaskExecutor(unsigned int numThreads)
+  : mNumThreads(1)
+{
+  setNumThreads(numThreads);
+}
+
+
+/*
+ * Destructor for SedTaskExecutor.
+ */
+SedTaskExecutor::~SedTaskExecutor()
+{
+}
+
+
+/*
+ * Sets the number of threads used to run the simulations.
+ */
+int
+SedTaskExecutor::setNumThreads(unsigned int numThreads)
+{
+  if (numThreads > 1 && !SedWorkQueue::hasThreads())
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  if (numThreads == 0)
+    {
+      numThreads = SedWorkQueue::getNumProcessors();
+    }
+
+  mNumThreads = numThreads;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the number of threads used to run the simulations.
+ */
+unsigned int
+SedTaskExecutor::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+/*
+ * Adds a backend.
+ */
+int
+SedTaskExecutor::addBackend(const SedSimulationBackend* backend)
+{
+  if (backend == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  mBackends.push_back(backend);
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the number of backends of this executor.
+ */
+unsigned int
+SedTaskExecutor::getNumBackends() const
+{
+  return (unsigned int)mBackends.size();
+}
+
+
+/*
+ * @return the first backend supporting the given language and algorithm.
+ */
+const SedSimulationBackend*
+SedTaskExecutor::findBackend(const std::string& language,
+                             const std::string& kisaoID) const
+{
+  for (size_t n = 0; n < mBackends.size(); ++n)
+    {
+      if (mBackends[n]->supports(language, kisaoID)) return mBackends[n];
+    }
+
+  return NULL;
+}
+
+
+/*
+ * Runs the simulations of the given tasks.
+ */
+int
+SedTaskExecutor::execute(const std::vector<const SedTask*>& tasks,
+                         SedExecutionListener& listener)
+{
+  SedExecution execution(listener);
+
+  mErrorMessage.clear();
+
+  for (size_t t = 0; t < tasks.size(); ++t)
+    {
+      if (tasks[t] == NULL) return LIBSEDML_INVALID_OBJECT;
+
+      const SedTask& task = *tasks[t];
+      const SedDocument* doc = findDocument(&task);
+
+      if (doc == NULL)
+        {
+          mErrorMessage = "task '" + task.getId() + "' is not in a document";
+          return LIBSEDML_INVALID_OBJECT;
+        }
+
+      SedExecutedTask* executed = new SedExecutedTask();
+      execution.tasks.push_back(executed);
+      executed->task = &task;
+      executed->runsPerIteration = 0;
+      executed->ensemble = false;
+
+      int result = executed->plan.compile(task);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        {
+          mErrorMessage = executed->plan.getErrorMessage();
+          return result;
+        }
+
+      result = prepareTask(*this, *doc, task, execution, mErrorMessage);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+      // the variables of the data generators referencing the task
+      for (unsigned int g = 0; g < doc->getNumDataGenerators(); ++g)
+        {
+          const SedDataGenerator* generator = doc->getDataGenerator(g);
+
+          for (unsigned int v = 0; v < generator->getNumVariables(); ++v)
+            {
+              const SedVariable* variable = generator->getVariable(v);
+
+              if (variable->getTaskReference() == task.getId())
+                executed->variables.push_back(variable);
+            }
+        }
+
+      // the iterations of a repeated task resetting its models are split
+      unsigned int numIterations = executed->plan.getNumOuterIterations();
+      unsigned int unitSize = numIterations;
+
+      if (numIterations == 0) continue;
+
+      executed->runsPerIteration =
+        (unsigned long)(executed->plan.getNumRuns() / numIterations);
+
+      executed->ensemble = isEnsemble(*doc, task, execution);
+
+      if (executed->ensemble)
+        {
+          // each thread simulates ensembles as large as possible
+          unitSize = (numIterations + mNumThreads - 1) / mNumThreads;
+          unitSize = std::min(unitSize, (unsigned int)SEDML_MATH_BLOCK_SIZE);
+        }
+      else if (task.getTypeCode() == SEDML_TASK_REPEATEDTASK
+               && static_cast<const SedRepeatedTask&>(task).getResetModel())
+        {
+          unitSize = std::max(numIterations / (4 * mNumThreads), 1u);
+        }
+
+      for (unsigned int first = 0; first < numIterations; first += unitSize)
+        {
+          SedExecutionUnit unit;
+          unit.task = t;
+          unit.firstIteration = first;
+          unit.numIterations = std::min(unitSize, numIterations - first);
+          execution.units.push_back(unit);
+        }
+    }
+
+  unsigned int numThreads = mNumThreads;
+
+  if (numThreads > execution.units.size())
+    numThreads = (unsigned int)execution.units.size();
+
+  SedWorkQueue queue(execution.units.size(), numThreads);
+  execution.queue = &queue;
+  SedWorkQueue::run(queue.getNumShares(), executeUnits, &execution);
+
+  if (execution.numFailed > 0)
+    {
+      ostringstream message;
+      message << execution.numFailed << " runs failed, the first reported "
+              << "because: " << execution.firstFailure;
+      mErrorMessage = message.str();
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the reason the last call to execute() failed.
+ */
+const std::string&
+SedTaskExecutor::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/*
+ * Finds the tasks needed by some outputs.
+ */
+int
+SedTaskExecutor::findTasks(const SedDocument& doc,
+                           const std::vector<const SedBase*>& outputs,
+                           std::vector<const SedTask*>& tasks)
+{
+  SedDependencyGraph graph;
+  std::vector<const SedBase*> order;
+
+  tasks.clear();
+
+  int result = graph.build(doc);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    result = graph.schedule(outputs, order);
+
+  if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+  for (size_t n = 0; n < order.size(); ++n)
+    {
+      if (order[n]->getTypeCode() != SEDML_VARIABLE) continue;
+
+      const SedTask* task = doc.getTask(
+        static_cast<const SedVariable*>(order[n])->getTaskReference());
+
+      if (task != NULL && std::find(tasks.begin(), tasks.end(), task)
+                          == tasks.end())
+        tasks.push_back(task);
+    }
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * A listener calling the function given to SedTaskExecutor_execute().
+ */
+class SedCallbackListener : public SedExecutionListener
+{
+public:
+
+  SedCallbackListener(SedRunFinishedFunc finished, void* context)
+    : mFinished(finished)
+    , mContext(context)
+  {
+  }
+
+  virtual void runFinished(const SedSimulationRun& run,
+                           const SedSimulationResult& result)
+  {
+    mFinished(&run, &result, mContext);
+  }
+
+private:
+
+  SedRunFinishedFunc  mFinished;
+  void*               mContext;
+};
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedTaskExecutor_t *
+SedTaskExecutor_create(unsigned int numThreads)
+{
+  return new(std::nothrow) SedTaskExecutor(numThreads);
+}
+
+
+LIBSEDML_EXTERN
+void
+SedTaskExecutor_free(SedTaskExecutor_t *executor)
+{
+  delete executor;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedTaskExecutor_addBackend(SedTaskExecutor_t *executor,
+                           const SedSimulationBackend_t *backend)
+{
+  if (executor == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return executor->addBackend(backend);
+}
+
+
+LIBSEDML_EXTERN
+int
+SedTaskExecutor_execute(SedTaskExecutor_t *executor,
+                        const SedTask_t **tasks, unsigned int numTasks,
+                        SedRunFinishedFunc finished, void *context)
+{
+  if (executor == NULL || (tasks == NULL && numTasks > 0) || finished == NULL)
+    return LIBSEDML_INVALID_OBJECT;
+
+  SedCallbackListener listener(finished, context);
+  std::vector<const SedTask*> list(tasks, tasks + numTasks);
+  return executor->execute(list, listener);
+}
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_END
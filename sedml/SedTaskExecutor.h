@@ -0,0 +1,341 @@
+/**
+ * @file    SedTaskExecutor.h
+ * @brief   Definition of SedTaskExecutor
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedTaskExecutor
+ * @ingroup Core
+ * @brief Runs the simulations of tasks on several threads.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedTaskExecutor runs the simulations of SedTask and SedRepeatedTask
+ * objects with the SedSimulationBackend objects it is given, and passes
+ * their results to a SedExecutionListener.  The backend of a model is the
+ * first one supporting the language of the model and the algorithm of a
+ * simulation it is run with.
+ *
+ * The runs of a task are walked with a SedTaskPlanStep.  They are split
+ * into units of work, which are spread over the threads by a SedWorkQueue:
+ *
+ * @li a task that is not a repeated task is a unit;
+ * @li the iterations of a repeated task resetting its models are
+ * independent, and are split into several units;
+ * @li a repeated task not resetting its models is a unit, since each
+ * iteration continues from the state the previous one left the models in.
+ *
+ * Each thread keeps one SedSimulationSession per model, which it resets at
+ * the start of each unit, and when a repeated task resetting its models
+ * starts an iteration; the changes of the repeated task are then applied
+ * to the sessions of their models.  The changes whose math uses variables
+ * of the models are not supported, and their runs fail.
+ *
+ * When a repeated task resetting its model repeats a single task of that
+ * model, its iterations form an ensemble: the runs of up to
+ * #SEDML_MATH_BLOCK_SIZE iterations are passed together to
+ * SedSimulationSession::simulateEnsemble(), which a backend such as
+ * SedSbmlBackend implements by simulating them side by side.
+ * @code{.cpp}
+ * SedMockBackend backend;
+ * SedTaskExecutor executor;
+ * executor.addBackend(&backend);
+ *
+ * std::vector<const SedTask*> tasks;
+ * SedTaskExecutor::findTasks(*doc, outputs, tasks);
+ * if (executor.execute(tasks, listener) != LIBSEDML_OPERATION_SUCCESS)
+ *   cerr << executor.getErrorMessage() << endl;
+ * @endcode
+ *
+ * The threads are created by each call to execute().  When libSEDML is
+ * built without thread support (WITH_THREADS), the runs are executed on
+ * the calling thread.
+ */
+
+#ifndef SedTaskExecutor_h
+#define SedTaskExecutor_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+#include <sedml/SedSimulationBackend.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedBase;
+class SedDocument;
+
+
+/**
+ * @class SedExecutionListener
+ * @ingroup Core
+ * @brief Receives the results of the runs of a SedTaskExecutor.
+ *
+ * The functions of a listener are called by the threads of the executor,
+ * one call at a time, in no particular order; SedSimulationRun::getIndex()
+ * tells where a run stands among the runs of its task.  The run and the
+ * result are only valid during the call.
+ */
+class LIBSEDML_EXTERN SedExecutionListener
+{
+public:
+
+  /**
+   * Destructor method.
+   */
+  virtual ~SedExecutionListener();
+
+
+  /**
+   * Receives the result of a run.
+   *
+   * @param run the run.
+   * @param result the values of the variables of the run.
+   */
+  virtual void runFinished(const SedSimulationRun& run,
+                           const SedSimulationResult& result) = 0;
+
+
+  /**
+   * Is told that a run failed.  The default does nothing.
+   *
+   * @param run the run.
+   * @param message the reason it failed.
+   */
+  virtual void runFailed(const SedSimulationRun& run,
+                         const std::string& message);
+};
+
+
+class LIBSEDML_EXTERN SedTaskExecutor
+{
+public:
+
+  /**
+   * Creates a new SedTaskExecutor, without backends.
+   *
+   * @param numThreads the number of threads to use; @c 0 uses as many
+   * threads as the hardware runs concurrently.
+   */
+  SedTaskExecutor(unsigned int numThreads = 0);
+
+
+  /**
+   * Destructor for SedTaskExecutor.
+   */
+  ~SedTaskExecutor();
+
+
+  /**
+   * Sets the number of threads used to run the simulations.
+   *
+   * @param numThreads the number of threads; @c 0 uses as many threads as
+   * the hardware runs concurrently.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if more than one thread is requested and libSEDML was built without
+   * thread support.
+   */
+  int setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads used to run the simulations.
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Adds a backend, after those added before.
+   *
+   * @param backend the backend, which is not owned by this executor and
+   * must outlive it.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if @p backend is @c NULL.
+   */
+  int addBackend(const SedSimulationBackend* backend);
+
+
+  /**
+   * @return the number of backends of this executor.
+   */
+  unsigned int getNumBackends() const;
+
+
+  /**
+   * @param language the language of a model.
+   * @param kisaoID the algorithm of a simulation.
+   *
+   * @return the first backend supporting the given language and
+   * algorithm, or @c NULL if there is none.
+   */
+  const SedSimulationBackend* findBackend(const std::string& language,
+                                          const std::string& kisaoID) const;
+
+
+  /**
+   * Runs the simulations of the given tasks, and passes their results to
+   * @p listener.
+   *
+   * @param tasks the tasks, which must be in a document.
+   * @param listener the listener receiving the results.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a task is not in a document, references an element that does not
+   * exist, or has no backend; nothing is run then.
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math of a repeated task cannot be compiled, or a repeated task
+   * is one of its own subtasks, in which case nothing is run; or if some
+   * runs failed.  See getErrorMessage().
+   */
+  int execute(const std::vector<const SedTask*>& tasks,
+              SedExecutionListener& listener);
+
+
+  /**
+   * @return the reason the last call to execute() failed, or an empty
+   * string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+  /**
+   * Finds the tasks needed by some outputs: the tasks referenced by the
+   * variables of their data generators, in the order of
+   * SedDependencyGraph::schedule().
+   *
+   * @param doc the document.
+   * @param outputs the outputs, or other elements of the document.
+   * @param tasks the tasks found.
+   *
+   * @return integer value indicating success/failure of the
+   * function, as SedDependencyGraph::schedule().
+   */
+  static int findTasks(const SedDocument& doc,
+                       const std::vector<const SedBase*>& outputs,
+                       std::vector<const SedTask*>& tasks);
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  SedTaskExecutor(const SedTaskExecutor&);
+  SedTaskExecutor& operator=(const SedTaskExecutor&);
+
+  std::vector<const SedSimulationBackend*>  mBackends;
+  unsigned int                              mNumThreads;
+  std::string                               mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * The function receiving the results of the runs of
+ * SedTaskExecutor_execute(), with the context given to it.
+ */
+typedef void (*SedRunFinishedFunc)(const SedSimulationRun_t *run,
+                                   const SedSimulationResult_t *result,
+                                   void *context);
+
+/**
+ * Creates a new SedTaskExecutor using the given number of threads, @c 0
+ * for as many as the hardware runs concurrently.
+ */
+LIBSEDML_EXTERN
+SedTaskExecutor_t *
+SedTaskExecutor_create(unsigned int numThreads);
+
+/**
+ * Frees the given SedTaskExecutor.
+ */
+LIBSEDML_EXTERN
+void
+SedTaskExecutor_free(SedTaskExecutor_t *executor);
+
+/**
+ * Adds a backend to the given SedTaskExecutor.
+ */
+LIBSEDML_EXTERN
+int
+SedTaskExecutor_addBackend(SedTaskExecutor_t *executor,
+                           const SedSimulationBackend_t *backend);
+
+/**
+ * Runs the simulations of the given tasks with the given SedTaskExecutor,
+ * and calls @p finished with the result of each run.
+ */
+LIBSEDML_EXTERN
+int
+SedTaskExecutor_execute(SedTaskExecutor_t *executor,
+                        const SedTask_t **tasks, unsigned int numTasks,
+                        SedRunFinishedFunc finished, void *context);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedTaskExecutor_h */
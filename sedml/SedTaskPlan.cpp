@@ -0,0 +1,945 @@
+/**
+ * @file    SedTaskPlan.cpp
+ * @brief   Implementation of SedTaskPlan
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedTaskPlan.h>
+#include <sedml/SedDocument.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedRangeValues.h>
+#include <sedml/SedRepeatedTask.h>
+#include <sedml/SedUniformTimeCourse.h>
+#include <sedml/common/operationReturnValues.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <new>
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * A repeated task of a plan: the values of its ranges, the programs of its
+ * task changes, its subtasks in order, and the work of all its iterations.
+ */
+class SedTaskPlanLevel
+{
+public:
+
+  /*
+   * A subtask: a task to run, or the index of the level of a repeated
+   * task.
+   */
+  struct Child
+  {
+    const SedTask* task;
+    int            level;
+  };
+
+  SedTaskPlanLevel()
+    : task(NULL)
+    , size(0)
+    , depth(1)
+    , numRuns(0)
+    , numIterations(0)
+    , numPoints(0)
+  {
+  }
+
+  ~SedTaskPlanLevel()
+  {
+    for (size_t n = 0; n < ranges.size(); ++n)
+      {
+        delete ranges[n];
+      }
+  }
+
+  const SedRepeatedTask*        task;
+  unsigned int                  size;
+  unsigned int                  depth;
+  std::vector<SedRangeValues*>  ranges;
+  std::vector<SedMathProgram>   changes;
+  std::vector<Child>            children;
+  double                        numRuns;
+  double                        numIterations;
+  double                        numPoints;
+};
+
+
+/*
+ * Orders subtasks by their order, those without one last, keeping the
+ * order of the document otherwise.
+ */
+static bool
+precedes(const SedSubTask* a, const SedSubTask* b)
+{
+  if (!b->isSetOrder()) return a->isSetOrder();
+  return a->isSetOrder() && a->getOrder() < b->getOrder();
+}
+
+
+/*
+ * @return the document containing the given object, even if the object
+ * has not been connected to it yet.
+ */
+static const SedDocument*
+findDocument(const SedBase* object)
+{
+  while (object != NULL && object->getTypeCode() != SEDML_DOCUMENT)
+    {
+      object = object->getParentSedObject();
+    }
+
+  return static_cast<const SedDocument*>(object);
+}
+
+
+/*
+ * @return the number of output points of a run of the given task.
+ */
+static double
+countPoints(const SedTask& task, const SedDocument* doc)
+{
+  const SedSimulation* simulation = (doc != NULL)
+    ? doc->getSimulation(task.getSimulationReference()) : NULL;
+
+  if (simulation != NULL
+      && simulation->getTypeCode() == SEDML_SIMULATION_UNIFORMTIMECOURSE)
+    {
+      int numberOfPoints = static_cast<const SedUniformTimeCourse*>(simulation)
+                             ->getNumberOfPoints();
+
+      if (numberOfPoints >= 0 && numberOfPoints != SEDML_INT_MAX)
+        return numberOfPoints + 1.0;
+    }
+
+  return 1.0;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new, empty, SedTaskPlan.
+ */
+SedTaskPlan::SedTaskPlan()
+  : mTask(NULL)
+  , mRoot(-1)
+  , mMaxDepth(0)
+  , mNumRuns(0)
+  , mNumIterations(0)
+  , mNumPoints(0)
+{
+}
+
+
+/*
+ * Destructor for SedTaskPlan.
+ */
+SedTaskPlan::~SedTaskPlan()
+{
+  clear();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Forgets the plan.
+ */
+void
+SedTaskPlan::clear()
+{
+  for (size_t n = 0; n < mLevels.size(); ++n)
+    {
+      delete mLevels[n];
+    }
+
+  mLevels.clear();
+  mTask = NULL;
+  mRoot = -1;
+  mMaxDepth = 0;
+  mNumRuns = 0;
+  mNumIterations = 0;
+  mNumPoints = 0;
+  mErrorMessage.clear();
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Compiles the plan of the given task.
+ */
+int
+SedTaskPlan::compile(const SedTask& task)
+{
+  clear();
+
+  if (task.getTypeCode() != SEDML_TASK_REPEATEDTASK)
+    {
+      mTask = &task;
+      mNumRuns = 1;
+      mNumPoints = countPoints(task, findDocument(&task));
+      return LIBSEDML_OPERATION_SUCCESS;
+    }
+
+  std::vector<const SedTask*> path;
+  int index = -1;
+  int result = compileLevel(static_cast<const SedRepeatedTask&>(task), path,
+                            index);
+
+  if (result != LIBSEDML_OPERATION_SUCCESS)
+    {
+      std::string message;
+      message.swap(mErrorMessage);
+      clear();
+      mErrorMessage.swap(message);
+      return result;
+    }
+
+  const SedTaskPlanLevel* root = mLevels[index];
+
+  mTask = &task;
+  mRoot = index;
+  mMaxDepth = root->depth;
+  mNumRuns = root->numRuns;
+  mNumIterations = root->numIterations;
+  mNumPoints = root->numPoints;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Compiles the level of the given repeated task, or finds it if it has been
+ * compiled already; path holds the repeated tasks it is nested in.
+ */
+int
+SedTaskPlan::compileLevel(const SedRepeatedTask& task,
+                          std::vector<const SedTask*>& path, int& index)
+{
+  if (std::find(path.begin(), path.end(), &task) != path.end())
+    {
+      mErrorMessage = "repeated task '" + task.getId()
+                      + "' is one of its own subtasks";
+      return LIBSEDML_OPERATION_FAILED;
+    }
+
+  for (size_t n = 0; n < mLevels.size(); ++n)
+    {
+      if (mLevels[n]->task == &task)
+        {
+          index = (int)n;
+          return LIBSEDML_OPERATION_SUCCESS;
+        }
+    }
+
+  const SedDocument* doc = findDocument(&task);
+
+  if (doc == NULL)
+    {
+      mErrorMessage = "repeated task '" + task.getId()
+                      + "' is not in a document";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  SedTaskPlanLevel* level = new SedTaskPlanLevel();
+  level->task = &task;
+  index = (int)mLevels.size();
+  mLevels.push_back(level);
+
+  // the ranges, which advance together with the main one
+  const SedRange* main = task.getRange(task.getRangeId());
+
+  if (main == NULL)
+    {
+      mErrorMessage = "repeated task '" + task.getId() + "' has no range '"
+                      + task.getRangeId() + "'";
+      return LIBSEDML_INVALID_OBJECT;
+    }
+
+  std::vector<std::string> rangeIds;
+
+  for (unsigned int n = 0; n < task.getNumRanges(); ++n)
+    {
+      const SedRange* range = task.getRange(n);
+      SedRangeValues* values = new SedRangeValues();
+      level->ranges.push_back(values);
+      rangeIds.push_back(range->getId());
+
+      int result = values->setRange(*range);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        {
+          mErrorMessage = "range '" + range->getId() + "': "
+                          + values->getErrorMessage();
+          return result;
+        }
+
+      if (range == main)
+        level->size = values->getSize();
+    }
+
+  for (size_t n = 0; n < level->ranges.size(); ++n)
+    {
+      if (level->ranges[n]->getSize() < level->size)
+        {
+          mErrorMessage = "range '" + rangeIds[n]
+                          + "' is shorter than the range of repeated task '"
+                          + task.getId() + "'";
+          return LIBSEDML_INVALID_OBJECT;
+        }
+    }
+
+  // the task changes, whose inputs are the ranges then the variables
+  level->changes.resize(task.getNumTaskChanges());
+
+  for (unsigned int n = 0; n < task.getNumTaskChanges(); ++n)
+    {
+      const SedSetValue* change = task.getTaskChange(n);
+      std::vector<std::string> inputIds(rangeIds);
+      std::map<std::string, double> constants;
+
+      for (unsigned int v = 0; v < change->getNumVariables(); ++v)
+        {
+          inputIds.push_back(change->getVariable(v)->getId());
+        }
+
+      for (unsigned int p = 0; p < change->getNumParameters(); ++p)
+        {
+          const SedParameter* parameter = change->getParameter(p);
+
+          if (parameter->isSetValue())
+            constants[parameter->getId()] = parameter->getValue();
+        }
+
+      int result = level->changes[n].compile(change->getMath(), inputIds,
+                                             constants);
+
+      if (result != LIBSEDML_OPERATION_SUCCESS)
+        {
+          mErrorMessage = "change of '" + change->getTarget() + "': "
+                          + level->changes[n].getErrorMessage();
+          return result;
+        }
+    }
+
+  // the subtasks, in order
+  std::vector<const SedSubTask*> subTasks;
+
+  for (unsigned int n = 0; n < task.getNumSubTasks(); ++n)
+    {
+      subTasks.push_back(task.getSubTask(n));
+    }
+
+  std::stable_sort(subTasks.begin(), subTasks.end(), precedes);
+
+  double numRuns = 0;
+  double numIterations = 0;
+  double numPoints = 0;
+
+  path.push_back(&task);
+
+  for (size_t n = 0; n < subTasks.size(); ++n)
+    {
+      const SedTask* child = doc->getTask(subTasks[n]->getTask());
+
+      if (child == NULL)
+        {
+          mErrorMessage = "repeated task '" + task.getId() + "' has no task '"
+                          + subTasks[n]->getTask() + "'";
+          return LIBSEDML_INVALID_OBJECT;
+        }
+
+      SedTaskPlanLevel::Child entry;
+      entry.task = NULL;
+      entry.level = -1;
+
+      if (child->getTypeCode() == SEDML_TASK_REPEATEDTASK)
+        {
+          int result = compileLevel(static_cast<const SedRepeatedTask&>(*child),
+                                    path, entry.level);
+
+          if (result != LIBSEDML_OPERATION_SUCCESS) return result;
+
+          const SedTaskPlanLevel* nested = mLevels[entry.level];
+          numRuns += nested->numRuns;
+          numIterations += nested->numIterations;
+          numPoints += nested->numPoints;
+          level->depth = std::max(level->depth, nested->depth + 1);
+        }
+      else
+        {
+          entry.task = child;
+          numRuns += 1;
+          numPoints += countPoints(*child, doc);
+        }
+
+      level->children.push_back(entry);
+    }
+
+  path.pop_back();
+
+  level->numRuns = level->size * numRuns;
+  level->numIterations = level->size * (1 + numIterations);
+  level->numPoints = level->size * numPoints;
+
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * @return true if this plan has been compiled successfully.
+ */
+bool
+SedTaskPlan::isCompiled() const
+{
+  return mTask != NULL;
+}
+
+
+/*
+ * @return the task of this plan.
+ */
+const SedTask*
+SedTaskPlan::getTask() const
+{
+  return mTask;
+}
+
+
+/*
+ * @return the reason the last compilation failed.
+ */
+const std::string&
+SedTaskPlan::getErrorMessage() const
+{
+  return mErrorMessage;
+}
+
+
+/*
+ * @return the depth of the deepest run.
+ */
+unsigned int
+SedTaskPlan::getMaxDepth() const
+{
+  return mMaxDepth;
+}
+
+
+/*
+ * @return the number of iterations of the task of the plan.
+ */
+unsigned int
+SedTaskPlan::getNumOuterIterations() const
+{
+  if (mTask == NULL) return 0;
+
+  return (mRoot < 0) ? 1 : mLevels[mRoot]->size;
+}
+
+
+/*
+ * @return the total number of simulation runs of the task.
+ */
+double
+SedTaskPlan::getNumRuns() const
+{
+  return mNumRuns;
+}
+
+
+/*
+ * @return the total number of iterations of the repeated tasks.
+ */
+double
+SedTaskPlan::getNumIterations() const
+{
+  return mNumIterations;
+}
+
+
+/*
+ * @return the total number of output points of the simulation runs.
+ */
+double
+SedTaskPlan::getNumPoints() const
+{
+  return mNumPoints;
+}
+
+
+/*
+ * Gets the shape of the results of the runs of the task.
+ */
+void
+SedTaskPlan::getShape(std::vector<unsigned int>& shape) const
+{
+  shape.clear();
+
+  if (mTask == NULL) return;
+
+  const SedDocument* doc = findDocument(mTask);
+  shape.assign(mMaxDepth + 1, 0);
+
+  if (mRoot < 0)
+    shape[0] = (unsigned int)countPoints(*mTask, doc);
+  else
+    collectShape(mRoot, 0, doc, shape);
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Extends the shape with the iterations of the given level, at the given
+ * depth, and with the points of the runs of its subtasks.
+ */
+void
+SedTaskPlan::collectShape(int index, unsigned int depth,
+                          const SedDocument* doc,
+                          std::vector<unsigned int>& shape) const
+{
+  const SedTaskPlanLevel* level = mLevels[index];
+  shape[depth] = std::max(shape[depth], level->size);
+
+  for (size_t n = 0; n < level->children.size(); ++n)
+    {
+      const SedTaskPlanLevel::Child& child = level->children[n];
+
+      if (child.level >= 0)
+        collectShape(child.level, depth + 1, doc, shape);
+      else
+        shape[mMaxDepth] = std::max(shape[mMaxDepth],
+                                    (unsigned int)countPoints(*child.task, doc));
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedTaskPlanStep, before the first run of the given plan.
+ */
+SedTaskPlanStep::SedTaskPlanStep(const SedTaskPlan& plan)
+  : mPlan(&plan)
+  , mFirstIteration(0)
+  , mEndIteration(numeric_limits<unsigned int>::max())
+  , mFrames(plan.getMaxDepth())
+  , mDepth(0)
+  , mFirstNew(0)
+  , mTask(NULL)
+  , mStarted(false)
+  , mDone(false)
+  , mUnknown(SEDML_MATH_BLOCK_SIZE, numeric_limits<double>::quiet_NaN())
+{
+}
+
+
+/*
+ * Creates a new SedTaskPlanStep, before the first run of some iterations
+ * of the task of the given plan.
+ */
+SedTaskPlanStep::SedTaskPlanStep(const SedTaskPlan& plan,
+                                 unsigned int firstIteration,
+                                 unsigned int numIterations)
+  : mPlan(&plan)
+  , mFirstIteration(firstIteration)
+  , mEndIteration(firstIteration +
+                  std::min(numIterations,
+                           numeric_limits<unsigned int>::max() - firstIteration))
+  , mFrames(plan.getMaxDepth())
+  , mDepth(0)
+  , mFirstNew(0)
+  , mTask(NULL)
+  , mStarted(false)
+  , mDone(false)
+  , mUnknown(SEDML_MATH_BLOCK_SIZE, numeric_limits<double>::quiet_NaN())
+{
+}
+
+
+/*
+ * Moves to the next simulation run.
+ */
+bool
+SedTaskPlanStep::next()
+{
+  if (mDone) return false;
+
+  if (!mStarted)
+    {
+      mStarted = true;
+
+      if (!mPlan->isCompiled()) return finish();
+
+      if (mFirstIteration >= mEndIteration) return finish();
+
+      if (mPlan->mRoot < 0)
+        {
+          if (mFirstIteration > 0) return finish();
+
+          mTask = mPlan->getTask();
+          return true;
+        }
+
+      if (!push(mPlan->mRoot)) return finish();
+
+      return settle();
+    }
+
+  mFirstNew = mDepth;
+
+  if (!advance()) return finish();
+
+  return settle();
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Enters the first iteration of the given level, unless it has no runs.
+ */
+bool
+SedTaskPlanStep::push(int level)
+{
+  const SedTaskPlanLevel* entered = mPlan->mLevels[level];
+
+  if (entered->numRuns == 0) return false;
+
+  Frame& frame = mFrames[mDepth];
+  frame.level = entered;
+  frame.iteration = 0;
+
+  // the outermost level walks the iterations of the step only
+  if (mDepth == 0)
+    {
+      if (mFirstIteration >= entered->size) return false;
+      frame.iteration = mFirstIteration;
+    }
+
+  frame.child = 0;
+  loadChunk(frame);
+
+  if (mFirstNew > mDepth) mFirstNew = mDepth;
+
+  ++mDepth;
+  return true;
+}
+
+
+/*
+ * Moves to the next subtask of the innermost iteration, to the next
+ * iteration, or out of the finished levels.
+ */
+bool
+SedTaskPlanStep::advance()
+{
+  while (mDepth > 0)
+    {
+      Frame& frame = mFrames[mDepth - 1];
+
+      if (++frame.child < frame.level->children.size()) return true;
+
+      if (++frame.iteration < frame.level->size &&
+          (mDepth > 1 || frame.iteration < mEndIteration))
+        {
+          frame.child = 0;
+
+          if (frame.iteration >= frame.chunkStart + frame.chunkSize)
+            loadChunk(frame);
+
+          if (mFirstNew > mDepth - 1) mFirstNew = mDepth - 1;
+
+          return true;
+        }
+
+      --mDepth;
+    }
+
+  return false;
+}
+
+
+/*
+ * Descends from the current subtask to the next task to run.
+ */
+bool
+SedTaskPlanStep::settle()
+{
+  for (;;)
+    {
+      const Frame& frame = mFrames[mDepth - 1];
+      const SedTaskPlanLevel::Child& child =
+        frame.level->children[frame.child];
+
+      if (child.task != NULL)
+        {
+          mTask = child.task;
+          if (mFirstNew > mDepth) mFirstNew = mDepth;
+          return true;
+        }
+
+      if (push(child.level)) continue;
+
+      if (!advance()) return finish();
+    }
+}
+
+
+/*
+ * Ends the walk.
+ */
+bool
+SedTaskPlanStep::finish()
+{
+  mDepth = 0;
+  mFirstNew = 0;
+  mTask = NULL;
+  mDone = true;
+  return false;
+}
+
+
+/*
+ * Computes the values of the ranges and changes of the chunk of iterations
+ * starting with the current one.
+ */
+void
+SedTaskPlanStep::loadChunk(Frame& frame)
+{
+  const SedTaskPlanLevel& level = *frame.level;
+  unsigned int numRanges = (unsigned int)level.ranges.size();
+  unsigned int numChanges = (unsigned int)level.changes.size();
+
+  frame.chunkStart = frame.iteration;
+  frame.chunkSize = std::min(level.size - frame.iteration,
+                             (unsigned int)SEDML_MATH_BLOCK_SIZE);
+  frame.ranges.resize(numRanges);
+  frame.values.resize((numRanges + numChanges) * SEDML_MATH_BLOCK_SIZE);
+
+  for (unsigned int n = 0; n < numRanges; ++n)
+    {
+      frame.ranges[n] = level.ranges[n]->getValues(frame.chunkStart,
+        frame.chunkSize, &frame.values[n * SEDML_MATH_BLOCK_SIZE]);
+    }
+
+  // the variables of the changes are unknown
+  std::vector<const double*> inputs(frame.ranges);
+
+  for (unsigned int n = 0; n < numChanges; ++n)
+    {
+      const SedMathProgram& program = level.changes[n];
+      inputs.resize(program.getNumInputs() + 1, &mUnknown[0]);
+
+      program.evaluate(&inputs[0], frame.chunkSize,
+        &frame.values[(numRanges + n) * SEDML_MATH_BLOCK_SIZE]);
+    }
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * @return the task to run.
+ */
+const SedTask*
+SedTaskPlanStep::getTask() const
+{
+  return mTask;
+}
+
+
+/*
+ * @return the number of repeated tasks the run is nested in.
+ */
+unsigned int
+SedTaskPlanStep::getDepth() const
+{
+  return mDepth;
+}
+
+
+/*
+ * @return the depth of the outermost repeated task whose iteration started
+ * with this run.
+ */
+unsigned int
+SedTaskPlanStep::getFirstNewIteration() const
+{
+  return mFirstNew;
+}
+
+
+/*
+ * @return the repeated task at the given depth.
+ */
+const SedRepeatedTask*
+SedTaskPlanStep::getRepeatedTask(unsigned int depth) const
+{
+  return (depth < mDepth) ? mFrames[depth].level->task : NULL;
+}
+
+
+/*
+ * @return the iteration of the repeated task at the given depth.
+ */
+unsigned int
+SedTaskPlanStep::getIteration(unsigned int depth) const
+{
+  return (depth < mDepth) ? mFrames[depth].iteration : 0;
+}
+
+
+/*
+ * @return the value of the nth range of the repeated task at the given
+ * depth.
+ */
+double
+SedTaskPlanStep::getRangeValue(unsigned int depth, unsigned int n) const
+{
+  if (depth >= mDepth || n >= mFrames[depth].ranges.size())
+    return numeric_limits<double>::quiet_NaN();
+
+  const Frame& frame = mFrames[depth];
+  return frame.ranges[n][frame.iteration - frame.chunkStart];
+}
+
+
+/*
+ * @return the value of the nth task change of the repeated task at the
+ * given depth.
+ */
+double
+SedTaskPlanStep::getChangeValue(unsigned int depth, unsigned int n) const
+{
+  if (depth >= mDepth || n >= mFrames[depth].level->changes.size())
+    return numeric_limits<double>::quiet_NaN();
+
+  const Frame& frame = mFrames[depth];
+  size_t offset = (frame.ranges.size() + n) * SEDML_MATH_BLOCK_SIZE;
+  return frame.values[offset + frame.iteration - frame.chunkStart];
+}
+
+
+/** @cond doxygen-c-only */
+
+LIBSEDML_EXTERN
+SedTaskPlan_t *
+SedTaskPlan_create(void)
+{
+  return new(std::nothrow) SedTaskPlan();
+}
+
+
+LIBSEDML_EXTERN
+void
+SedTaskPlan_free(SedTaskPlan_t *plan)
+{
+  delete plan;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedTaskPlan_compile(SedTaskPlan_t *plan, const SedTask_t *task)
+{
+  if (plan == NULL || task == NULL) return LIBSEDML_INVALID_OBJECT;
+
+  return plan->compile(*task);
+}
+
+
+LIBSEDML_EXTERN
+double
+SedTaskPlan_getNumRuns(const SedTaskPlan_t *plan)
+{
+  return (plan != NULL) ? plan->getNumRuns() : 0;
+}
+
+
+LIBSEDML_EXTERN
+SedTaskPlanStep_t *
+SedTaskPlanStep_create(const SedTaskPlan_t *plan)
+{
+  if (plan == NULL) return NULL;
+
+  return new(std::nothrow) SedTaskPlanStep(*plan);
+}
+
+
+LIBSEDML_EXTERN
+void
+SedTaskPlanStep_free(SedTaskPlanStep_t *step)
+{
+  delete step;
+}
+
+
+LIBSEDML_EXTERN
+int
+SedTaskPlanStep_next(SedTaskPlanStep_t *step)
+{
+  return (step != NULL && step->next()) ? 1 : 0;
+}
+
+
+LIBSEDML_EXTERN
+const SedTask_t *
+SedTaskPlanStep_getTask(const SedTaskPlanStep_t *step)
+{
+  return (step != NULL) ? step->getTask() : NULL;
+}
+
+/** @endcond */
+
+LIBSEDML_CPP_NAMESPACE_END
@@ -0,0 +1,456 @@
+/**
+ * @file    SedTaskPlan.h
+ * @brief   Definition of SedTaskPlan
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedTaskPlan
+ * @ingroup Core
+ * @brief The runs of the simulations a task stands for, in order.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedRepeatedTask runs its subtasks once per value of its range, after
+ * resetting the model when @c resetModel is set, and after applying its
+ * task changes; its subtasks may themselves be repeated tasks.  A
+ * SedTaskPlan compiles such a task, once, into the information a
+ * simulation tool needs to run it:
+ *
+ * @li the subtasks of each repeated task, sorted by their @c order; the
+ * subtasks without an order come last, in the order of the document;
+ * @li the values of the ranges of each repeated task, see SedRangeValues;
+ * all the ranges of a repeated task advance together, and must have at
+ * least as many values as its main range;
+ * @li the math of the task changes, compiled with SedMathProgram; it may
+ * use the ids of the ranges of the repeated task, and the ids of its
+ * parameters and variables.  The variables, which come from the model
+ * being simulated, are unknown to the plan: the values of the changes with
+ * variables are NaN, and must be computed by the simulation tool;
+ * @li the total number of simulation runs, of iterations of repeated
+ * tasks, and of output points, as estimates of the work.
+ *
+ * The runs are not stored: a SedTaskPlanStep walks them one at a time, so
+ * nested sweeps of millions of runs take constant memory.  The values of
+ * the ranges and changes are computed in chunks of #SEDML_MATH_BLOCK_SIZE
+ * iterations.
+ * @code{.cpp}
+ * SedTaskPlan plan;
+ * if (plan.compile(*task) == LIBSEDML_OPERATION_SUCCESS)
+ *   {
+ *     SedTaskPlanStep step(plan);
+ *     while (step.next())
+ *       {
+ *         for (unsigned int d = step.getFirstNewIteration();
+ *              d < step.getDepth(); ++d)
+ *           {
+ *             const SedRepeatedTask* repeated = step.getRepeatedTask(d);
+ *             if (repeated->getResetModel())
+ *               // ... reset the models of repeated ...
+ *             for (unsigned int n = 0; n < repeated->getNumTaskChanges(); ++n)
+ *               // ... set the target of repeated->getTaskChange(n) to
+ *               //     step.getChangeValue(d, n) ...
+ *           }
+ *         // ... run the simulation of step.getTask() ...
+ *       }
+ *   }
+ * @endcode
+ *
+ * The task, and the objects it references, must outlive the plan and not
+ * be modified while it is used.  Several SedTaskPlanStep objects may walk
+ * the same plan at the same time, on different threads.
+ */
+
+#ifndef SedTaskPlan_h
+#define SedTaskPlan_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <string>
+#include <vector>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+class SedDocument;
+class SedRepeatedTask;
+class SedTask;
+class SedTaskPlanLevel;
+
+
+class LIBSEDML_EXTERN SedTaskPlan
+{
+public:
+
+  /**
+   * Creates a new, empty, SedTaskPlan.
+   */
+  SedTaskPlan();
+
+
+  /**
+   * Destructor for SedTaskPlan.
+   */
+  ~SedTaskPlan();
+
+
+  /**
+   * Compiles the plan of the given task.  A task that is not a repeated
+   * task is run once.
+   *
+   * @param task the task to compile.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+   * if a repeated task is not in a document, references a task or a range
+   * that does not exist, or has a range shorter than its main range; see
+   * getErrorMessage().
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if the math of a range or a task change cannot be compiled, or a
+   * repeated task is one of its own subtasks; see getErrorMessage().
+   */
+  int compile(const SedTask& task);
+
+
+  /**
+   * @return @c true if this plan has been compiled successfully.
+   */
+  bool isCompiled() const;
+
+
+  /**
+   * @return the task of this plan, or @c NULL if it is not compiled.
+   */
+  const SedTask* getTask() const;
+
+
+  /**
+   * @return the reason the last compilation failed, or an empty string.
+   */
+  const std::string& getErrorMessage() const;
+
+
+  /**
+   * @return the number of nested repeated tasks, the task of the plan
+   * included, of the deepest run.
+   */
+  unsigned int getMaxDepth() const;
+
+
+  /**
+   * @return the number of iterations of the task of the plan, @c 1 if it is
+   * not a repeated task, or @c 0 if the plan is not compiled.
+   */
+  unsigned int getNumOuterIterations() const;
+
+
+  /**
+   * @return the total number of simulation runs of the task.
+   */
+  double getNumRuns() const;
+
+
+  /**
+   * @return the total number of iterations of the repeated tasks.
+   */
+  double getNumIterations() const;
+
+
+  /**
+   * @return the total number of output points of the simulation runs: the
+   * number of points of a uniform time course plus one, or one for the
+   * other simulations.
+   */
+  double getNumPoints() const;
+
+
+  /**
+   * Gets the shape of the results of the runs of the task, as stored by
+   * SedResultStore: the largest number of iterations of the repeated tasks
+   * at each depth, the task of the plan first, then the largest number of
+   * output points of a run.
+   *
+   * @param shape the vector receiving the getMaxDepth() + 1 extents, or
+   * none if the plan is not compiled.
+   */
+  void getShape(std::vector<unsigned int>& shape) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  friend class SedTaskPlanStep;
+
+  SedTaskPlan(const SedTaskPlan&);
+  SedTaskPlan& operator=(const SedTaskPlan&);
+
+  void clear();
+
+  int compileLevel(const SedRepeatedTask& task,
+                   std::vector<const SedTask*>& path, int& index);
+
+  void collectShape(int index, unsigned int depth, const SedDocument* doc,
+                    std::vector<unsigned int>& shape) const;
+
+  const SedTask*                  mTask;
+  int                             mRoot;
+  std::vector<SedTaskPlanLevel*>  mLevels;
+  unsigned int                    mMaxDepth;
+  double                          mNumRuns;
+  double                          mNumIterations;
+  double                          mNumPoints;
+  std::string                     mErrorMessage;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+/**
+ * @class SedTaskPlanStep
+ * @ingroup Core
+ * @brief A position in the runs of a SedTaskPlan.
+ *
+ * A SedTaskPlanStep walks the simulation runs of a SedTaskPlan in order.
+ * After each call to next(), it gives the task to run, the repeated tasks
+ * it is nested in, from the outermost one (at depth 0) to the innermost
+ * one, and the iteration of each of them.  The repeated tasks from depth
+ * getFirstNewIteration() on have just started an iteration: their models
+ * must be reset if requested, and their changes applied, before the task
+ * is run.
+ */
+class LIBSEDML_EXTERN SedTaskPlanStep
+{
+public:
+
+  /**
+   * Creates a new SedTaskPlanStep, before the first run of the given plan.
+   *
+   * @param plan the plan to walk, which must outlive the step.
+   */
+  explicit SedTaskPlanStep(const SedTaskPlan& plan);
+
+
+  /**
+   * Creates a new SedTaskPlanStep, before the first run of some iterations
+   * of the task of the given plan.  The walk is that of the whole plan,
+   * restricted to the runs of those iterations; it lets several threads
+   * share the runs of a repeated task.
+   *
+   * @param plan the plan to walk, which must outlive the step.
+   * @param firstIteration the first iteration to walk.
+   * @param numIterations the number of iterations to walk.
+   */
+  SedTaskPlanStep(const SedTaskPlan& plan, unsigned int firstIteration,
+                  unsigned int numIterations);
+
+
+  /**
+   * Moves to the next simulation run.
+   *
+   * @return @c true if there is a next run, @c false once all the runs
+   * have been walked or if the plan is not compiled.
+   */
+  bool next();
+
+
+  /**
+   * @return the task to run, which is not a repeated task, or @c NULL
+   * before the first run and after the last one.
+   */
+  const SedTask* getTask() const;
+
+
+  /**
+   * @return the number of repeated tasks the run is nested in.
+   */
+  unsigned int getDepth() const;
+
+
+  /**
+   * @return the depth of the outermost repeated task whose iteration
+   * started with this run; getDepth() if none did.
+   */
+  unsigned int getFirstNewIteration() const;
+
+
+  /**
+   * @return the repeated task at the given depth, or @c NULL.
+   */
+  const SedRepeatedTask* getRepeatedTask(unsigned int depth) const;
+
+
+  /**
+   * @return the iteration of the repeated task at the given depth.
+   */
+  unsigned int getIteration(unsigned int depth) const;
+
+
+  /**
+   * @return the value, in the current iteration, of the nth range of the
+   * repeated task at the given depth, or NaN.
+   */
+  double getRangeValue(unsigned int depth, unsigned int n) const;
+
+
+  /**
+   * @return the value, in the current iteration, of the nth task change of
+   * the repeated task at the given depth, or NaN.
+   */
+  double getChangeValue(unsigned int depth, unsigned int n) const;
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  /*
+   * The iteration of one of the repeated tasks the run is nested in, and
+   * the chunk of the values of its ranges and changes.
+   */
+  struct Frame
+  {
+    const SedTaskPlanLevel*   level;
+    unsigned int              iteration;
+    unsigned int              child;
+    unsigned int              chunkStart;
+    unsigned int              chunkSize;
+    std::vector<const double*> ranges;
+    std::vector<double>       values;
+  };
+
+  bool push(int level);
+
+  bool advance();
+
+  bool settle();
+
+  bool finish();
+
+  void loadChunk(Frame& frame);
+
+  const SedTaskPlan*    mPlan;
+  unsigned int          mFirstIteration;
+  unsigned int          mEndIteration;
+  std::vector<Frame>    mFrames;
+  unsigned int          mDepth;
+  unsigned int          mFirstNew;
+  const SedTask*        mTask;
+  bool                  mStarted;
+  bool                  mDone;
+  std::vector<double>   mUnknown;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+/**
+ * Creates a new, empty, SedTaskPlan.
+ */
+LIBSEDML_EXTERN
+SedTaskPlan_t *
+SedTaskPlan_create(void);
+
+/**
+ * Frees the given SedTaskPlan.
+ */
+LIBSEDML_EXTERN
+void
+SedTaskPlan_free(SedTaskPlan_t *plan);
+
+/**
+ * Compiles the plan of the given task into the given SedTaskPlan.
+ */
+LIBSEDML_EXTERN
+int
+SedTaskPlan_compile(SedTaskPlan_t *plan, const SedTask_t *task);
+
+/**
+ * Returns the total number of simulation runs of the given SedTaskPlan.
+ */
+LIBSEDML_EXTERN
+double
+SedTaskPlan_getNumRuns(const SedTaskPlan_t *plan);
+
+/**
+ * Creates a new SedTaskPlanStep, before the first run of the given plan.
+ */
+LIBSEDML_EXTERN
+SedTaskPlanStep_t *
+SedTaskPlanStep_create(const SedTaskPlan_t *plan);
+
+/**
+ * Frees the given SedTaskPlanStep.
+ */
+LIBSEDML_EXTERN
+void
+SedTaskPlanStep_free(SedTaskPlanStep_t *step);
+
+/**
+ * Moves the given SedTaskPlanStep to the next simulation run, and returns
+ * @c 1 if there is one, @c 0 otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedTaskPlanStep_next(SedTaskPlanStep_t *step);
+
+/**
+ * Returns the task to run at the given SedTaskPlanStep.
+ */
+LIBSEDML_EXTERN
+const SedTask_t *
+SedTaskPlanStep_getTask(const SedTaskPlanStep_t *step);
+
+END_C_DECLS
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+
+#endif  /* SedTaskPlan_h */
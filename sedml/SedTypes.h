@@ -76,10 +76,32 @@
 
 #include <sedml/SedBase.h>
 #include <sedml/SedListOf.h>
+#include <sedml/SedVisitor.h>
 
 
 #include <sedml/SedReader.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedJSONReader.h>
+#include <sedml/SedJSONWriter.h>
+#include <sedml/SedStatistics.h>
+#include <sedml/SedMemoryUsage.h>
+#include <sedml/SedIterator.h>
+#include <sedml/SedParallelTraversal.h>
+#include <sedml/SedDeferredConnect.h>
+#include <sedml/SedMathProgram.h>
+#include <sedml/SedRangeValues.h>
+#include <sedml/SedTaskPlan.h>
+#include <sedml/SedDependencyGraph.h>
+#include <sedml/SedWorkQueue.h>
+#include <sedml/SedSimulationBackend.h>
+#include <sedml/SedMockBackend.h>
+#include <sedml/SedOdeSolver.h>
+#include <sedml/SedSbmlBackend.h>
+#include <sedml/SedTaskExecutor.h>
+#include <sedml/SedResampler.h>
+#include <sedml/SedResultStore.h>
+#include <sedml/SedReportWriter.h>
+#include <sedml/SedDocumentSnapshot.h>
 
 #include <sbml/xml/XMLError.h>
 #include <sbml/math/ASTNode.h>
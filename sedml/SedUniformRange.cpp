@@ -36,6 +36,7 @@
 
 #include <sedml/SedUniformRange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -225,6 +226,8 @@ SedUniformRange::isSetType() const
 int
 SedUniformRange::setStart(double start)
 {
+  markDirty();
+
   mStart = start;
   mIsSetStart = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -237,6 +240,8 @@ SedUniformRange::setStart(double start)
 int
 SedUniformRange::setEnd(double end)
 {
+  markDirty();
+
   mEnd = end;
   mIsSetEnd = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -249,6 +254,8 @@ SedUniformRange::setEnd(double end)
 int
 SedUniformRange::setNumberOfPoints(int numberOfPoints)
 {
+  markDirty();
+
   mNumberOfPoints = numberOfPoints;
   mIsSetNumberOfPoints = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -261,6 +268,8 @@ SedUniformRange::setNumberOfPoints(int numberOfPoints)
 int
 SedUniformRange::setType(const std::string& type)
 {
+  markDirty();
+
   {
     mType = type;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -274,6 +283,8 @@ SedUniformRange::setType(const std::string& type)
 int
 SedUniformRange::unsetStart()
 {
+  markDirty();
+
   mStart = numeric_limits<double>::quiet_NaN();
   mIsSetStart = false;
 
@@ -294,6 +305,8 @@ SedUniformRange::unsetStart()
 int
 SedUniformRange::unsetEnd()
 {
+  markDirty();
+
   mEnd = numeric_limits<double>::quiet_NaN();
   mIsSetEnd = false;
 
@@ -314,6 +327,8 @@ SedUniformRange::unsetEnd()
 int
 SedUniformRange::unsetNumberOfPoints()
 {
+  markDirty();
+
   mNumberOfPoints = SEDML_INT_MAX;
   mIsSetNumberOfPoints = false;
 
@@ -334,6 +349,8 @@ SedUniformRange::unsetNumberOfPoints()
 int
 SedUniformRange::unsetType()
 {
+  markDirty();
+
   mType.erase();
 
   if (mType.empty() == true)
@@ -429,8 +446,27 @@ SedUniformRange::writeElements(XMLOutputStream& stream) const
 bool
 SedUniformRange::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
 
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedUniformRange::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedRange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedUniformRange));
+  usage.addString(mType);
 }
 
 
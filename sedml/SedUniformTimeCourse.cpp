@@ -36,6 +36,7 @@
 
 #include <sedml/SedUniformTimeCourse.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -229,6 +230,8 @@ SedUniformTimeCourse::isSetNumberOfPoints() const
 int
 SedUniformTimeCourse::setInitialTime(double initialTime)
 {
+  markDirty();
+
   mInitialTime = initialTime;
   mIsSetInitialTime = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -241,6 +244,8 @@ SedUniformTimeCourse::setInitialTime(double initialTime)
 int
 SedUniformTimeCourse::setOutputStartTime(double outputStartTime)
 {
+  markDirty();
+
   mOutputStartTime = outputStartTime;
   mIsSetOutputStartTime = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -253,6 +258,8 @@ SedUniformTimeCourse::setOutputStartTime(double outputStartTime)
 int
 SedUniformTimeCourse::setOutputEndTime(double outputEndTime)
 {
+  markDirty();
+
   mOutputEndTime = outputEndTime;
   mIsSetOutputEndTime = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -265,6 +272,8 @@ SedUniformTimeCourse::setOutputEndTime(double outputEndTime)
 int
 SedUniformTimeCourse::setNumberOfPoints(int numberOfPoints)
 {
+  markDirty();
+
   mNumberOfPoints = numberOfPoints;
   mIsSetNumberOfPoints = true;
   return LIBSEDML_OPERATION_SUCCESS;
@@ -277,6 +286,8 @@ SedUniformTimeCourse::setNumberOfPoints(int numberOfPoints)
 int
 SedUniformTimeCourse::unsetInitialTime()
 {
+  markDirty();
+
   mInitialTime = numeric_limits<double>::quiet_NaN();
   mIsSetInitialTime = false;
 
@@ -297,6 +308,8 @@ SedUniformTimeCourse::unsetInitialTime()
 int
 SedUniformTimeCourse::unsetOutputStartTime()
 {
+  markDirty();
+
   mOutputStartTime = numeric_limits<double>::quiet_NaN();
   mIsSetOutputStartTime = false;
 
@@ -317,6 +330,8 @@ SedUniformTimeCourse::unsetOutputStartTime()
 int
 SedUniformTimeCourse::unsetOutputEndTime()
 {
+  markDirty();
+
   mOutputEndTime = numeric_limits<double>::quiet_NaN();
   mIsSetOutputEndTime = false;
 
@@ -337,6 +352,8 @@ SedUniformTimeCourse::unsetOutputEndTime()
 int
 SedUniformTimeCourse::unsetNumberOfPoints()
 {
+  markDirty();
+
   mNumberOfPoints = SEDML_INT_MAX;
   mIsSetNumberOfPoints = false;
 
@@ -433,8 +450,31 @@ SedUniformTimeCourse::writeElements(XMLOutputStream& stream) const
 bool
 SedUniformTimeCourse::accept(SedVisitor& v) const
 {
-  return false;
+  if (v.visit(*this))
+    {
+      if (mAlgorithm != NULL)
+        mAlgorithm->accept(v);
+    }
+
+  v.leave(*this);
 
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedUniformTimeCourse::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedSimulation::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedUniformTimeCourse));
 }
 
 
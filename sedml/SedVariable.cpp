@@ -36,6 +36,7 @@
 
 #include <sedml/SedVariable.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -261,7 +262,12 @@ SedVariable::isSetModelReference() const
 int
 SedVariable::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+
+  if (result == LIBSEDML_OPERATION_SUCCESS)
+    markDirty();
+
+  return result;
 }
 
 
@@ -271,6 +277,8 @@ SedVariable::setId(const std::string& id)
 int
 SedVariable::setName(const std::string& name)
 {
+  markDirty();
+
   {
     mName = name;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -284,6 +292,8 @@ SedVariable::setName(const std::string& name)
 int
 SedVariable::setSymbol(const std::string& symbol)
 {
+  markDirty();
+
   {
     mSymbol = symbol;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -297,6 +307,8 @@ SedVariable::setSymbol(const std::string& symbol)
 int
 SedVariable::setTarget(const std::string& target)
 {
+  markDirty();
+
   {
     mTarget = target;
     return LIBSEDML_OPERATION_SUCCESS;
@@ -316,6 +328,7 @@ SedVariable::setTaskReference(const std::string& taskReference)
     }
   else
     {
+      markDirty();
       mTaskReference = taskReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -334,6 +347,7 @@ SedVariable::setModelReference(const std::string& modelReference)
     }
   else
     {
+      markDirty();
       mModelReference = modelReference;
       return LIBSEDML_OPERATION_SUCCESS;
     }
@@ -346,6 +360,8 @@ SedVariable::setModelReference(const std::string& modelReference)
 int
 SedVariable::unsetId()
 {
+  markDirty();
+
   mId.erase();
 
   if (mId.empty() == true)
@@ -365,6 +381,8 @@ SedVariable::unsetId()
 int
 SedVariable::unsetName()
 {
+  markDirty();
+
   mName.erase();
 
   if (mName.empty() == true)
@@ -384,6 +402,8 @@ SedVariable::unsetName()
 int
 SedVariable::unsetSymbol()
 {
+  markDirty();
+
   mSymbol.erase();
 
   if (mSymbol.empty() == true)
@@ -403,6 +423,8 @@ SedVariable::unsetSymbol()
 int
 SedVariable::unsetTarget()
 {
+  markDirty();
+
   mTarget.erase();
 
   if (mTarget.empty() == true)
@@ -422,6 +444,8 @@ SedVariable::unsetTarget()
 int
 SedVariable::unsetTaskReference()
 {
+  markDirty();
+
   mTaskReference.erase();
 
   if (mTaskReference.empty() == true)
@@ -441,6 +465,8 @@ SedVariable::unsetTaskReference()
 int
 SedVariable::unsetModelReference()
 {
+  markDirty();
+
   mModelReference.erase();
 
   if (mModelReference.empty() == true)
@@ -513,8 +539,32 @@ SedVariable::writeElements(XMLOutputStream& stream) const
 bool
 SedVariable::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
 
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedVariable::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedBase::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedVariable));
+  usage.addString(mId);
+  usage.addString(mName);
+  usage.addString(mSymbol);
+  usage.addString(mTarget);
+  usage.addString(mTaskReference);
+  usage.addString(mModelReference);
 }
 
 
@@ -864,6 +914,7 @@ SedListOfVariables::remove(const std::string& sid)
     {
       item = *result;
       mItems.erase(result);
+      markDirty();
     }
 
   return static_cast <SedVariable*>(item);
@@ -36,6 +36,7 @@
 
 #include <sedml/SedVectorRange.h>
 #include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 #include <sbml/xml/XMLInputStream.h>
 
 
@@ -177,6 +178,8 @@ SedVectorRange::getNumValues() const
 int
 SedVectorRange::setValues(const std::vector<double>& value)
 {
+  markDirty();
+
   mValues = value;
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -197,6 +200,8 @@ SedVectorRange::setValues(const std::vector<double>& value)
 int
 SedVectorRange::addValue(double value)
 {
+  markDirty();
+
   mValues.push_back(value);
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -215,6 +220,8 @@ SedVectorRange::addValue(double value)
 int
 SedVectorRange::clearValues()
 {
+  markDirty();
+
   mValues.clear();
   return LIBSEDML_OPERATION_SUCCESS;
 }
@@ -302,8 +309,27 @@ SedVectorRange::writeElements(XMLOutputStream& stream) const
 bool
 SedVectorRange::accept(SedVisitor& v) const
 {
-  return false;
+  v.visit(*this);
+  v.leave(*this);
+
+  return true;
+}
+
+
+/** @endcond doxygen-libsedml-internal */
 
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Adds the memory held by this object to the given SedMemoryUsage.
+ */
+void
+SedVectorRange::addMemoryUsage(SedMemoryUsage& usage) const
+{
+  SedRange::addMemoryUsage(usage);
+  usage.setObjectSize(sizeof(SedVectorRange));
+  usage.addListOverhead(mValues.capacity() * sizeof(double));
 }
 
 
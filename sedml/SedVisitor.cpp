@@ -60,18 +60,511 @@ SedVisitor::visit(const SedListOf& x, int type)
 }
 
 
+bool
+SedVisitor::enter(const SedDocument& x)
+{
+  visit(x);
+  return true;
+}
+
+
+bool
+SedVisitor::enter(const SedListOf& x, int type)
+{
+  visit(x, type);
+  return true;
+}
+
+
+bool
+SedVisitor::visit(const SedDataDescription& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedDataSource& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedSlice& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedModel& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedChange& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedChangeAttribute& x)
+{
+  return visit(static_cast<const SedChange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedAddXML& x)
+{
+  return visit(static_cast<const SedChange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedChangeXML& x)
+{
+  return visit(static_cast<const SedChange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedRemoveXML& x)
+{
+  return visit(static_cast<const SedChange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedComputeChange& x)
+{
+  return visit(static_cast<const SedChange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedSimulation& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedUniformTimeCourse& x)
+{
+  return visit(static_cast<const SedSimulation&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedOneStep& x)
+{
+  return visit(static_cast<const SedSimulation&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedSteadyState& x)
+{
+  return visit(static_cast<const SedSimulation&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedAlgorithm& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedAlgorithmParameter& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedTask& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedRepeatedTask& x)
+{
+  return visit(static_cast<const SedTask&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedSubTask& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedSetValue& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedRange& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedUniformRange& x)
+{
+  return visit(static_cast<const SedRange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedVectorRange& x)
+{
+  return visit(static_cast<const SedRange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedFunctionalRange& x)
+{
+  return visit(static_cast<const SedRange&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedDataGenerator& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedVariable& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedParameter& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedOutput& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedReport& x)
+{
+  return visit(static_cast<const SedOutput&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedPlot2D& x)
+{
+  return visit(static_cast<const SedOutput&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedPlot3D& x)
+{
+  return visit(static_cast<const SedOutput&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedDataSet& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedCurve& x)
+{
+  return visit(static_cast<const SedBase&>(x));
+}
+
+
+bool
+SedVisitor::visit(const SedSurface& x)
+{
+  return visit(static_cast<const SedCurve&>(x));
+}
+
+
 bool
 SedVisitor::visit(const SedBase& sb)
 {
-  return false;
+  return true;
 }
 
 
 void
 SedVisitor::leave(const SedDocument& x)
 {
+  leave(static_cast<const SedBase&>(x));
+}
+
+void
+SedVisitor::leave(const SedDataDescription& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedDataSource& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedSlice& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedModel& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedChange& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedChangeAttribute& x)
+{
+  leave(static_cast<const SedChange&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedAddXML& x)
+{
+  leave(static_cast<const SedChange&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedChangeXML& x)
+{
+  leave(static_cast<const SedChange&>(x));
 }
 
+
+void
+SedVisitor::leave(const SedRemoveXML& x)
+{
+  leave(static_cast<const SedChange&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedComputeChange& x)
+{
+  leave(static_cast<const SedChange&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedSimulation& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedUniformTimeCourse& x)
+{
+  leave(static_cast<const SedSimulation&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedOneStep& x)
+{
+  leave(static_cast<const SedSimulation&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedSteadyState& x)
+{
+  leave(static_cast<const SedSimulation&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedAlgorithm& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedAlgorithmParameter& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedTask& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedRepeatedTask& x)
+{
+  leave(static_cast<const SedTask&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedSubTask& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedSetValue& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedRange& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedUniformRange& x)
+{
+  leave(static_cast<const SedRange&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedVectorRange& x)
+{
+  leave(static_cast<const SedRange&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedFunctionalRange& x)
+{
+  leave(static_cast<const SedRange&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedDataGenerator& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedVariable& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedParameter& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedOutput& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedReport& x)
+{
+  leave(static_cast<const SedOutput&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedPlot2D& x)
+{
+  leave(static_cast<const SedOutput&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedPlot3D& x)
+{
+  leave(static_cast<const SedOutput&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedDataSet& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedCurve& x)
+{
+  leave(static_cast<const SedBase&>(x));
+}
+
+
+void
+SedVisitor::leave(const SedSurface& x)
+{
+  leave(static_cast<const SedCurve&>(x));
+}
+
+
 void
 SedVisitor::leave(const SedBase& x)
 {
@@ -81,6 +574,7 @@ SedVisitor::leave(const SedBase& x)
 void
 SedVisitor::leave(const SedListOf& x, int type)
 {
+  leave(static_cast<const SedBase&>(x));
 }
 
 LIBSEDML_CPP_NAMESPACE_END
@@ -53,6 +53,22 @@
  * <code>accept</code> that are used for invoking an object of class
  * SedVisitor.  An example of its use is in the Sed validation system,
  * which is internally implemented using this Visitor Pattern facility.
+ *
+ * Calling <code>doc->accept(visitor)</code> visits every object of a
+ * SedDocument in document order.  Each object is passed to the
+ * <code>visit</code> overload for its class; its children are then visited
+ * if that method returned @c true, and the object is finally passed to the
+ * matching <code>leave</code> overload.  Returning @c false from
+ * <code>visit</code> thus prunes the subtree below an object.  A
+ * SedDocument and its lists are passed to <code>enter</code> instead,
+ * which by default passes them on to their <code>visit</code> overloads
+ * and visits all of their children; a visitor overrides
+ * <code>enter</code> to prune the traversal there.  The default
+ * implementation of each overload forwards to the overload of the parent
+ * class (for instance SedUniformTimeCourse to SedSimulation), down to the
+ * SedBase overloads, which visit all children and do nothing on leaving.
+ * A visitor therefore only overrides the overloads for the classes it is
+ * interested in.  The traversal neither allocates memory nor uses RTTI.
  */
 
 #ifndef SedVisitor_h
@@ -74,6 +90,40 @@ class SedBase;
 
 class SedDocument;
 class SedListOf;
+class SedDataDescription;
+class SedDataSource;
+class SedSlice;
+class SedModel;
+class SedChange;
+class SedChangeAttribute;
+class SedAddXML;
+class SedChangeXML;
+class SedRemoveXML;
+class SedComputeChange;
+class SedSimulation;
+class SedUniformTimeCourse;
+class SedOneStep;
+class SedSteadyState;
+class SedAlgorithm;
+class SedAlgorithmParameter;
+class SedTask;
+class SedRepeatedTask;
+class SedSubTask;
+class SedSetValue;
+class SedRange;
+class SedUniformRange;
+class SedVectorRange;
+class SedFunctionalRange;
+class SedDataGenerator;
+class SedVariable;
+class SedParameter;
+class SedOutput;
+class SedReport;
+class SedPlot2D;
+class SedPlot3D;
+class SedDataSet;
+class SedCurve;
+class SedSurface;
 
 
 class SedVisitor
@@ -106,12 +156,383 @@ public:
   virtual void visit(const SedListOf       &x, int type);
 
 
+  /**
+   * Enters a SedDocument before its lists are visited; by default, visits
+   * it with visit(const SedDocument &x) and visits all of its lists.
+   *
+   * Override this method to prune the traversal at the document.
+   *
+   * @param x the SedDocument object to enter.
+   *
+   * @return @c true to visit the lists of @p x, @c false to skip them.
+   */
+  virtual bool enter(const SedDocument &x);
+
+
+  /**
+   * Enters a ListOf before its items are visited; by default, visits it
+   * with visit(const SedListOf &x, int type) and visits all of its items.
+   *
+   * Override this method to prune the traversal at a list.
+   *
+   * @param x the ListOf object to enter.
+   *
+   * @param type the object type code.
+   *
+   * @return @c true to visit the items of @p x, @c false to skip them.
+   */
+  virtual bool enter(const SedListOf &x, int type);
+
+
+  /**
+   * Visits a SedDataDescription; by default, visits it as a SedBase.
+   *
+   * @param x the SedDataDescription object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedDataDescription &x);
+
+
+  /**
+   * Visits a SedDataSource; by default, visits it as a SedBase.
+   *
+   * @param x the SedDataSource object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedDataSource &x);
+
+
+  /**
+   * Visits a SedSlice; by default, visits it as a SedBase.
+   *
+   * @param x the SedSlice object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedSlice &x);
+
+
+  /**
+   * Visits a SedModel; by default, visits it as a SedBase.
+   *
+   * @param x the SedModel object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedModel &x);
+
+
+  /**
+   * Visits a SedChange; by default, visits it as a SedBase.
+   *
+   * @param x the SedChange object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedChange &x);
+
+
+  /**
+   * Visits a SedChangeAttribute; by default, visits it as a SedChange.
+   *
+   * @param x the SedChangeAttribute object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedChangeAttribute &x);
+
+
+  /**
+   * Visits a SedAddXML; by default, visits it as a SedChange.
+   *
+   * @param x the SedAddXML object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedAddXML &x);
+
+
+  /**
+   * Visits a SedChangeXML; by default, visits it as a SedChange.
+   *
+   * @param x the SedChangeXML object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedChangeXML &x);
+
+
+  /**
+   * Visits a SedRemoveXML; by default, visits it as a SedChange.
+   *
+   * @param x the SedRemoveXML object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedRemoveXML &x);
+
+
+  /**
+   * Visits a SedComputeChange; by default, visits it as a SedChange.
+   *
+   * @param x the SedComputeChange object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedComputeChange &x);
+
+
+  /**
+   * Visits a SedSimulation; by default, visits it as a SedBase.
+   *
+   * @param x the SedSimulation object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedSimulation &x);
+
+
+  /**
+   * Visits a SedUniformTimeCourse; by default, visits it as a SedSimulation.
+   *
+   * @param x the SedUniformTimeCourse object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedUniformTimeCourse &x);
+
+
+  /**
+   * Visits a SedOneStep; by default, visits it as a SedSimulation.
+   *
+   * @param x the SedOneStep object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedOneStep &x);
+
+
+  /**
+   * Visits a SedSteadyState; by default, visits it as a SedSimulation.
+   *
+   * @param x the SedSteadyState object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedSteadyState &x);
+
+
+  /**
+   * Visits a SedAlgorithm; by default, visits it as a SedBase.
+   *
+   * @param x the SedAlgorithm object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedAlgorithm &x);
+
+
+  /**
+   * Visits a SedAlgorithmParameter; by default, visits it as a SedBase.
+   *
+   * @param x the SedAlgorithmParameter object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedAlgorithmParameter &x);
+
+
+  /**
+   * Visits a SedTask; by default, visits it as a SedBase.
+   *
+   * @param x the SedTask object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedTask &x);
+
+
+  /**
+   * Visits a SedRepeatedTask; by default, visits it as a SedTask.
+   *
+   * @param x the SedRepeatedTask object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedRepeatedTask &x);
+
+
+  /**
+   * Visits a SedSubTask; by default, visits it as a SedBase.
+   *
+   * @param x the SedSubTask object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedSubTask &x);
+
+
+  /**
+   * Visits a SedSetValue; by default, visits it as a SedBase.
+   *
+   * @param x the SedSetValue object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedSetValue &x);
+
+
+  /**
+   * Visits a SedRange; by default, visits it as a SedBase.
+   *
+   * @param x the SedRange object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedRange &x);
+
+
+  /**
+   * Visits a SedUniformRange; by default, visits it as a SedRange.
+   *
+   * @param x the SedUniformRange object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedUniformRange &x);
+
+
+  /**
+   * Visits a SedVectorRange; by default, visits it as a SedRange.
+   *
+   * @param x the SedVectorRange object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedVectorRange &x);
+
+
+  /**
+   * Visits a SedFunctionalRange; by default, visits it as a SedRange.
+   *
+   * @param x the SedFunctionalRange object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedFunctionalRange &x);
+
+
+  /**
+   * Visits a SedDataGenerator; by default, visits it as a SedBase.
+   *
+   * @param x the SedDataGenerator object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedDataGenerator &x);
+
+
+  /**
+   * Visits a SedVariable; by default, visits it as a SedBase.
+   *
+   * @param x the SedVariable object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedVariable &x);
+
+
+  /**
+   * Visits a SedParameter; by default, visits it as a SedBase.
+   *
+   * @param x the SedParameter object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedParameter &x);
+
+
+  /**
+   * Visits a SedOutput; by default, visits it as a SedBase.
+   *
+   * @param x the SedOutput object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedOutput &x);
+
+
+  /**
+   * Visits a SedReport; by default, visits it as a SedOutput.
+   *
+   * @param x the SedReport object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedReport &x);
+
+
+  /**
+   * Visits a SedPlot2D; by default, visits it as a SedOutput.
+   *
+   * @param x the SedPlot2D object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedPlot2D &x);
+
+
+  /**
+   * Visits a SedPlot3D; by default, visits it as a SedOutput.
+   *
+   * @param x the SedPlot3D object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedPlot3D &x);
+
+
+  /**
+   * Visits a SedDataSet; by default, visits it as a SedBase.
+   *
+   * @param x the SedDataSet object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedDataSet &x);
+
+
+  /**
+   * Visits a SedCurve; by default, visits it as a SedBase.
+   *
+   * @param x the SedCurve object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedCurve &x);
+
+
+  /**
+   * Visits a SedSurface; by default, visits it as a SedCurve.
+   *
+   * @param x the SedSurface object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them.
+   */
+  virtual bool visit(const SedSurface &x);
+
+
   /**
    * Interface method for using the <a target="_blank"
    * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
    * Pattern</i></a> to perform operations on SedBase objects.
    *
    * @param x the SedBase object to visit.
+   *
+   * @return @c true to visit the children of @p x, @c false to skip them;
+   * @c true by default.
    */
   virtual bool visit(const SedBase                    &x);
 
@@ -124,12 +545,318 @@ public:
    */
   virtual void leave(const SedDocument &x);
 
+  /**
+   * Leaves a SedDataDescription once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedDataDescription object to leave.
+   */
+  virtual void leave(const SedDataDescription &x);
+
+
+  /**
+   * Leaves a SedDataSource once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedDataSource object to leave.
+   */
+  virtual void leave(const SedDataSource &x);
+
+
+  /**
+   * Leaves a SedSlice once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedSlice object to leave.
+   */
+  virtual void leave(const SedSlice &x);
+
+
+  /**
+   * Leaves a SedModel once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedModel object to leave.
+   */
+  virtual void leave(const SedModel &x);
+
+
+  /**
+   * Leaves a SedChange once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedChange object to leave.
+   */
+  virtual void leave(const SedChange &x);
+
+
+  /**
+   * Leaves a SedChangeAttribute once its children have been visited; by default, leaves
+   * it as a SedChange.
+   *
+   * @param x the SedChangeAttribute object to leave.
+   */
+  virtual void leave(const SedChangeAttribute &x);
+
+
+  /**
+   * Leaves a SedAddXML once its children have been visited; by default, leaves
+   * it as a SedChange.
+   *
+   * @param x the SedAddXML object to leave.
+   */
+  virtual void leave(const SedAddXML &x);
+
+
+  /**
+   * Leaves a SedChangeXML once its children have been visited; by default, leaves
+   * it as a SedChange.
+   *
+   * @param x the SedChangeXML object to leave.
+   */
+  virtual void leave(const SedChangeXML &x);
+
+
+  /**
+   * Leaves a SedRemoveXML once its children have been visited; by default, leaves
+   * it as a SedChange.
+   *
+   * @param x the SedRemoveXML object to leave.
+   */
+  virtual void leave(const SedRemoveXML &x);
+
+
+  /**
+   * Leaves a SedComputeChange once its children have been visited; by default, leaves
+   * it as a SedChange.
+   *
+   * @param x the SedComputeChange object to leave.
+   */
+  virtual void leave(const SedComputeChange &x);
+
+
+  /**
+   * Leaves a SedSimulation once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedSimulation object to leave.
+   */
+  virtual void leave(const SedSimulation &x);
+
+
+  /**
+   * Leaves a SedUniformTimeCourse once its children have been visited; by default, leaves
+   * it as a SedSimulation.
+   *
+   * @param x the SedUniformTimeCourse object to leave.
+   */
+  virtual void leave(const SedUniformTimeCourse &x);
+
+
+  /**
+   * Leaves a SedOneStep once its children have been visited; by default, leaves
+   * it as a SedSimulation.
+   *
+   * @param x the SedOneStep object to leave.
+   */
+  virtual void leave(const SedOneStep &x);
+
+
+  /**
+   * Leaves a SedSteadyState once its children have been visited; by default, leaves
+   * it as a SedSimulation.
+   *
+   * @param x the SedSteadyState object to leave.
+   */
+  virtual void leave(const SedSteadyState &x);
+
+
+  /**
+   * Leaves a SedAlgorithm once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedAlgorithm object to leave.
+   */
+  virtual void leave(const SedAlgorithm &x);
+
+
+  /**
+   * Leaves a SedAlgorithmParameter once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedAlgorithmParameter object to leave.
+   */
+  virtual void leave(const SedAlgorithmParameter &x);
+
+
+  /**
+   * Leaves a SedTask once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedTask object to leave.
+   */
+  virtual void leave(const SedTask &x);
+
+
+  /**
+   * Leaves a SedRepeatedTask once its children have been visited; by default, leaves
+   * it as a SedTask.
+   *
+   * @param x the SedRepeatedTask object to leave.
+   */
+  virtual void leave(const SedRepeatedTask &x);
+
+
+  /**
+   * Leaves a SedSubTask once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedSubTask object to leave.
+   */
+  virtual void leave(const SedSubTask &x);
+
+
+  /**
+   * Leaves a SedSetValue once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedSetValue object to leave.
+   */
+  virtual void leave(const SedSetValue &x);
+
+
+  /**
+   * Leaves a SedRange once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedRange object to leave.
+   */
+  virtual void leave(const SedRange &x);
+
+
+  /**
+   * Leaves a SedUniformRange once its children have been visited; by default, leaves
+   * it as a SedRange.
+   *
+   * @param x the SedUniformRange object to leave.
+   */
+  virtual void leave(const SedUniformRange &x);
+
+
+  /**
+   * Leaves a SedVectorRange once its children have been visited; by default, leaves
+   * it as a SedRange.
+   *
+   * @param x the SedVectorRange object to leave.
+   */
+  virtual void leave(const SedVectorRange &x);
+
+
+  /**
+   * Leaves a SedFunctionalRange once its children have been visited; by default, leaves
+   * it as a SedRange.
+   *
+   * @param x the SedFunctionalRange object to leave.
+   */
+  virtual void leave(const SedFunctionalRange &x);
+
+
+  /**
+   * Leaves a SedDataGenerator once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedDataGenerator object to leave.
+   */
+  virtual void leave(const SedDataGenerator &x);
+
+
+  /**
+   * Leaves a SedVariable once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedVariable object to leave.
+   */
+  virtual void leave(const SedVariable &x);
+
+
+  /**
+   * Leaves a SedParameter once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedParameter object to leave.
+   */
+  virtual void leave(const SedParameter &x);
+
+
+  /**
+   * Leaves a SedOutput once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedOutput object to leave.
+   */
+  virtual void leave(const SedOutput &x);
+
+
+  /**
+   * Leaves a SedReport once its children have been visited; by default, leaves
+   * it as a SedOutput.
+   *
+   * @param x the SedReport object to leave.
+   */
+  virtual void leave(const SedReport &x);
+
+
+  /**
+   * Leaves a SedPlot2D once its children have been visited; by default, leaves
+   * it as a SedOutput.
+   *
+   * @param x the SedPlot2D object to leave.
+   */
+  virtual void leave(const SedPlot2D &x);
+
+
+  /**
+   * Leaves a SedPlot3D once its children have been visited; by default, leaves
+   * it as a SedOutput.
+   *
+   * @param x the SedPlot3D object to leave.
+   */
+  virtual void leave(const SedPlot3D &x);
+
+
+  /**
+   * Leaves a SedDataSet once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedDataSet object to leave.
+   */
+  virtual void leave(const SedDataSet &x);
+
+
+  /**
+   * Leaves a SedCurve once its children have been visited; by default, leaves
+   * it as a SedBase.
+   *
+   * @param x the SedCurve object to leave.
+   */
+  virtual void leave(const SedCurve &x);
+
+
+  /**
+   * Leaves a SedSurface once its children have been visited; by default, leaves
+   * it as a SedCurve.
+   *
+   * @param x the SedSurface object to leave.
+   */
+  virtual void leave(const SedSurface &x);
+
+
   /**
    * Interface method for using the <a target="_blank"
    * href="http://en.wikipedia.org/wiki/Design_pattern_(computer_science)"><i>Visitor
-   * Pattern</i></a> to perform operations on Reaction objects.
+   * Pattern</i></a> to perform operations on SedBase objects.
    *
-   * @param x the Reaction object to visit.
+   * @param x the SedBase object to leave.
    */
   virtual void leave(const SedBase     &x);
 
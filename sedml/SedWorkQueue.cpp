@@ -0,0 +1,241 @@
+/**
+ * @file    SedWorkQueue.cpp
+ * @brief   Implementation of SedWorkQueue
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <sedml/SedWorkQueue.h>
+
+#include <vector>
+
+#ifdef LIBSEDML_USE_THREADS
+#include <mutex>
+#include <thread>
+#endif
+
+
+/** @cond doxygen-ignored */
+
+using namespace std;
+
+/** @endcond */
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * The items not yet taken of the share of a thread.
+ */
+struct SedWorkQueue::Share
+{
+#ifdef LIBSEDML_USE_THREADS
+  std::mutex mutex;
+#endif
+  size_t     next;
+  size_t     end;
+};
+
+
+#ifdef LIBSEDML_USE_THREADS
+#define SEDML_LOCK_SHARE(share) std::lock_guard<std::mutex> lock((share).mutex)
+#else
+#define SEDML_LOCK_SHARE(share)
+#endif
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Creates a new SedWorkQueue.
+ */
+SedWorkQueue::SedWorkQueue(size_t numItems, unsigned int numShares)
+  : mShares(NULL)
+  , mNumShares(numShares == 0 ? 1 : numShares)
+{
+  mShares = new Share[mNumShares];
+
+  size_t shareSize = numItems / mNumShares;
+  size_t remainder = numItems % mNumShares;
+  size_t begin = 0;
+
+  for (unsigned int s = 0; s < mNumShares; ++s)
+    {
+      mShares[s].next = begin;
+      begin += shareSize + (s < remainder ? 1 : 0);
+      mShares[s].end = begin;
+    }
+}
+
+
+/*
+ * Destructor for SedWorkQueue.
+ */
+SedWorkQueue::~SedWorkQueue()
+{
+  delete [] mShares;
+}
+
+
+/*
+ * @return the number of threads taking items.
+ */
+unsigned int
+SedWorkQueue::getNumShares() const
+{
+  return mNumShares;
+}
+
+
+/*
+ * Takes the next item of the given thread.
+ */
+bool
+SedWorkQueue::next(unsigned int share, size_t& item)
+{
+  do
+    {
+      SEDML_LOCK_SHARE(mShares[share]);
+
+      if (mShares[share].next != mShares[share].end)
+        {
+          item = mShares[share].next++;
+          return true;
+        }
+    }
+  while (steal(share));
+
+  return false;
+}
+
+
+/** @cond doxygen-libsedml-internal */
+
+/*
+ * Moves the back half of the remaining items of another share to the
+ * given, empty, share; returns false if all shares are empty.
+ */
+bool
+SedWorkQueue::steal(unsigned int thief)
+{
+  for (unsigned int n = 1; n < mNumShares; ++n)
+    {
+      Share& victim = mShares[(thief + n) % mNumShares];
+      size_t begin, end;
+
+      {
+        SEDML_LOCK_SHARE(victim);
+
+        if (victim.next == victim.end)
+          continue;
+
+        end = victim.end;
+        begin = victim.next + (victim.end - victim.next) / 2;
+        victim.end = begin;
+      }
+
+      SEDML_LOCK_SHARE(mShares[thief]);
+      mShares[thief].next = begin;
+      mShares[thief].end = end;
+      return true;
+    }
+
+  return false;
+}
+
+/** @endcond doxygen-libsedml-internal */
+
+
+/*
+ * Calls work on the given number of threads.
+ */
+void
+SedWorkQueue::run(unsigned int numThreads,
+                  void (*work)(void* context, unsigned int thread),
+                  void* context)
+{
+#ifdef LIBSEDML_USE_THREADS
+  std::vector<std::thread> threads;
+
+  for (unsigned int t = 1; t < numThreads; ++t)
+    {
+      threads.push_back(std::thread(work, context, t));
+    }
+
+  if (numThreads > 0) work(context, 0);
+
+  for (size_t t = 0; t < threads.size(); ++t)
+    {
+      threads[t].join();
+    }
+#else
+  for (unsigned int t = 0; t < numThreads; ++t)
+    {
+      work(context, t);
+    }
+#endif
+}
+
+
+/*
+ * @return true if libSEDML was built with thread support.
+ */
+bool
+SedWorkQueue::hasThreads()
+{
+#ifdef LIBSEDML_USE_THREADS
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+/*
+ * @return the number of threads the hardware runs at once.
+ */
+unsigned int
+SedWorkQueue::getNumProcessors()
+{
+#ifdef LIBSEDML_USE_THREADS
+  unsigned int numProcessors = std::thread::hardware_concurrency();
+  return (numProcessors == 0) ? 1 : numProcessors;
+#else
+  return 1;
+#endif
+}
+
+
+LIBSEDML_CPP_NAMESPACE_END
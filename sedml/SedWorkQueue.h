@@ -0,0 +1,170 @@
+/**
+ * @file    SedWorkQueue.h
+ * @brief   Definition of SedWorkQueue
+ *
+ * <!--------------------------------------------------------------------------
+ *
+ * This file is part of libSEDML.  Please visit http://sed-ml.org for more
+ * information about SED-ML. The latest version of libSEDML can be found on
+ * github: https://github.com/fbergmann/libSEDML/
+ *
+ *
+ * Copyright (c) 2013-2014, Frank T. Bergmann
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ *    list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class SedWorkQueue
+ * @ingroup Core
+ * @brief Spreads numbered items of work over several threads.
+ *
+ * <em style='color: #555'>This class of objects is defined by libSed only
+ * and has no direct equivalent in terms of Sed components.</em>
+ *
+ * A SedWorkQueue hands out the items @c 0 to <code>numItems - 1</code> to
+ * a fixed number of threads.  Each thread starts with an equal share of
+ * the items, which it takes from the front; a thread that has finished its
+ * share takes the back half of the remaining share of another one, so that
+ * a few long items do not hold up the others.  It is used by
+ * SedParallelTraversal and SedTaskExecutor.
+ * @code{.cpp}
+ * static void work(void* context, unsigned int thread)
+ * {
+ *   SedWorkQueue* queue = static_cast<SedWorkQueue*>(context);
+ *   size_t item;
+ *   while (queue->next(thread, item))
+ *     // ... process item ...
+ * }
+ *
+ * SedWorkQueue queue(numItems, numThreads);
+ * SedWorkQueue::run(queue.getNumShares(), work, &queue);
+ * @endcode
+ *
+ * When libSEDML is built without thread support (WITH_THREADS), run()
+ * calls the work function of each thread in turn, on the calling thread.
+ */
+
+#ifndef SedWorkQueue_h
+#define SedWorkQueue_h
+
+
+#include <sedml/common/extern.h>
+#include <sedml/common/sedmlfwd.h>
+
+
+#ifdef __cplusplus
+
+
+#include <cstddef>
+
+
+LIBSEDML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSEDML_EXTERN SedWorkQueue
+{
+public:
+
+  /**
+   * Creates a new SedWorkQueue.
+   *
+   * @param numItems the number of items.
+   * @param numShares the number of threads taking items, at least one.
+   */
+  SedWorkQueue(size_t numItems, unsigned int numShares);
+
+
+  /**
+   * Destructor for SedWorkQueue.
+   */
+  ~SedWorkQueue();
+
+
+  /**
+   * @return the number of threads taking items.
+   */
+  unsigned int getNumShares() const;
+
+
+  /**
+   * Takes the next item of the given thread, from its share or from the
+   * share of another thread.
+   *
+   * @param share the index of the calling thread, below getNumShares().
+   * @param item the item taken.
+   *
+   * @return @c false once no item is left.
+   */
+  bool next(unsigned int share, size_t& item);
+
+
+  /**
+   * Calls @p work on @p numThreads threads, the calling one included, and
+   * waits for all of them to return.
+   *
+   * @param numThreads the number of threads.
+   * @param work the function each thread runs, given @p context and the
+   * index of the thread.
+   * @param context the argument of @p work.
+   */
+  static void run(unsigned int numThreads,
+                  void (*work)(void* context, unsigned int thread),
+                  void* context);
+
+
+  /**
+   * @return @c true if libSEDML was built with thread support, in which
+   * case run() uses one thread per share.
+   */
+  static bool hasThreads();
+
+
+  /**
+   * @return the number of threads the hardware runs at once, or @c 1 if it
+   * is unknown or libSEDML was built without thread support.
+   */
+  static unsigned int getNumProcessors();
+
+
+private:
+  /** @cond doxygen-libsedml-internal */
+
+  struct Share;
+
+  SedWorkQueue(const SedWorkQueue&);
+  SedWorkQueue& operator=(const SedWorkQueue&);
+
+  bool steal(unsigned int thief);
+
+  Share*        mShares;
+  unsigned int  mNumShares;
+
+  /** @endcond doxygen-libsedml-internal */
+};
+
+
+LIBSEDML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+#endif  /* SedWorkQueue_h */
@@ -47,6 +47,7 @@
 #include <sedml/SedErrorLog.h>
 #include <sedml/SedDocument.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedOutputStream.h>
 
 #include <sbml/compress/CompressCommon.h>
 #include <sbml/compress/OutputCompressor.h>
@@ -63,6 +64,9 @@ LIBSEDML_CPP_NAMESPACE_BEGIN
  * Creates a new SedWriter.
  */
 SedWriter::SedWriter()
+  : mUseSubtreeCache(false)
+  , mNumThreads(1)
+  , mCollectStatistics(false)
 {
 }
 
@@ -113,6 +117,86 @@ SedWriter::setProgramVersion(const std::string& version)
 }
 
 
+/*
+ * Sets whether the serialized output of unmodified elements is re-used.
+ */
+int
+SedWriter::setUseSubtreeCache(bool useCache)
+{
+  mUseSubtreeCache = useCache;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if the serialized output of unmodified elements is re-used.
+ */
+bool
+SedWriter::getUseSubtreeCache() const
+{
+  return mUseSubtreeCache;
+}
+
+
+/*
+ * Sets the number of threads used to serialize the top level lists.
+ */
+int
+SedWriter::setNumThreads(unsigned int numThreads)
+{
+#ifndef LIBSEDML_USE_THREADS
+  if (numThreads > 1)
+    {
+      return LIBSEDML_OPERATION_FAILED;
+    }
+#endif
+
+  mNumThreads = (numThreads == 0) ? 1 : numThreads;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the number of threads used to serialize the top level lists.
+ */
+unsigned int
+SedWriter::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+/*
+ * Sets whether this SedWriter collects statistics.
+ */
+int
+SedWriter::setCollectStatistics(bool collect)
+{
+  mCollectStatistics = collect;
+  return LIBSEDML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return true if this SedWriter collects statistics.
+ */
+bool
+SedWriter::getCollectStatistics() const
+{
+  return mCollectStatistics;
+}
+
+
+/*
+ * @return the statistics collected by this SedWriter.
+ */
+SedWriterStatistics*
+SedWriter::getStatistics()
+{
+  return &mStatistics;
+}
+
+
 /*
  * Writes the given Sed document to filename.
  *
@@ -196,7 +280,8 @@ SedWriter::writeSedML(const SedDocument* d, const std::string& filename)
   catch (ZlibNotLinked&)
     {
       // libSed is not linked with zlib.
-      XMLErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+      SedErrorLog scratch;
+      XMLErrorLog *log = d->getWriteErrorLog(scratch);
       std::ostringstream oss;
       oss << "Tried to write " << filename << ". Writing a gzip/zip file is not enabled because "
           << "underlying libSed is not linked with zlib.";
@@ -206,7 +291,8 @@ SedWriter::writeSedML(const SedDocument* d, const std::string& filename)
   catch (Bzip2NotLinked&)
     {
       // libSed is not linked with bzip2.
-      XMLErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+      SedErrorLog scratch;
+      XMLErrorLog *log = d->getWriteErrorLog(scratch);
       std::ostringstream oss;
       oss << "Tried to write " << filename << ". Writing a bzip2 file is not enabled because "
           << "underlying libSed is not linked with bzip2.";
@@ -217,7 +303,8 @@ SedWriter::writeSedML(const SedDocument* d, const std::string& filename)
 
   if (stream == NULL || stream->fail() || stream->bad())
     {
-      SedErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+      SedErrorLog scratch;
+      SedErrorLog *log = d->getWriteErrorLog(scratch);
       log->logError(XMLFileUnwritable);
       return false;
     }
@@ -240,12 +327,36 @@ bool
 SedWriter::writeSedML(const SedDocument* d, std::ostream& stream)
 {
   bool result = false;
+  double start = 0.0;
+  streampos startPos = -1;
+
+  // a frozen document may be written by several threads at once, so
+  // nothing is stored in it: its subtrees are not cached
+  const bool frozen = d->isFrozen();
+
+  if (mCollectStatistics)
+    {
+      start = SedReaderStatistics::now();
+      startPos = stream.tellp();
+    }
 
   try
     {
       stream.exceptions(ios_base::badbit | ios_base::failbit | ios_base::eofbit);
-      XMLOutputStream xos(stream, "UTF-8", true, mProgramName,
+      SedOutputStream xos(stream, "UTF-8", true, mProgramName,
                           mProgramVersion);
+
+      if (mCollectStatistics)
+        xos.setStatistics(&mStatistics);
+
+      if (mUseSubtreeCache && !frozen)
+        {
+          xos.setUseSubtreeCache(true);
+          xos.setCacheEpoch(d->getWriteCacheEpoch());
+        }
+
+      xos.setNumThreads(mNumThreads);
+
       d->write(xos);
       stream << endl;
 
@@ -253,10 +364,24 @@ SedWriter::writeSedML(const SedDocument* d, std::ostream& stream)
     }
   catch (ios_base::failure&)
     {
-      SedErrorLog *log = (const_cast<SedDocument *>(d))->getErrorLog();
+      SedErrorLog scratch;
+      SedErrorLog *log = d->getWriteErrorLog(scratch);
       log->logError(XMLFileOperationError);
     }
 
+  if (mCollectStatistics)
+    {
+      // streams that cannot tell their position (e.g. compressed ones)
+      // report no bytes
+      streampos endPos = result ? stream.tellp() : streampos(-1);
+      unsigned long numBytes = 0;
+
+      if (startPos != streampos(-1) && endPos != streampos(-1))
+        numBytes = (unsigned long)(endPos - startPos);
+
+      mStatistics.addDocument(SedReaderStatistics::now() - start, numBytes);
+    }
+
   return result;
 }
 
@@ -400,6 +525,108 @@ SedWriter_setProgramVersion(SedWriter_t *sw, const char *version)
 }
 
 
+/**
+ * Sets whether the given SedWriter re-uses the serialized output of
+ * elements that have not been modified since they were last written.
+ *
+ * @return integer value indicating success/failure of the
+ * function.  @if clike The value is drawn from the
+ * enumeration #OperationReturnValues_t. @endif@~ The possible values
+ * returned by this function are:
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setUseSubtreeCache(SedWriter_t *sw, int useCache)
+{
+  if (sw != NULL)
+    return sw->setUseSubtreeCache(useCache != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns non-zero if the given SedWriter re-uses the serialized output of
+ * unmodified elements, zero otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getUseSubtreeCache(const SedWriter_t *sw)
+{
+  return (sw != NULL) ? static_cast<int>(sw->getUseSubtreeCache()) : 0;
+}
+
+
+/**
+ * Sets the number of threads the given SedWriter uses to serialize the
+ * top level lists of a SedDocument.
+ *
+ * @return integer value indicating success/failure of the
+ * function.  @if clike The value is drawn from the
+ * enumeration #OperationReturnValues_t. @endif@~ The possible values
+ * returned by this function are:
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setNumThreads(SedWriter_t *sw, unsigned int numThreads)
+{
+  if (sw != NULL)
+    return sw->setNumThreads(numThreads);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the number of threads the given SedWriter uses to serialize the
+ * top level lists of a SedDocument.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedWriter_getNumThreads(const SedWriter_t *sw)
+{
+  return (sw != NULL) ? sw->getNumThreads() : 0;
+}
+
+
+/**
+ * Sets whether the given SedWriter collects timings and counters about the
+ * documents it writes.
+ *
+ * @return integer value indicating success/failure of the
+ * function.  @if clike The value is drawn from the
+ * enumeration #OperationReturnValues_t. @endif@~ The possible values
+ * returned by this function are:
+ * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+ * @li @link OperationReturnValues_t#LIBSEDML_INVALID_OBJECT LIBSEDML_INVALID_OBJECT @endlink
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setCollectStatistics(SedWriter_t *sw, int collect)
+{
+  if (sw != NULL)
+    return sw->setCollectStatistics(collect != 0);
+  else
+    return LIBSEDML_INVALID_OBJECT;
+}
+
+
+/**
+ * Returns the statistics collected by the given SedWriter.
+ */
+LIBSEDML_EXTERN
+SedWriterStatistics_t *
+SedWriter_getStatistics(SedWriter_t *sw)
+{
+  return (sw != NULL) ? sw->getStatistics() : NULL;
+}
+
+
 /**
  * Writes the given Sed document to filename.
  *
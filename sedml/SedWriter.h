@@ -84,6 +84,7 @@
 
 #include <sedml/common/extern.h>
 #include <sedml/common/sedmlfwd.h>
+#include <sedml/SedStatistics.h>
 
 
 #ifdef __cplusplus
@@ -174,6 +175,108 @@ public:
   int setProgramVersion(const std::string& version);
 
 
+  /**
+   * Sets whether this SedWriter re-uses the serialized output of elements
+   * that have not been modified since they were last written.
+   *
+   * When enabled, the items of the top level lists of a SedDocument
+   * (models, simulations, tasks, data generators, outputs and data
+   * descriptions) keep a copy of their serialized form, and writing the
+   * same document again only re-renders the items that were modified in
+   * between (see SedBase::markDirty()).  The output is identical to the
+   * output written with the cache disabled.  The cache roughly doubles the
+   * memory held by the document, and is therefore disabled by default.
+   * Frozen documents (see SedDocument::freeze()) are always written
+   * without the cache.
+   *
+   * @param useCache @c true to enable the subtree cache, @c false to
+   * disable it.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setUseSubtreeCache(bool useCache);
+
+
+  /**
+   * @return @c true if this SedWriter re-uses the serialized output of
+   * unmodified elements, @c false otherwise.
+   *
+   * @see setUseSubtreeCache(bool useCache)
+   */
+  bool getUseSubtreeCache() const;
+
+
+  /**
+   * Sets the number of threads this SedWriter uses to serialize the top
+   * level lists of a SedDocument.
+   *
+   * Lists with many elements (for example thousands of data generators or
+   * outputs) are split into contiguous chunks that are serialized
+   * concurrently and written in order, so the output does not depend on
+   * the number of threads.  Lists with fewer than
+   * SedOutputStream::MIN_ITEMS_PER_CHUNK elements per thread are written
+   * by the calling thread.  The document must not be modified while it is
+   * being written.
+   *
+   * @param numThreads the number of threads to use; @c 0 and @c 1 (the
+   * default) write on the calling thread only.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_FAILED LIBSEDML_OPERATION_FAILED @endlink
+   * if more than one thread is requested and libSEDML was built without
+   * thread support.
+   */
+  int setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads used to serialize the top level lists of
+   * a SedDocument.
+   *
+   * @see setNumThreads(unsigned int numThreads)
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Sets whether this SedWriter collects timings and counters about the
+   * documents it writes (see SedWriterStatistics).  Statistics are added
+   * up over all documents written until they are reset.
+   *
+   * @param collect @c true to collect statistics, @c false (the default)
+   * not to.
+   *
+   * @return integer value indicating success/failure of the
+   * function.  The possible values
+   * returned by this function are:
+   * @li @link OperationReturnValues_t#LIBSEDML_OPERATION_SUCCESS LIBSEDML_OPERATION_SUCCESS @endlink
+   */
+  int setCollectStatistics(bool collect);
+
+
+  /**
+   * @return @c true if this SedWriter collects statistics, @c false
+   * otherwise.
+   *
+   * @see setCollectStatistics(bool collect)
+   */
+  bool getCollectStatistics() const;
+
+
+  /**
+   * @return the statistics collected by this SedWriter.
+   *
+   * @see setCollectStatistics(bool collect)
+   */
+  SedWriterStatistics* getStatistics();
+
+
   /**
    * Writes the given Sed document to filename.
    *
@@ -320,8 +423,12 @@ public:
 protected:
   /** @cond doxygen-libsbml-internal */
 
-  std::string mProgramName;
-  std::string mProgramVersion;
+  std::string  mProgramName;
+  std::string  mProgramVersion;
+  bool         mUseSubtreeCache;
+  unsigned int mNumThreads;
+  bool         mCollectStatistics;
+  SedWriterStatistics mStatistics;
 
   /** @endcond */
 };
@@ -378,6 +485,53 @@ LIBSEDML_EXTERN
 int
 SedWriter_setProgramVersion(SedWriter_t *sw, const char *version);
 
+/**
+ * Sets whether the given SedWriter re-uses the serialized output of
+ * elements that have not been modified since they were last written.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setUseSubtreeCache(SedWriter_t *sw, int useCache);
+
+/**
+ * Returns non-zero if the given SedWriter re-uses the serialized output of
+ * unmodified elements, zero otherwise.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_getUseSubtreeCache(const SedWriter_t *sw);
+
+/**
+ * Sets the number of threads the given SedWriter uses to serialize the
+ * top level lists of a SedDocument.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setNumThreads(SedWriter_t *sw, unsigned int numThreads);
+
+/**
+ * Returns the number of threads the given SedWriter uses to serialize the
+ * top level lists of a SedDocument.
+ */
+LIBSEDML_EXTERN
+unsigned int
+SedWriter_getNumThreads(const SedWriter_t *sw);
+
+/**
+ * Sets whether the given SedWriter collects timings and counters about the
+ * documents it writes.
+ */
+LIBSEDML_EXTERN
+int
+SedWriter_setCollectStatistics(SedWriter_t *sw, int collect);
+
+/**
+ * Returns the statistics collected by the given SedWriter.
+ */
+LIBSEDML_EXTERN
+SedWriterStatistics_t *
+SedWriter_getStatistics(SedWriter_t *sw);
+
 /**
  * Writes the given Sed document to filename.
  *
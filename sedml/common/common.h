@@ -111,6 +111,21 @@ static const int SEDML_INT_MIN = -2147483647 - 1;
 #define LIBSEDML_UNKNOWN_COLUMN SEDML_INT_MAX
 
 
+/*
+ * Declares a variable of which each thread has its own copy, in every
+ * build: with thread_local when libSEDML is built with threads (and so as
+ * C++11), and with the extension of the compiler otherwise.  The variable
+ * must be of a plain type, with a constant initializer.
+ */
+#if defined(LIBSEDML_USE_THREADS)
+#  define LIBSEDML_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#  define LIBSEDML_THREAD_LOCAL __declspec(thread)
+#else
+#  define LIBSEDML_THREAD_LOCAL __thread
+#endif
+
+
 #include <sedml/common/extern.h>
 #include <sbml/util/memory.h>
 #include <sbml/util/util.h>
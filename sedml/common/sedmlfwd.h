@@ -84,6 +84,55 @@ typedef CLASS_OR_STRUCT SedReader                     SedReader_t;
 typedef CLASS_OR_STRUCT SedWriter                     SedWriter_t;
 
 
+/**
+ * @var typedef class SedJSONReader SedJSONReader_t
+ * @copydoc SedJSONReader
+ */
+typedef CLASS_OR_STRUCT SedJSONReader                 SedJSONReader_t;
+
+
+/**
+ * @var typedef class SedJSONWriter SedJSONWriter_t
+ * @copydoc SedJSONWriter
+ */
+typedef CLASS_OR_STRUCT SedJSONWriter                 SedJSONWriter_t;
+
+
+/**
+ * @var typedef class SedReaderStatistics SedReaderStatistics_t
+ * @copydoc SedReaderStatistics
+ */
+typedef CLASS_OR_STRUCT SedReaderStatistics           SedReaderStatistics_t;
+
+
+/**
+ * @var typedef class SedWriterStatistics SedWriterStatistics_t
+ * @copydoc SedWriterStatistics
+ */
+typedef CLASS_OR_STRUCT SedWriterStatistics           SedWriterStatistics_t;
+
+
+/**
+ * @var typedef class SedMemoryUsage SedMemoryUsage_t
+ * @copydoc SedMemoryUsage
+ */
+typedef CLASS_OR_STRUCT SedMemoryUsage                SedMemoryUsage_t;
+
+
+/**
+ * @var typedef class SedDocumentSnapshot SedDocumentSnapshot_t
+ * @copydoc SedDocumentSnapshot
+ */
+typedef CLASS_OR_STRUCT SedDocumentSnapshot           SedDocumentSnapshot_t;
+
+
+/**
+ * @var typedef class SedMathProgram SedMathProgram_t
+ * @copydoc SedMathProgram
+ */
+typedef CLASS_OR_STRUCT SedMathProgram                SedMathProgram_t;
+
+
 /**
  * @var typedef class SedNamespaces SedNamespaces_t
  * @copydoc SedNamespaces
@@ -135,6 +184,13 @@ typedef CLASS_OR_STRUCT SedChange                     SedChange_t;
  */
 typedef CLASS_OR_STRUCT SedRange                     SedRange_t;
 
+
+/**
+ * @var typedef class SedRangeValues SedRangeValues_t
+ * @copydoc SedRangeValues
+ */
+typedef CLASS_OR_STRUCT SedRangeValues               SedRangeValues_t;
+
 /**
  * @var typedef class SedUniformRange SedUniformRange_t
  * @copydoc SedUniformRange
@@ -230,6 +286,12 @@ typedef CLASS_OR_STRUCT SedChangeAttribute                     SedChangeAttribut
  */
 typedef CLASS_OR_STRUCT SedDataGenerator                     SedDataGenerator_t;
 
+/**
+ * @var typedef class SedDependencyGraph SedDependencyGraph_t
+ * @copydoc SedDependencyGraph
+ */
+typedef CLASS_OR_STRUCT SedDependencyGraph                     SedDependencyGraph_t;
+
 /**
  * @var typedef class SedListOfDataGenerators SedListOfDataGenerators_t
  * @copydoc SedListOfDataGenerators
@@ -270,6 +332,60 @@ typedef CLASS_OR_STRUCT SedTask                     SedTask_t;
  */
 typedef CLASS_OR_STRUCT SedRepeatedTask                     SedRepeatedTask_t;
 
+/**
+ * @var typedef class SedTaskPlan SedTaskPlan_t
+ * @copydoc SedTaskPlan
+ */
+typedef CLASS_OR_STRUCT SedTaskPlan                     SedTaskPlan_t;
+
+/**
+ * @var typedef class SedTaskPlanStep SedTaskPlanStep_t
+ * @copydoc SedTaskPlanStep
+ */
+typedef CLASS_OR_STRUCT SedTaskPlanStep                     SedTaskPlanStep_t;
+
+/**
+ * @var typedef class SedTaskExecutor SedTaskExecutor_t
+ * @copydoc SedTaskExecutor
+ */
+typedef CLASS_OR_STRUCT SedTaskExecutor                     SedTaskExecutor_t;
+
+/**
+ * @var typedef class SedSimulationBackend SedSimulationBackend_t
+ * @copydoc SedSimulationBackend
+ */
+typedef CLASS_OR_STRUCT SedSimulationBackend                     SedSimulationBackend_t;
+
+/**
+ * @var typedef class SedSimulationRun SedSimulationRun_t
+ * @copydoc SedSimulationRun
+ */
+typedef CLASS_OR_STRUCT SedSimulationRun                     SedSimulationRun_t;
+
+/**
+ * @var typedef class SedSimulationResult SedSimulationResult_t
+ * @copydoc SedSimulationResult
+ */
+typedef CLASS_OR_STRUCT SedSimulationResult                     SedSimulationResult_t;
+
+/**
+ * @var typedef class SedResampler SedResampler_t
+ * @copydoc SedResampler
+ */
+typedef CLASS_OR_STRUCT SedResampler                     SedResampler_t;
+
+/**
+ * @var typedef class SedResultStore SedResultStore_t
+ * @copydoc SedResultStore
+ */
+typedef CLASS_OR_STRUCT SedResultStore                     SedResultStore_t;
+
+/**
+ * @var typedef class SedReportWriter SedReportWriter_t
+ * @copydoc SedReportWriter
+ */
+typedef CLASS_OR_STRUCT SedReportWriter                     SedReportWriter_t;
+
 /**
  * @var typedef class SedSimulation SedSimulation_t
  * @copydoc SedSimulation
@@ -38,11 +38,16 @@
  */
 
 #include <limits>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <map>
 
 #include <iostream>
 #include <check.h>
 #include <string>
 #include <sstream>
+#include <clocale>
 
 #include <sbml/common/libsbml-version.h>
 #include <sedml/common/libsedml-version.h>
@@ -50,9 +55,14 @@
 #include <sedml/SedDocument.h>
 #include <sedml/SedDataGenerator.h>
 #include <sedml/SedWriter.h>
+#include <sedml/SedJSONReader.h>
+#include <sedml/SedJSONWriter.h>
+#include <sedml/SedTypes.h>
+#include <sedml/SedVisitor.h>
 
 #include <sbml/math/L3FormulaFormatter.h>
 #include <sbml/math/L3Parser.h>
+#include <sbml/SBMLTypes.h>
 
 /** @cond doxygenIgnored */
 
@@ -66,6 +76,53 @@ LIBSEDML_CPP_NAMESPACE_USE
 CK_CPPSTART
 
 
+/*
+ * Adds to doc the model "model", the uniform time course "sim" and the
+ * task "task" simulating them, and a repeated task with the given id that
+ * resets the model and sets target to each value of the uniform range "r"
+ * from 0 to end; returns the repeated task.
+ */
+static SedRepeatedTask*
+createSweep(SedDocument& doc, const std::string& id, double end,
+            int numberOfPoints, const std::string& target)
+{
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->setLanguage("urn:sedml:language:sbml");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(10);
+  sim->setNumberOfPoints(10);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("sim");
+
+  SedRepeatedTask* sweep = doc.createRepeatedTask();
+  sweep->setId(id);
+  sweep->setRangeId("r");
+  sweep->setResetModel(true);
+  SedUniformRange* uniform = sweep->createUniformRange();
+  uniform->setId("r");
+  uniform->setStart(0);
+  uniform->setEnd(end);
+  uniform->setNumberOfPoints(numberOfPoints);
+  sweep->createSubTask()->setTask("task");
+  SedSetValue* change = sweep->createTaskChange();
+  change->setModelReference("model");
+  change->setTarget(target);
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+
+  return sweep;
+}
+
 
 START_TEST (test_mathml_issue1)
 {
@@ -99,6 +156,1975 @@ START_TEST (test_mathml_issue1)
 END_TEST
 
 
+START_TEST (test_writer_subtree_cache)
+{
+  SedDocument doc;
+  for (int i = 0; i < 3; ++i)
+  {
+    SedModel* model = doc.createModel();
+    ostringstream id; id << "model" << i;
+    model->setId(id.str());
+    model->setSource("model.xml");
+  }
+
+  SedWriter plain;
+  SedWriter cached;
+  cached.setUseSubtreeCache(true);
+
+  ostringstream expected, actual;
+  plain.writeSedML(&doc, expected);
+  cached.writeSedML(&doc, actual);
+  fail_unless( expected.str() == actual.str() );
+  fail_unless( !doc.getModel(1)->isDirty() );
+
+  doc.getModel(1)->setSource("other.xml");
+  fail_unless( doc.getModel(1)->isDirty() );
+  fail_unless( !doc.getModel(0)->isDirty() );
+
+  expected.str(""); actual.str("");
+  plain.writeSedML(&doc, expected);
+  cached.writeSedML(&doc, actual);
+  fail_unless( expected.str() == actual.str() );
+  fail_unless( actual.str().find("other.xml") != string::npos );
+}
+END_TEST
+
+#ifdef LIBSEDML_USE_THREADS
+START_TEST (test_writer_parallel_lists)
+{
+  SedDocument doc;
+  ASTNode* math = SBML_parseL3Formula("S1/S2");
+  for (int i = 0; i < 500; ++i)
+  {
+    SedDataGenerator* sdg = doc.createDataGenerator();
+    ostringstream id; id << "dg" << i;
+    sdg->setId(id.str());
+    sdg->setMath(math);
+  }
+  delete math;
+
+  SedWriter serial;
+  SedWriter parallel;
+  fail_unless( parallel.setNumThreads(4) == LIBSEDML_OPERATION_SUCCESS );
+
+  ostringstream expected, actual;
+  serial.writeSedML(&doc, expected);
+  parallel.writeSedML(&doc, actual);
+  fail_unless( expected.str() == actual.str() );
+}
+END_TEST
+#endif
+
+
+START_TEST (test_json_roundtrip)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setSource("urn:miriam:biomodels.db:BIOMD0000000012");
+  model->setLanguage("urn:sedml:language:sbml");
+  SedDataGenerator* sdg = doc.createDataGenerator();
+  sdg->setId("dg1");
+  sdg->setName("ratio \"S1 < S2\"");
+  ASTNode* math = SBML_parseL3Formula("S1/S2");
+  sdg->setMath(math);
+  delete math;
+  sdg->setNotes("<notes><p xmlns=\"http://www.w3.org/1999/xhtml\">"
+                "<b>a</b> <i>b &amp; c</i></p></notes>");
+  model->setAnnotation("<annotation><x:info xmlns:x=\"urn:example\" "
+                       "x:kind=\"test\">\xF0\x9F\x98\x80</x:info>"
+                       "</annotation>");
+
+  SedWriter sw;
+  ostringstream expected;
+  sw.writeSedML(&doc, expected);
+
+  SedJSONWriter jw;
+  ostringstream json;
+  fail_unless( jw.writeSedML(&doc, json) );
+
+  // the MathML is written as elements, without libSBML's indentation
+  fail_unless( json.str().find("{\"name\":\"divide\"}") != string::npos );
+  fail_unless( json.str().find("{\"text\":\"\\n") == string::npos );
+
+  SedJSONReader jr;
+  SedDocument* copy = jr.readSedMLFromString(json.str());
+  fail_unless( copy->getNumErrors(LIBSEDML_SEV_ERROR) == 0 );
+
+  ostringstream actual;
+  sw.writeSedML(copy, actual);
+  fail_unless( expected.str() == actual.str() );
+  fail_unless( actual.str().find("<b>a</b> <i>") != string::npos );
+  fail_unless( actual.str().find("x:kind=\"test\"") != string::npos );
+  delete copy;
+
+  copy = jr.readSedMLFromString("{\"name\":\"sedML\",\"children\":[");
+  fail_unless( copy->getNumErrors() > 0 );
+  fail_unless( copy->getError(0)->getErrorId() == BadlyFormedXML );
+  delete copy;
+
+  // a high surrogate has to be followed by a low one
+  copy = jr.readSedMLFromString("{\"name\":\"sedML\",\"children\":"
+                                "[{\"text\":\"\\ud83d\\u0041\"}]}");
+  fail_unless( copy->getNumErrors() > 0 );
+  fail_unless( copy->getError(0)->getErrorId() == BadlyFormedXML );
+  delete copy;
+}
+END_TEST
+
+
+START_TEST (test_errorlog_index)
+{
+  SedErrorLog log;
+  log.logError(SedNotSchemaConformant, 1, 1, "bad", 0, 0, LIBSEDML_SEV_ERROR);
+  log.logError(SedUnknownError, 1, 1, "", 0, 0, LIBSEDML_SEV_FATAL);
+  log.logError(SedNotSchemaConformant, 1, 1, "", 0, 0, LIBSEDML_SEV_ERROR);
+
+  fail_unless( log.getNumErrorsWithId(SedNotSchemaConformant) == 2 );
+  const string& message = log.getError(0)->getMessage();
+  fail_unless( message.find("An SED-ML XML document") == 0 );
+  fail_unless( message.substr(message.size() - 5) == " bad\n" );
+  const XMLError* base = log.getError(0);
+  fail_unless( base->getMessage() == message );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_ERROR) == 2 );
+
+  log.remove(SedNotSchemaConformant);
+  fail_unless( log.getNumErrors() == 2 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_ERROR) == 1 );
+  fail_unless( log.getError(0)->getErrorId() == SedUnknownError );
+  log.remove(SedNotSchemaConformant);
+  fail_unless( log.getNumErrors() == 1 );
+  log.logError(SedNotSchemaConformant, 1, 1, "", 0, 0, LIBSEDML_SEV_ERROR);
+
+  log.removeAll(SedNotSchemaConformant);
+  fail_unless( !log.contains(SedNotSchemaConformant) );
+  fail_unless( log.contains(SedUnknownError) );
+
+  // once the log is full, errors of every severity are only counted
+  log.setMaxErrors(2);
+  log.logError(SedUnknownError, 1, 1, "", 0, 0, LIBSEDML_SEV_WARNING);
+  log.logError(SedUnknownError, 1, 1, "", 0, 0, LIBSEDML_SEV_WARNING);
+  log.logError(SedUnknownError, 1, 1, "", 0, 0, LIBSEDML_SEV_FATAL);
+  fail_unless( log.getNumErrors() == 2 );
+  fail_unless( log.getNumDroppedErrors() == 2 );
+  fail_unless( log.getNumDroppedErrors(LIBSEDML_SEV_WARNING) == 1 );
+  fail_unless( log.getNumDroppedErrors(LIBSEDML_SEV_FATAL) == 1 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_FATAL) == 2 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_WARNING) == 2 );
+
+  // errors appended by XMLErrorLog directly are counted, and then limited
+  log.XMLErrorLog::add(XMLError(BadlyFormedXML, "", 0, 0, LIBSBML_SEV_WARNING));
+  fail_unless( log.getNumErrorsWithId(BadlyFormedXML) == 1 );
+  log.updateIndex();
+  fail_unless( log.getNumErrorsWithId(BadlyFormedXML) == 0 );
+  fail_unless( log.getNumDroppedErrors(LIBSEDML_SEV_WARNING) == 2 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_WARNING) == 3 );
+
+  log.clearLog();
+  fail_unless( log.getNumErrors() == 0 );
+  fail_unless( log.getNumDroppedErrors() == 0 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSEDML_SEV_FATAL) == 0 );
+}
+END_TEST
+
+
+
+START_TEST (test_reader_cache)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setSource("model.xml");
+  model->setLanguage("urn:sedml:language:sbml");
+
+  SedWriter writer;
+  ostringstream out;
+  writer.writeSedML(&doc, out);
+
+  // without its declaration, the document is assembled in the buffer of
+  // the cache, and an unknown attribute has to be reported on every read
+  string xml = out.str();
+  xml = xml.substr(xml.find("<sedML"));
+  string bad = xml;
+  bad.insert(bad.find("id=\"m1\""), "unknown=\"1\" ");
+
+  SedReader reader;
+
+  for (int i = 0; i < 2; ++i)
+  {
+    SedDocument* copy = reader.readSedMLFromString(bad);
+    fail_unless( copy->getNumErrors() > 0 );
+    fail_unless( copy->getNumModels() == 1 );
+    delete copy;
+
+    copy = reader.readSedMLFromString(xml);
+    fail_unless( copy->getNumErrors() == 0 );
+    fail_unless( copy->getModel(0)->getSource() == "model.xml" );
+    delete copy;
+
+    reader.clearCache();
+  }
+
+  SedReader fresh;
+  SedDocument* first = fresh.readSedMLFromString(bad);
+  SedDocument* second = reader.readSedMLFromString(bad);
+  fail_unless( first->getNumErrors() == second->getNumErrors() );
+  delete first;
+  delete second;
+}
+END_TEST
+
+
+START_TEST (test_reader_trusted_failfast)
+{
+  SedDocument doc;
+
+  for (int i = 1; i <= 2; ++i)
+  {
+    SedModel* model = doc.createModel();
+    model->setId(i == 1 ? "m1" : "m2");
+    model->setSource("model.xml");
+    model->setLanguage("urn:sedml:language:sbml");
+  }
+
+  SedWriter writer;
+  ostringstream out;
+  writer.writeSedML(&doc, out);
+
+  string xml = out.str();
+  size_t pos = xml.find("<listOfModels>");
+  fail_unless( pos != string::npos );
+  xml.insert(pos, "<listOfSimulations/>");
+
+  SedReader reader;
+  SedDocument* copy = reader.readSedMLFromString(xml);
+  fail_unless( copy->getNumErrors() > 0 );
+  fail_unless( copy->getModel(0)->getLine() > 0 );
+  delete copy;
+
+  reader.setTrustedInput(true);
+  copy = reader.readSedMLFromString(xml);
+  fail_unless( copy->getNumErrors() == 0 );
+  fail_unless( copy->getNumModels() == 2 );
+  fail_unless( copy->getModel(0)->getLine() == 0 );
+  delete copy;
+
+  reader.setTrustedInput(false);
+  reader.setFailFast(true);
+  xml = out.str();
+  xml.replace(xml.find("\"m1\""), 4, "\"1m\"");
+  xml.replace(xml.find("\"m2\""), 4, "\"2m\"");
+  copy = reader.readSedMLFromString(xml);
+  fail_unless( copy->getNumErrors(LIBSEDML_SEV_ERROR) == 1 );
+  fail_unless( copy->getNumModels() == 1 );
+  delete copy;
+}
+END_TEST
+
+
+START_TEST (test_reader_writer_statistics)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setSource("model.xml");
+  model->setLanguage("urn:sedml:language:sbml");
+  SedDataGenerator* sdg = doc.createDataGenerator();
+  sdg->setId("dg1");
+  ASTNode* math = SBML_parseL3Formula("S1/S2");
+  sdg->setMath(math);
+  delete math;
+
+  SedWriter writer;
+  writer.setCollectStatistics(true);
+  ostringstream out;
+  fail_unless( writer.writeSedML(&doc, out) );
+
+  const SedWriterStatistics* written = writer.getStatistics();
+  fail_unless( written->getNumDocuments() == 1 );
+  fail_unless( written->getNumBytes() == out.str().size() );
+  fail_unless( written->getNumElements(SEDML_DOCUMENT) == 1 );
+  fail_unless( written->getNumElements(SEDML_MODEL) == 1 );
+  fail_unless( written->getNumElements(SEDML_DATAGENERATOR) == 1 );
+
+  SedReader reader;
+  reader.setCollectStatistics(true);
+  SedDocument* copy = reader.readSedMLFromString(out.str());
+  delete copy;
+
+  const SedReaderStatistics* read = reader.getStatistics();
+  fail_unless( read->getNumDocuments() == 1 );
+  fail_unless( read->getNumBytes() == out.str().size() );
+  fail_unless( read->getNumElements(SEDML_MODEL) == 1 );
+  fail_unless( read->getNumElements(SEDML_DATAGENERATOR) == 1 );
+  fail_unless( read->getNumElements() == written->getNumElements() );
+  fail_unless( read->getTime(SEDML_READ_PHASE_READ_ATTRIBUTES) >= 0.0 );
+  fail_unless( read->getTotalTime() >= read->getTime(SEDML_READ_PHASE_CHECKS) );
+
+  reader.getStatistics()->reset();
+  fail_unless( read->getNumDocuments() == 0 );
+}
+END_TEST
+
+
+START_TEST (test_document_memory_usage)
+{
+  SedMemoryUsage::resetObjectCounts();
+  SedMemoryUsage::setCountObjects(true);
+
+  SedDocument* doc = new SedDocument();
+  SedModel* model = doc->createModel();
+  model->setId("a_model_with_an_id_too_long_to_be_stored_inline");
+  SedDataGenerator* sdg = doc->createDataGenerator();
+  sdg->setId("dg1");
+  ASTNode* math = SBML_parseL3Formula("S1/S2");
+  sdg->setMath(math);
+  delete math;
+
+  SedMemoryUsage usage = doc->getMemoryUsage();
+  fail_unless( usage.getNumObjects(SEDML_DOCUMENT) == 1 );
+  fail_unless( usage.getNumObjects(SEDML_MODEL) == 1 );
+  fail_unless( usage.getNumObjects(SEDML_DATAGENERATOR) == 1 );
+  // six lists in the document, one in the model, two in the data generator
+  fail_unless( usage.getNumObjects(SEDML_LIST_OF) == 9 );
+  fail_unless( usage.getBytes(SEDML_MEMORY_MATH) > 0 );
+  fail_unless( usage.getBytes(SEDML_MEMORY_STRINGS) > 0 );
+  fail_unless( usage.getBytes(SEDML_MEMORY_NAMESPACES) > 0 );
+  fail_unless( usage.getBytesForType(SEDML_MODEL) >= sizeof(SedModel) );
+  fail_unless( usage.getBytes(SEDML_MEMORY_OBJECTS) >= sizeof(SedDocument) );
+
+  unsigned long total = 0;
+  for (int i = SEDML_MEMORY_OBJECTS; i < SEDML_MEMORY_UNKNOWN; ++i)
+    total += usage.getBytes((SedMemoryCategory_t)i);
+  fail_unless( total == usage.getTotalBytes() );
+
+  delete doc;
+  SedMemoryUsage::setCountObjects(false);
+  fail_unless( SedMemoryUsage::getNumObjectsCreated() >= 12 );
+  fail_unless( SedMemoryUsage::getNumObjectsCreated()
+               == SedMemoryUsage::getNumObjectsDestroyed() );
+}
+END_TEST
+
+
+START_TEST (test_document_freeze)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("m1");
+  model->setSource("model.xml");
+  model->setLanguage("urn:sedml:language:sbml");
+
+  SedDocumentSnapshot snapshot = doc.freeze();
+  const SedDocument* frozen = snapshot.getDocument();
+  fail_unless( frozen != NULL );
+  fail_unless( frozen != &doc );
+  fail_unless( frozen->isFrozen() );
+  fail_unless( !doc.isFrozen() );
+  fail_unless( snapshot.getVersion() == 1 );
+
+  // copies share the frozen document
+  SedDocumentSnapshot copy = snapshot;
+  fail_unless( copy.getDocument() == frozen );
+
+  // writing a frozen document does not use the subtree cache
+  SedWriter writer;
+  writer.setUseSubtreeCache(true);
+  writer.setCollectStatistics(true);
+  ostringstream expected, first, second;
+  fail_unless( SedWriter().writeSedML(&doc, expected) );
+  fail_unless( writer.writeSedML(frozen, first) );
+  fail_unless( writer.writeSedML(frozen, second) );
+  fail_unless( first.str() == expected.str() );
+  fail_unless( second.str() == expected.str() );
+  fail_unless( writer.getStatistics()->getNumElements(SEDML_MODEL) == 2 );
+  fail_unless( writer.getStatistics()->getNumCachedElements() == 0 );
+
+  // the namespaces of the snapshot are settled, and writers of it log to a
+  // scratch log instead of the frozen one
+  fail_unless( frozen->getNamespaces()->getLength() == 1 );
+  SedErrorLog scratch;
+  fail_unless( frozen->getWriteErrorLog(scratch) == &scratch );
+  fail_unless( doc.getWriteErrorLog(scratch) == doc.getErrorLog() );
+
+  // edits go to a new copy, and the frozen version is unchanged
+  SedDocument* draft = snapshot.edit();
+  fail_unless( !draft->isFrozen() );
+  draft->getModel(0)->setSource("other.xml");
+  SedDocumentSnapshot next = draft->freeze();
+  delete draft;
+
+  fail_unless( next.getVersion() == 2 );
+  fail_unless( next.getDocument()->getModel(0)->getSource() == "other.xml" );
+  fail_unless( frozen->getModel(0)->getSource() == "model.xml" );
+
+  copy = next;
+  fail_unless( copy.getDocument() == next.getDocument() );
+  fail_unless( snapshot.getDocument() == frozen );
+}
+END_TEST
+
+
+/*
+ * Records the objects visited, and prunes repeated tasks.
+ */
+class RecordingVisitor : public SedVisitor
+{
+public:
+  using SedVisitor::visit;
+  using SedVisitor::leave;
+
+  virtual bool visit(const SedBase& x)
+  {
+    trace << '<' << x.getTypeCode();
+    return true;
+  }
+
+  virtual bool visit(const SedRepeatedTask& x)
+  {
+    trace << "<R";
+    return false;
+  }
+
+  virtual bool visit(const SedSimulation& x)
+  {
+    trace << "<S";
+    return visit(static_cast<const SedBase&>(x));
+  }
+
+  virtual void leave(const SedBase& x)
+  {
+    trace << '>';
+  }
+
+  ostringstream trace;
+};
+
+
+/*
+ * Records the objects visited, and prunes the list of data generators.
+ */
+class ListPruningVisitor : public RecordingVisitor
+{
+public:
+  using RecordingVisitor::enter;
+
+  virtual bool enter(const SedListOf& x, int type)
+  {
+    RecordingVisitor::enter(x, type);
+    return type != SEDML_DATAGENERATOR;
+  }
+};
+
+
+START_TEST (test_visitor_traversal)
+{
+  SedDocument doc;
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->createSubTask();
+  SedDataGenerator* sdg = doc.createDataGenerator();
+  sdg->createVariable();
+
+  RecordingVisitor visitor;
+  fail_unless( doc.accept(visitor) );
+
+  ostringstream expected;
+  expected << '<' << SEDML_DOCUMENT
+           << '<' << SEDML_LIST_OF << '>'                 // data descriptions
+           << '<' << SEDML_LIST_OF                        // simulations
+           << "<S<" << SEDML_SIMULATION_UNIFORMTIMECOURSE
+           << '<' << SEDML_SIMULATION_ALGORITHM
+           << '<' << SEDML_LIST_OF << '>'                 // parameters
+           << ">>>"
+           << '<' << SEDML_LIST_OF << '>'                 // models
+           << '<' << SEDML_LIST_OF << "<R>>"              // tasks, pruned
+           << '<' << SEDML_LIST_OF                        // data generators
+           << '<' << SEDML_DATAGENERATOR
+           << '<' << SEDML_LIST_OF << '<' << SEDML_VARIABLE << ">>"
+           << '<' << SEDML_LIST_OF << '>'
+           << ">>"
+           << '<' << SEDML_LIST_OF << '>'                 // outputs
+           << '>';
+  fail_unless( visitor.trace.str() == expected.str() );
+
+  // lists prune their items
+  ListPruningVisitor listVisitor;
+  fail_unless( doc.accept(listVisitor) );
+
+  ostringstream pruned;
+  pruned << '<' << SEDML_DOCUMENT
+         << '<' << SEDML_LIST_OF << '>'
+         << '<' << SEDML_LIST_OF
+         << "<S<" << SEDML_SIMULATION_UNIFORMTIMECOURSE
+         << '<' << SEDML_SIMULATION_ALGORITHM
+         << '<' << SEDML_LIST_OF << '>'
+         << ">>>"
+         << '<' << SEDML_LIST_OF << '>'
+         << '<' << SEDML_LIST_OF << "<R>>"
+         << '<' << SEDML_LIST_OF << '>'                   // data generators
+         << '<' << SEDML_LIST_OF << '>'
+         << '>';
+  fail_unless( listVisitor.trace.str() == pruned.str() );
+}
+END_TEST
+
+
+START_TEST (test_tree_iteration)
+{
+  SedDocument doc;
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->createAlgorithm();
+  SedDataGenerator* sdg = doc.createDataGenerator();
+  sdg->createVariable();
+  sdg->createVariable();
+  sdg->createParameter();
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->createFunctionalRange()->createVariable();
+
+  fail_unless( doc.elements<SedVariable>().size() == 3 );
+  fail_unless( doc.elements<SedSimulation>().size() == 1 );
+  fail_unless( *doc.elements<SedSimulation>().begin() == sim );
+  fail_unless( sdg->elements<SedParameter>().size() == 1 );
+  fail_unless( doc.elements<SedCurve>().empty() );
+
+  // pre-order starts with the root, post-order ends with it
+  const SedDocument& cdoc = doc;
+  fail_unless( *cdoc.preOrder().begin() == &doc );
+  fail_unless( *cdoc.postOrder().begin() == doc.getListOfDataDescriptions() );
+
+  unsigned int numObjects = 0;
+  const SedBase* last = NULL;
+  SedElementRange<const SedBase, SedPostOrderIterator> post = cdoc.postOrder();
+  for (SedElementRange<const SedBase, SedPostOrderIterator>::iterator it =
+         post.begin(); it != post.end(); ++it, ++numObjects)
+    {
+      last = *it;
+    }
+  fail_unless( last == &doc );
+  fail_unless( numObjects == 24 );
+  fail_unless( cdoc.preOrder().size() == numObjects );
+
+  // skipping the children of the tasks list leaves 8 objects out
+  unsigned int numVisited = 0;
+  for (SedPreOrderIterator it(&doc); it.get() != NULL; ++numVisited)
+    {
+      if (it.get() == repeated->getParentSedObject())
+        it.skipChildren();
+      else
+        ++it;
+    }
+  fail_unless( numVisited == numObjects - 8 );
+
+  // the lists are left out of the elements
+  unsigned int numLists = 0;
+  for (SedPreOrderIterator it(&doc); it.get() != NULL; ++it)
+    {
+      if (it.get()->getTypeCode() == SEDML_LIST_OF) ++numLists;
+    }
+  fail_unless( numLists > 0 );
+
+  List* all = doc.getAllElements();
+  fail_unless( all->getSize() == numObjects - numLists - 1 );
+  fail_unless( static_cast<SedBase*>(all->get(0)) == sim );
+  delete all;
+
+  all = sdg->getAllElements();
+  fail_unless( all->getSize() == 3 );
+  delete all;
+}
+END_TEST
+
+
+/*
+ * Counts the objects visited, and the variables among them.
+ */
+class CountingVisitor : public SedMergeableVisitor
+{
+public:
+  using SedVisitor::visit;
+
+  CountingVisitor() : numObjects(0), numVariables(0), numMerged(0) {}
+
+  virtual bool visit(const SedBase& x)
+  {
+    ++numObjects;
+    return true;
+  }
+
+  virtual bool visit(const SedVariable& x)
+  {
+    ++numVariables;
+    return visit(static_cast<const SedBase&>(x));
+  }
+
+  virtual SedMergeableVisitor* createWorker() const
+  {
+    return new CountingVisitor();
+  }
+
+  virtual void merge(const SedMergeableVisitor& worker)
+  {
+    const CountingVisitor& counts = static_cast<const CountingVisitor&>(worker);
+    numObjects += counts.numObjects;
+    numVariables += counts.numVariables;
+    ++numMerged;
+  }
+
+  unsigned int numObjects;
+  unsigned int numVariables;
+  unsigned int numMerged;
+};
+
+
+/*
+ * Counts the objects visited, pruning the list of data generators.
+ */
+class PruningCountingVisitor : public CountingVisitor
+{
+public:
+  using CountingVisitor::enter;
+
+  virtual bool enter(const SedListOf& x, int type)
+  {
+    CountingVisitor::enter(x, type);
+    return type != SEDML_DATAGENERATOR;
+  }
+
+  virtual SedMergeableVisitor* createWorker() const
+  {
+    return new PruningCountingVisitor();
+  }
+};
+
+
+START_TEST (test_parallel_traversal)
+{
+  SedDocument doc;
+  doc.createUniformTimeCourse()->createAlgorithm();
+
+  for (unsigned int n = 0; n < 200; ++n)
+    {
+      SedDataGenerator* sdg = doc.createDataGenerator();
+      sdg->createVariable();
+      sdg->createParameter();
+      doc.createModel()->createChangeAttribute();
+    }
+
+  CountingVisitor sequential;
+  fail_unless( doc.accept(sequential) );
+
+  SedParallelTraversal traversal;
+  fail_unless( traversal.getNumThreads() >= 1 );
+
+  CountingVisitor parallel;
+  fail_unless( traversal.traverse(doc, parallel) );
+  fail_unless( parallel.numObjects == sequential.numObjects );
+  fail_unless( parallel.numVariables == 200 );
+  fail_unless( parallel.numMerged == traversal.getNumThreads() );
+
+  // pruning a list skips the subtrees of its items, as with accept()
+  PruningCountingVisitor prunedSequential, prunedParallel;
+  fail_unless( doc.accept(prunedSequential) );
+  fail_unless( traversal.traverse(doc, prunedParallel) );
+  fail_unless( prunedParallel.numVariables == 0 );
+  fail_unless( prunedParallel.numObjects == prunedSequential.numObjects );
+  fail_unless( prunedParallel.numObjects < sequential.numObjects );
+}
+END_TEST
+
+
+START_TEST (test_deferred_connect)
+{
+  SedDocument doc;
+  SedDataGenerator* sdg = NULL;
+  SedVariable* var = NULL;
+
+  {
+    SedDeferredConnect deferred(&doc);
+    fail_unless( SedDeferredConnect::isActive() );
+
+    sdg = doc.createDataGenerator();
+    var = sdg->createVariable();
+
+    fail_unless( sdg->getSedDocument() == NULL );
+    fail_unless( var->getSedDocument() == NULL );
+    fail_unless( var->getParentSedObject() != NULL );
+    fail_unless( var->getParentSedObject()->getParentSedObject() == sdg );
+  }
+
+  fail_unless( !SedDeferredConnect::isActive() );
+  fail_unless( sdg->getSedDocument() == &doc );
+  fail_unless( var->getSedDocument() == &doc );
+
+  // without deferral, objects are linked to the document when added
+  SedVariable* other = sdg->createVariable();
+  fail_unless( other->getSedDocument() == &doc );
+}
+END_TEST
+
+
+START_TEST (test_math_program)
+{
+  SedDataGenerator sdg;
+  sdg.createVariable()->setId("v");
+  sdg.createVariable()->setId("w");
+  SedParameter* p = sdg.createParameter();
+  p->setId("p");
+  p->setValue(0.5);
+
+  ASTNode* math = SBML_parseL3Formula(
+    "p * v + sin(v) / 2 + piecewise(v^2, v > w, log10(w + 1)) + (4 * p)^2");
+  sdg.setMath(math);
+  delete math;
+
+  SedMathProgram program;
+  fail_unless( program.compile(sdg) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( program.getNumInputs() == 2 );
+  fail_unless( program.getInputId(1) == "w" );
+
+  const unsigned int numPoints = 1000;
+  std::vector<double> v(numPoints), w(numPoints), result(numPoints);
+
+  for (unsigned int n = 0; n < numPoints; ++n)
+    {
+      v[n] = n * 0.01;
+      w[n] = 5.0 - n * 0.007;
+    }
+
+  const double* inputs[2] = { &v[0], &w[0] };
+  fail_unless( program.evaluate(inputs, numPoints, &result[0])
+               == LIBSEDML_OPERATION_SUCCESS );
+
+  for (unsigned int n = 0; n < numPoints; ++n)
+    {
+      double expected = 0.5 * v[n] + sin(v[n]) / 2
+                        + ((v[n] > w[n]) ? v[n] * v[n] : log10(w[n] + 1)) + 4;
+      fail_unless( fabs(result[n] - expected) < 1e-12 );
+    }
+
+  double values[2] = { 1.0, 2.0 };
+  fail_unless( fabs(program.evaluate(values)
+                    - (0.5 + sin(1.0) / 2 + log10(3.0) + 4)) < 1e-12 );
+
+  math = SBML_parseL3Formula("v + unknown");
+  sdg.setMath(math);
+  delete math;
+
+  fail_unless( program.compile(sdg) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( !program.isCompiled() );
+  fail_unless( program.getErrorMessage() == "unknown name 'unknown'" );
+  fail_unless( program.evaluate(inputs, numPoints, &result[0])
+               == LIBSEDML_INVALID_OBJECT );
+}
+END_TEST
+
+
+START_TEST (test_range_values)
+{
+  SedDocument doc;
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setRangeId("u");
+
+  SedUniformRange* uniform = repeated->createUniformRange();
+  uniform->setId("u");
+  uniform->setStart(0);
+  uniform->setEnd(1);
+  uniform->setNumberOfPoints(1000);
+
+  SedUniformRange* logRange = repeated->createUniformRange();
+  logRange->setId("l");
+  logRange->setStart(1);
+  logRange->setEnd(1000);
+  logRange->setNumberOfPoints(3);
+  logRange->setType("log");
+
+  SedVectorRange* vectorRange = repeated->createVectorRange();
+  vectorRange->setId("v");
+  vectorRange->addValue(3);
+  vectorRange->addValue(5);
+
+  SedFunctionalRange* functional = repeated->createFunctionalRange();
+  functional->setId("f");
+  functional->setRange("u");
+  functional->createVariable()->setId("x");
+  SedParameter* k = functional->createParameter();
+  k->setId("k");
+  k->setValue(2);
+
+  ASTNode* math = SBML_parseL3Formula("k * u + x");
+  functional->setMath(math);
+  delete math;
+
+  SedRangeValues values;
+  std::vector<double> all;
+
+  fail_unless( values.setRange(*uniform) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( values.getSize() == 1001 );
+  fail_unless( values.getValues(all) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( all[0] == 0 && all[1000] == 1 && all[500] == 0.5 );
+
+  fail_unless( values.setRange(*logRange) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( values.getSize() == 4 );
+  fail_unless( values.getValue(0) == 1 && values.getValue(3) == 1000 );
+  fail_unless( fabs(values.getValue(2) - 100) < 1e-12 );
+
+  // the values of a vector range are not copied
+  double buffer[SEDML_MATH_BLOCK_SIZE];
+  fail_unless( values.setRange(*vectorRange) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( values.getSize() == 2 );
+  fail_unless( values.getValues(1, 1, buffer) == &vectorRange->getValues()[1] );
+
+  fail_unless( values.setRange(*functional) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( values.getSize() == 1001 );
+  fail_unless( values.getValue(3) != values.getValue(3) );   // x is NaN
+  fail_unless( values.setVariableValue("x", 1) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( values.setVariableValue("y", 1) == LIBSEDML_INVALID_OBJECT );
+
+  // streamed in chunks, as the whole range at once
+  values.getValues(all);
+  for (unsigned int first = 0; first < values.getSize();
+       first += SEDML_MATH_BLOCK_SIZE)
+    {
+      unsigned int count = values.getSize() - first;
+      if (count > SEDML_MATH_BLOCK_SIZE) count = SEDML_MATH_BLOCK_SIZE;
+
+      const double* chunk = values.getValues(first, count, buffer);
+      fail_unless( chunk == buffer );
+
+      for (unsigned int n = 0; n < count; ++n)
+        {
+          fail_unless( chunk[n] == all[first + n] );
+          fail_unless( fabs(chunk[n] - (2 * (first + n) / 1000.0 + 1)) < 1e-12 );
+        }
+    }
+  fail_unless( values.getValues(1000, 2, buffer) == NULL );
+
+  // without a range of its own, a functional range follows the repeated task
+  functional->unsetRange();
+  fail_unless( values.setRange(*functional) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( values.getSize() == 1001 );
+
+  functional->setRange("f");
+  fail_unless( values.setRange(*functional) == LIBSEDML_INVALID_OBJECT );
+  fail_unless( values.getSize() == 0 );
+
+  logRange->setType("cubic");
+  fail_unless( values.setRange(*logRange) == LIBSEDML_INVALID_OBJECT );
+  fail_unless( values.getErrorMessage() == "unknown type 'cubic'" );
+}
+END_TEST
+
+
+START_TEST (test_task_plan)
+{
+  SedDocument doc;
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setNumberOfPoints(100);
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setSimulationReference("sim");
+
+  // inner: three iterations over a vector range, resetting the model
+  SedRepeatedTask* inner = doc.createRepeatedTask();
+  inner->setId("inner");
+  inner->setRangeId("v");
+  inner->setResetModel(true);
+  SedVectorRange* vectorRange = inner->createVectorRange();
+  vectorRange->setId("v");
+  vectorRange->addValue(3);
+  vectorRange->addValue(5);
+  vectorRange->addValue(7);
+  inner->createSubTask()->setTask("task");
+
+  SedSetValue* change = inner->createTaskChange();
+  change->setTarget("k");
+  ASTNode* math = SBML_parseL3Formula("v * 10");
+  change->setMath(math);
+  delete math;
+
+  // outer: two iterations, running inner after task
+  SedRepeatedTask* outer = doc.createRepeatedTask();
+  outer->setId("outer");
+  outer->setRangeId("u");
+  SedUniformRange* uniform = outer->createUniformRange();
+  uniform->setId("u");
+  uniform->setStart(0);
+  uniform->setEnd(1);
+  uniform->setNumberOfPoints(1);
+  SedSubTask* subTask = outer->createSubTask();
+  subTask->setTask("inner");
+  subTask->setOrder(2);
+  subTask = outer->createSubTask();
+  subTask->setTask("task");
+  subTask->setOrder(1);
+
+  SedTaskPlan plan;
+  fail_unless( plan.compile(*outer) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( plan.getNumRuns() == 8 );
+  fail_unless( plan.getNumIterations() == 8 );
+  fail_unless( plan.getNumPoints() == 8 * 101 );
+  fail_unless( plan.getMaxDepth() == 2 );
+
+  ostringstream trace;
+  SedTaskPlanStep step(plan);
+  while (step.next())
+    {
+      fail_unless( step.getTask() == task );
+      trace << step.getFirstNewIteration() << step.getDepth();
+      if (step.getDepth() == 2)
+        trace << '@' << step.getChangeValue(1, 0);
+      trace << ' ';
+    }
+  fail_unless( step.getTask() == NULL );
+  fail_unless( trace.str() == "01 12@30 12@50 12@70 01 12@30 12@50 12@70 " );
+
+  // a task that is not repeated is run once
+  fail_unless( plan.compile(*task) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( plan.getNumRuns() == 1 );
+  SedTaskPlanStep single(plan);
+  fail_unless( single.next() && single.getDepth() == 0 );
+  fail_unless( !single.next() );
+
+  // a repeated task cannot contain itself
+  inner->createSubTask()->setTask("outer");
+  fail_unless( plan.compile(*outer) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( !plan.isCompiled() );
+  fail_unless( plan.getErrorMessage()
+               == "repeated task 'outer' is one of its own subtasks" );
+}
+END_TEST
+
+
+START_TEST (test_dependency_graph)
+{
+  SedDocument doc;
+  SedModel* m1 = doc.createModel();
+  m1->setId("m1");
+  SedModel* m2 = doc.createModel();
+  m2->setId("m2");
+  m2->setSource("#m1");
+  doc.createUniformTimeCourse()->setId("sim");
+
+  const char* models[] = { "m1", "m2", "m1", "unknown" };
+  for (unsigned int n = 0; n < 4; ++n)
+    {
+      ostringstream id;
+      id << "t" << n;
+      SedTask* task = doc.createTask();
+      task->setId(id.str());
+      task->setModelReference(models[n]);
+      task->setSimulationReference("sim");
+
+      ostringstream generatorId;
+      generatorId << "dg" << n;
+      SedDataGenerator* generator = doc.createDataGenerator();
+      generator->setId(generatorId.str());
+      generator->createVariable()->setTaskReference(id.str());
+    }
+
+  SedPlot2D* plot = doc.createPlot2D();
+  plot->setId("plot");
+  SedCurve* curve = plot->createCurve();
+  curve->setXDataReference("dg0");
+  curve->setYDataReference("dg1");
+  SedReport* report = doc.createReport();
+  report->setId("report");
+  report->createDataSet()->setDataReference("dg2");
+
+  SedDependencyGraph graph;
+  fail_unless( graph.build(doc) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( graph.getNumNodes() == 2 + 1 + 4 + 8 + 2 );
+  fail_unless( graph.getNumUnresolved() == 1 );
+  fail_unless( graph.getUnresolved(0)
+               == "task 't3' references unknown model 'unknown'" );
+
+  int sim = graph.getIndex(doc.getSimulation("sim"));
+  fail_unless( graph.getNumDependents(sim) == 4 );
+
+  // the plot needs two tasks out of four, each after what it needs
+  std::vector<const SedBase*> targets(1, plot);
+  std::vector<const SedBase*> order;
+  fail_unless( graph.schedule(targets, order) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( order.size() == 10 );
+  fail_unless( order.back() == plot );
+
+  ostringstream tasks;
+  for (size_t n = 0; n < order.size(); ++n)
+    {
+      if (order[n]->getTypeCode() == SEDML_TASK) tasks << order[n]->getId();
+
+      int node = graph.getIndex(order[n]);
+      for (unsigned int i = 0; i < graph.getNumDependencies(node); ++i)
+        {
+          const SedBase* needed = graph.getNode(graph.getDependency(node, i));
+          fail_unless( std::find(order.begin(), order.begin() + n, needed)
+                       != order.begin() + n );
+        }
+    }
+  fail_unless( tasks.str() == "t0t1" );
+
+  fail_unless( graph.schedule(order) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( order.size() == graph.getNumNodes() );
+
+  targets[0] = &doc;
+  fail_unless( graph.schedule(targets, order) == LIBSEDML_INVALID_OBJECT );
+
+  // models derived from each other
+  m1->setSource("m2");
+  graph.build(doc);
+  targets[0] = report;
+  fail_unless( graph.schedule(targets, order) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( order.empty() );
+}
+END_TEST
+
+
+/*
+ * Keeps the last value of each variable of each run, by run.
+ */
+class TestExecutionListener : public SedExecutionListener
+{
+public:
+  virtual void runFinished(const SedSimulationRun& run,
+                           const SedSimulationResult& result)
+  {
+    ostringstream key;
+    key << run.getTask()->getId() << run.getIndex();
+    std::vector<double>& values = mValues[key.str()];
+
+    for (unsigned int n = 0; n < result.getNumColumns(); ++n)
+      {
+        values.push_back(result.getColumn(n)[result.getNumPoints() - 1]);
+      }
+  }
+
+  virtual void runFailed(const SedSimulationRun&, const std::string& message)
+  {
+    mFailures.push_back(message);
+  }
+
+  std::map<std::string, std::vector<double> > mValues;
+  std::vector<std::string> mFailures;
+};
+
+
+START_TEST (test_task_executor)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->setLanguage("urn:sedml:language:sbml");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(10);
+  sim->setNumberOfPoints(10);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("sim");
+
+  // a sweep resetting the model, whose iterations are spread over threads
+  SedRepeatedTask* sweep = doc.createRepeatedTask();
+  sweep->setId("sweep");
+  sweep->setRangeId("r");
+  sweep->setResetModel(true);
+  SedUniformRange* uniform = sweep->createUniformRange();
+  uniform->setId("r");
+  uniform->setStart(0);
+  uniform->setEnd(99);
+  uniform->setNumberOfPoints(99);
+  sweep->createSubTask()->setTask("task");
+  SedSetValue* change = sweep->createTaskChange();
+  change->setModelReference("model");
+  change->setTarget("k");
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+
+  // a sweep continuing from the state of the previous iteration
+  SedRepeatedTask* series = doc.createRepeatedTask();
+  series->setId("series");
+  series->setRangeId("v");
+  SedVectorRange* vectorRange = series->createVectorRange();
+  vectorRange->setId("v");
+  vectorRange->addValue(1);
+  vectorRange->addValue(2);
+  series->createSubTask()->setTask("task");
+
+  SedDataGenerator* generator = doc.createDataGenerator();
+  generator->setId("dg");
+  SedVariable* variable = generator->createVariable();
+  variable->setSymbol("urn:sedml:symbol:time");
+  variable->setTaskReference("task");
+  variable = generator->createVariable();
+  variable->setTarget("k");
+  variable->setTaskReference("sweep");
+  variable = generator->createVariable();
+  variable->setTarget("x");
+  variable->setTaskReference("sweep");
+  variable = generator->createVariable();
+  variable->setTarget("x");
+  variable->setTaskReference("series");
+
+  SedMockBackend backend;
+  SedTaskExecutor executor;
+  fail_unless( executor.addBackend(&backend) == LIBSEDML_OPERATION_SUCCESS );
+
+  std::vector<const SedTask*> tasks;
+  tasks.push_back(task);
+  tasks.push_back(sweep);
+  tasks.push_back(series);
+
+  TestExecutionListener listener;
+  fail_unless( executor.execute(tasks, listener)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( listener.mValues.size() == 1 + 100 + 2 );
+  fail_unless( listener.mFailures.empty() );
+  fail_unless( listener.mValues["task0"].size() == 1 );
+  fail_unless( listener.mValues["task0"][0] == 10 );
+
+  double x = SedMockBackend::getValue("x", 10, 0);
+  for (unsigned int n = 0; n < 100; ++n)
+    {
+      ostringstream key;
+      key << "sweep" << n;
+      const std::vector<double>& values = listener.mValues[key.str()];
+      fail_unless( values.size() == 2 );
+      fail_unless( values[0] == n );
+      fail_unless( values[1] == x );
+    }
+  fail_unless( listener.mValues["series0"][0] == x );
+  fail_unless( listener.mValues["series1"][0] == x + 1 );
+
+  // the tasks needed by an output
+  SedReport* report = doc.createReport();
+  report->createDataSet()->setDataReference("dg");
+  std::vector<const SedBase*> outputs(1, report);
+  fail_unless( SedTaskExecutor::findTasks(doc, outputs, tasks)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( tasks.size() == 3 );
+
+  // changes using variables of the model cannot be computed
+  change->createVariable()->setId("y");
+  TestExecutionListener failing;
+  fail_unless( executor.execute(tasks, failing)
+               == LIBSEDML_OPERATION_FAILED );
+  fail_unless( failing.mFailures.size() == 100 );
+  fail_unless( failing.mFailures[0] == "change of 'k' of repeated task "
+                                       "'sweep' uses variables of the model" );
+
+  // no backend for the language
+  SedMockBackend cellml("urn:sedml:language:cellml");
+  SedTaskExecutor other(1);
+  other.addBackend(&cellml);
+  fail_unless( other.execute(tasks, failing) == LIBSEDML_INVALID_OBJECT );
+}
+END_TEST
+
+
+START_TEST (test_sbml_backend)
+{
+  // A -> B at rate k * A, in a compartment of size 2
+  const char* sbml =
+    "<?xml version='1.0' encoding='UTF-8'?>"
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    " <model id='decay'>"
+    "  <listOfCompartments>"
+    "   <compartment id='C' size='2' constant='true'/>"
+    "  </listOfCompartments>"
+    "  <listOfSpecies>"
+    "   <species id='A' compartment='C' initialConcentration='1' hasOnlySubstanceUnits='false' boundaryCondition='false' constant='false'/>"
+    "   <species id='B' compartment='C' initialConcentration='0' hasOnlySubstanceUnits='false' boundaryCondition='false' constant='false'/>"
+    "  </listOfSpecies>"
+    "  <listOfParameters>"
+    "   <parameter id='k' value='0.5' constant='true'/>"
+    "   <parameter id='total' constant='false'/>"
+    "  </listOfParameters>"
+    "  <listOfRules>"
+    "   <assignmentRule variable='total'>"
+    "    <math xmlns='http://www.w3.org/1998/Math/MathML'><apply><plus/><ci>A</ci><ci>B</ci></apply></math>"
+    "   </assignmentRule>"
+    "  </listOfRules>"
+    "  <listOfReactions>"
+    "   <reaction id='r1' reversible='false' fast='false'>"
+    "    <listOfReactants><speciesReference species='A' stoichiometry='1' constant='true'/></listOfReactants>"
+    "    <listOfProducts><speciesReference species='B' stoichiometry='1' constant='true'/></listOfProducts>"
+    "    <kineticLaw>"
+    "     <math xmlns='http://www.w3.org/1998/Math/MathML'><apply><times/><ci>k</ci><ci>A</ci><ci>C</ci></apply></math>"
+    "    </kineticLaw>"
+    "   </reaction>"
+    "  </listOfReactions>"
+    " </model>"
+    "</sbml>";
+
+  SBMLDocument* decay = readSBMLFromString(sbml);
+  fail_unless( decay->getNumErrors(LIBSBML_SEV_ERROR) == 0 );
+
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->setLanguage("urn:sedml:language:sbml.level-3.version-1");
+  model->setSource("decay.xml");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(2);
+  sim->setNumberOfPoints(4);
+  SedAlgorithm* algorithm = sim->createAlgorithm();
+  algorithm->setKisaoID("KISAO:0000087");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("sim");
+
+  // the iterations of the sweep are integrated as an ensemble
+  SedRepeatedTask* sweep = doc.createRepeatedTask();
+  sweep->setId("sweep");
+  sweep->setRangeId("r");
+  sweep->setResetModel(true);
+  SedUniformRange* uniform = sweep->createUniformRange();
+  uniform->setId("r");
+  uniform->setStart(0);
+  uniform->setEnd(1);
+  uniform->setNumberOfPoints(10);
+  sweep->createSubTask()->setTask("task");
+  SedSetValue* change = sweep->createTaskChange();
+  change->setModelReference("model");
+  change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']");
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+
+  SedDataGenerator* generator = doc.createDataGenerator();
+  generator->setId("dg");
+  SedVariable* variable = generator->createVariable();
+  variable->setId("A");
+  variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='A']");
+  variable->setTaskReference("task");
+  variable = generator->createVariable();
+  variable->setId("total");
+  variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='total']");
+  variable->setTaskReference("task");
+  variable = generator->createVariable();
+  variable->setId("A_sweep");
+  variable->setTarget("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='A']");
+  variable->setTaskReference("sweep");
+
+  SedSbmlBackend backend;
+  fail_unless( backend.addDocument("decay.xml", decay) == LIBSEDML_OPERATION_SUCCESS );
+  delete decay;
+  fail_unless( backend.supports("urn:sedml:language:sbml", "KISAO:0000033") );
+  fail_unless( !backend.supports("urn:sedml:language:sbml", "KISAO:0000029") );
+  fail_unless( !backend.supports("urn:sedml:language:cellml", "") );
+
+  SedTaskExecutor executor;
+  executor.addBackend(&backend);
+  std::vector<const SedTask*> tasks;
+  tasks.push_back(task);
+  tasks.push_back(sweep);
+
+  // the Dormand-Prince method, then the Rosenbrock method
+  const char* methods[] = { "KISAO:0000087", "KISAO:0000033" };
+  for (unsigned int m = 0; m < 2; ++m)
+    {
+      algorithm->setKisaoID(methods[m]);
+
+      TestExecutionListener listener;
+      fail_unless( executor.execute(tasks, listener)
+                   == LIBSEDML_OPERATION_SUCCESS );
+      fail_unless( listener.mValues.size() == 1 + 11 );
+      fail_unless( fabs(listener.mValues["task0"][0] - exp(-1.0)) < 1e-5 );
+      fail_unless( fabs(listener.mValues["task0"][1] - 1) < 1e-9 );
+
+      for (unsigned int n = 0; n <= 10; ++n)
+        {
+          ostringstream key;
+          key << "sweep" << n;
+          fail_unless( fabs(listener.mValues[key.str()][0] - exp(-0.2 * n))
+                       < 1e-5 );
+        }
+    }
+
+  // a model that cannot be read fails its runs
+  model->setSource("missing.xml");
+  TestExecutionListener failing;
+  fail_unless( executor.execute(tasks, failing) == LIBSEDML_OPERATION_FAILED );
+  fail_unless( failing.mFailures.size() == 12 );
+
+  SedOdeSolver solver;
+  fail_unless( solver.setRelativeTolerance(0) == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( solver.getMethod() == SEDML_ODE_DORMAND_PRINCE );
+}
+END_TEST
+
+
+START_TEST (test_sbml_conversion_factor)
+{
+  // A -> B at rate k * A, in amounts; the conversion factor of the model
+  // (3) scales the rate of A, and that of B (2) the rate of B; k has an
+  // initial assignment, which the changes of the sweep replace
+  const char* sbml =
+    "<?xml version='1.0' encoding='UTF-8'?>"
+    "<sbml xmlns='http://www.sbml.org/sbml/level3/version1/core' level='3' version='1'>"
+    " <model id='convert' conversionFactor='g'>"
+    "  <listOfCompartments>"
+    "   <compartment id='C' size='1' constant='true'/>"
+    "  </listOfCompartments>"
+    "  <listOfSpecies>"
+    "   <species id='A' compartment='C' initialAmount='1' hasOnlySubstanceUnits='true' boundaryCondition='false' constant='false'/>"
+    "   <species id='B' compartment='C' initialAmount='0' hasOnlySubstanceUnits='true' boundaryCondition='false' constant='false' conversionFactor='f'/>"
+    "  </listOfSpecies>"
+    "  <listOfParameters>"
+    "   <parameter id='k' value='1' constant='true'/>"
+    "   <parameter id='f' value='2' constant='true'/>"
+    "   <parameter id='g' value='3' constant='true'/>"
+    "  </listOfParameters>"
+    "  <listOfInitialAssignments>"
+    "   <initialAssignment symbol='k'>"
+    "    <math xmlns='http://www.w3.org/1998/Math/MathML'><cn>0.1</cn></math>"
+    "   </initialAssignment>"
+    "  </listOfInitialAssignments>"
+    "  <listOfReactions>"
+    "   <reaction id='r1' reversible='false' fast='false'>"
+    "    <listOfReactants><speciesReference species='A' stoichiometry='1' constant='true'/></listOfReactants>"
+    "    <listOfProducts><speciesReference species='B' stoichiometry='1' constant='true'/></listOfProducts>"
+    "    <kineticLaw>"
+    "     <math xmlns='http://www.w3.org/1998/Math/MathML'><apply><times/><ci>k</ci><ci>A</ci></apply></math>"
+    "    </kineticLaw>"
+    "   </reaction>"
+    "  </listOfReactions>"
+    " </model>"
+    "</sbml>";
+
+  SBMLDocument* convert = readSBMLFromString(sbml);
+  fail_unless( convert->getNumErrors(LIBSBML_SEV_ERROR) == 0 );
+
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->setLanguage("urn:sedml:language:sbml.level-3.version-1");
+  model->setSource("convert.xml");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(1);
+  sim->setNumberOfPoints(4);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000087");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("sim");
+
+  SedRepeatedTask* sweep = doc.createRepeatedTask();
+  sweep->setId("sweep");
+  sweep->setRangeId("r");
+  sweep->setResetModel(true);
+  SedUniformRange* uniform = sweep->createUniformRange();
+  uniform->setId("r");
+  uniform->setStart(0);
+  uniform->setEnd(1);
+  uniform->setNumberOfPoints(10);
+  sweep->createSubTask()->setTask("task");
+  SedSetValue* change = sweep->createTaskChange();
+  change->setModelReference("model");
+  change->setTarget("/sbml:sbml/sbml:model/sbml:listOfParameters/sbml:parameter[@id='k']");
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+
+  SedDataGenerator* generator = doc.createDataGenerator();
+  generator->setId("dg");
+  const char* targets[] = { "A", "B" };
+  const char* taskIds[] = { "task", "sweep" };
+  for (unsigned int t = 0; t < 2; ++t)
+    {
+      for (unsigned int n = 0; n < 2; ++n)
+        {
+          SedVariable* variable = generator->createVariable();
+          variable->setId(string(targets[n]) + "_" + taskIds[t]);
+          variable->setTarget(string("/sbml:sbml/sbml:model/sbml:listOfSpecies/sbml:species[@id='")
+                              + targets[n] + "']");
+          variable->setTaskReference(taskIds[t]);
+        }
+    }
+
+  SedSbmlBackend backend;
+  fail_unless( backend.addDocument("convert.xml", convert) == LIBSEDML_OPERATION_SUCCESS );
+  delete convert;
+
+  SedTaskExecutor executor;
+  executor.addBackend(&backend);
+  std::vector<const SedTask*> tasks;
+  tasks.push_back(task);
+  tasks.push_back(sweep);
+
+  TestExecutionListener listener;
+  fail_unless( executor.execute(tasks, listener) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( listener.mFailures.empty() );
+
+  // dA/dt = -3 k A and dB/dt = 2 k A, so B = 2 (1 - A) / 3
+  double a = exp(-0.3);
+  fail_unless( fabs(listener.mValues["task0"][0] - a) < 1e-5 );
+  fail_unless( fabs(listener.mValues["task0"][1] - 2 * (1 - a) / 3) < 1e-5 );
+
+  for (unsigned int n = 0; n <= 10; ++n)
+    {
+      ostringstream key;
+      key << "sweep" << n;
+      a = exp(-0.3 * n);
+      fail_unless( fabs(listener.mValues[key.str()][0] - a) < 1e-5 );
+      fail_unless( fabs(listener.mValues[key.str()][1] - 2 * (1 - a) / 3)
+                   < 1e-5 );
+    }
+}
+END_TEST
+
+
+START_TEST (test_resample)
+{
+  SedResampler resampler;
+  fail_unless( resampler.setGrid(0, 2, 5) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( resampler.getNumPoints() == 5 );
+  fail_unless( resampler.getTime(4) == 2 );
+  fail_unless( resampler.setGrid(1, 0, 5) == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+
+  // irregular time points, as an adaptive integrator reports them
+  double times[] = { 0, 0.13, 0.4, 0.45, 1.1, 1.6, 2 };
+  double line[7], square[7];
+  for (unsigned int i = 0; i < 7; ++i)
+    {
+      line[i] = 3 * times[i] - 1;
+      square[i] = times[i] * times[i];
+    }
+
+  const double* columns[] = { line, square };
+  double lineOut[5], squareOut[5];
+  double* results[] = { lineOut, squareOut };
+
+  double linearError = 0;
+  SedResampleMethod_t methods[] = { SEDML_RESAMPLE_LINEAR,
+                                    SEDML_RESAMPLE_HERMITE };
+  for (unsigned int m = 0; m < 2; ++m)
+    {
+      fail_unless( resampler.setMethod(methods[m]) == LIBSEDML_OPERATION_SUCCESS );
+      fail_unless( resampler.resample(times, 7, columns, 2, results)
+                   == LIBSEDML_OPERATION_SUCCESS );
+
+      double error = 0;
+      for (unsigned int p = 0; p < 5; ++p)
+        {
+          double t = resampler.getTime(p);
+          fail_unless( fabs(lineOut[p] - (3 * t - 1)) < 1e-12 );
+          error = max(error, fabs(squareOut[p] - t * t));
+        }
+
+      if (m == 0)
+        linearError = error;
+      else
+        fail_unless( error < 1e-12 && linearError > 1e-3 );
+    }
+
+  // outside the time points, and time points that decrease
+  double inside[] = { 0.5, 1.5 };
+  fail_unless( resampler.resample(inside, 2, columns, 1, results)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( lineOut[0] != lineOut[0] && lineOut[4] != lineOut[4] );
+  fail_unless( fabs(lineOut[2] - 2) < 1e-12 );
+  double decreasing[] = { 0, 2, 1 };
+  fail_unless( resampler.resample(decreasing, 3, columns, 1, results)
+               == LIBSEDML_INVALID_ATTRIBUTE_VALUE );
+
+  // two tasks with different time points, onto the same grid
+  fail_unless( resampler.setGrid(0, 2, 101) == LIBSEDML_OPERATION_SUCCESS );
+  std::vector<double> first(50), second(80), sine(50), cosine(80);
+  for (unsigned int i = 0; i < 50; ++i)
+    {
+      first[i] = 2.0 * i / 49;
+      sine[i] = sin(first[i]);
+    }
+  for (unsigned int i = 0; i < 80; ++i)
+    {
+      second[i] = 2 * pow(i / 79.0, 1.5);
+      cosine[i] = cos(second[i]);
+    }
+
+  const double* alignTimes[] = { &first[0], &second[0] };
+  unsigned int alignNumTimes[] = { 50, 80 };
+  const double* alignColumns[] = { &sine[0], &cosine[0] };
+  std::vector<double> sineOut(101), cosineOut(101);
+  double* alignResults[] = { &sineOut[0], &cosineOut[0] };
+  fail_unless( resampler.align(2, alignTimes, alignNumTimes, alignColumns,
+                               alignResults) == LIBSEDML_OPERATION_SUCCESS );
+  for (unsigned int p = 0; p < 101; ++p)
+    {
+      double t = resampler.getTime(p);
+      fail_unless( fabs(sineOut[p] - sin(t)) < 1e-4 );
+      fail_unless( fabs(cosineOut[p] - cos(t)) < 1e-4 );
+    }
+
+  // the grid of a data generator is that of the time course of its task
+  SedDocument doc;
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setInitialTime(0);
+  sim->setOutputStartTime(1);
+  sim->setOutputEndTime(3);
+  sim->setNumberOfPoints(4);
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setSimulationReference("sim");
+  SedRepeatedTask* repeated = doc.createRepeatedTask();
+  repeated->setId("repeated");
+  repeated->createSubTask()->setTask("task");
+
+  SedDataGenerator* generator = doc.createDataGenerator();
+  generator->setId("dg");
+  generator->createVariable()->setTaskReference("repeated");
+  fail_unless( resampler.setGrid(*generator) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( resampler.getNumPoints() == 5 );
+  fail_unless( resampler.getTime(1) == 1.5 );
+  fail_unless( resampler.getTime(4) == 3 );
+}
+END_TEST
+
+
+START_TEST (test_result_store)
+{
+  SedDocument doc;
+
+  // a sweep of 3 values around a sweep of 4 values
+  createSweep(doc, "inner", 3, 3, "k");
+
+  SedRepeatedTask* outer = doc.createRepeatedTask();
+  outer->setId("outer");
+  outer->setRangeId("v");
+  outer->setResetModel(true);
+  SedVectorRange* vectorRange = outer->createVectorRange();
+  vectorRange->setId("v");
+  vectorRange->addValue(10);
+  vectorRange->addValue(20);
+  vectorRange->addValue(30);
+  outer->createSubTask()->setTask("inner");
+
+  SedDataGenerator* generator = doc.createDataGenerator();
+  generator->setId("dg");
+  SedVariable* variable = generator->createVariable();
+  variable->setId("k");
+  variable->setTarget("k");
+  variable->setTaskReference("outer");
+  variable = generator->createVariable();
+  variable->setId("t");
+  variable->setSymbol("urn:sedml:symbol:time");
+  variable->setTaskReference("outer");
+  ASTNode* math = SBML_parseL3Formula("k + t");
+  generator->setMath(math);
+  delete math;
+
+  SedDataGenerator* time = doc.createDataGenerator();
+  time->setId("time");
+  variable = time->createVariable();
+  variable->setId("t");
+  variable->setSymbol("urn:sedml:symbol:time");
+  variable->setTaskReference("outer");
+  math = SBML_parseL3Formula("t");
+  time->setMath(math);
+  delete math;
+
+  SedTaskPlan plan;
+  fail_unless( plan.compile(*outer) == LIBSEDML_OPERATION_SUCCESS );
+  std::vector<unsigned int> shape;
+  plan.getShape(shape);
+  fail_unless( shape.size() == 3 );
+  fail_unless( shape[0] == 3 && shape[1] == 4 && shape[2] == 11 );
+
+  SedMockBackend backend;
+  SedTaskExecutor executor(2);
+  executor.addBackend(&backend);
+  std::vector<const SedTask*> tasks;
+  tasks.push_back(outer);
+
+  SedResultStore store;
+  fail_unless( executor.execute(tasks, store) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( store.getNumTasks() == 1 );
+  fail_unless( store.getNumVariables("outer") == 2 );
+
+  // the values of k form a contiguous 3 x 4 x 11 tensor
+  SedResultSlice k = store.getSlice(*generator->getVariable(0));
+  fail_unless( k.getNumDimensions() == 3 );
+  fail_unless( k.getNumValues() == 3 * 4 * 11 );
+  fail_unless( k.isContiguous() );
+  std::vector<unsigned int> indices(3);
+  indices[0] = 2;
+  indices[1] = 1;
+  indices[2] = 5;
+  fail_unless( k.getValue(indices) == 1 );
+
+  // the time course of one iteration, and one point of every iteration
+  SedResultSlice course = k.select(0, 2).select(0, 3);
+  fail_unless( course.getNumDimensions() == 1 && course.getExtent(0) == 11 );
+  fail_unless( course.isContiguous() && course.getData()[10] == 3 );
+  SedResultSlice point = k.select(2, 5);
+  fail_unless( !point.isContiguous() );
+  fail_unless( point.getData()[point.getStride(0) + 2 * point.getStride(1)] == 2 );
+
+  SedMathProgram program;
+  fail_unless( program.compile(*generator) == LIBSEDML_OPERATION_SUCCESS );
+  size_t memoryUsage = store.getMemoryUsage();
+  SedResultSlice slice;
+  fail_unless( store.evaluate(*generator, program, slice)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( slice.getNumValues() == 3 * 4 * 11 );
+  fail_unless( slice.getValue(indices) == 1 + 5 );
+  fail_unless( store.getMemoryUsage() == memoryUsage + 3 * 4 * 11 * sizeof(double) );
+
+  // evaluating again reuses the values of the generator
+  const double* data = slice.getData();
+  fail_unless( store.evaluate(*generator, program, slice)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( slice.getData() == data );
+  fail_unless( store.getMemoryUsage() == memoryUsage + 3 * 4 * 11 * sizeof(double) );
+
+  // a generator that is a variable reads the store
+  fail_unless( program.compile(*time) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( store.evaluate(*time, program, slice)
+               == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( slice.getData() == store.getSlice("outer", "urn:sedml:symbol:time").getData() );
+
+  fail_unless( store.getSlice("outer", "x").getData() == NULL );
+  store.clear();
+  fail_unless( store.getNumTasks() == 0 );
+}
+END_TEST
+
+
+START_TEST (test_result_spill)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->setLanguage("urn:sedml:language:sbml");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(10);
+  sim->setNumberOfPoints(10);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("sim");
+
+  SedRepeatedTask* sweep = doc.createRepeatedTask();
+  sweep->setId("sweep");
+  sweep->setRangeId("r");
+  sweep->setResetModel(true);
+  SedUniformRange* uniform = sweep->createUniformRange();
+  uniform->setId("r");
+  uniform->setStart(0);
+  uniform->setEnd(9);
+  uniform->setNumberOfPoints(9);
+  sweep->createSubTask()->setTask("task");
+  SedSetValue* change = sweep->createTaskChange();
+  change->setModelReference("model");
+  change->setTarget("k");
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+
+  // three tensors of 10 x 11 values
+  SedDataGenerator* generator = doc.createDataGenerator();
+  generator->setId("dg");
+  const char* targets[] = { "k", "x", "y" };
+  for (unsigned int n = 0; n < 3; ++n)
+    {
+      SedVariable* variable = generator->createVariable();
+      variable->setId(targets[n]);
+      variable->setTarget(targets[n]);
+      variable->setTaskReference("sweep");
+    }
+
+  SedMockBackend backend;
+  SedTaskExecutor executor(2);
+  executor.addBackend(&backend);
+  std::vector<const SedTask*> tasks;
+  tasks.push_back(sweep);
+
+  // room for two of the tensors: the least recently used one is spilled
+  const size_t bytes = 10 * 11 * sizeof(double);
+  SedResultStore store;
+  fail_unless( store.setMemoryBudget(2 * bytes + 100) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( store.getMemoryBudget() == 2 * bytes + 100 );
+  fail_unless( executor.execute(tasks, store) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( store.getErrorMessage().empty() );
+  fail_unless( store.getMemoryUsage() == 2 * bytes );
+  fail_unless( store.getSpilledSize() == bytes );
+
+  for (unsigned int pass = 0; pass < 2; ++pass)
+    {
+      SedResultSlice k = store.getSlice("sweep", "k");
+      SedResultSlice x = store.getSlice("sweep", "x");
+      fail_unless( k.getNumValues() == 10 * 11 && x.getNumValues() == 10 * 11 );
+
+      for (unsigned int i = 0; i < 10; ++i)
+        {
+          for (unsigned int p = 0; p < 11; ++p)
+            {
+              fail_unless( k.getData()[i * 11 + p] == i );
+              fail_unless( x.getData()[i * 11 + p]
+                           == SedMockBackend::getValue("x", p, 0) );
+            }
+        }
+
+      // everything spilled, and still readable through the same slices
+      fail_unless( store.setMemoryBudget(1) == LIBSEDML_OPERATION_SUCCESS );
+      fail_unless( store.getMemoryUsage() == 0 );
+      fail_unless( store.getSpilledSize() == 3 * bytes );
+      fail_unless( store.getSlice("sweep", "k").getData() == k.getData() );
+      fail_unless( k.getData()[10 * 11 - 1] == 9 );
+    }
+
+  store.clear();
+  fail_unless( store.getSpilledSize() == 0 );
+
+  // tensors larger than the budget go straight to files, leaving the
+  // smaller ones in memory
+  SedVariable* point = generator->createVariable();
+  point->setId("kt");
+  point->setTarget("k");
+  point->setTaskReference("task");
+  tasks.insert(tasks.begin(), doc.getTask("task"));
+  fail_unless( store.setMemoryBudget(bytes / 2) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( executor.execute(tasks, store) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( store.getMemoryUsage() == 11 * sizeof(double) );
+  fail_unless( store.getSpilledSize() == 3 * bytes );
+}
+END_TEST
+
+
+/*
+ * Forwards the runs of a task to another listener in the reverse order,
+ * once all of them have finished.
+ */
+class ReversingListener : public SedExecutionListener
+{
+public:
+  ReversingListener(SedExecutionListener& listener, size_t numRuns)
+    : mListener(listener)
+    , mNumRuns(numRuns)
+  {
+  }
+
+  virtual void runFinished(const SedSimulationRun& run,
+                           const SedSimulationResult& result)
+  {
+    mRuns.push_back(run);
+    mResults.push_back(result);
+
+    if (mRuns.size() < mNumRuns) return;
+
+    for (size_t n = mRuns.size(); n > 0; --n)
+      {
+        mListener.runFinished(mRuns[n - 1], mResults[n - 1]);
+      }
+
+    mRuns.clear();
+    mResults.clear();
+  }
+
+  SedExecutionListener& mListener;
+  size_t mNumRuns;
+  std::vector<SedSimulationRun> mRuns;
+  std::vector<SedSimulationResult> mResults;
+};
+
+
+START_TEST (test_report_writer)
+{
+  SedDocument doc;
+  SedModel* model = doc.createModel();
+  model->setId("model");
+  model->setLanguage("urn:sedml:language:sbml");
+
+  SedUniformTimeCourse* sim = doc.createUniformTimeCourse();
+  sim->setId("sim");
+  sim->setOutputStartTime(0);
+  sim->setOutputEndTime(10);
+  sim->setNumberOfPoints(10);
+  sim->createAlgorithm()->setKisaoID("KISAO:0000019");
+
+  SedTask* task = doc.createTask();
+  task->setId("task");
+  task->setModelReference("model");
+  task->setSimulationReference("sim");
+
+  SedRepeatedTask* sweep = doc.createRepeatedTask();
+  sweep->setId("sweep");
+  sweep->setRangeId("r");
+  sweep->setResetModel(true);
+  SedUniformRange* uniform = sweep->createUniformRange();
+  uniform->setId("r");
+  uniform->setStart(0);
+  uniform->setEnd(3);
+  uniform->setNumberOfPoints(3);
+  sweep->createSubTask()->setTask("task");
+  SedSetValue* change = sweep->createTaskChange();
+  change->setModelReference("model");
+  change->setTarget("k");
+  ASTNode* math = SBML_parseL3Formula("r");
+  change->setMath(math);
+  delete math;
+
+  const char* ids[] = { "time", "k" };
+  for (unsigned int n = 0; n < 2; ++n)
+    {
+      SedDataGenerator* generator = doc.createDataGenerator();
+      generator->setId(ids[n]);
+      SedVariable* variable = generator->createVariable();
+      variable->setId("v");
+      if (n == 0)
+        variable->setSymbol("urn:sedml:symbol:time");
+      else
+        variable->setTarget("k");
+      variable->setTaskReference("sweep");
+      math = SBML_parseL3Formula("v");
+      generator->setMath(math);
+      delete math;
+    }
+
+  SedReport* report = doc.createReport();
+  report->setId("report");
+  SedDataSet* dataSet = report->createDataSet();
+  dataSet->setId("d1");
+  dataSet->setLabel("time, s");
+  dataSet->setDataReference("time");
+  dataSet = report->createDataSet();
+  dataSet->setId("d2");
+  dataSet->setDataReference("k");
+
+  SedMockBackend backend;
+  SedTaskExecutor executor(2);
+  executor.addBackend(&backend);
+  std::vector<const SedTask*> tasks;
+  tasks.push_back(sweep);
+
+  // the rows are written in the order of the runs as they finish
+  SedReportWriter writer;
+  std::ostringstream csv;
+  fail_unless( writer.open(*report, csv) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.isOpen() );
+  fail_unless( executor.execute(tasks, writer) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.getNumRows() == 4 * 11 );
+  std::string text = csv.str();
+  fail_unless( text.find("\"time, s\",d2\n0,0\n1,0\n") == 0 );
+  fail_unless( text.find("\n10,3\n") == text.size() - 6 );
+  fail_unless( std::count(text.begin(), text.end(), '\n') == 1 + 4 * 11 );
+
+  fail_unless( writer.setFormat(SEDML_REPORT_TSV) == LIBSEDML_OPERATION_SUCCESS );
+  std::ostringstream tsv;
+  fail_unless( writer.open(*report, tsv) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( executor.execute(tasks, writer) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( tsv.str().find("time, s\td2\n0\t0\n") == 0 );
+
+  // a header, one block of 44 rows, and an empty block
+  fail_unless( writer.setFormat(SEDML_REPORT_BINARY) == LIBSEDML_OPERATION_SUCCESS );
+  std::ostringstream binary;
+  fail_unless( writer.open(*report, binary) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( executor.execute(tasks, writer) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  text = binary.str();
+  fail_unless( text.size() == 12 + 4 + 7 + 4 + 2 + 4 + 4 * 11 * 2 * 8 + 4 );
+  fail_unless( text.compare(0, 4, "SEDR") == 0 );
+  fail_unless( text[8] == 2 && text[29] == 44 );
+  fail_unless( text.compare(text.size() - 4, 4, std::string(4, '\0')) == 0 );
+
+  // the same rows, from a store
+  SedResultStore store;
+  fail_unless( executor.execute(tasks, store) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.setFormat(SEDML_REPORT_CSV) == LIBSEDML_OPERATION_SUCCESS );
+  std::ostringstream stored;
+  fail_unless( writer.open(*report, stored) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.write(store) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( stored.str() == csv.str() );
+
+  // the runs reported ahead of their turn, held in memory or in a file
+  ReversingListener reversing(writer, 4);
+  std::ostringstream reversed;
+  fail_unless( writer.getMemoryBudget() == 64 * 1024 * 1024 );
+  fail_unless( writer.open(*report, reversed) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( executor.execute(tasks, reversing) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( reversed.str() == csv.str() );
+
+  fail_unless( writer.setMemoryBudget(11 * 2 * sizeof(double)) == LIBSEDML_OPERATION_SUCCESS );
+  std::ostringstream spilled;
+  fail_unless( writer.open(*report, spilled) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( executor.execute(tasks, reversing) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( spilled.str() == csv.str() );
+
+  // the precision applies to the integers too, whatever the locale
+  SedDataGenerator* generator = doc.createDataGenerator();
+  generator->setId("scaled");
+  SedVariable* variable = generator->createVariable();
+  variable->setId("v");
+  variable->setSymbol("urn:sedml:symbol:time");
+  variable->setTaskReference("sweep");
+  math = SBML_parseL3Formula("1000 * v + v / 4");
+  generator->setMath(math);
+  delete math;
+  dataSet->setDataReference("scaled");
+  fail_unless( executor.execute(tasks, store) == LIBSEDML_OPERATION_SUCCESS );
+
+  fail_unless( writer.setPrecision(3) == LIBSEDML_OPERATION_SUCCESS );
+  std::ostringstream rounded;
+  fail_unless( writer.open(*report, rounded) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.write(store) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  text = rounded.str();
+  fail_unless( text.find("\n0,0\n1,1e+03\n") != std::string::npos );
+  fail_unless( text.find("\n10,1e+04\n") != std::string::npos );
+
+  fail_unless( writer.setPrecision(5) == LIBSEDML_OPERATION_SUCCESS );
+  std::string locale = setlocale(LC_NUMERIC, NULL);
+  if (setlocale(LC_NUMERIC, "de_DE.UTF-8") == NULL)
+    setlocale(LC_NUMERIC, "fr_FR.UTF-8");
+  std::ostringstream decimal;
+  fail_unless( writer.open(*report, decimal) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.write(store) == LIBSEDML_OPERATION_SUCCESS );
+  fail_unless( writer.close() == LIBSEDML_OPERATION_SUCCESS );
+  setlocale(LC_NUMERIC, locale.c_str());
+  text = decimal.str();
+  fail_unless( text.find("\n1,1000.2\n") != std::string::npos );
+  fail_unless( text.find("\n3,3000.8\n") != std::string::npos );
+  fail_unless( text.find("\n10,10002\n") != std::string::npos );
+
+  dataSet->setDataReference("unknown");
+  fail_unless( writer.open(*report, stored) == LIBSEDML_INVALID_OBJECT );
+  fail_unless( !writer.isOpen() );
+  fail_unless( !writer.getErrorMessage().empty() );
+}
+END_TEST
+
 
 Suite *
 create_suite_SedMLIssues (void)
@@ -117,6 +2143,35 @@ create_suite_SedMLIssues (void)
   cout << "  libSEDML : " << getLibSEDMLDottedVersion() << endl << endl;
  
   tcase_add_test( tcase, test_mathml_issue1         );
+  tcase_add_test( tcase, test_writer_subtree_cache  );
+#ifdef LIBSEDML_USE_THREADS
+  tcase_add_test( tcase, test_writer_parallel_lists );
+#else
+  cout << "  skipping test_writer_parallel_lists (built without WITH_THREADS)"
+       << endl << endl;
+#endif
+  tcase_add_test( tcase, test_json_roundtrip        );
+  tcase_add_test( tcase, test_errorlog_index        );
+  tcase_add_test( tcase, test_reader_cache );
+  tcase_add_test( tcase, test_reader_trusted_failfast );
+  tcase_add_test( tcase, test_reader_writer_statistics );
+  tcase_add_test( tcase, test_document_memory_usage );
+  tcase_add_test( tcase, test_document_freeze );
+  tcase_add_test( tcase, test_visitor_traversal );
+  tcase_add_test( tcase, test_tree_iteration );
+  tcase_add_test( tcase, test_parallel_traversal );
+  tcase_add_test( tcase, test_deferred_connect );
+  tcase_add_test( tcase, test_math_program );
+  tcase_add_test( tcase, test_range_values );
+  tcase_add_test( tcase, test_task_plan );
+  tcase_add_test( tcase, test_dependency_graph );
+  tcase_add_test( tcase, test_task_executor );
+  tcase_add_test( tcase, test_sbml_backend );
+  tcase_add_test( tcase, test_sbml_conversion_factor );
+  tcase_add_test( tcase, test_resample );
+  tcase_add_test( tcase, test_result_store );
+  tcase_add_test( tcase, test_result_spill );
+  tcase_add_test( tcase, test_report_writer );
 
   suite_add_tcase(suite, tcase);
 